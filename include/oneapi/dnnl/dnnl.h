@@ -316,6 +316,32 @@ dnnl_status_t DNNL_API dnnl_primitive_attr_get_scratchpad_mode(
 dnnl_status_t DNNL_API dnnl_primitive_attr_set_scratchpad_mode(
         dnnl_primitive_attr_t attr, dnnl_scratchpad_mode_t mode);
 
+/// Returns the primitive attributes maximum number of threads.
+///
+/// @param attr Primitive attributes.
+/// @param max_threads Output maximum number of threads.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_max_threads(
+        const_dnnl_primitive_attr_t attr, int *max_threads);
+
+/// Sets the primitive attributes maximum number of threads.
+///
+/// The primitive uses at most @p max_threads threads of the ones the
+/// threading runtime provides, both for the execution and for the choice of
+/// the blocking at the creation time. The setting has no effect on GPU
+/// engines.
+///
+/// @param attr Primitive attributes.
+/// @param max_threads Maximum number of threads. The possible values are:
+///     0 (default) to use all the threads, a positive number, and
+///     #DNNL_MAX_THREADS_AUTO to choose the number of threads based on the
+///     amount of work of the primitive.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_max_threads(
+        dnnl_primitive_attr_t attr, int max_threads);
+
 /// Returns primitive attributes output scaling factors correspondence mask
 /// and values.
 ///
@@ -506,6 +532,47 @@ dnnl_status_t DNNL_API dnnl_primitive_attr_set_zero_points(
         dnnl_primitive_attr_t attr, int arg, dnnl_dim_t count, int mask,
         const int32_t *zero_points);
 
+/// Returns the parameters of the weights decompression.
+///
+/// @param attr Primitive attributes.
+/// @param group_size Output size of the groups of the input channels, 0 for
+///     the scales and the zero points shared by all the input channels.
+/// @param with_zero_points Output flag of the zero points: 1 if the weights
+///     are decompressed with the zero points, 0 otherwise.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise. #dnnl_invalid_arguments is returned if the weights
+///     decompression is not set.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_weights_decompression(
+        const_dnnl_primitive_attr_t attr, dnnl_dim_t *group_size,
+        int *with_zero_points);
+
+/// Sets the weights decompression: the weights of an integer data type (s8,
+/// u8, s4 or u4) are converted to the floating point data type of the source
+/// inside of the primitive as
+///
+///     weights_f(k, n) = scale(g, n) * (weights(k, n) - zero_point(g, n)),
+///
+/// where k is the input channel, n is the output channel, and g is the group
+/// of the input channels k / @p group_size (or 0 if @p group_size is 0).
+///
+/// The scales and the zero points are passed at the execution time as f32
+/// tensors of G x N elements, the output channels innermost, with the
+/// #DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_SCALES and
+/// #DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_ZERO_POINTS arguments, where G is the
+/// number of the groups. The attribute is supported by the matmul primitive.
+///
+/// @param attr Primitive attributes.
+/// @param group_size Size of the groups of the input channels sharing the
+///     scales and the zero points, or 0 if they are shared by all the input
+///     channels. Must divide the number of the input channels.
+/// @param with_zero_points If not 0, the zero points are subtracted from the
+///     weights before the scaling.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_weights_decompression(
+        dnnl_primitive_attr_t attr, dnnl_dim_t group_size,
+        int with_zero_points);
+
 /// Returns primitive attributes post-ops.
 ///
 /// @warning
@@ -888,6 +955,30 @@ dnnl_status_t DNNL_API dnnl_memory_desc_init_by_tag(
         dnnl_memory_desc_t *memory_desc, int ndims, const dnnl_dims_t dims,
         dnnl_data_type_t data_type, dnnl_format_tag_t tag);
 
+/// Initializes a memory descriptor for a 2D tensor of weights in the
+/// block-sparse format described by @ref dnnl_sparse_desc_t.
+///
+/// The memory object is filled by a reorder from a dense tensor of weights
+/// that fails if the tensor has more non-zero blocks than @p nnz_blocks.
+///
+/// @param memory_desc Output memory descriptor.
+/// @param ndims Number of dimensions, must be 2.
+/// @param dims Array of dimensions.
+/// @param data_type Elements data type: #dnnl_f32, #dnnl_bf16 or #dnnl_s8.
+/// @param oc_dim Index of the output channels dimension: 0 for the inner
+///     product weights and 1 for the matmul weights.
+/// @param block_k Number of the input channels in a block: 1 or 4. Must be
+///     4 for #dnnl_bf16 and #dnnl_s8, and must divide the number of the
+///     input channels.
+/// @param nnz_blocks Maximum number of the stored blocks. If 0, the tensor
+///     can hold all the blocks.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_memory_desc_init_by_sparse_bcsr(
+        dnnl_memory_desc_t *memory_desc, int ndims, const dnnl_dims_t dims,
+        dnnl_data_type_t data_type, int oc_dim, int block_k,
+        dnnl_dim_t nnz_blocks);
+
 /// Initializes a memory descriptor for a region inside an area
 /// described by an existing memory descriptor.
 ///
@@ -1186,6 +1277,28 @@ dnnl_status_t DNNL_API dnnl_reorder_primitive_desc_create(
         const dnnl_memory_desc_t *dst_desc, dnnl_engine_t dst_engine,
         const_dnnl_primitive_attr_t attr);
 
+/// Creates a primitive descriptor for a multi-destination reorder
+/// primitive. The primitive reads the source once and writes it to @p n
+/// destinations that may differ in memory format and data type. The source
+/// is passed as #DNNL_ARG_FROM and the i-th destination as
+/// #DNNL_ARG_MULTIPLE_DST + i.
+///
+/// @param multi_reorder_primitive_desc Output primitive descriptor.
+/// @param src_desc Source memory descriptor.
+/// @param n Number of destinations.
+/// @param dst_descs Array of destination memory descriptors with @p n
+///     elements.
+/// @param attr Primitive attributes to use (can be NULL). The attributes
+///     apply to every destination.
+/// @param engine Engine to use.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_multi_reorder_primitive_desc_create(
+        dnnl_primitive_desc_t *multi_reorder_primitive_desc,
+        const dnnl_memory_desc_t *src_desc, int n,
+        const dnnl_memory_desc_t *dst_descs, const_dnnl_primitive_attr_t attr,
+        dnnl_engine_t engine);
+
 /// @} dnnl_api_reorder
 
 /// @addtogroup dnnl_api_concat
@@ -3313,6 +3426,25 @@ size_t DNNL_API dnnl_engine_get_count(dnnl_engine_kind_t kind);
 dnnl_status_t DNNL_API dnnl_engine_create(
         dnnl_engine_t *engine, dnnl_engine_kind_t kind, size_t index);
 
+/// Creates a CPU engine allocating the memory of the memory objects and of
+/// the scratchpads with user functions.
+///
+/// @note
+///     The buffers the library allocates internally, for instance when a
+///     primitive is created, are allocated with the library functions.
+///
+/// @param engine Output engine.
+/// @param kind Engine kind, only #dnnl_cpu is supported.
+/// @param index Engine index that should be between 0 and the count of
+///     engines of the requested kind.
+/// @param allocate Function allocating the memory.
+/// @param deallocate Function releasing the memory allocated by @p allocate.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_engine_create_with_allocator(dnnl_engine_t *engine,
+        dnnl_engine_kind_t kind, size_t index, dnnl_memory_allocate_f allocate,
+        dnnl_memory_deallocate_f deallocate);
+
 /// Returns the kind of an engine.
 ///
 /// @param engine Engine to query.
@@ -3395,6 +3527,31 @@ dnnl_status_t DNNL_API dnnl_get_primitive_cache_capacity(int *capacity);
 ///     success.
 dnnl_status_t DNNL_API dnnl_set_primitive_cache_capacity(int capacity);
 
+/// Returns the amount of memory in bytes that the primitives held in the
+/// primitive cache may occupy.
+///
+/// @param capacity Primitive cache memory capacity to query. The value of 0
+///     means that the memory is not limited. Concurrently accessing
+///     @p capacity is safe.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p capacity value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_capacity_bytes(
+        size_t *capacity);
+
+/// Sets the amount of memory in bytes that the primitives held in the
+/// primitive cache may occupy. The memory of a primitive is estimated as the
+/// memory allocated for it at creation time (e.g. for generated code). The
+/// limit applies together with the limit on the number of primitives.
+///
+/// @param capacity Primitive cache memory capacity to set. If the primitives
+///     the cache already has occupy more memory, the least recently used
+///     ones are evicted. Setting the @p capacity to 0 (the default) removes
+///     the limit. Concurrently modifying @p capacity is safe.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_primitive_cache_capacity_bytes(
+        size_t capacity);
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_service
@@ -3434,6 +3591,55 @@ dnnl_status_t DNNL_API dnnl_set_jit_dump(int enable);
 ///  - hash: git commit hash.
 const dnnl_version_t DNNL_API *dnnl_version(void);
 
+/// Returns the scratchpad pool statistics.
+///
+/// When the DNNL_SCRATCHPAD_POOL environment variable is set to 1, primitives
+/// executed in #dnnl_scratchpad_mode_library mode on CPU engines with a
+/// synchronous runtime take their scratchpad from a process-wide pool for the
+/// duration of each execution.
+///
+/// @param stats Output statistics. Concurrently querying the statistics is
+///     safe.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p stats value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_scratchpad_pool_stats(
+        dnnl_scratchpad_pool_stats_t *stats);
+
+/// Sets the huge pages mode of the buffers of 2 MB and more the library
+/// allocates on CPU: the memory objects, the scratchpads, and the internal
+/// buffers such as the packed GEMM matrices. The large buffers use fewer TLB
+/// entries with huge pages.
+///
+/// @note
+///     This setting overrides the DNNL_HUGE_PAGES environment variable, which
+///     accepts the same values as integers. It affects only the buffers
+///     allocated after the call. The mode is ignored on the systems other
+///     than Linux.
+///
+/// @param mode Huge pages mode, #dnnl_huge_pages_none by default.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p mode value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_set_huge_pages_mode(dnnl_huge_pages_mode_t mode);
+
+/// Configures the autotuning of the threading of the CPU GEMM. In this mode,
+/// the first call with a new signature (the sizes, the transposition flags,
+/// the leading dimensions, the data types, and the number of threads) times
+/// several thread decompositions of the problem and the copy-based and the
+/// no-copy kernels. The fastest variant is reused for the next calls with the
+/// same signature.
+///
+/// @note
+///     This setting overrides the DNNL_GEMM_TUNE environment variable. When
+///     the DNNL_GEMM_TUNE_FILE environment variable is set, the tuned
+///     variants are loaded from and appended to the file it names. Tuning is
+///     available on x64 only.
+///
+/// @param enable Flag value. Set to 0 to disable and set to 1 to enable.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_gemm_tune(int enable);
+
 /// Sets library profiling flags. The flags define which profilers are
 /// supported.
 ///
@@ -3713,6 +3919,176 @@ dnnl_status_t DNNL_API dnnl_gemm_s8s8s32(char transa, char transb, char offsetc,
         dnnl_dim_t lda, int8_t ao, const int8_t *B, dnnl_dim_t ldb, int8_t bo,
         float beta, int32_t *C, dnnl_dim_t ldc, const int32_t *co);
 
+/// Performs matrix-matrix multiply on bfloat16 matrices A and B, and
+/// single-precision resulting matrix C.
+///
+/// The operation is defined as:
+///
+/// `C := alpha * op( A ) * op( B ) + beta * C`
+///
+/// where
+///  - `op( X ) = X` or `op( X ) = X**T`,
+///  - `alpha` and `beta` are scalars, and
+///  - `A`, `B`, and `C` are matrices:
+///     - `op( A )` is an `MxK` matrix,
+///     - `op( B )` is an `KxN` matrix,
+///     - `C` is an `MxN` matrix.
+///
+/// The bfloat16 values are passed as their 16-bit representations: the 16
+/// most significant bits of the corresponding single-precision values.
+///
+/// The matrices are assumed to be stored in row-major order (the elements in
+/// each of the matrix rows are contiguous in memory).
+///
+/// @note
+///     This API does not support XERBLA. Instead, unlike the standard BLAS
+///     functions, this one returns a dnnl_status_t value to allow error
+///     handling.
+///
+/// @param transa Transposition flag for matrix A: 'N' or 'n' means A is not
+///     transposed, and 'T' or 't' means that A is transposed.
+/// @param transb Transposition flag for matrix B: 'N' or 'n' means B is not
+///     transposed, and 'T' or 't' means that B is transposed.
+/// @param M The M dimension.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param alpha The alpha parameter that is used to scale the product of
+///     matrices A and B.
+/// @param A A pointer to the A matrix data.
+/// @param lda The leading dimension for the matrix A.
+/// @param B A pointer to the B matrix data.
+/// @param ldb The leading dimension for the matrix B.
+/// @param beta The beta parameter that is used to scale the matrix C.
+/// @param C A pointer to the C matrix data.
+/// @param ldc The leading dimension for the matrix C.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_bf16bf16f32(char transa, char transb,
+        dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, float alpha,
+        const uint16_t *A, dnnl_dim_t lda, const uint16_t *B, dnnl_dim_t ldb,
+        float beta, float *C, dnnl_dim_t ldc);
+
+/// Returns the size of the buffer for a matrix A or B packed by
+/// dnnl_gemm_bf16bf16f32_pack().
+///
+/// A matrix reused by several multiplications, for instance the weights of a
+/// model, may be packed once into an internal layout that
+/// dnnl_gemm_bf16bf16f32_compute() reads directly.
+///
+/// @param identifier The matrix to pack: 'A' or 'a' for the matrix A, and
+///     'B' or 'b' for the matrix B.
+/// @param transa Transposition flag for matrix A: 'N' or 'n' means A is not
+///     transposed, and 'T' or 't' means that A is transposed.
+/// @param transb Transposition flag for matrix B: 'N' or 'n' means B is not
+///     transposed, and 'T' or 't' means that B is transposed.
+/// @param M The M dimension.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param lda The leading dimension for the matrix A.
+/// @param ldb The leading dimension for the matrix B.
+/// @param size Output size of the packed matrix in bytes.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_bf16bf16f32_pack_get_size(char identifier,
+        char transa, char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K,
+        dnnl_dim_t lda, dnnl_dim_t ldb, size_t *size);
+
+/// Packs a matrix A or B for dnnl_gemm_bf16bf16f32_compute().
+///
+/// The packed matrix may be used only with the same dimensions and
+/// transposition flags, and on the same number of threads.
+///
+/// @param identifier The matrix to pack: 'A' or 'a' for the matrix A, and
+///     'B' or 'b' for the matrix B.
+/// @param transa Transposition flag for matrix A: 'N' or 'n' means A is not
+///     transposed, and 'T' or 't' means that A is transposed.
+/// @param transb Transposition flag for matrix B: 'N' or 'n' means B is not
+///     transposed, and 'T' or 't' means that B is transposed.
+/// @param M The M dimension.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param lda The leading dimension for the matrix A.
+/// @param ldb The leading dimension for the matrix B.
+/// @param src A pointer to the matrix to pack.
+/// @param dst A pointer to the packed matrix of the size returned by
+///     dnnl_gemm_bf16bf16f32_pack_get_size().
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_bf16bf16f32_pack(char identifier,
+        char transa, char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K,
+        dnnl_dim_t lda, dnnl_dim_t ldb, const uint16_t *src, uint16_t *dst);
+
+/// Performs the matrix-matrix multiply of dnnl_gemm_bf16bf16f32() with
+/// alpha equal to 1 on the matrices A and B packed by
+/// dnnl_gemm_bf16bf16f32_pack().
+///
+/// @param transa Transposition flag for matrix A: 'P' or 'p' means A is
+///     packed, the other values are the same as for dnnl_gemm_bf16bf16f32().
+/// @param transb Transposition flag for matrix B: 'P' or 'p' means B is
+///     packed, the other values are the same as for dnnl_gemm_bf16bf16f32().
+/// @param M The M dimension.
+/// @param N The N dimension.
+/// @param K The K dimension.
+/// @param A A pointer to the A matrix data.
+/// @param lda The leading dimension for the matrix A, ignored if A is
+///     packed.
+/// @param B A pointer to the B matrix data.
+/// @param ldb The leading dimension for the matrix B, ignored if B is
+///     packed.
+/// @param beta The beta parameter that is used to scale the matrix C.
+/// @param C A pointer to the C matrix data.
+/// @param ldc The leading dimension for the matrix C.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_gemm_bf16bf16f32_compute(char transa,
+        char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K,
+        const uint16_t *A, dnnl_dim_t lda, const uint16_t *B, dnnl_dim_t ldb,
+        float beta, float *C, dnnl_dim_t ldc);
+
+/// Performs a group of single-precision matrix-matrix multiplies with
+/// different sizes.
+///
+/// Each multiply of the group is defined as for dnnl_sgemm():
+///
+/// `C[i] := alpha * op( A[i] ) * op( B[i] ) + beta * C[i]`
+///
+/// where `op( A[i] )` is an `M[i]xK[i]` matrix, `op( B[i] )` is a
+/// `K[i]xN[i]` matrix, and `C[i]` is an `M[i]xN[i]` matrix. The matrices are
+/// stored in row-major order.
+///
+/// The multiplies are split into blocks of rows of C distributed between the
+/// threads at once, so that a group of small multiplies uses all the threads.
+/// The multiplies sharing the same matrix B (the same pointer, sizes, and
+/// leading dimension) use a single packed copy of it when alpha is 1.
+///
+/// @note
+///     The matrices C of the group must not overlap.
+///
+/// @param transa Transposition flag for the matrices A: 'N' or 'n' means A
+///     is not transposed, and 'T' or 't' means that A is transposed.
+/// @param transb Transposition flag for the matrices B: 'N' or 'n' means B
+///     is not transposed, and 'T' or 't' means that B is transposed.
+/// @param group_size The number of multiplies in the group.
+/// @param M An array of @p group_size M dimensions.
+/// @param N An array of @p group_size N dimensions.
+/// @param K An array of @p group_size K dimensions.
+/// @param alpha The alpha parameter that is used to scale the products of
+///     matrices A and B.
+/// @param A An array of @p group_size pointers to the A matrices.
+/// @param lda An array of @p group_size leading dimensions of the matrices A.
+/// @param B An array of @p group_size pointers to the B matrices.
+/// @param ldb An array of @p group_size leading dimensions of the matrices B.
+/// @param beta The beta parameter that is used to scale the matrices C.
+/// @param C An array of @p group_size pointers to the C matrices.
+/// @param ldc An array of @p group_size leading dimensions of the matrices C.
+/// @returns #dnnl_success/#dnnl::status::success on success and a status
+///     describing the error otherwise.
+dnnl_status_t DNNL_API dnnl_sgemm_grouped(char transa, char transb,
+        dnnl_dim_t group_size, const dnnl_dim_t *M, const dnnl_dim_t *N,
+        const dnnl_dim_t *K, float alpha, const float *const *A,
+        const dnnl_dim_t *lda, const float *const *B, const dnnl_dim_t *ldb,
+        float beta, float *const *C, const dnnl_dim_t *ldc);
+
 /// @} dnnl_api_blas
 
 /// @} dnnl_api
@@ -313,6 +313,8 @@ struct primitive : public handle<dnnl_primitive_t> {
         reduction = dnnl_reduction,
         /// A PReLU primitive.
         prelu = dnnl_prelu,
+        /// A multi-destination reorder primitive.
+        multi_reorder = dnnl_multi_reorder,
     };
 
     using handle::handle;
@@ -907,6 +909,26 @@ struct engine : public handle<dnnl_engine_t> {
         reset(engine);
     }
 
+    /// Constructs a CPU engine allocating the memory of the memory objects
+    /// and of the scratchpads with user functions.
+    ///
+    /// @param akind The kind of engine to construct, only
+    ///     #dnnl::engine::kind::cpu is supported.
+    /// @param index The index of the engine. Must be less than the value
+    ///     returned by #get_count() for this particular kind of engine.
+    /// @param allocate The function allocating the memory.
+    /// @param deallocate The function releasing the memory allocated by
+    ///     @p allocate.
+    engine(kind akind, size_t index, dnnl_memory_allocate_f allocate,
+            dnnl_memory_deallocate_f deallocate) {
+        dnnl_engine_t engine;
+        error::wrap_c_api(
+                dnnl_engine_create_with_allocator(&engine,
+                        convert_to_c(akind), index, allocate, deallocate),
+                "could not create an engine with an allocator");
+        reset(engine);
+    }
+
     /// Constructs an engine based on a primitive from the primitive
     /// descriptor @p pd by querying its engine.
     ///
@@ -989,7 +1011,8 @@ struct stream : public handle<dnnl_stream_t> {
     enum class flags : unsigned {
         /// In-order execution.
         in_order = dnnl_stream_in_order,
-        /// Out-of-order execution.
+        /// Out-of-order execution. On CPU, the primitives are executed
+        /// asynchronously and the independent ones run concurrently.
         out_of_order = dnnl_stream_out_of_order,
         /// Default stream configuration.
         default_flags = dnnl_stream_default_flags,
@@ -1143,6 +1166,12 @@ struct memory : public handle<dnnl_memory_t> {
         s8 = dnnl_s8,
         /// 8-bit unsigned integer.
         u8 = dnnl_u8,
+        /// 4-bit signed integer, two values per byte. Only used for the
+        /// compressed weights.
+        s4 = dnnl_s4,
+        /// 4-bit unsigned integer, two values per byte. Only used for the
+        /// compressed weights.
+        u4 = dnnl_u4,
     };
 
     /// Memory format kind
@@ -1160,6 +1189,8 @@ struct memory : public handle<dnnl_memory_t> {
         wino = dnnl_format_kind_wino,
         /// Packed weights format used in RNN.
         packed = dnnl_format_kind_rnn_packed,
+        /// Block-sparse weights format used in inner product and matmul.
+        sparse = dnnl_format_kind_sparse,
     };
 
     /// Memory format tag specification.
@@ -1610,6 +1641,12 @@ struct memory : public handle<dnnl_memory_t> {
         abdEc32e = dnnl_abdEc32e,
         abdEC32e2c = dnnl_abdEC32e2c,
         abdEC32e4c = dnnl_abdEC32e4c,
+        BA16a64b = dnnl_BA16a64b,
+        BA16a64b2a = dnnl_BA16a64b2a,
+        BA16a64b4a = dnnl_BA16a64b4a,
+        aCB16b64c = dnnl_aCB16b64c,
+        aCB16b64c2b = dnnl_aCB16b64c2b,
+        aCB16b64c4b = dnnl_aCB16b64c4b,
 
         format_tag_last = dnnl_format_tag_last,
 
@@ -1877,6 +1914,37 @@ struct memory : public handle<dnnl_memory_t> {
         /// @param data A C API ::dnnl_memory_desc_t structure.
         desc(const dnnl_memory_desc_t &data) : data(data) {}
 
+        /// Constructs a memory descriptor for a 2D tensor of weights in the
+        /// block-sparse format described by ::dnnl_sparse_desc_t.
+        ///
+        /// @param adims Tensor dimensions.
+        /// @param adata_type Data precision/type: f32, bf16 or s8.
+        /// @param oc_dim Index of the output channels dimension: 0 for the
+        ///     inner product weights and 1 for the matmul weights.
+        /// @param block_k Number of the input channels in a block: 1 or 4.
+        ///     Must be 4 for bf16 and s8.
+        /// @param nnz_blocks Maximum number of the stored blocks. If 0, the
+        ///     tensor can hold all the blocks.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case a
+        ///     zero memory descriptor will be returned. This flag is optional
+        ///     and defaults to false.
+        /// @returns A memory descriptor for the block-sparse tensor.
+        static desc sparse_bcsr(const dims &adims, data_type adata_type,
+                int oc_dim, int block_k, dim nnz_blocks = 0,
+                bool allow_empty = false) {
+            validate_dims(adims);
+            dnnl_memory_desc_t md = dnnl_memory_desc_t();
+            dnnl_status_t status = dnnl_memory_desc_init_by_sparse_bcsr(&md,
+                    (int)adims.size(), adims.data(), convert_to_c(adata_type),
+                    oc_dim, block_k, nnz_blocks);
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not construct a block-sparse memory "
+                        "descriptor");
+            return desc(md);
+        }
+
         /// Constructs a memory descriptor for a region inside an area
         /// described by this memory descriptor.
         //
@@ -2645,6 +2713,25 @@ struct primitive_attr : public handle<dnnl_primitive_attr_t> {
                 "could not set scratchpad mode primitive attribute");
     }
 
+    /// Returns the maximum number of threads.
+    int get_max_threads() const {
+        int result;
+        error::wrap_c_api(dnnl_primitive_attr_get_max_threads(get(), &result),
+                "could not get max threads primitive attribute");
+        return result;
+    }
+
+    /// Sets the maximum number of threads.
+    ///
+    /// @param max_threads Maximum number of threads: 0 (default) to use all
+    ///     the threads, a positive number, or #DNNL_MAX_THREADS_AUTO to let
+    ///     the library choose based on the amount of work of the primitive.
+    void set_max_threads(int max_threads) {
+        error::wrap_c_api(
+                dnnl_primitive_attr_set_max_threads(get(), max_threads),
+                "could not set max threads primitive attribute");
+    }
+
     /// Returns output scaling factors correspondence mask and values.
     ///
     /// @param mask Scaling factors correspondence mask that defines the
@@ -2818,6 +2905,39 @@ struct primitive_attr : public handle<dnnl_primitive_attr_t> {
                 "could not set zero points primitive attribute");
     }
 
+    /// Returns the parameters of the weights decompression.
+    ///
+    /// @sa dnnl_primitive_attr_get_weights_decompression
+    ///
+    /// @param group_size Output size of the groups of the input channels.
+    /// @param with_zero_points Output flag of the zero points.
+    void get_weights_decompression(
+            memory::dim &group_size, bool &with_zero_points) const {
+        dnnl_dim_t c_group_size;
+        int c_with_zero_points;
+        error::wrap_c_api(dnnl_primitive_attr_get_weights_decompression(get(),
+                                  &c_group_size, &c_with_zero_points),
+                "could not get weights decompression primitive attribute");
+        group_size = c_group_size;
+        with_zero_points = c_with_zero_points != 0;
+    }
+
+    /// Sets the weights decompression of the integer weights.
+    ///
+    /// @sa dnnl_primitive_attr_set_weights_decompression
+    ///
+    /// @param group_size Size of the groups of the input channels sharing the
+    ///     scales and the zero points, or 0 if they are shared by all the
+    ///     input channels.
+    /// @param with_zero_points Whether the zero points are subtracted from
+    ///     the weights before the scaling.
+    void set_weights_decompression(
+            memory::dim group_size, bool with_zero_points = false) {
+        error::wrap_c_api(dnnl_primitive_attr_set_weights_decompression(
+                                  get(), group_size, with_zero_points),
+                "could not set weights decompression primitive attribute");
+    }
+
     /// Returns post-ops previously set via set_post_ops().
     ///
     /// @returns Post-ops.
@@ -3599,6 +3719,96 @@ struct concat : public primitive {
 
 /// @} dnnl_api_concat
 
+/// @addtogroup dnnl_api_multi_reorder Multi-destination reorder
+///
+/// A primitive to copy data from one memory object to several memory objects
+/// with different memory formats or data types, reading the source only once.
+///
+/// @sa @ref dev_guide_reorder in developer guide
+///
+/// @{
+
+/// Multi-destination reorder primitive.
+struct multi_reorder : public primitive {
+    /// Primitive descriptor for a multi-destination reorder primitive.
+    struct primitive_desc : public primitive_desc_base {
+        using primitive_desc_base::primitive_desc_base;
+
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for a multi-destination reorder
+        /// primitive.
+        ///
+        /// @param src Source memory descriptor.
+        /// @param dsts Vector of destination memory descriptors.
+        /// @param aengine Engine to perform the operation on.
+        /// @param attr Primitive attributes to use (optional). The attributes
+        ///     apply to every destination.
+        /// @param allow_empty A flag signifying whether construction is allowed
+        ///     to fail without throwing an exception. In this case an empty
+        ///     object will be produced. This flag is optional and defaults to
+        ///     false.
+        primitive_desc(const memory::desc &src,
+                const std::vector<memory::desc> &dsts, const engine &aengine,
+                const primitive_attr &attr = primitive_attr(),
+                bool allow_empty = false) {
+            auto c_dsts = convert_to_c(dsts);
+
+            dnnl_primitive_desc_t result;
+            dnnl_status_t status = dnnl_multi_reorder_primitive_desc_create(
+                    &result, &src.data, (int)c_dsts.size(), c_dsts.data(),
+                    attr.get(), aengine.get());
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for a "
+                        "multi-destination reorder primitive");
+            reset(status == dnnl_success ? result : dnnl_primitive_desc_t());
+        }
+
+        /// Constructs a primitive descriptor for multi-destination reorder
+        /// primitive from a C API primitive descriptor which must have a
+        /// matching kind.
+        ///
+        /// @param pd C API primitive descriptor for multi-destination reorder
+        ///     primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : primitive_desc_base(pd, dnnl::primitive::kind::multi_reorder) {}
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc(int)const
+        memory::desc dst_desc(int idx = 0) const { return base::dst_desc(idx); }
+    };
+
+    /// Default constructor. Produces an empty object.
+    multi_reorder() = default;
+
+    /// Constructs a multi-destination reorder primitive.
+    /// @param pd Primitive descriptor for multi-destination reorder
+    ///     primitive.
+    multi_reorder(const primitive_desc &pd) : primitive(pd.get()) {}
+
+    using primitive::execute;
+
+    /// Executes the multi-destination reorder primitive.
+    ///
+    /// @param astream Stream object. The stream must belong to the same engine
+    ///     as the primitive.
+    /// @param src Source memory object.
+    /// @param dsts Destination memory objects.
+    void execute(const stream &astream, memory &src,
+            const std::vector<memory> &dsts) const {
+        std::unordered_map<int, memory> args {{DNNL_ARG_FROM, src}};
+        for (size_t i = 0; i < dsts.size(); ++i)
+            args.insert({DNNL_ARG_MULTIPLE_DST + (int)i, dsts[i]});
+        primitive::execute(astream, args);
+    }
+};
+
+/// @} dnnl_api_multi_reorder
+
 /// @addtogroup dnnl_api_sum Sum
 ///
 /// A primitive to sum multiple tensors.
@@ -10612,6 +10822,9 @@ struct reduction : public primitive {
 /// @copydoc dnnl_version_t
 using version_t = dnnl_version_t;
 
+/// @copydoc dnnl_scratchpad_pool_stats_t
+using scratchpad_pool_stats_t = dnnl_scratchpad_pool_stats_t;
+
 /// Status values returned by the library functions.
 enum class status {
     /// @copydoc dnnl_success
@@ -10640,6 +10853,36 @@ inline const version_t *version() {
     return dnnl_version();
 }
 
+/// Returns the scratchpad pool statistics.
+/// @sa dnnl_get_scratchpad_pool_stats()
+inline scratchpad_pool_stats_t get_scratchpad_pool_stats() {
+    scratchpad_pool_stats_t result;
+    error::wrap_c_api(dnnl_get_scratchpad_pool_stats(&result),
+            "could not get scratchpad pool statistics");
+    return result;
+}
+
+/// @copydoc dnnl_huge_pages_mode_t
+enum class huge_pages_mode {
+    /// @copydoc dnnl_huge_pages_none
+    none = dnnl_huge_pages_none,
+    /// @copydoc dnnl_huge_pages_madvise
+    madvise = dnnl_huge_pages_madvise,
+    /// @copydoc dnnl_huge_pages_hugetlb
+    hugetlb = dnnl_huge_pages_hugetlb,
+};
+
+/// @copydoc dnnl_set_huge_pages_mode()
+inline status set_huge_pages_mode(huge_pages_mode mode) {
+    return static_cast<status>(dnnl_set_huge_pages_mode(
+            static_cast<dnnl_huge_pages_mode_t>(mode)));
+}
+
+/// @copydoc dnnl_set_gemm_tune()
+inline status set_gemm_tune(int enable) {
+    return static_cast<status>(dnnl_set_gemm_tune(enable));
+}
+
 /// @copydoc dnnl_set_jit_dump()
 inline status set_jit_dump(int enable) {
     return static_cast<status>(dnnl_set_jit_dump(enable));
@@ -10726,6 +10969,21 @@ inline void set_primitive_cache_capacity(int capacity) {
             "could not set primitive cache capacity");
 }
 
+/// Returns the amount of memory in bytes that the primitives held in the
+/// primitive cache may occupy.
+inline size_t get_primitive_cache_capacity_bytes() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_capacity_bytes(&result),
+            "could not get primitive cache memory capacity");
+    return result;
+}
+
+/// @copydoc dnnl_set_primitive_cache_capacity_bytes(size_t capacity)
+inline void set_primitive_cache_capacity_bytes(size_t capacity) {
+    error::wrap_c_api(dnnl_set_primitive_cache_capacity_bytes(capacity),
+            "could not set primitive cache memory capacity");
+}
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_blas BLAS functions
@@ -10761,6 +11019,50 @@ inline status gemm_s8s8s32(char transa, char transb, char offsetc, dnnl_dim_t M,
             K, alpha, A, lda, ao, B, ldb, bo, beta, C, ldc, co));
 }
 
+/// @copydoc dnnl_gemm_bf16bf16f32()
+inline status gemm_bf16bf16f32(char transa, char transb, dnnl_dim_t M,
+        dnnl_dim_t N, dnnl_dim_t K, float alpha, const uint16_t *A,
+        dnnl_dim_t lda, const uint16_t *B, dnnl_dim_t ldb, float beta,
+        float *C, dnnl_dim_t ldc) {
+    return static_cast<status>(dnnl_gemm_bf16bf16f32(
+            transa, transb, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc));
+}
+
+/// @copydoc dnnl_gemm_bf16bf16f32_pack_get_size()
+inline status gemm_bf16bf16f32_pack_get_size(char identifier, char transa,
+        char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, dnnl_dim_t lda,
+        dnnl_dim_t ldb, size_t *size) {
+    return static_cast<status>(dnnl_gemm_bf16bf16f32_pack_get_size(
+            identifier, transa, transb, M, N, K, lda, ldb, size));
+}
+
+/// @copydoc dnnl_gemm_bf16bf16f32_pack()
+inline status gemm_bf16bf16f32_pack(char identifier, char transa, char transb,
+        dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, dnnl_dim_t lda,
+        dnnl_dim_t ldb, const uint16_t *src, uint16_t *dst) {
+    return static_cast<status>(dnnl_gemm_bf16bf16f32_pack(
+            identifier, transa, transb, M, N, K, lda, ldb, src, dst));
+}
+
+/// @copydoc dnnl_gemm_bf16bf16f32_compute()
+inline status gemm_bf16bf16f32_compute(char transa, char transb, dnnl_dim_t M,
+        dnnl_dim_t N, dnnl_dim_t K, const uint16_t *A, dnnl_dim_t lda,
+        const uint16_t *B, dnnl_dim_t ldb, float beta, float *C,
+        dnnl_dim_t ldc) {
+    return static_cast<status>(dnnl_gemm_bf16bf16f32_compute(
+            transa, transb, M, N, K, A, lda, B, ldb, beta, C, ldc));
+}
+
+/// @copydoc dnnl_sgemm_grouped()
+inline status sgemm_grouped(char transa, char transb, dnnl_dim_t group_size,
+        const dnnl_dim_t *M, const dnnl_dim_t *N, const dnnl_dim_t *K,
+        float alpha, const float *const *A, const dnnl_dim_t *lda,
+        const float *const *B, const dnnl_dim_t *ldb, float beta,
+        float *const *C, const dnnl_dim_t *ldc) {
+    return static_cast<status>(dnnl_sgemm_grouped(transa, transb, group_size,
+            M, N, K, alpha, A, lda, B, ldb, beta, C, ldc));
+}
+
 /// @} dnnl_api_blas
 
 // implementation section
@@ -85,6 +85,24 @@ dnnl_status_t DNNL_API dnnl_threadpool_interop_gemm_s8s8s32(char transa,
         const int8_t *B, dnnl_dim_t ldb, int8_t bo, float beta, int32_t *C,
         dnnl_dim_t ldc, const int32_t *co, void *threadpool);
 
+/// @copydoc dnnl_gemm_bf16bf16f32()
+/// @param threadpool A pointer to a threadpool interface (only when built with
+///     the THREADPOOL CPU runtime).
+dnnl_status_t DNNL_API dnnl_threadpool_interop_gemm_bf16bf16f32(char transa,
+        char transb, dnnl_dim_t M, dnnl_dim_t N, dnnl_dim_t K, float alpha,
+        const uint16_t *A, dnnl_dim_t lda, const uint16_t *B, dnnl_dim_t ldb,
+        float beta, float *C, dnnl_dim_t ldc, void *threadpool);
+
+/// @copydoc dnnl_sgemm_grouped()
+/// @param threadpool A pointer to a threadpool interface (only when built with
+///     the THREADPOOL CPU runtime).
+dnnl_status_t DNNL_API dnnl_threadpool_interop_sgemm_grouped(char transa,
+        char transb, dnnl_dim_t group_size, const dnnl_dim_t *M,
+        const dnnl_dim_t *N, const dnnl_dim_t *K, float alpha,
+        const float *const *A, const dnnl_dim_t *lda, const float *const *B,
+        const dnnl_dim_t *ldb, float beta, float *const *C,
+        const dnnl_dim_t *ldc, void *threadpool);
+
 /// @} dnnl_api_threadpool_interop
 
 /// @} dnnl_api_interop
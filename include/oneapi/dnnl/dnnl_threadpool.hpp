@@ -100,6 +100,26 @@ inline status gemm_s8s8s32(char transa, char transb, char offsetc, dnnl_dim_t M,
                     K, alpha, A, lda, ao, B, ldb, bo, beta, C, ldc, co, tp));
 }
 
+/// @copydoc dnnl_gemm_bf16bf16f32_tp()
+inline status gemm_bf16bf16f32(char transa, char transb, dnnl_dim_t M,
+        dnnl_dim_t N, dnnl_dim_t K, float alpha, const uint16_t *A,
+        dnnl_dim_t lda, const uint16_t *B, dnnl_dim_t ldb, float beta,
+        float *C, dnnl_dim_t ldc, threadpool_iface *tp) {
+    return static_cast<status>(dnnl_threadpool_interop_gemm_bf16bf16f32(
+            transa, transb, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, tp));
+}
+
+/// @copydoc dnnl_sgemm_grouped_tp()
+inline status sgemm_grouped(char transa, char transb, dnnl_dim_t group_size,
+        const dnnl_dim_t *M, const dnnl_dim_t *N, const dnnl_dim_t *K,
+        float alpha, const float *const *A, const dnnl_dim_t *lda,
+        const float *const *B, const dnnl_dim_t *ldb, float beta,
+        float *const *C, const dnnl_dim_t *ldc, threadpool_iface *tp) {
+    return static_cast<status>(dnnl_threadpool_interop_sgemm_grouped(transa,
+            transb, group_size, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc,
+            tp));
+}
+
 } // namespace threadpool_interop
 
 /// @} dnnl_api_threadpool_interop
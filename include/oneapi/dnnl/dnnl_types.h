@@ -74,6 +74,14 @@ typedef enum {
     dnnl_s8 = 5,
     /// 8-bit unsigned integer.
     dnnl_u8 = 6,
+    /// 4-bit signed integer. Two values are packed into a byte, the first one
+    /// in the lower half of the byte. Only used for the compressed weights,
+    /// see dnnl_primitive_attr_set_weights_decompression().
+    dnnl_s4 = 7,
+    /// 4-bit unsigned integer. Two values are packed into a byte, the first
+    /// one in the lower half of the byte. Only used for the compressed
+    /// weights, see dnnl_primitive_attr_set_weights_decompression().
+    dnnl_u4 = 8,
 } dnnl_data_type_t;
 
 /// Memory format kind
@@ -91,6 +99,9 @@ typedef enum {
     dnnl_format_kind_wino,
     /// Packed weights format used in RNN
     dnnl_format_kind_rnn_packed,
+    /// Block-sparse weights format used in inner product and matmul. See
+    /// @ref dnnl_sparse_desc_t for more information.
+    dnnl_format_kind_sparse,
 } dnnl_format_kind_t;
 
 /// Memory format tag specification.
@@ -461,6 +472,12 @@ typedef enum {
     dnnl_abdEc32e,
     dnnl_abdEC32e2c,
     dnnl_abdEC32e4c,
+    dnnl_BA16a64b,
+    dnnl_BA16a64b2a,
+    dnnl_BA16a64b4a,
+    dnnl_aCB16b64c,
+    dnnl_aCB16b64c2b,
+    dnnl_aCB16b64c4b,
 
     /// Just a sentinel, not real memory format tag. Must be changed after new
     /// format tag is added.
@@ -936,6 +953,8 @@ typedef enum {
     dnnl_reduction,
     /// A PReLU primitive.
     dnnl_prelu,
+    /// A multi-destination reorder primitive.
+    dnnl_multi_reorder,
 
     /// Parameter to allow internal only primitives without undefined behavior.
     /// This parameter is chosen to be valid for so long as sizeof(int) >= 2.
@@ -1244,6 +1263,47 @@ typedef struct {
     char reserved[200];
 } dnnl_rnn_packed_desc_t;
 
+/// Sparse encodings
+typedef enum {
+    /// Undefined sparse encoding, used for empty memory descriptors.
+    dnnl_sparse_encoding_undef = 0,
+    /// Block compressed sparse row encoding, see @ref dnnl_sparse_desc_t.
+    dnnl_sparse_bcsr,
+} dnnl_sparse_encoding_t;
+
+/// Description of a 2D tensor of weights in a block-sparse format.
+///
+/// The tensor is seen as a matrix of output channels (rows) by input
+/// channels (columns) split into blocks of @p block_n output channels by
+/// @p block_k input channels. Only the blocks with non-zero values are
+/// stored, row of blocks after row of blocks. The buffer holds:
+///  - the offsets of the rows of blocks: `nb_n + 1` 32-bit integers, where
+///    `nb_n` is the number of the rows of blocks; the stored blocks of the
+///    row of blocks `i` are the blocks `offsets[i]` to `offsets[i + 1] - 1`,
+///  - the indices of the blocks of input channels of the stored blocks:
+///    @p nnz_blocks 32-bit integers,
+///  - the values of the stored blocks, starting at the first 64-byte aligned
+///    offset. The values of a block are stored input channel by input
+///    channel, with the @p block_n output channels innermost. For bf16 and
+///    int8 the input channels are interleaved by 2 and 4 respectively, as in
+///    the VNNI weights formats. The output channels past the end of the
+///    tensor are padded with zeros.
+typedef struct {
+    /// Sparse encoding.
+    dnnl_sparse_encoding_t encoding;
+    /// Index of the output channels dimension: 0 for the inner product
+    /// weights (`{OC, IC}`) and 1 for the matmul weights (`{K, N}`).
+    int oc_dim;
+    /// Number of the input channels in a block: 1 or 4.
+    int block_k;
+    /// Number of the output channels in a block: 16.
+    int block_n;
+    /// Maximum number of the stored blocks.
+    dnnl_dim_t nnz_blocks;
+    /// Size of the buffer in bytes.
+    size_t size;
+} dnnl_sparse_desc_t;
+
 /// Flags for memory special features
 typedef enum {
     dnnl_memory_extra_flag_none = 0x0U,
@@ -1324,6 +1384,8 @@ typedef struct {
         dnnl_wino_desc_t wino_desc;
         /// Tensor of packed weights for RNN.
         dnnl_rnn_packed_desc_t rnn_packed_desc;
+        /// Tensor of block-sparse weights.
+        dnnl_sparse_desc_t sparse_desc;
         // ... other descriptions possible
     } format_desc;
 
@@ -2003,6 +2065,16 @@ typedef struct dnnl_engine *dnnl_engine_t;
 typedef const struct dnnl_engine *const_dnnl_engine_t;
 #endif
 
+/// @brief A function allocating the memory of a CPU engine.
+///
+/// Returns a pointer to @p size bytes aligned on @p alignment bytes, or NULL
+/// if the memory cannot be allocated.
+typedef void *(*dnnl_memory_allocate_f)(size_t size, size_t alignment);
+
+/// @brief A function releasing the memory allocated by the matching
+/// #dnnl_memory_allocate_f function.
+typedef void (*dnnl_memory_deallocate_f)(void *ptr);
+
 /// @} dnnl_api_engine
 
 /// @addtogroup dnnl_api_primitives
@@ -2062,6 +2134,12 @@ typedef enum {
     dnnl_scratchpad_mode_user,
 } dnnl_scratchpad_mode_t;
 
+/// A special value of the maximum number of threads primitive attribute. The
+/// library chooses the number of threads for each primitive based on the
+/// amount of work it does, so that small primitives do not pay for the
+/// synchronization of all the threads.
+#define DNNL_MAX_THREADS_AUTO (-1)
+
 /// @struct dnnl_primitive_attr
 /// @brief An opaque structure for primitive descriptor attributes.
 ///
@@ -2284,6 +2362,14 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// Output scaling factors provided at execution time.
 #define DNNL_ARG_ATTR_OUTPUT_SCALES 513
 
+/// Scaling factors of the weights decompression.
+/// See dnnl_primitive_attr_set_weights_decompression().
+#define DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_SCALES 514
+
+/// Zero points of the weights decompression.
+/// See dnnl_primitive_attr_set_weights_decompression().
+#define DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_ZERO_POINTS 515
+
 /// Starting index for source arguments for primitives that take a variable
 /// number of source arguments.
 #define DNNL_ARG_MULTIPLE_SRC 1024
@@ -2425,7 +2511,8 @@ typedef enum {
 typedef enum {
     // In-order execution.
     dnnl_stream_in_order = 0x1U,
-    /// Out-of-order execution.
+    /// Out-of-order execution. On CPU, the primitives are executed
+    /// asynchronously and the independent ones run concurrently.
     dnnl_stream_out_of_order = 0x2U,
     /// Default stream configuration.
     dnnl_stream_default_flags = dnnl_stream_in_order,
@@ -2466,6 +2553,9 @@ typedef const struct dnnl_stream_attr *const_dnnl_stream_attr_t;
 /// Threadpool runtime (CPU only)
 #define DNNL_RUNTIME_THREADPOOL 8u
 
+/// Native threadpool runtime (CPU only)
+#define DNNL_RUNTIME_NATIVE 16u
+
 /// OpenCL runtime
 #define DNNL_RUNTIME_OCL 256u
 
@@ -2486,6 +2576,30 @@ typedef struct {
     unsigned gpu_runtime; ///< GPU runtime
 } dnnl_version_t;
 
+/// Structure containing the scratchpad pool statistics
+typedef struct {
+    /// Number of buffers allocated by the pool
+    uint64_t allocations;
+    /// Number of scratchpads served with a buffer the pool already had
+    uint64_t reuses;
+    /// Memory held by the pool in bytes, including the buffers in use
+    uint64_t bytes;
+    /// Memory of the buffers in use by executing primitives in bytes
+    uint64_t bytes_in_use;
+} dnnl_scratchpad_pool_stats_t;
+
+/// Huge pages modes of the memory allocated by the library
+typedef enum {
+    /// The large buffers use the pages of the default size
+    dnnl_huge_pages_none = 0,
+    /// The large buffers are advised to use transparent huge pages
+    dnnl_huge_pages_madvise = 1,
+    /// The large buffers are allocated from the explicit huge pages pool
+    /// (hugetlbfs), falling back to #dnnl_huge_pages_madvise if the pool is
+    /// exhausted
+    dnnl_huge_pages_hugetlb = 2,
+} dnnl_huge_pages_mode_t;
+
 /// Disable profiling completely
 #define DNNL_JIT_PROFILE_NONE 0u
 
@@ -0,0 +1,244 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/// @file
+/// ukernel C API
+
+#ifndef ONEAPI_DNNL_DNNL_UKERNEL_H
+#define ONEAPI_DNNL_DNNL_UKERNEL_H
+
+#include "oneapi/dnnl/dnnl_config.h"
+#include "oneapi/dnnl/dnnl_types.h"
+#include "oneapi/dnnl/dnnl_ukernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @addtogroup dnnl_api
+/// @{
+
+/// @addtogroup dnnl_api_ukernel
+/// @{
+
+/// @addtogroup dnnl_api_ukernel_brgemm
+/// @{
+
+/// Creates a BRGEMM ukernel object. The ukernel computes
+/// C = alpha * sum_i(A_i * B_i) + beta * C for a batch of the A_i and B_i
+/// matrices. All the matrices are in the row-major layout. The matrices B_i
+/// are expected in the packed layout (see dnnl_brgemm_pack_B()).
+///
+/// @sa @ref dev_guide_ukernel_brgemm
+///
+/// @param brgemm Output BRGEMM ukernel object.
+/// @param batch_kind Kind of the batch.
+/// @param M Number of rows of the matrices A_i and C.
+/// @param N Number of columns of the matrices B_i and C.
+/// @param K Number of columns of the matrices A_i and of rows of the
+///     matrices B_i.
+/// @param a_dt Data type of the matrices A_i. Can be f32, bf16 or u8.
+/// @param lda Leading dimension of the matrices A_i. Must be at least K.
+/// @param b_dt Data type of the matrices B_i. Can be f32, bf16 or s8.
+/// @param ldb Leading dimension of the packed matrices B_i. Must be at
+///     least N.
+/// @param c_dt Data type of the matrix C. Must be s32 for the integer
+///     matrices A_i and B_i, and f32 otherwise.
+/// @param ldc Leading dimension of the matrix C. Must be at least N.
+/// @param alpha Scaling factor of the product of the matrices.
+/// @param beta Scaling factor of the matrix C.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_create(dnnl_brgemm_t *brgemm,
+        dnnl_brgemm_batch_kind_t batch_kind, dnnl_dim_t M, dnnl_dim_t N,
+        dnnl_dim_t K, dnnl_data_type_t a_dt, dnnl_dim_t lda,
+        dnnl_data_type_t b_dt, dnnl_dim_t ldb, dnnl_data_type_t c_dt,
+        dnnl_dim_t ldc, float alpha, float beta);
+
+/// Sets the strides between the matrices of a batch of the
+/// #dnnl_brgemm_batch_strd kind.
+///
+/// @param brgemm BRGEMM ukernel object.
+/// @param stride_a Stride between the matrices A_i in bytes.
+/// @param stride_b Stride between the matrices B_i in bytes.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_set_batch_strides(
+        dnnl_brgemm_t brgemm, dnnl_dim_t stride_a, dnnl_dim_t stride_b);
+
+/// Attaches post-operations to a BRGEMM ukernel object. The post-operations
+/// are applied to the matrix C and the result is written to the matrix D.
+///
+/// @param brgemm BRGEMM ukernel object.
+/// @param d_dt Data type of the matrix D.
+/// @param ldd Leading dimension of the matrix D. Must be at least N.
+/// @param bias_dt Data type of the bias, #dnnl_data_type_undef if the bias
+///     is not applied.
+/// @param attr Attributes with the output scales and the eltwise and sum
+///     post-ops. Can be NULL.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_set_post_ops(dnnl_brgemm_t brgemm,
+        dnnl_data_type_t d_dt, dnnl_dim_t ldd, dnnl_data_type_t bias_dt,
+        const_dnnl_primitive_attr_t attr);
+
+/// Generates the code of a BRGEMM ukernel. The ukernels are cached in the
+/// primitive cache, so the objects with the same parameters share the code.
+///
+/// @param brgemm BRGEMM ukernel object.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_generate(dnnl_brgemm_t brgemm);
+
+/// Returns the size of the scratchpad a BRGEMM ukernel needs at execution.
+///
+/// @param brgemm Generated BRGEMM ukernel object.
+/// @param size Output size of the scratchpad in bytes.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_get_scratchpad_size(
+        const_dnnl_brgemm_t brgemm, size_t *size);
+
+/// Prepares the calling thread to execute a BRGEMM ukernel. With Intel AMX,
+/// configures the tile registers. The configuration stays valid for the
+/// ukernels with the same M, N, K and data types.
+///
+/// @param brgemm Generated BRGEMM ukernel object.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_set_hw_context(const_dnnl_brgemm_t brgemm);
+
+/// Releases the hardware state of the calling thread set by
+/// dnnl_brgemm_set_hw_context().
+///
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_release_hw_context();
+
+/// Executes a BRGEMM ukernel with a batch of the #dnnl_brgemm_batch_addr
+/// kind.
+///
+/// @param brgemm Generated BRGEMM ukernel object.
+/// @param batch_size Number of the pairs of the matrices A_i and B_i.
+/// @param A_addrs Array of the addresses of the matrices A_i.
+/// @param B_addrs Array of the addresses of the matrices B_i.
+/// @param C Matrix C.
+/// @param D Matrix D. Ignored if no post-operations are attached.
+/// @param bias Bias vector of N elements. Ignored if no post-operations are
+///     attached.
+/// @param scales Output scales, one value or N values depending on the
+///     attributes. Ignored if no post-operations are attached.
+/// @param scratchpad Scratchpad of dnnl_brgemm_get_scratchpad_size() bytes.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_execute_addr(const_dnnl_brgemm_t brgemm,
+        dnnl_dim_t batch_size, const void **A_addrs, const void **B_addrs,
+        void *C, void *D, const void *bias, const float *scales,
+        void *scratchpad);
+
+/// Executes a BRGEMM ukernel with a batch of the #dnnl_brgemm_batch_offs
+/// kind.
+///
+/// @param brgemm Generated BRGEMM ukernel object.
+/// @param batch_size Number of the pairs of the matrices A_i and B_i.
+/// @param A Base address of the matrices A_i.
+/// @param A_offsets Array of the offsets of the matrices A_i in bytes.
+/// @param B Base address of the matrices B_i.
+/// @param B_offsets Array of the offsets of the matrices B_i in bytes.
+/// @param C Matrix C.
+/// @param D Matrix D. Ignored if no post-operations are attached.
+/// @param bias Bias vector of N elements. Ignored if no post-operations are
+///     attached.
+/// @param scales Output scales, one value or N values depending on the
+///     attributes. Ignored if no post-operations are attached.
+/// @param scratchpad Scratchpad of dnnl_brgemm_get_scratchpad_size() bytes.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_execute_offs(const_dnnl_brgemm_t brgemm,
+        dnnl_dim_t batch_size, const void *A, const dnnl_dim_t *A_offsets,
+        const void *B, const dnnl_dim_t *B_offsets, void *C, void *D,
+        const void *bias, const float *scales, void *scratchpad);
+
+/// Executes a BRGEMM ukernel with a batch of the #dnnl_brgemm_batch_strd
+/// kind.
+///
+/// @param brgemm Generated BRGEMM ukernel object.
+/// @param batch_size Number of the pairs of the matrices A_i and B_i.
+/// @param A Address of the matrix A_0.
+/// @param B Address of the matrix B_0.
+/// @param C Matrix C.
+/// @param D Matrix D. Ignored if no post-operations are attached.
+/// @param bias Bias vector of N elements. Ignored if no post-operations are
+///     attached.
+/// @param scales Output scales, one value or N values depending on the
+///     attributes. Ignored if no post-operations are attached.
+/// @param scratchpad Scratchpad of dnnl_brgemm_get_scratchpad_size() bytes.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_execute_strd(const_dnnl_brgemm_t brgemm,
+        dnnl_dim_t batch_size, const void *A, const void *B, void *C, void *D,
+        const void *bias, const float *scales, void *scratchpad);
+
+/// Destroys a BRGEMM ukernel object.
+///
+/// @param brgemm BRGEMM ukernel object to destroy.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_destroy(dnnl_brgemm_t brgemm);
+
+/// Returns the size of a matrix B packed by dnnl_brgemm_pack_B().
+///
+/// @param b_dt Data type of the matrix B.
+/// @param K Number of rows of the matrix B.
+/// @param ldb_packed Leading dimension of the packed matrix B.
+/// @param size Output size of the packed matrix in bytes.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_get_B_packed_size(dnnl_data_type_t b_dt,
+        dnnl_dim_t K, dnnl_dim_t ldb_packed, size_t *size);
+
+/// Packs a K x N matrix B into the layout BRGEMM ukernels expect. For 16-bit
+/// and 8-bit data types, the groups of 2 and 4 consecutive rows respectively
+/// are interleaved, and the number of rows is padded with zeroes to a
+/// multiple of the group size. The f32 matrices are copied.
+///
+/// @param b_dt Data type of the matrix B.
+/// @param K Number of rows of the matrix B.
+/// @param N Number of columns of the matrix B.
+/// @param B Matrix B in the row-major layout.
+/// @param ldb Leading dimension of the matrix B.
+/// @param trans_b Whether the matrix B is transposed, 'N' or 'T'.
+/// @param B_packed Output packed matrix B of
+///     dnnl_brgemm_get_B_packed_size() bytes.
+/// @param ldb_packed Leading dimension of the packed matrix B, to be passed
+///     to dnnl_brgemm_create(). Must be at least N.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_brgemm_pack_B(dnnl_data_type_t b_dt, dnnl_dim_t K,
+        dnnl_dim_t N, const void *B, dnnl_dim_t ldb, char trans_b,
+        void *B_packed, dnnl_dim_t ldb_packed);
+
+/// @} dnnl_api_ukernel_brgemm
+
+/// @} dnnl_api_ukernel
+
+/// @} dnnl_api
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,273 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/// @file
+/// ukernel C++ API
+
+#ifndef ONEAPI_DNNL_DNNL_UKERNEL_HPP
+#define ONEAPI_DNNL_DNNL_UKERNEL_HPP
+
+#include <vector>
+
+#include "oneapi/dnnl/dnnl.hpp"
+#include "oneapi/dnnl/dnnl_ukernel.h"
+
+/// @addtogroup dnnl_api
+/// @{
+
+namespace dnnl {
+
+/// @addtogroup dnnl_api_ukernel Ukernels
+/// Collection of ukernels: the building blocks of the primitives executed
+/// directly by the calling thread on the memory buffers of the user.
+/// @{
+
+/// @cond DO_NOT_DOCUMENT_THIS
+template <>
+struct handle_traits<dnnl_brgemm_t> {
+    static dnnl_status_t destructor(dnnl_brgemm_t p) {
+        return dnnl_brgemm_destroy(p);
+    }
+};
+/// @endcond
+
+/// ukernel namespace
+namespace ukernel {
+
+/// @addtogroup dnnl_api_ukernel_brgemm BRGEMM ukernel
+/// Batch-reduce general matrix multiplication ukernel.
+///
+/// @sa @ref dev_guide_ukernel_brgemm
+/// @{
+
+/// BRGEMM ukernel.
+struct brgemm : public handle<dnnl_brgemm_t> {
+    /// Kinds of batches.
+    enum class batch_kind {
+        /// @copydoc dnnl_brgemm_batch_addr
+        addr = dnnl_brgemm_batch_addr,
+        /// @copydoc dnnl_brgemm_batch_offs
+        offs = dnnl_brgemm_batch_offs,
+        /// @copydoc dnnl_brgemm_batch_strd
+        strd = dnnl_brgemm_batch_strd,
+    };
+
+    /// Default constructor. Produces an empty object.
+    brgemm() = default;
+
+    /// Constructs a BRGEMM ukernel object.
+    ///
+    /// @param abatch_kind Kind of the batch.
+    /// @param M Number of rows of the matrices A_i and C.
+    /// @param N Number of columns of the matrices B_i and C.
+    /// @param K Number of columns of the matrices A_i and of rows of the
+    ///     matrices B_i.
+    /// @param a_dt Data type of the matrices A_i.
+    /// @param lda Leading dimension of the matrices A_i.
+    /// @param b_dt Data type of the matrices B_i.
+    /// @param ldb Leading dimension of the packed matrices B_i.
+    /// @param c_dt Data type of the matrix C.
+    /// @param ldc Leading dimension of the matrix C.
+    /// @param alpha Scaling factor of the product of the matrices.
+    /// @param beta Scaling factor of the matrix C.
+    brgemm(batch_kind abatch_kind, memory::dim M, memory::dim N,
+            memory::dim K, memory::data_type a_dt, memory::dim lda,
+            memory::data_type b_dt, memory::dim ldb, memory::data_type c_dt,
+            memory::dim ldc, float alpha = 1.f, float beta = 0.f) {
+        dnnl_brgemm_t brg = nullptr;
+        error::wrap_c_api(
+                dnnl_brgemm_create(&brg,
+                        static_cast<dnnl_brgemm_batch_kind_t>(abatch_kind), M,
+                        N, K, memory::convert_to_c(a_dt), lda,
+                        memory::convert_to_c(b_dt), ldb,
+                        memory::convert_to_c(c_dt), ldc, alpha, beta),
+                "could not create a BRGEMM ukernel object");
+        reset(brg);
+    }
+
+    /// Sets the strides between the matrices of a batch of the
+    /// #dnnl::ukernel::brgemm::batch_kind::strd kind.
+    ///
+    /// @param stride_a Stride between the matrices A_i in bytes.
+    /// @param stride_b Stride between the matrices B_i in bytes.
+    void set_batch_strides(memory::dim stride_a, memory::dim stride_b) {
+        error::wrap_c_api(
+                dnnl_brgemm_set_batch_strides(get(), stride_a, stride_b),
+                "could not set BRGEMM batch strides");
+    }
+
+    /// Attaches post-operations to the ukernel.
+    ///
+    /// @param d_dt Data type of the matrix D.
+    /// @param ldd Leading dimension of the matrix D.
+    /// @param bias_dt Data type of the bias, memory::data_type::undef if the
+    ///     bias is not applied.
+    /// @param attr Attributes with the output scales and the eltwise and
+    ///     sum post-ops.
+    void set_post_ops(memory::data_type d_dt, memory::dim ldd,
+            memory::data_type bias_dt = memory::data_type::undef,
+            const primitive_attr &attr = primitive_attr()) {
+        error::wrap_c_api(dnnl_brgemm_set_post_ops(get(),
+                                  memory::convert_to_c(d_dt), ldd,
+                                  memory::convert_to_c(bias_dt), attr.get()),
+                "could not set BRGEMM post-ops");
+    }
+
+    /// Generates the code of the ukernel.
+    void generate() {
+        error::wrap_c_api(dnnl_brgemm_generate(get()),
+                "could not generate a BRGEMM ukernel");
+    }
+
+    /// Returns the size of the scratchpad the ukernel needs at execution.
+    ///
+    /// @returns Size of the scratchpad in bytes.
+    size_t get_scratchpad_size() const {
+        size_t size = 0;
+        error::wrap_c_api(dnnl_brgemm_get_scratchpad_size(get(), &size),
+                "could not query the BRGEMM scratchpad size");
+        return size;
+    }
+
+    /// Prepares the calling thread to execute the ukernel.
+    void set_hw_context() const {
+        error::wrap_c_api(dnnl_brgemm_set_hw_context(get()),
+                "could not set the BRGEMM hardware context");
+    }
+
+    /// Releases the hardware state of the calling thread.
+    static void release_hw_context() {
+        error::wrap_c_api(dnnl_brgemm_release_hw_context(),
+                "could not release the BRGEMM hardware context");
+    }
+
+    /// Executes the ukernel with a batch of the
+    /// #dnnl::ukernel::brgemm::batch_kind::addr kind.
+    ///
+    /// @param A_addrs Addresses of the matrices A_i.
+    /// @param B_addrs Addresses of the matrices B_i.
+    /// @param C Matrix C.
+    /// @param D Matrix D, nullptr if no post-operations are attached.
+    /// @param bias Bias vector.
+    /// @param scales Output scales.
+    /// @param scratchpad Scratchpad of get_scratchpad_size() bytes.
+    void execute(const std::vector<const void *> &A_addrs,
+            const std::vector<const void *> &B_addrs, void *C,
+            void *D = nullptr, const void *bias = nullptr,
+            const float *scales = nullptr, void *scratchpad = nullptr) const {
+        if (A_addrs.size() != B_addrs.size())
+            DNNL_THROW_ERROR(dnnl_invalid_arguments,
+                    "batch sizes of A and B are different");
+        error::wrap_c_api(
+                dnnl_brgemm_execute_addr(get(), (memory::dim)A_addrs.size(),
+                        const_cast<const void **>(A_addrs.data()),
+                        const_cast<const void **>(B_addrs.data()), C, D, bias,
+                        scales, scratchpad),
+                "could not execute a BRGEMM ukernel");
+    }
+
+    /// Executes the ukernel with a batch of the
+    /// #dnnl::ukernel::brgemm::batch_kind::offs kind.
+    ///
+    /// @param A Base address of the matrices A_i.
+    /// @param A_offsets Offsets of the matrices A_i in bytes.
+    /// @param B Base address of the matrices B_i.
+    /// @param B_offsets Offsets of the matrices B_i in bytes.
+    /// @param C Matrix C.
+    /// @param D Matrix D, nullptr if no post-operations are attached.
+    /// @param bias Bias vector.
+    /// @param scales Output scales.
+    /// @param scratchpad Scratchpad of get_scratchpad_size() bytes.
+    void execute(const void *A, const std::vector<memory::dim> &A_offsets,
+            const void *B, const std::vector<memory::dim> &B_offsets, void *C,
+            void *D = nullptr, const void *bias = nullptr,
+            const float *scales = nullptr, void *scratchpad = nullptr) const {
+        if (A_offsets.size() != B_offsets.size())
+            DNNL_THROW_ERROR(dnnl_invalid_arguments,
+                    "batch sizes of A and B are different");
+        error::wrap_c_api(
+                dnnl_brgemm_execute_offs(get(), (memory::dim)A_offsets.size(),
+                        A, A_offsets.data(), B, B_offsets.data(), C, D, bias,
+                        scales, scratchpad),
+                "could not execute a BRGEMM ukernel");
+    }
+
+    /// Executes the ukernel with a batch of the
+    /// #dnnl::ukernel::brgemm::batch_kind::strd kind.
+    ///
+    /// @param batch_size Number of the pairs of the matrices A_i and B_i.
+    /// @param A Address of the matrix A_0.
+    /// @param B Address of the matrix B_0.
+    /// @param C Matrix C.
+    /// @param D Matrix D, nullptr if no post-operations are attached.
+    /// @param bias Bias vector.
+    /// @param scales Output scales.
+    /// @param scratchpad Scratchpad of get_scratchpad_size() bytes.
+    void execute(memory::dim batch_size, const void *A, const void *B,
+            void *C, void *D = nullptr, const void *bias = nullptr,
+            const float *scales = nullptr, void *scratchpad = nullptr) const {
+        error::wrap_c_api(dnnl_brgemm_execute_strd(get(), batch_size, A, B, C,
+                                  D, bias, scales, scratchpad),
+                "could not execute a BRGEMM ukernel");
+    }
+
+    /// Returns the size of a matrix B packed by pack_B().
+    ///
+    /// @param b_dt Data type of the matrix B.
+    /// @param K Number of rows of the matrix B.
+    /// @param ldb_packed Leading dimension of the packed matrix B.
+    /// @returns Size of the packed matrix in bytes.
+    static size_t get_B_packed_size(
+            memory::data_type b_dt, memory::dim K, memory::dim ldb_packed) {
+        size_t size = 0;
+        error::wrap_c_api(dnnl_brgemm_get_B_packed_size(
+                                  memory::convert_to_c(b_dt), K, ldb_packed,
+                                  &size),
+                "could not query the packed B matrix size");
+        return size;
+    }
+
+    /// Packs a K x N matrix B into the layout the ukernels expect.
+    ///
+    /// @param b_dt Data type of the matrix B.
+    /// @param K Number of rows of the matrix B.
+    /// @param N Number of columns of the matrix B.
+    /// @param B Matrix B in the row-major layout.
+    /// @param ldb Leading dimension of the matrix B.
+    /// @param trans_b Whether the matrix B is transposed.
+    /// @param B_packed Output packed matrix B of get_B_packed_size() bytes.
+    /// @param ldb_packed Leading dimension of the packed matrix B.
+    static void pack_B(memory::data_type b_dt, memory::dim K, memory::dim N,
+            const void *B, memory::dim ldb, bool trans_b, void *B_packed,
+            memory::dim ldb_packed) {
+        error::wrap_c_api(dnnl_brgemm_pack_B(memory::convert_to_c(b_dt), K,
+                                  N, B, ldb, trans_b ? 'T' : 'N', B_packed,
+                                  ldb_packed),
+                "could not pack the B matrix");
+    }
+};
+
+/// @} dnnl_api_ukernel_brgemm
+
+} // namespace ukernel
+
+/// @} dnnl_api_ukernel
+
+} // namespace dnnl
+
+/// @} dnnl_api
+
+#endif
@@ -0,0 +1,71 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/// @file
+/// ukernel C API types definitions
+
+#ifndef ONEAPI_DNNL_DNNL_UKERNEL_TYPES_H
+#define ONEAPI_DNNL_DNNL_UKERNEL_TYPES_H
+
+#include "oneapi/dnnl/dnnl_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @addtogroup dnnl_api
+/// @{
+
+/// @addtogroup dnnl_api_ukernel
+/// @{
+
+/// Version of the ukernel API. The version is increased each time the API
+/// changes in a way that is not backward compatible.
+#define DNNL_UKERNEL_API_VERSION 1
+
+/// Kinds of the batches a BRGEMM ukernel processes.
+typedef enum {
+    /// Undefined batch kind.
+    dnnl_brgemm_batch_undef = 0,
+    /// The matrices of the batch are passed as arrays of addresses.
+    dnnl_brgemm_batch_addr,
+    /// The matrices of the batch are passed as base addresses and arrays of
+    /// offsets in bytes.
+    dnnl_brgemm_batch_offs,
+    /// The matrices of the batch are passed as base addresses, consecutive
+    /// matrices being separated by constant strides in bytes.
+    dnnl_brgemm_batch_strd,
+} dnnl_brgemm_batch_kind_t;
+
+/// @struct dnnl_brgemm
+/// An opaque structure to describe a BRGEMM ukernel.
+struct dnnl_brgemm;
+
+/// A BRGEMM ukernel handle.
+typedef struct dnnl_brgemm *dnnl_brgemm_t;
+
+/// A constant BRGEMM ukernel handle.
+typedef const struct dnnl_brgemm *const_dnnl_brgemm_t;
+
+/// @} dnnl_api_ukernel
+
+/// @} dnnl_api
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
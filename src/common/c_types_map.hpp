@@ -142,6 +142,8 @@ const data_type_t f32 = dnnl_f32;
 const data_type_t s32 = dnnl_s32;
 const data_type_t s8 = dnnl_s8;
 const data_type_t u8 = dnnl_u8;
+const data_type_t s4 = dnnl_s4;
+const data_type_t u4 = dnnl_u4;
 } // namespace data_type
 
 using scratchpad_mode_t = dnnl_scratchpad_mode_t;
@@ -158,6 +160,12 @@ const rnn_packed_format_t ldgoi_p = dnnl_ldgoi_p;
 const rnn_packed_format_t ldio_p = dnnl_ldio_p;
 } // namespace rnn_packed_format
 
+using sparse_encoding_t = dnnl_sparse_encoding_t;
+namespace sparse_encoding {
+const sparse_encoding_t undef = dnnl_sparse_encoding_undef;
+const sparse_encoding_t bcsr = dnnl_sparse_bcsr;
+} // namespace sparse_encoding
+
 using format_kind_t = dnnl_format_kind_t;
 namespace format_kind {
 const format_kind_t undef = dnnl_format_kind_undef;
@@ -165,6 +173,7 @@ const format_kind_t any = dnnl_format_kind_any;
 const format_kind_t blocked = dnnl_blocked;
 const format_kind_t wino = dnnl_format_kind_wino;
 const format_kind_t rnn_packed = dnnl_format_kind_rnn_packed;
+const format_kind_t sparse = dnnl_format_kind_sparse;
 } // namespace format_kind
 
 using format_tag_t = dnnl_format_tag_t;
@@ -431,6 +440,12 @@ const format_tag_t abDC32d4c = dnnl_abDC32d4c;
 const format_tag_t abdEc32e = dnnl_abdEc32e;
 const format_tag_t abdEC32e2c = dnnl_abdEC32e2c;
 const format_tag_t abdEC32e4c = dnnl_abdEC32e4c;
+const format_tag_t BA16a64b = dnnl_BA16a64b;
+const format_tag_t BA16a64b2a = dnnl_BA16a64b2a;
+const format_tag_t BA16a64b4a = dnnl_BA16a64b4a;
+const format_tag_t aCB16b64c = dnnl_aCB16b64c;
+const format_tag_t aCB16b64c2b = dnnl_aCB16b64c2b;
+const format_tag_t aCB16b64c4b = dnnl_aCB16b64c4b;
 
 const format_tag_t last = dnnl_format_tag_last;
 
@@ -730,6 +745,7 @@ enum runtime_kind_t {
     dnnl_runtime_omp,
     dnnl_runtime_tbb,
     dnnl_runtime_threadpool,
+    dnnl_runtime_native,
     dnnl_runtime_ocl,
     dnnl_runtime_sycl,
 };
@@ -740,6 +756,7 @@ const runtime_kind_t seq = dnnl_runtime_seq;
 const runtime_kind_t omp = dnnl_runtime_omp;
 const runtime_kind_t tbb = dnnl_runtime_tbb;
 const runtime_kind_t threadpool = dnnl_runtime_threadpool;
+const runtime_kind_t native = dnnl_runtime_native;
 const runtime_kind_t ocl = dnnl_runtime_ocl;
 const runtime_kind_t sycl = dnnl_runtime_sycl;
 } // namespace runtime_kind
@@ -749,6 +766,7 @@ namespace primitive_kind {
 const primitive_kind_t undefined = dnnl_undefined_primitive;
 const primitive_kind_t reorder = dnnl_reorder;
 const primitive_kind_t concat = dnnl_concat;
+const primitive_kind_t multi_reorder = dnnl_multi_reorder;
 const primitive_kind_t sum = dnnl_sum;
 const primitive_kind_t convolution = dnnl_convolution;
 const primitive_kind_t deconvolution = dnnl_deconvolution;
@@ -773,6 +791,7 @@ const primitive_kind_t reduction = dnnl_reduction;
 // Internal only primitive kinds.
 const primitive_kind_t internal_only_start = (primitive_kind_t)(1 << 12);
 const primitive_kind_t zero_pad = internal_only_start;
+const primitive_kind_t brgemm = (primitive_kind_t)(internal_only_start + 1);
 } // namespace primitive_kind
 
 using query_t = dnnl_query_t;
@@ -838,6 +857,7 @@ const query_t zero_pad_d = internal_only_start;
 
 using blocking_desc_t = dnnl_blocking_desc_t;
 using rnn_packed_desc_t = dnnl_rnn_packed_desc_t;
+using sparse_desc_t = dnnl_sparse_desc_t;
 using wino_desc_t = dnnl_wino_desc_t;
 using memory_extra_desc_t = dnnl_memory_extra_desc_t;
 using memory_desc_t = dnnl_memory_desc_t;
@@ -868,8 +888,10 @@ using gemm_desc_t = dnnl_gemm_desc_t;
 /* Internal types, for the primitives which don't have descs */
 using concat_desc_t = dnnl_concat_desc_t;
 using reorder_desc_t = dnnl_reorder_desc_t;
+using multi_reorder_desc_t = dnnl_multi_reorder_desc_t;
 using sum_desc_t = dnnl_sum_desc_t;
 using zero_pad_desc_t = dnnl_zero_pad_desc_t;
+using brgemm_desc_t = dnnl_brgemm_desc_t;
 
 /* C op_desc_t, which eventually are just (void*) */
 using c_op_desc_t = dnnl_op_desc_t;
@@ -894,11 +916,13 @@ struct op_desc_t {
         gemm_desc_t gemm;
         concat_desc_t concat;
         reorder_desc_t reorder;
+        multi_reorder_desc_t multi_reorder;
         sum_desc_t sum;
         binary_desc_t binary;
         matmul_desc_t matmul;
         resampling_desc_t resampling;
         zero_pad_desc_t zero_pad;
+        brgemm_desc_t brgemm;
         reduction_desc_t reduction;
     };
 
@@ -926,17 +950,19 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(gemm_desc_t);
     DECL_CTOR_AND_CONVERTERS(concat_desc_t);
     DECL_CTOR_AND_CONVERTERS(reorder_desc_t);
+    DECL_CTOR_AND_CONVERTERS(multi_reorder_desc_t);
     DECL_CTOR_AND_CONVERTERS(sum_desc_t);
     DECL_CTOR_AND_CONVERTERS(binary_desc_t);
     DECL_CTOR_AND_CONVERTERS(matmul_desc_t);
     DECL_CTOR_AND_CONVERTERS(resampling_desc_t);
     DECL_CTOR_AND_CONVERTERS(zero_pad_desc_t);
+    DECL_CTOR_AND_CONVERTERS(brgemm_desc_t);
     DECL_CTOR_AND_CONVERTERS(reduction_desc_t);
 
-    // concat_desc_t and sum_desc_t have data members which have non-trivial
-    // special member functions hence the default destructor is implicitly
-    // deleted by the compiler which causes a warning on Windows so we should
-    // delete the destructor explicitly.
+    // concat_desc_t, multi_reorder_desc_t and sum_desc_t have data members
+    // which have non-trivial special member functions hence the default
+    // destructor is implicitly deleted by the compiler which causes a warning
+    // on Windows so we should delete the destructor explicitly.
     ~op_desc_t() = delete;
 
 #undef DECL_CTOR_AND_CONVERTERS
@@ -987,6 +1013,7 @@ struct lrn_bwd_pd_t;
 struct lrn_fwd_pd_t;
 struct lrn_pd_t;
 struct matmul_pd_t;
+struct multi_reorder_pd_t;
 struct pooling_bwd_pd_t;
 struct pooling_fwd_pd_t;
 struct pooling_pd_t;
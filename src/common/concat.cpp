@@ -75,7 +75,11 @@ status_t dnnl_concat_primitive_desc_create(
 
     concat_pd_t *concat_pd = nullptr;
     for (auto c = engine->get_concat_implementation_list(); *c; ++c) {
-        if ((*c)(&concat_pd, engine, attr, dst_md, n, concat_dim, src_mds)
+        auto create_pd = [&](concat_pd_t **pd) {
+            return (*c)(pd, engine, attr, dst_md, n, concat_dim, src_mds);
+        };
+        if (primitive_desc_t::create_with_max_threads(
+                    &concat_pd, attr, engine, create_pd)
                 == success) {
             auto status = safe_ptr_assign(*concat_pd_iface,
                     new primitive_desc_iface_t(concat_pd, engine));
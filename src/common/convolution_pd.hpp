@@ -73,6 +73,11 @@ struct convolution_pd_t : public primitive_desc_t {
 
     /* common conv aux functions */
 
+    dim_t work_amount() const override {
+        return memory_desc_wrapper(invariant_dst_md()).nelems() * IC() / G()
+                * KD() * KH() * KW();
+    }
+
     dim_t MB() const { return invariant_src_md()->dims[0]; }
 
     dim_t IC() const { return invariant_src_md()->dims[1]; }
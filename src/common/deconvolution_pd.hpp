@@ -59,6 +59,11 @@ struct deconvolution_pd_t : public primitive_desc_t {
 
     /* common deconv aux functions (note that conv_desc_t == deconv_desc_t) */
 
+    dim_t work_amount() const override {
+        return memory_desc_wrapper(invariant_src_md()).nelems() * OC() / G()
+                * KD() * KH() * KW();
+    }
+
     dim_t MB() const { return invariant_src_md()->dims[0]; }
 
     dim_t IC() const { return invariant_src_md()->dims[1]; }
@@ -42,6 +42,7 @@ const char *dnnl_runtime2str(unsigned runtime) {
         case DNNL_RUNTIME_TBB: return "TBB";
         case DNNL_RUNTIME_OCL: return "OpenCL";
         case DNNL_RUNTIME_THREADPOOL: return "threadpool";
+        case DNNL_RUNTIME_NATIVE: return "native threadpool";
 #ifdef DNNL_SYCL_DPCPP
         case DNNL_RUNTIME_SYCL: return "DPC++";
 #endif
@@ -81,7 +82,10 @@ int dnnl_md2fmt_str(
 
     DPRINT("%s:", dnnl_fmt_kind2str(md.format_kind()));
 
-    if (!md.is_blocking_desc()) {
+    if (md.is_sparse_desc()) {
+        const auto &sd = md.sparse_desc();
+        DPRINT("bcsr%dx%d%c:", sd.block_k, sd.block_n, 'a' + (char)sd.oc_dim);
+    } else if (!md.is_blocking_desc()) {
         /* TODO: extend */
         DPRINT("%s:", "");
     } else {
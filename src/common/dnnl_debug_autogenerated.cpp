@@ -43,6 +43,8 @@ const char *dnnl_dt2str(dnnl_data_type_t v) {
     if (v == dnnl_s32) return "s32";
     if (v == dnnl_s8) return "s8";
     if (v == dnnl_u8) return "u8";
+    if (v == dnnl_s4) return "s4";
+    if (v == dnnl_u4) return "u4";
     assert(!"unknown dt");
     return "unknown dt";
 }
@@ -53,6 +55,7 @@ const char *dnnl_fmt_kind2str(dnnl_format_kind_t v) {
     if (v == dnnl_blocked) return "blocked";
     if (v == dnnl_format_kind_wino) return "wino";
     if (v == dnnl_format_kind_rnn_packed) return "rnn_packed";
+    if (v == dnnl_format_kind_sparse) return "sparse";
     assert(!"unknown fmt_kind");
     return "unknown fmt_kind";
 }
@@ -320,6 +323,12 @@ const char *dnnl_fmt_tag2str(dnnl_format_tag_t v) {
     if (v == dnnl_abdEc32e) return "abdEc32e";
     if (v == dnnl_abdEC32e2c) return "abdEC32e2c";
     if (v == dnnl_abdEC32e4c) return "abdEC32e4c";
+    if (v == dnnl_BA16a64b) return "BA16a64b";
+    if (v == dnnl_BA16a64b2a) return "BA16a64b2a";
+    if (v == dnnl_BA16a64b4a) return "BA16a64b4a";
+    if (v == dnnl_aCB16b64c) return "aCB16b64c";
+    if (v == dnnl_aCB16b64c2b) return "aCB16b64c2b";
+    if (v == dnnl_aCB16b64c4b) return "aCB16b64c4b";
     if (v == dnnl_format_tag_last) return "format_tag_last";
     if (v == dnnl_x) return "x";
     if (v == dnnl_nc) return "nc";
@@ -634,6 +643,7 @@ const char *dnnl_prim_kind2str(dnnl_primitive_kind_t v) {
     if (v == dnnl_pooling_v2) return "pooling_v2";
     if (v == dnnl_reduction) return "reduction";
     if (v == dnnl_prelu) return "prelu";
+    if (v == dnnl_multi_reorder) return "multi_reorder";
     if (v == dnnl_primitive_kind_max) return "primitive_kind_max";
     assert(!"unknown prim_kind");
     return "unknown prim_kind";
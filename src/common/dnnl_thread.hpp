@@ -22,6 +22,27 @@
 #include "utils.hpp"
 #include "z_magic.hpp"
 
+/* The limit on the number of threads the calling thread may use, 0 if there is
+ * none. It is set for the creation and the execution of the primitives with
+ * the maximum number of threads attribute, see max_threads_limit_scope_t. */
+inline int &dnnl_max_threads_limit() {
+    static thread_local int limit = 0;
+    return limit;
+}
+inline int dnnl_apply_max_threads_limit(int nthr) {
+    const int limit = dnnl_max_threads_limit();
+    return limit > 0 && limit < nthr ? limit : nthr;
+}
+
+/* Whether the calling thread, running a parallel region, may start a nested
+ * one. It is only the case for the execution of the primitives limited to a
+ * number of threads, the limit being the budget of the nested region, and the
+ * nested region is not nested further. */
+inline bool &dnnl_nested_parallelism_allowed() {
+    static thread_local bool allowed = false;
+    return allowed;
+}
+
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
 #define DNNL_THR_SYNC 1
 inline int dnnl_get_max_threads() {
@@ -35,8 +56,18 @@ inline void dnnl_thr_barrier() {}
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
 #include "omp.h"
 #define DNNL_THR_SYNC 1
+/* The number of threads a parallel region of the calling thread is guaranteed
+ * to get with dynamic teams disabled: its share of the thread limit when every
+ * thread of the enclosing teams starts a region as well. */
+inline int dnnl_omp_get_thread_limit() {
+    int nthr_busy = 1;
+    for (int level = 1; level <= omp_get_level(); level++)
+        nthr_busy *= std::max(1, omp_get_team_size(level));
+    return std::max(1, omp_get_thread_limit() / nthr_busy);
+}
 inline int dnnl_get_max_threads() {
-    return omp_get_max_threads();
+    return dnnl_apply_max_threads_limit(
+            std::min(omp_get_max_threads(), dnnl_omp_get_thread_limit()));
 }
 inline int dnnl_in_parallel() {
     return omp_in_parallel();
@@ -50,7 +81,8 @@ inline void dnnl_thr_barrier() {
 #include "tbb/task_arena.h"
 #define DNNL_THR_SYNC 0
 inline int dnnl_get_max_threads() {
-    return tbb::this_task_arena::max_concurrency();
+    return dnnl_apply_max_threads_limit(
+            tbb::this_task_arena::max_concurrency());
 }
 inline int dnnl_in_parallel() {
     return 0;
@@ -59,6 +91,22 @@ inline void dnnl_thr_barrier() {
     assert(!"no barrier in TBB");
 }
 
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+#include "native_threadpool.hpp"
+// The barrier requires all the threads of a parallel region to run at the
+// same time, which the pool cannot guarantee to concurrent regions
+#define DNNL_THR_SYNC 0
+inline int dnnl_get_max_threads() {
+    return dnnl_apply_max_threads_limit(
+            dnnl::impl::native_threadpool::get_num_threads());
+}
+inline int dnnl_in_parallel() {
+    return dnnl::impl::native_threadpool::in_parallel();
+}
+inline void dnnl_thr_barrier() {
+    dnnl::impl::native_threadpool::barrier();
+}
+
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
 #include <thread>
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
@@ -96,8 +144,10 @@ inline int dnnl_get_max_threads() {
     assert(def_max_threads > 0);
     // Use the default value if the threadpool-provided is outside the range
     // [1, def_max_threads]
-    return tp ? std::min(std::max(1, tp->get_num_threads()), def_max_threads)
-              : def_max_threads;
+    return dnnl_apply_max_threads_limit(tp
+                    ? std::min(std::max(1, tp->get_num_threads()),
+                            def_max_threads)
+                    : def_max_threads);
 }
 inline int dnnl_in_parallel() {
     using namespace dnnl::impl::threadpool_utils;
@@ -111,10 +161,13 @@ inline void dnnl_thr_barrier() {
 
 /* The purpose of this function is to provide the number of threads the library
  * is aware of when this function is invoked. Since oneDNN does not allow nested
- * parallelism, inside a parallel region the number of available threads is 1.
- * Otherwise, the number of current threads varies between threading runtimes:
- * - for OpenMP and TBB, return the max number of threads since the number of
- *   threads is held in a global object throughout the entire execution.
+ * parallelism, inside a parallel region the number of available threads is 1,
+ * except for the primitives limited to a number of threads with OpenMP and the
+ * native threadpool (see dnnl_nested_parallelism_allowed()). Otherwise, the
+ * number of current threads varies between threading runtimes:
+ * - for OpenMP, TBB and the native threadpool, return the max number of
+ *   threads since the number of threads is held in a global object throughout
+ *   the entire execution.
  * - for Threadpool, since the global object in oneDNN changes throughout
  *   execution, two situations can occur:
  *   a) if the library *is* aware of a threadpool when this function is invoked,
@@ -123,11 +176,12 @@ inline void dnnl_thr_barrier() {
  *   invoked, return 1 since the main thread will do the work.
  */
 inline int dnnl_get_current_num_threads() {
-    if (dnnl_in_parallel()) return 1;
-#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
-    return omp_get_max_threads();
-#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
-    return tbb::this_task_arena::max_concurrency();
+    if (dnnl_in_parallel())
+        return dnnl_nested_parallelism_allowed() ? dnnl_get_max_threads() : 1;
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+    return dnnl_get_max_threads();
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     using namespace dnnl::impl::threadpool_utils;
     dnnl::threadpool_interop::threadpool_iface *tp = get_active_threadpool();
@@ -174,6 +228,33 @@ inline bool dnnl_thr_syncable() {
     return DNNL_THR_SYNC == 1;
 }
 
+/* Limits the number of threads the calling thread uses while the object is
+ * alive. The limit may only be lowered, so the scopes nest, and 0 keeps the
+ * current one. A thread running a parallel region may start a nested one with
+ * the threads of the limit. */
+struct max_threads_limit_scope_t {
+    max_threads_limit_scope_t(int limit)
+        : prev_(dnnl_max_threads_limit())
+        , prev_nested_(dnnl_nested_parallelism_allowed()) {
+        if (limit <= 0) return;
+        dnnl_max_threads_limit() = prev_ > 0 ? nstl::min(prev_, limit) : limit;
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+        if (dnnl_in_parallel()) dnnl_nested_parallelism_allowed() = true;
+#endif
+    }
+    ~max_threads_limit_scope_t() {
+        dnnl_max_threads_limit() = prev_;
+        dnnl_nested_parallelism_allowed() = prev_nested_;
+    }
+
+private:
+    int prev_;
+    bool prev_nested_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(max_threads_limit_scope_t);
+};
+
 template <typename T, typename U>
 inline void balance211(T n, U team, U tid, T &n_start, T &n_end) {
     T n_min = 1;
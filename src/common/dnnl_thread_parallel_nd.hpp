@@ -36,6 +36,10 @@
  *  - parallel_nd_in_omp(dims..., f)     - queries current nthr and ithr and
  *                                         then calls for_nd (mostly for
  *                                         convenience)
+ *  - parallel_chunked(nthr, work, f)    - executes f(ichunk, nchunks) using at
+ *                                         most nthr threads, with the chunks
+ *                                         balanced dynamically between the
+ *                                         threads if the runtime can do it
  */
 
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
@@ -47,9 +51,15 @@ namespace impl {
 
 namespace {
 inline int adjust_num_threads(int nthr, size_t work_amount) {
-    if (nthr == 0) nthr = dnnl_get_current_num_threads();
+    // A primitive executed with a lower limit than the one it was created
+    // with gets fewer threads than it asks for
+    nthr = nthr == 0 ? dnnl_get_current_num_threads()
+                     : dnnl_apply_max_threads_limit(nthr);
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
-    return (work_amount == 1 || omp_in_parallel()) ? 1 : nthr;
+    return (work_amount == 1
+                   || (omp_in_parallel() && !dnnl_nested_parallelism_allowed()))
+            ? 1
+            : nthr;
 #else
     return (int)std::min((size_t)nthr, work_amount);
 #endif
@@ -69,6 +79,20 @@ void parallel(int nthr, F f) {
         return;
     }
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    // The threads of a nested region do not start nested regions themselves
+    const bool nested = omp_in_parallel();
+    const int max_active_levels = omp_get_max_active_levels();
+    if (nested) {
+        const int level = omp_get_active_level();
+        if (max_active_levels <= level) omp_set_max_active_levels(level + 1);
+        dnnl_nested_parallelism_allowed() = false;
+    }
+    // The functions expect exactly nthr threads, e.g. to reach the barriers.
+    // The runtime provides them with dynamic teams disabled as long as they
+    // are within the thread limit, which dnnl_get_max_threads() accounts for.
+    const int dynamic = omp_get_dynamic();
+    if (dynamic) omp_set_dynamic(0);
+    nthr = std::min(nthr, dnnl_omp_get_thread_limit());
 #pragma omp parallel num_threads(nthr)
     {
         int nthr_ = omp_get_num_threads();
@@ -76,10 +100,17 @@ void parallel(int nthr, F f) {
         assert(nthr_ == nthr);
         f(ithr_, nthr_);
     }
+    if (dynamic) omp_set_dynamic(dynamic);
+    if (nested) {
+        dnnl_nested_parallelism_allowed() = true;
+        omp_set_max_active_levels(max_active_levels);
+    }
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
     tbb::parallel_for(
             0, nthr, [&](int ithr) { f(ithr, nthr); },
             tbb::static_partitioner());
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+    native_threadpool::parallel(nthr, f);
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     using namespace dnnl::impl::threadpool_utils;
     dnnl::threadpool_interop::threadpool_iface *tp = get_active_threadpool();
@@ -106,6 +137,22 @@ void parallel(int nthr, F f) {
 #endif
 }
 
+/* The functions f does not depend on the thread executing it, so the native
+ * runtime splits the work into more chunks than threads: the threads done
+ * with their chunks take the ones of the threads that are late. Elsewhere,
+ * there is a chunk per thread. */
+template <typename F>
+void parallel_chunked(int nthr, size_t work_amount, F f) {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+    const size_t chunks_per_thr = 4;
+    const int nchunks = (int)std::min(work_amount, chunks_per_thr * nthr);
+    native_threadpool::parallel_chunks(nthr, nchunks, f);
+#else
+    UNUSED(work_amount);
+    parallel(nthr, f);
+#endif
+}
+
 /* for_nd section */
 
 template <typename T0, typename F>
@@ -393,7 +440,8 @@ void parallel_nd(const T0 &D0, F f) {
     const size_t work_amount = (size_t)D0;
     int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
     if (nthr)
-        parallel(nthr, [&](int ithr, int nthr) { for_nd(ithr, nthr, D0, f); });
+        parallel_chunked(nthr, work_amount,
+                [&](int ithr, int nthr) { for_nd(ithr, nthr, D0, f); });
 }
 
 template <typename T0, typename T1, typename F>
@@ -401,7 +449,7 @@ void parallel_nd(const T0 &D0, const T1 &D1, F f) {
     const size_t work_amount = (size_t)D0 * D1;
     int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
     if (nthr)
-        parallel(nthr,
+        parallel_chunked(nthr, work_amount,
                 [&](int ithr, int nthr) { for_nd(ithr, nthr, D0, D1, f); });
 }
 
@@ -410,7 +458,7 @@ void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, F f) {
     const size_t work_amount = (size_t)D0 * D1 * D2;
     int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
     if (nthr)
-        parallel(nthr,
+        parallel_chunked(nthr, work_amount,
                 [&](int ithr, int nthr) { for_nd(ithr, nthr, D0, D1, D2, f); });
 }
 
@@ -419,7 +467,7 @@ void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3, F f) {
     const size_t work_amount = (size_t)D0 * D1 * D2 * D3;
     int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
     if (nthr)
-        parallel(nthr, [&](int ithr, int nthr) {
+        parallel_chunked(nthr, work_amount, [&](int ithr, int nthr) {
             for_nd(ithr, nthr, D0, D1, D2, D3, f);
         });
 }
@@ -431,7 +479,7 @@ void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3,
     const size_t work_amount = (size_t)D0 * D1 * D2 * D3 * D4;
     int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
     if (nthr)
-        parallel(nthr, [&](int ithr, int nthr) {
+        parallel_chunked(nthr, work_amount, [&](int ithr, int nthr) {
             for_nd(ithr, nthr, D0, D1, D2, D3, D4, f);
         });
 }
@@ -443,7 +491,7 @@ void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3,
     const size_t work_amount = (size_t)D0 * D1 * D2 * D3 * D4 * D5;
     int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
     if (nthr)
-        parallel(nthr, [&](int ithr, int nthr) {
+        parallel_chunked(nthr, work_amount, [&](int ithr, int nthr) {
             for_nd(ithr, nthr, D0, D1, D2, D3, D4, D5, f);
         });
 }
@@ -458,7 +506,8 @@ void parallel_nd_in_omp(Args &&... args) {
     for_nd(omp_get_thread_num(), omp_get_num_threads(),
             utils::forward<Args>(args)...);
 #elif (DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB \
-        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL)
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE)
     assert(!"parallel_nd_in_omp() is not supported by this DNNL_CPU_RUNTIME");
 #endif
 }
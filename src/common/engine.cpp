@@ -79,6 +79,20 @@ status_t dnnl_engine_create(
     return ef->engine_create(engine, index);
 }
 
+status_t dnnl_engine_create_with_allocator(engine_t **engine,
+        engine_kind_t kind, size_t index, dnnl_memory_allocate_f allocate,
+        dnnl_memory_deallocate_f deallocate) {
+    if (any_null(engine, allocate, deallocate)) return invalid_arguments;
+    if (kind != engine_kind::cpu
+            || !is_native_runtime(get_default_runtime(kind)))
+        return unimplemented;
+
+    cpu::cpu_engine_factory_t ef;
+    if (index >= ef.count()) return invalid_arguments;
+
+    return ef.engine_create(engine, index, allocate, deallocate);
+}
+
 status_t dnnl_engine_get_kind(engine_t *engine, engine_kind_t *kind) {
     if (engine == nullptr) return invalid_arguments;
     *kind = engine->kind();
@@ -49,6 +49,10 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
 
     virtual dnnl::impl::device_id_t device_id() const = 0;
 
+    /** get the maximum number of threads the primitives use, 0 if the engine
+     * does not limit it */
+    virtual int max_threads() const { return 0; }
+
     /** create memory storage */
     virtual dnnl::impl::status_t create_memory_storage(
             dnnl::impl::memory_storage_t **storage, unsigned flags, size_t size,
@@ -94,6 +98,12 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
             const dnnl::impl::memory_desc_t *dst_md, int n, int concat_dim,
             const dnnl::impl::memory_desc_t *src_mds);
 
+    typedef dnnl::impl::status_t (*multi_reorder_primitive_desc_create_f)(
+            dnnl::impl::multi_reorder_pd_t **, dnnl::impl::engine_t *engine,
+            const dnnl::impl::primitive_attr_t *attr,
+            const dnnl::impl::memory_desc_t *src_md, int n,
+            const dnnl::impl::memory_desc_t *dst_mds);
+
     typedef dnnl::impl::status_t (*sum_primitive_desc_create_f)(
             dnnl::impl::sum_pd_t **, dnnl::impl::engine_t *engine,
             const dnnl::impl::primitive_attr_t *attr,
@@ -118,6 +128,16 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
     virtual const concat_primitive_desc_create_f *
     get_concat_implementation_list() const = 0;
 
+    /** return the list of multi-destination reorder implementations. engine
+     * guarantees to return a NULL-terminated list. The default is an empty
+     * list, i.e. the primitive is not supported by the engine */
+    virtual const multi_reorder_primitive_desc_create_f *
+    get_multi_reorder_implementation_list() const {
+        static const multi_reorder_primitive_desc_create_f empty_list[]
+                = {nullptr};
+        return empty_list;
+    }
+
     /** return the list of sum implementations. engine guarantees to return
      * a NULL-terminated list */
     virtual const sum_primitive_desc_create_f *
@@ -150,6 +170,8 @@ inline runtime_kind_t get_default_runtime(engine_kind_t kind) {
     return runtime_kind::tbb;
 #elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     return runtime_kind::threadpool;
+#elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_NATIVE
+    return runtime_kind::native;
 #elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_SYCL
     return runtime_kind::sycl;
 #else
@@ -166,6 +188,8 @@ inline runtime_kind_t get_cpu_native_runtime() {
     return runtime_kind::tbb;
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     return runtime_kind::threadpool;
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+    return runtime_kind::native;
 #else
     return runtime_kind::none;
 #endif
@@ -173,7 +197,7 @@ inline runtime_kind_t get_cpu_native_runtime() {
 
 inline bool is_native_runtime(runtime_kind_t kind) {
     return utils::one_of(kind, runtime_kind::seq, runtime_kind::omp,
-            runtime_kind::tbb, runtime_kind::threadpool);
+            runtime_kind::tbb, runtime_kind::threadpool, runtime_kind::native);
 }
 
 struct engine_factory_t : public c_compatible {
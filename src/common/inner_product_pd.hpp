@@ -58,6 +58,8 @@ struct inner_product_pd_t : public primitive_desc_t {
 
     /* common inner_product aux functions */
 
+    dim_t work_amount() const override { return MB() * OC() * IC_total(); }
+
     dim_t MB() const { return invariant_src_md()->dims[0]; }
     dim_t IC() const { return invariant_src_md()->dims[1]; }
     dim_t OC() const { return invariant_dst_md()->dims[1]; }
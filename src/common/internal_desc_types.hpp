@@ -19,6 +19,7 @@
 
 #include <vector>
 #include "oneapi/dnnl/dnnl_types.h"
+#include "oneapi/dnnl/dnnl_ukernel_types.h"
 
 namespace dnnl {
 namespace impl {
@@ -40,6 +41,13 @@ struct dnnl_concat_desc_t {
     std::vector<dnnl_memory_desc_t> src_mds;
 };
 
+struct dnnl_multi_reorder_desc_t {
+    dnnl_primitive_kind_t primitive_kind;
+    dnnl_memory_desc_t src_md;
+    dnnl_dim_t n;
+    std::vector<dnnl_memory_desc_t> dst_mds;
+};
+
 struct dnnl_sum_desc_t {
     dnnl_primitive_kind_t primitive_kind;
     dnnl_memory_desc_t dst_md;
@@ -52,6 +60,28 @@ struct dnnl_zero_pad_desc_t {
     dnnl_primitive_kind_t primitive_kind;
 };
 
+// The BRGEMM ukernels are cached as primitives
+struct dnnl_brgemm_desc_t {
+    dnnl_primitive_kind_t primitive_kind;
+    dnnl_brgemm_batch_kind_t batch_kind;
+    dnnl_dim_t M;
+    dnnl_dim_t N;
+    dnnl_dim_t K;
+    dnnl_data_type_t a_dt;
+    dnnl_data_type_t b_dt;
+    dnnl_data_type_t c_dt;
+    dnnl_data_type_t d_dt;
+    dnnl_data_type_t bias_dt;
+    dnnl_dim_t lda;
+    dnnl_dim_t ldb;
+    dnnl_dim_t ldc;
+    dnnl_dim_t ldd;
+    dnnl_dim_t stride_a;
+    dnnl_dim_t stride_b;
+    float alpha;
+    float beta;
+};
+
 } // namespace impl
 } // namespace dnnl
 
@@ -85,6 +85,12 @@ status_t dnnl_matmul_desc_init(matmul_desc_t *matmul_desc,
 
     op_d.accum_data_type = types::default_accum_data_type(src_md->data_type,
             weights_md->data_type, dst_md->data_type, prop_kind::forward);
+    // The integer weights are decompressed to f32 (see the weights
+    // decompression attribute)
+    if (everyone_is(data_type::f32, src_md->data_type, dst_md->data_type)
+            && one_of(weights_md->data_type, data_type::s8, data_type::u8,
+                    data_type::s4, data_type::u4))
+        op_d.accum_data_type = data_type::f32;
     if (op_d.accum_data_type == data_type::undef)
         return status::invalid_arguments;
 
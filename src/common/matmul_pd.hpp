@@ -124,6 +124,12 @@ struct matmul_pd_t : public primitive_desc_t {
     dim_t N() const { return dst_md_.dims[ndims() - 1]; }
     dim_t K() const { return src_md_.dims[ndims() - 1]; }
 
+    dim_t work_amount() const override {
+        // unknown until the execution
+        if (has_runtime_dims_or_strides()) return 0;
+        return batch() * M() * N() * K();
+    }
+
     bool is_bias_1xN() const {
         if (!with_bias()) return false;
 
@@ -148,6 +154,9 @@ protected:
     bool set_default_formats() {
         for (auto md : {&src_md_, &weights_md_, &bias_md_, &dst_md_}) {
             memory_desc_wrapper mdw(md);
+            // The sparse weights are supported by the dedicated
+            // implementations
+            if (mdw.is_sparse_desc()) return false;
             if (mdw.format_any()) {
                 if (mdw.has_runtime_dims_or_strides()) return false;
                 status_t status = memory_desc_init_by_strides(*md, nullptr);
@@ -204,6 +204,51 @@ status_t dnnl_memory_desc_init_by_strides(memory_desc_t *memory_desc, int ndims,
     return success;
 }
 
+status_t dnnl_memory_desc_init_by_sparse_bcsr(memory_desc_t *memory_desc,
+        int ndims, const dims_t dims, data_type_t data_type, int oc_dim,
+        int block_k, dim_t nnz_blocks) {
+    if (any_null(memory_desc)) return invalid_arguments;
+
+    bool args_ok = ndims == 2
+            && memory_desc_sanity_check(
+                    ndims, dims, data_type, format_kind::undef)
+            && one_of(data_type, f32, bf16, s8) && one_of(oc_dim, 0, 1)
+            && one_of(block_k, 1, 4)
+            && IMPLICATION(data_type != f32, block_k == 4);
+    if (!args_ok) return invalid_arguments;
+    for (int d = 0; d < ndims; ++d)
+        if (dims[d] <= 0) return invalid_arguments;
+
+    const int block_n = 16;
+    const dim_t oc = dims[oc_dim], ic = dims[1 - oc_dim];
+    // The input channels are not padded
+    if (ic % block_k != 0) return invalid_arguments;
+    const dim_t max_nnz_blocks = div_up(oc, block_n) * (ic / block_k);
+    if (nnz_blocks < 0 || nnz_blocks > max_nnz_blocks)
+        return invalid_arguments;
+
+    auto md = memory_desc_t();
+    md.ndims = ndims;
+    array_copy(md.dims, dims, ndims);
+    md.data_type = data_type;
+    array_copy(md.padded_dims, dims, ndims);
+    md.format_kind = format_kind::sparse;
+
+    auto &sd = md.format_desc.sparse_desc;
+    sd.encoding = sparse_encoding::bcsr;
+    sd.oc_dim = oc_dim;
+    sd.block_k = block_k;
+    sd.block_n = block_n;
+    sd.nnz_blocks = nnz_blocks ? nnz_blocks : max_nnz_blocks;
+    sd.size = memory_desc_wrapper(md).sparse_values_offset()
+            + (size_t)sd.nnz_blocks * block_k * block_n
+                    * types::data_type_size(data_type);
+
+    *memory_desc = md;
+
+    return success;
+}
+
 status_t dnnl_memory_desc_init_submemory(memory_desc_t *md,
         const memory_desc_t *parent_md, const dims_t dims,
         const dims_t offsets) {
@@ -57,6 +57,7 @@ struct memory_desc_wrapper : public c_compatible {
     bool is_rnn_packed_desc() const {
         return format_kind() == format_kind::rnn_packed;
     }
+    bool is_sparse_desc() const { return format_kind() == format_kind::sparse; }
 
     const blocking_desc_t &blocking_desc() const {
         assert(is_blocking_desc());
@@ -70,6 +71,10 @@ struct memory_desc_wrapper : public c_compatible {
         assert(is_rnn_packed_desc());
         return md_->format_desc.rnn_packed_desc;
     }
+    const sparse_desc_t &sparse_desc() const {
+        assert(is_sparse_desc());
+        return md_->format_desc.sparse_desc;
+    }
 
     const memory_extra_desc_t &extra() const { return md_->extra; }
 
@@ -144,6 +149,20 @@ struct memory_desc_wrapper : public c_compatible {
         return buff_size;
     }
 
+    /** returns the number of the rows of blocks of a sparse tensor */
+    dim_t sparse_nb_n() const {
+        const auto &sd = sparse_desc();
+        return utils::div_up(dims()[sd.oc_dim], sd.block_n);
+    }
+
+    /** returns the offset of the values of the stored blocks of a sparse
+     * tensor, they follow the offsets of the rows of blocks and the indices
+     * of the blocks */
+    size_t sparse_values_offset() const {
+        const dim_t n_indices = sparse_nb_n() + 1 + sparse_desc().nnz_blocks;
+        return utils::rnd_up(n_indices * sizeof(int32_t), 64);
+    }
+
     /** returns the size required to store described memory
      * note: if offset0 != 0 returns 0 (need to specify the behavior) */
     size_t size() const {
@@ -157,6 +176,8 @@ struct memory_desc_wrapper : public c_compatible {
             return wino_desc().size;
         } else if (format_kind() == format_kind::rnn_packed) {
             return rnn_packed_desc().size;
+        } else if (format_kind() == format_kind::sparse) {
+            return sparse_desc().size;
         } else {
             if (offset0() != 0) return 0;
 
@@ -177,7 +198,11 @@ struct memory_desc_wrapper : public c_compatible {
                 max_size = utils::array_product(bd.inner_blks, bd.inner_nblks);
             }
 
-            return max_size * data_type_size() + additional_buffer_size();
+            // two 4-bit values share a byte
+            const size_t data_size = types::is_4bit_data_type(data_type())
+                    ? utils::div_up(max_size, 2)
+                    : max_size * data_type_size();
+            return data_size + additional_buffer_size();
         }
     }
 
@@ -420,7 +445,8 @@ inline bool memory_desc_wrapper::similar_to(const memory_desc_wrapper &rhs,
 
     if (one_of(format_kind(), format_kind::undef, format_kind::any))
         return false;
-    if (is_wino_desc() || is_rnn_packed_desc()) return false;
+    if (is_wino_desc() || is_rnn_packed_desc() || is_sparse_desc())
+        return false;
 
     const int ds = dim_start;
     const auto &blk = blocking_desc();
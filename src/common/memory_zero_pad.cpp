@@ -281,6 +281,9 @@ static status_t zero_pad(const memory_t *memory, const exec_ctx_t &ctx) {
         case s32: return typed_zero_pad<s32>(memory, ctx);
         case s8: return typed_zero_pad<s8>(memory, ctx);
         case u8: return typed_zero_pad<u8>(memory, ctx);
+        // the 4-bit data types are supported with the plain layouts only
+        case s4:
+        case u4: return success;
         default: assert(!"memory is undefined"); return unimplemented;
     }
     return unimplemented;
@@ -0,0 +1,65 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "multi_reorder_pd.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::utils;
+using namespace dnnl::impl::status;
+
+status_t dnnl_multi_reorder_primitive_desc_create(
+        primitive_desc_iface_t **multi_reorder_pd_iface,
+        const memory_desc_t *src_md, int n, const memory_desc_t *dst_mds,
+        const primitive_attr_t *attr, engine_t *engine) {
+    bool args_ok = !any_null(multi_reorder_pd_iface, src_md, dst_mds, engine)
+            && n > 0;
+    if (!args_ok) return invalid_arguments;
+
+    if (attr == nullptr) attr = &default_attr();
+
+    const memory_desc_wrapper src_d(src_md);
+    if (src_d.format_kind() == format_kind::any) return invalid_arguments;
+    for (int i = 0; i < n; ++i) {
+        const memory_desc_wrapper dst_d(dst_mds[i]);
+        if (dst_d.format_kind() == format_kind::any
+                || !src_d.consistent_with(dst_d))
+            return invalid_arguments;
+    }
+
+    multi_reorder_pd_t *multi_reorder_pd = nullptr;
+    for (auto r = engine->get_multi_reorder_implementation_list(); *r; ++r) {
+        auto create_pd = [&](multi_reorder_pd_t **pd) {
+            return (*r)(pd, engine, attr, src_md, n, dst_mds);
+        };
+        if (primitive_desc_t::create_with_max_threads(
+                    &multi_reorder_pd, attr, engine, create_pd)
+                == success) {
+            auto status = safe_ptr_assign(*multi_reorder_pd_iface,
+                    new primitive_desc_iface_t(multi_reorder_pd, engine));
+            if (status != status::success) delete multi_reorder_pd;
+            return status;
+        }
+    }
+    return unimplemented;
+}
@@ -0,0 +1,123 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_MULTI_REORDER_PD_HPP
+#define COMMON_MULTI_REORDER_PD_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+
+struct multi_reorder_pd_t : public primitive_desc_t {
+    multi_reorder_pd_t(const primitive_attr_t *attr,
+            const memory_desc_t *src_md, int n, const memory_desc_t *dst_mds)
+        : primitive_desc_t(attr, primitive_kind::multi_reorder)
+        , n_(n)
+        , src_md_(*src_md) {
+        dst_mds_.reserve(n_);
+        for (int i = 0; i < n_; ++i)
+            dst_mds_.push_back(dst_mds[i]);
+
+        // Fill a desc that is intended for internal use only
+        desc_ = multi_reorder_desc_t();
+        desc_.primitive_kind = primitive_kind::multi_reorder;
+        desc_.src_md = src_md_;
+        desc_.n = n_;
+        desc_.dst_mds = dst_mds_;
+    }
+
+    const multi_reorder_desc_t *desc() const { return &desc_; }
+    const op_desc_t *op_desc() const override {
+        return reinterpret_cast<const op_desc_t *>(this->desc());
+    }
+
+    arg_usage_t arg_usage(int arg) const override {
+        if (arg == DNNL_ARG_FROM) return arg_usage_t::input;
+
+        if (arg >= DNNL_ARG_MULTIPLE_DST
+                && arg < DNNL_ARG_MULTIPLE_DST + n_outputs())
+            return arg_usage_t::output;
+
+        return primitive_desc_t::arg_usage(arg);
+    }
+
+    const memory_desc_t *arg_md(int arg) const override {
+        int dst_index = arg - DNNL_ARG_MULTIPLE_DST;
+        if (dst_index >= 0 && dst_index < n_outputs()) return dst_md(dst_index);
+        if (arg == DNNL_ARG_FROM) return src_md(0);
+        return primitive_desc_t::arg_md(arg);
+    }
+
+    const memory_desc_t *src_md(int index = 0) const override {
+        return index == 0 ? &src_md_ : &glob_zero_md;
+    }
+    const memory_desc_t *dst_md(int index = 0) const override {
+        return index < n_outputs() ? &dst_mds_[index] : &glob_zero_md;
+    }
+
+    int n_inputs() const override { return 1; }
+    int n_outputs() const override { return n_; }
+
+protected:
+    int n_;
+    memory_desc_t src_md_;
+    std::vector<memory_desc_t> dst_mds_;
+
+    multi_reorder_desc_t desc_;
+};
+
+#define DECLARE_MULTI_REORDER_PD_t(impl_name, ...) \
+    static status_t create(multi_reorder_pd_t **multi_reorder_pd, \
+            engine_t *engine, const primitive_attr_t *attr, \
+            const memory_desc_t *src_md, int n, \
+            const memory_desc_t *dst_mds) { \
+        using namespace status; \
+        auto _pd = new pd_t(attr, src_md, n, dst_mds); \
+        if (_pd == nullptr) return out_of_memory; \
+        if (_pd->init(engine) != success) { \
+            delete _pd; \
+            return unimplemented; \
+        } \
+        _pd->init_scratchpad_md(); \
+        return safe_ptr_assign(*multi_reorder_pd, _pd); \
+    } \
+    status_t create_primitive( \
+            std::pair<std::shared_ptr<primitive_t>, bool> &primitive, \
+            engine_t *engine) const override { \
+        return primitive_t::create_primitive_common<__VA_ARGS__, pd_t>( \
+                primitive, this, engine, false); \
+    } \
+    pd_t *clone() const override { \
+        auto new_pd = utils::make_unique<pd_t>(*this); \
+        if (!new_pd->is_initialized()) return nullptr; \
+        return new_pd.release(); \
+    } \
+    const char *name() const override { return impl_name; } \
+    std::type_index impl_id() const override { return typeid(pd_t); }
+
+#define DECLARE_MULTI_REORDER_PD_T(impl_name, ...) \
+    DECLARE_MULTI_REORDER_PD_t(impl_name, __VA_ARGS__)
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
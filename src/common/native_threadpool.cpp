@@ -0,0 +1,388 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_thread.hpp"
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) \
+        || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace native_threadpool {
+
+namespace {
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) \
+        || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// The number of the checks before a waiting thread starts to yield the CPU
+// (the calling thread) or to sleep (the pool threads)
+constexpr int spin_count = 4096;
+
+template <typename F>
+void spin_wait(const F &done) {
+    for (int i = 0; !done(); ++i) {
+        if (i < spin_count)
+            cpu_relax();
+        else
+            std::this_thread::yield();
+    }
+}
+
+// The chunks [begin, end) a thread of a region has left. Both bounds are
+// packed in a single word, so that the owner taking the chunks from the front
+// and the thieves taking them from the back never take the same chunk.
+struct chunk_range_t {
+    std::atomic<uint64_t> bounds {0};
+    // to keep the ranges of different threads in different cache lines
+    char pad[64 - sizeof(std::atomic<uint64_t>)];
+
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return ((uint64_t)end << 32) | begin;
+    }
+
+    void init(int begin, int end) {
+        bounds.store(pack(begin, end), std::memory_order_relaxed);
+    }
+
+    bool pop_front(int &chunk) {
+        uint64_t cur = bounds.load(std::memory_order_relaxed);
+        for (;;) {
+            const uint32_t begin = (uint32_t)cur, end = (uint32_t)(cur >> 32);
+            if (begin >= end) return false;
+            if (bounds.compare_exchange_weak(cur, pack(begin + 1, end),
+                        std::memory_order_acq_rel)) {
+                chunk = (int)begin;
+                return true;
+            }
+        }
+    }
+
+    bool pop_back(int &chunk) {
+        uint64_t cur = bounds.load(std::memory_order_relaxed);
+        for (;;) {
+            const uint32_t begin = (uint32_t)cur, end = (uint32_t)(cur >> 32);
+            if (begin >= end) return false;
+            if (bounds.compare_exchange_weak(cur, pack(begin, end - 1),
+                        std::memory_order_acq_rel)) {
+                chunk = (int)end - 1;
+                return true;
+            }
+        }
+    }
+};
+
+struct region_t {
+    region_t(int nthr, int nchunks, const std::function<void(int, int)> &f)
+        : f(f)
+        , nthr(nthr)
+        , nchunks(nchunks)
+        , ranges(new chunk_range_t[nthr]) {
+        // The chunks are split between the threads the same way as with the
+        // static partitioning, so that each thread processes contiguous
+        // chunks unless it steals the ones of the others
+        for (int ithr = 0; ithr < nthr; ++ithr) {
+            int begin = 0, end = 0;
+            balance211(nchunks, nthr, ithr, begin, end);
+            ranges[ithr].init(begin, end);
+        }
+    }
+
+    const std::function<void(int, int)> &f;
+    const int nthr;
+    const int nchunks;
+    std::unique_ptr<chunk_range_t[]> ranges;
+
+    // The threads joined the region so far, the thread starting the region
+    // being the thread 0
+    std::atomic<int> njoined {1};
+    // The threads of the pool that have not left the region yet
+    std::atomic<int> nactive {0};
+    std::atomic<int> nchunks_done {0};
+
+    std::atomic<int> barrier_count {0};
+    std::atomic<int> barrier_sense {0};
+};
+
+thread_local region_t *current_region = nullptr;
+
+void run_region(region_t &r, int ithr) {
+    region_t *prev_region = current_region;
+    current_region = &r;
+
+    auto run_chunk = [&](int chunk) {
+        r.f(chunk, r.nchunks);
+        r.nchunks_done.fetch_add(1, std::memory_order_release);
+    };
+
+    int chunk = 0;
+    while (r.ranges[ithr].pop_front(chunk))
+        run_chunk(chunk);
+    for (int i = 1; i < r.nthr; ++i) {
+        auto &victim = r.ranges[(ithr + i) % r.nthr];
+        while (victim.pop_back(chunk))
+            run_chunk(chunk);
+    }
+
+    current_region = prev_region;
+}
+
+std::vector<int> get_allowed_cpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+    }
+#endif
+    if (cpus.empty()) {
+        const int ncpus = std::max(1u, std::thread::hardware_concurrency());
+        for (int cpu = 0; cpu < ncpus; ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+// A region the pool threads may join. The threads reading the region count
+// themselves as its users, so that the thread starting the region returns only
+// when none of them may access it anymore.
+struct slot_t {
+    std::atomic<region_t *> region {nullptr};
+    std::atomic<int> nusers {0};
+    // to keep the slots in different cache lines
+    char pad[64 - sizeof(std::atomic<region_t *>) - sizeof(std::atomic<int>)];
+};
+
+struct pool_t {
+    pool_t() {
+        const std::vector<int> cpus = get_allowed_cpus();
+        const int ncpus = (int)cpus.size();
+        int nthr = getenv_int("DNNL_NATIVE_NUM_THREADS", ncpus);
+        if (nthr <= 0) nthr = ncpus;
+        const bool pin = getenv_int("DNNL_NATIVE_PIN_THREADS", 1) != 0;
+
+        // The thread starting a region is not pinned as it belongs to the
+        // application, the pool threads take the other CPUs
+        for (int i = 1; i < nthr; ++i) {
+            const int cpu = pin && nthr <= ncpus ? cpus[i] : -1;
+            workers_.emplace_back(&pool_t::worker, this, cpu);
+        }
+    }
+
+    int nthr() const { return (int)workers_.size() + 1; }
+
+    // Publishing and withdrawing a region are lock-free, the mutex is taken
+    // only to wake up the sleeping threads. A region finding no free slot is
+    // executed by the calling thread alone.
+    void run(region_t &r) {
+        slot_t *slot = r.nthr > 1 ? publish(r) : nullptr;
+
+        run_region(r, 0);
+
+        // All the chunks are taken, the threads joining the region from now
+        // on would have nothing to do
+        if (slot) {
+            slot->region.store(nullptr);
+            nregions_.fetch_sub(1);
+            spin_wait([&]() { return slot->nusers.load() == 0; });
+        }
+
+        spin_wait([&]() {
+            return r.nchunks_done.load(std::memory_order_acquire) == r.nchunks
+                    && r.nactive.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+private:
+    static constexpr int max_regions = 64;
+
+    slot_t *publish(region_t &r) {
+        for (auto &slot : slots_) {
+            region_t *expected = nullptr;
+            if (!slot.region.compare_exchange_strong(expected, &r)) continue;
+            // Pairs with the check of the sleeping threads in sleep()
+            nregions_.fetch_add(1);
+            if (nsleeping_.load() > 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                cv_.notify_all();
+            }
+            return &slot;
+        }
+        return nullptr;
+    }
+
+    // Joins one of the published regions that still miss threads
+    bool join(region_t *&r, int &ithr) {
+        if (nregions_.load(std::memory_order_acquire) == 0) return false;
+        for (auto &slot : slots_) {
+            slot.nusers.fetch_add(1);
+            region_t *cur = slot.region.load();
+            bool joined = false;
+            if (cur) {
+                int n = cur->njoined.load(std::memory_order_relaxed);
+                while (n < cur->nthr
+                        && !cur->njoined.compare_exchange_weak(n, n + 1))
+                    ;
+                joined = n < cur->nthr;
+                if (joined) {
+                    // Keeps the region alive once the slot is released
+                    cur->nactive.fetch_add(1, std::memory_order_relaxed);
+                    r = cur;
+                    ithr = n;
+                }
+            }
+            slot.nusers.fetch_sub(1, std::memory_order_release);
+            if (joined) return true;
+        }
+        return false;
+    }
+
+    void sleep() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        nsleeping_.fetch_add(1);
+        cv_.wait(lock, [&]() { return nregions_.load() > 0; });
+        nsleeping_.fetch_sub(1);
+    }
+
+    void worker(int cpu) {
+#if defined(__linux__)
+        if (cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            sched_setaffinity(0, sizeof(set), &set);
+        }
+#else
+        UNUSED(cpu);
+#endif
+
+        for (;;) {
+            region_t *r = nullptr;
+            int ithr = 0;
+            for (int i = 0; !join(r, ithr); ++i) {
+                if (i < spin_count)
+                    cpu_relax();
+                else if (nregions_.load(std::memory_order_acquire) > 0)
+                    // The regions all the threads joined end soon
+                    std::this_thread::yield();
+                else
+                    sleep();
+            }
+
+            run_region(*r, ithr);
+            r->nactive.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    slot_t slots_[max_regions];
+    // The number of the published regions
+    std::atomic<int> nregions_ {0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<int> nsleeping_ {0};
+    std::vector<std::thread> workers_;
+};
+
+pool_t &pool() {
+    // The pool threads never exit, so the pool is not destroyed at exit
+    static pool_t *p = new pool_t();
+    return *p;
+}
+
+} // namespace
+
+int get_num_threads() {
+    return pool().nthr();
+}
+
+bool in_parallel() {
+    return current_region != nullptr;
+}
+
+void barrier() {
+    region_t *r = current_region;
+    if (r == nullptr || r->nthr == 1) return;
+    assert(r->nchunks == r->nthr);
+
+    const int sense = r->barrier_sense.load(std::memory_order_acquire);
+    if (r->barrier_count.fetch_add(1, std::memory_order_acq_rel)
+            == r->nthr - 1) {
+        r->barrier_count.store(0, std::memory_order_relaxed);
+        r->barrier_sense.store(sense ^ 1, std::memory_order_release);
+    } else {
+        spin_wait([&]() {
+            return r->barrier_sense.load(std::memory_order_acquire) != sense;
+        });
+    }
+}
+
+void parallel(int nthr, const std::function<void(int, int)> &f) {
+    parallel_chunks(nthr, nthr, f);
+}
+
+void parallel_chunks(
+        int nthr, int nchunks, const std::function<void(int, int)> &f) {
+    if (nchunks <= 0) return;
+    // A region started by a thread of a region is executed by this thread
+    // unless nested parallelism is allowed (see max_threads_limit_scope_t)
+    const bool nested = in_parallel();
+    if ((nested && !dnnl_nested_parallelism_allowed()) || nthr <= 1) {
+        for (int ichunk = 0; ichunk < nchunks; ++ichunk)
+            f(ichunk, nchunks);
+        return;
+    }
+
+    // The pool threads busy with the outer region do not join the nested one,
+    // its chunks are then processed by the threads that are available
+    region_t r(std::min(nthr, nchunks), nchunks, f);
+    if (nested) dnnl_nested_parallelism_allowed() = false;
+    pool().run(r);
+    if (nested) dnnl_nested_parallelism_allowed() = true;
+}
+
+} // namespace native_threadpool
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
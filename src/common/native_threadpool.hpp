@@ -0,0 +1,66 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_NATIVE_THREADPOOL_HPP
+#define COMMON_NATIVE_THREADPOOL_HPP
+
+#include <functional>
+
+#include "oneapi/dnnl/dnnl_config.h"
+
+/* This header must be included by dnnl_thread.hpp only */
+
+namespace dnnl {
+namespace impl {
+namespace native_threadpool {
+
+// The threadpool of the native runtime is created with the first parallel
+// region and lives until the process exits. It holds one thread less than the
+// number of the CPUs the process may run on, the thread starting a parallel
+// region being one of its threads.
+//
+// The threads of the pool wait for the parallel regions spinning first, and
+// sleep if none comes for a while. A parallel region is split into chunks
+// distributed over its threads, and a thread done with its own chunks steals
+// the remaining ones of the other threads of the region.
+
+// Returns the number of threads a parallel region may use
+int DNNL_API get_num_threads();
+
+// Returns true if the calling thread executes a parallel region
+bool DNNL_API in_parallel();
+
+// Waits until all the threads of the parallel region started by parallel()
+// reach the barrier. The region must use at most get_num_threads() threads,
+// must not be nested, and no other region may run concurrently, as the
+// threads must all execute the region at the same time.
+void DNNL_API barrier();
+
+// Executes f(ithr, nthr) for each ithr in [0, nthr)
+void DNNL_API parallel(int nthr, const std::function<void(int, int)> &f);
+
+// Executes f(ichunk, nchunks) for each ichunk in [0, nchunks) on nthr
+// threads, the chunks being distributed dynamically
+void DNNL_API parallel_chunks(
+        int nthr, int nchunks, const std::function<void(int, int)> &f);
+
+} // namespace native_threadpool
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
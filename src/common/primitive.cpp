@@ -202,12 +202,19 @@ status_t dnnl_primitive::init() {
     const size_t scratchpad_size
             = primitive_->pd()->scratchpad_size(scratchpad_mode::library);
 
-    if (scratchpad_size) {
+    const bool use_global_scratchpad = scratchpad_debug::is_protect_scratchpad()
+            ? false
+            : primitive_->use_global_scratchpad();
+    // The pooled scratchpad is taken for each execution, see execute()
+    const bool use_pooled_scratchpad = !use_global_scratchpad
+            && !scratchpad_debug::is_protect_scratchpad()
+            && use_scratchpad_pool(pd_->engine());
+
+    if (scratchpad_size && use_pooled_scratchpad) {
+        pooled_scratchpad_size_ = scratchpad_size;
+    } else if (scratchpad_size) {
         const memory_tracking::registry_t &registry
                 = primitive_->pd()->scratchpad_registry();
-        bool use_global_scratchpad = scratchpad_debug::is_protect_scratchpad()
-                ? false
-                : primitive_->use_global_scratchpad();
         auto *scratchpad_ptr = create_scratchpad(
                 pd_->engine(), scratchpad_size, use_global_scratchpad);
         if (scratchpad_ptr == nullptr) return out_of_memory;
@@ -236,12 +243,30 @@ const primitive_desc_iface_t *dnnl_primitive::pd() const {
 
 status_t dnnl_primitive::execute(exec_ctx_t &ctx) const {
     const memory_storage_t *mem_storage = nullptr;
+    // Holds the buffer taken for this execution only until the execution
+    // completes
+    std::unique_ptr<scratchpad_t> exec_scratchpad;
+    // The executions that may overlap with the other executions of the
+    // primitive, or with the executions of the primitives sharing the global
+    // scratchpad, cannot use the scratchpad held by the primitive
+    const bool runs_concurrently
+            = ctx.stream() != nullptr && ctx.stream()->runs_concurrently();
     if (primitive_->pd()->attr()->scratchpad_mode_ == scratchpad_mode::user) {
         memory_t *scratchpad_memory = ctx.output(DNNL_ARG_SCRATCHPAD);
         mem_storage = scratchpad_memory ? scratchpad_memory->memory_storage()
                                         : nullptr;
-    } else if (scratchpad_) {
+    } else if (scratchpad_ && !runs_concurrently) {
         mem_storage = scratchpad_->get_memory_storage();
+    } else if (scratchpad_ || pooled_scratchpad_size_) {
+        const size_t size
+                = primitive_->pd()->scratchpad_size(scratchpad_mode::library);
+        exec_scratchpad.reset(use_scratchpad_pool(pd_->engine())
+                        ? create_pooled_scratchpad(size)
+                        : create_scratchpad(pd_->engine(), size, false));
+        if (exec_scratchpad == nullptr
+                || exec_scratchpad->get_memory_storage() == nullptr)
+            return out_of_memory;
+        mem_storage = exec_scratchpad->get_memory_storage();
     }
 
     auto scratchpad_grantor
@@ -249,6 +274,8 @@ status_t dnnl_primitive::execute(exec_ctx_t &ctx) const {
     ctx.set_scratchpad_grantor(&scratchpad_grantor);
     ctx.set_resource_mapper(&resource_mapper_);
 
+    max_threads_limit_scope_t max_threads_scope(
+            primitive_->pd()->max_threads());
     auto status = primitive_->execute(ctx);
     ctx.set_scratchpad_grantor(nullptr);
     return status;
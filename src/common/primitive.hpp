@@ -63,12 +63,19 @@ struct primitive_t : public c_compatible {
 
     bool use_global_scratchpad() const { return use_global_scratchpad_; }
 
+    // Approximate amount of memory held by the primitive
+    size_t footprint() const { return footprint_; }
+
 protected:
     template <typename impl_type, typename pd_t>
     static status_t create_primitive_common(
             std::pair<std::shared_ptr<primitive_t>, bool> &primitive,
             const pd_t *pd, engine_t *engine, bool use_global_scratchpad) {
 
+        // The kernels are generated for the number of threads the primitive
+        // descriptor is initialized for
+        max_threads_limit_scope_t scope(pd->max_threads());
+
         auto &global_primitive_cache = primitive_cache();
         primitive_hashing::key_t key(pd, engine, dnnl_get_max_threads());
 
@@ -95,7 +102,13 @@ protected:
             // we have to create it and notify the waiting threads
             // once the creation is done.
             p = std::make_shared<impl_type>(pd);
+            // Nested primitives are accounted separately
+            const size_t outer_footprint = get_primitive_creation_footprint();
+            set_primitive_creation_footprint(0);
             status = p->init(engine, use_global_scratchpad);
+            p->footprint_
+                    = sizeof(impl_type) + get_primitive_creation_footprint();
+            set_primitive_creation_footprint(outer_footprint);
             if (status != status::success) {
                 // Communicate an error.
                 p_promise.set_value({nullptr, status});
@@ -108,6 +121,7 @@ protected:
                 // Store the created primitive in the shared future and notify
                 // the waiting threads.
                 p_promise.set_value({p, status});
+                global_primitive_cache.update_footprint(key, p->footprint());
             }
         }
         primitive = std::make_pair(p, is_from_cache);
@@ -116,6 +130,7 @@ protected:
 
     std::shared_ptr<primitive_desc_t> pd_;
     bool use_global_scratchpad_;
+    size_t footprint_ = 0;
 
 private:
     primitive_t() = delete;
@@ -218,7 +233,8 @@ status_t primitive_execute(
 // 1. impl::primitive_t - a primitive implementation that can be
 // stored in the primitive cache. Other data members are NOT stored in
 // the cache
-// 2. scratchpad_t - a memory for scratchpad
+// 2. scratchpad_t - a memory for scratchpad, unless the scratchpad is taken
+// from the scratchpad pool for each execution
 // 3. primitive_desc_iface_t - an alias for dnnl_primitive_desc and is
 // a user facing primitive descriptor (the one a user should create prior
 // creating a primitive)
@@ -254,6 +270,8 @@ private:
     std::atomic<int> counter_;
     std::shared_ptr<dnnl::impl::primitive_t> primitive_;
     std::unique_ptr<dnnl::impl::scratchpad_t> scratchpad_;
+    // Non-zero if the scratchpad is taken from the scratchpad pool
+    size_t pooled_scratchpad_size_ = 0;
     std::unique_ptr<primitive_desc_iface_t> pd_;
     dnnl::impl::resource_mapper_t resource_mapper_;
 
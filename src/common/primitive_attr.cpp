@@ -133,6 +133,7 @@ bool primitive_attr_t::has_default_values(dnnl_primitive_attr::skip_mask_t mask,
     CHECK_MASK(smask_t::oscale, output_scales_);
     CHECK_MASK(smask_t::scales, scales_);
     CHECK_MASK(smask_t::zero_points, zero_points_);
+    CHECK_MASK(smask_t::weights_decompression, weights_decompression_);
     CHECK_MASK(smask_t::post_ops, post_ops_);
     CHECK_MASK(smask_t::rnn_data_qparams, rnn_data_qparams_);
     CHECK_MASK(smask_t::rnn_weights_qparams, rnn_weights_qparams_);
@@ -305,6 +306,14 @@ status_t primitive_attr_t::set_scratchpad_mode(
     return success;
 }
 
+status_t primitive_attr_t::set_max_threads(int max_threads) {
+    const bool ok = max_threads >= 0 || max_threads == DNNL_MAX_THREADS_AUTO;
+    if (!ok) return invalid_arguments;
+
+    max_threads_ = max_threads;
+    return success;
+}
+
 status_t primitive_attr_t::set_post_ops(const post_ops_t &post_ops) {
     return post_ops_.copy_from(post_ops);
 }
@@ -349,6 +358,22 @@ status_t dnnl_primitive_attr_set_scratchpad_mode(
     return attr->set_scratchpad_mode(scratchpad_mode);
 }
 
+status_t dnnl_primitive_attr_get_max_threads(
+        const primitive_attr_t *attr, int *max_threads) {
+    if (any_null(attr, max_threads)) return invalid_arguments;
+
+    *max_threads = attr->max_threads_;
+
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_max_threads(
+        primitive_attr_t *attr, int max_threads) {
+    if (any_null(attr)) return invalid_arguments;
+
+    return attr->set_max_threads(max_threads);
+}
+
 status_t dnnl_primitive_attr_get_output_scales(const primitive_attr_t *attr,
         dim_t *count, int *mask, const float **scales) {
     if (any_null(attr, count, mask, scales)) return invalid_arguments;
@@ -402,6 +427,26 @@ status_t dnnl_primitive_attr_set_zero_points(primitive_attr_t *attr, int arg,
     return attr->zero_points_.set(arg, count, mask, zero_points);
 }
 
+status_t dnnl_primitive_attr_get_weights_decompression(
+        const primitive_attr_t *attr, dim_t *group_size,
+        int *with_zero_points) {
+    if (any_null(attr, group_size, with_zero_points)) return invalid_arguments;
+    const auto &wd = attr->weights_decompression_;
+    if (!wd.enabled_) return invalid_arguments;
+
+    *group_size = wd.group_size_;
+    *with_zero_points = wd.with_zero_points_;
+
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_weights_decompression(
+        primitive_attr_t *attr, dim_t group_size, int with_zero_points) {
+    if (any_null(attr)) return invalid_arguments;
+
+    return attr->weights_decompression_.set(group_size, with_zero_points != 0);
+}
+
 status_t dnnl_primitive_attr_get_post_ops(
         const primitive_attr_t *attr, const post_ops_t **post_ops) {
     if (any_null(attr, post_ops)) return invalid_arguments;
@@ -307,6 +307,32 @@ private:
     }
 };
 
+// Conversion of the integer weights to the data type of the computations:
+// weights_f = scale * (weights - zero_point). The scales and the zero points
+// are run-time f32 arguments with a value per output channel and per group of
+// group_size_ input channels (the groups span all the input channels if
+// group_size_ is 0).
+struct weights_decompression_t : public c_compatible {
+    bool operator==(const weights_decompression_t &rhs) const {
+        return enabled_ == rhs.enabled_ && group_size_ == rhs.group_size_
+                && with_zero_points_ == rhs.with_zero_points_;
+    }
+
+    bool has_default_values() const { return !enabled_; }
+
+    status_t set(dim_t group_size, bool with_zero_points) {
+        if (group_size < 0) return status::invalid_arguments;
+        enabled_ = true;
+        group_size_ = group_size;
+        with_zero_points_ = with_zero_points;
+        return status::success;
+    }
+
+    bool enabled_ = false;
+    dim_t group_size_ = 0;
+    bool with_zero_points_ = false;
+};
+
 } // namespace impl
 } // namespace dnnl
 
@@ -533,7 +559,8 @@ private:
 
 struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl_primitive_attr()
-        : scratchpad_mode_(dnnl::impl::scratchpad_mode::library) {}
+        : scratchpad_mode_(dnnl::impl::scratchpad_mode::library)
+        , max_threads_(0) {}
 
     dnnl_primitive_attr *clone() const {
         return new dnnl_primitive_attr(*this);
@@ -550,7 +577,9 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         CHECK(output_scales_.copy_from(other.output_scales_));
         CHECK(scales_.copy_from(other.scales_));
         zero_points_ = other.zero_points_;
+        weights_decompression_ = other.weights_decompression_;
         scratchpad_mode_ = other.scratchpad_mode_;
+        max_threads_ = other.max_threads_;
         CHECK(post_ops_.copy_from(other.post_ops_));
         rnn_data_qparams_ = other.rnn_data_qparams_;
         CHECK(rnn_weights_qparams_.copy_from(other.rnn_weights_qparams_));
@@ -575,12 +604,13 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         rnn_weights_qparams = 1u << 7,
         rnn_tparams = 1u << 8,
         sum_dt = 1 << 9,
-        rnn_weights_projection_qparams = 1u << 10
+        rnn_weights_projection_qparams = 1u << 10,
+        weights_decompression = 1u << 11
     };
 
     /** Returns true if the attributes have default values.
      *
-     * @note The scratchpad_mode_ is not take into account */
+     * @note The scratchpad_mode_ and max_threads_ are not take into account */
     bool has_default_values(skip_mask_t mask = skip_mask_t::none,
             dnnl::impl::data_type_t dst_dt = dnnl_data_type_undef) const;
 
@@ -589,8 +619,10 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
 
     bool operator==(const dnnl_primitive_attr &rhs) const {
         bool ret = scratchpad_mode_ == rhs.scratchpad_mode_
+                && max_threads_ == rhs.max_threads_
                 && output_scales_ == rhs.output_scales_
                 && scales_ == rhs.scales_ && zero_points_ == rhs.zero_points_
+                && weights_decompression_ == rhs.weights_decompression_
                 && post_ops_ == rhs.post_ops_
                 && rnn_data_qparams_ == rhs.rnn_data_qparams_
                 && rnn_weights_qparams_ == rhs.rnn_weights_qparams_
@@ -602,13 +634,17 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
 
     dnnl::impl::status_t set_scratchpad_mode(
             dnnl::impl::scratchpad_mode_t scratchpad_mode);
+    dnnl::impl::status_t set_max_threads(int max_threads);
     dnnl::impl::status_t set_post_ops(const dnnl::impl::post_ops_t &post_ops);
 
     // NOTE: make sure that the types below have overloaded comparison operator
     dnnl::impl::scales_t output_scales_;
     dnnl::impl::arg_scales_t scales_;
     dnnl::impl::zero_points_t zero_points_;
+    dnnl::impl::weights_decompression_t weights_decompression_;
     dnnl::impl::scratchpad_mode_t scratchpad_mode_;
+    // 0 for all the threads or DNNL_MAX_THREADS_AUTO
+    int max_threads_;
     dnnl::impl::post_ops_t post_ops_;
     dnnl::impl::rnn_data_qparams_t rnn_data_qparams_;
     dnnl::impl::scales_t rnn_weights_qparams_;
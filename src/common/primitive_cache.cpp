@@ -16,6 +16,7 @@
 
 #include "primitive_cache.hpp"
 #include "c_types_map.hpp"
+#include "nstl.hpp"
 #include "rw_mutex.hpp"
 
 #include <list>
@@ -24,17 +25,50 @@
 namespace dnnl {
 namespace impl {
 
+namespace {
+// Replaces the cache below for testing, see set_primitive_cache_shards()
+std::unique_ptr<primitive_cache_t> &primitive_cache_for_testing() {
+    static std::unique_ptr<primitive_cache_t> cache;
+    return cache;
+}
+} // namespace
+
 primitive_cache_t &primitive_cache() {
 #ifndef DNNL_DISABLE_PRIMITIVE_CACHE
     static const int capacity
             = getenv_int("DNNL_PRIMITIVE_CACHE_CAPACITY", 1024);
+    static const int n_shards = nstl::min(
+            nstl::max(getenv_int("DNNL_PRIMITIVE_CACHE_SHARDS", 1), 1), 256);
 #else
     static const int capacity = 0;
+    static const int n_shards = 1;
 #endif
+    auto &cache_for_testing = primitive_cache_for_testing();
+    if (cache_for_testing) return *cache_for_testing;
+    if (n_shards > 1) {
+        static sharded_primitive_cache_t cache(capacity, n_shards);
+        return cache;
+    }
     static lru_primitive_cache_t cache(capacity);
     return cache;
 }
 
+namespace {
+thread_local size_t primitive_creation_footprint = 0;
+}
+
+void add_primitive_creation_footprint(size_t bytes) {
+    primitive_creation_footprint += bytes;
+}
+
+size_t get_primitive_creation_footprint() {
+    return primitive_creation_footprint;
+}
+
+void set_primitive_creation_footprint(size_t bytes) {
+    primitive_creation_footprint = bytes;
+}
+
 // Undocumented API, for testing only
 status_t get_primitive_cache_size(int *size) {
     if (size == nullptr) return dnnl::impl::status::invalid_arguments;
@@ -45,6 +79,23 @@ status_t get_primitive_cache_size(int *size) {
     return dnnl::impl::status::success;
 }
 
+// Undocumented API, for testing only: replaces the primitive cache with a
+// sharded one of the current capacity, 0 shards restores the default cache.
+// No primitive may be created meanwhile.
+status_t set_primitive_cache_shards(int n_shards) {
+    if (n_shards < 0) return dnnl::impl::status::invalid_arguments;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    auto &cache = primitive_cache_for_testing();
+    if (n_shards == 0) {
+        cache.reset();
+        return dnnl::impl::status::success;
+    }
+    const int capacity = primitive_cache().get_capacity();
+    cache.reset(new sharded_primitive_cache_t(capacity, n_shards));
+#endif
+    return dnnl::impl::status::success;
+}
+
 status_t lru_primitive_cache_t::set_capacity(int capacity) {
     utils::lock_write_t lock_w(rw_mutex());
     capacity_ = (size_t)capacity;
@@ -62,6 +113,18 @@ int lru_primitive_cache_t::get_capacity() const {
     return (int)capacity_;
 }
 
+status_t lru_primitive_cache_t::set_capacity_bytes(size_t capacity) {
+    utils::lock_write_t lock_w(rw_mutex());
+    capacity_bytes_ = capacity;
+    evict_to_capacity_bytes();
+    return status::success;
+}
+
+size_t lru_primitive_cache_t::get_capacity_bytes() const {
+    utils::lock_read_t lock_r(rw_mutex());
+    return capacity_bytes_;
+}
+
 // For undocumented API
 int lru_primitive_cache_t::get_size() const {
     utils::lock_read_t lock_r(rw_mutex());
@@ -113,7 +176,7 @@ lru_primitive_cache_t::value_t lru_primitive_cache_t::get(const key_t &key) {
 
     // Move 1 cache_list_ node to the front of the cache_list_
     cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
-    return cache_list_.front().second;
+    return cache_list_.front().value;
 }
 
 void lru_primitive_cache_t::remove_if_invalidated(const key_t &key) {
@@ -125,7 +188,7 @@ void lru_primitive_cache_t::remove_if_invalidated(const key_t &key) {
         return;
     }
 
-    const auto &value = it->second->second;
+    const auto &value = it->second->value;
     if (value.get().primitive) {
         // If the entry is not invalidated
         unlock_write();
@@ -133,20 +196,144 @@ void lru_primitive_cache_t::remove_if_invalidated(const key_t &key) {
     }
 
     // Remove the invalidated entry
+    footprint_ -= it->second->footprint;
     cache_list_.erase(it->second);
     cache_mapper_.erase(it);
     assert(cache_list_.size() == cache_mapper_.size());
     unlock_write();
 }
 
+void lru_primitive_cache_t::update_footprint(
+        const key_t &key, size_t footprint) {
+    utils::lock_write_t lock_w(rw_mutex());
+    auto it = cache_mapper_.find(key);
+    // The entry has been already evicted at this point
+    if (it == cache_mapper_.end()) return;
+
+    footprint_ += footprint - it->second->footprint;
+    it->second->footprint = footprint;
+    evict_to_capacity_bytes();
+}
+
 // Evicts n the least recently used entries
 void lru_primitive_cache_t::evict(size_t n) {
     for (size_t e = 0; e < n; e++) {
-        cache_mapper_.erase(cache_list_.back().first);
+        footprint_ -= cache_list_.back().footprint;
+        cache_mapper_.erase(cache_list_.back().key);
         cache_list_.pop_back();
     }
 }
 
+// Evicts the least recently used entries until the footprint of the rest
+// fits the capacity in bytes
+void lru_primitive_cache_t::evict_to_capacity_bytes() {
+    if (capacity_bytes_ == 0) return;
+    while (footprint_ > capacity_bytes_ && !cache_list_.empty())
+        evict(1);
+}
+
+sharded_primitive_cache_t::sharded_primitive_cache_t(
+        int capacity, int n_shards)
+    : capacity_(capacity)
+    , n_shards_(n_shards)
+    , n_active_shards_(n_active_shards(capacity)) {
+    shards_.reserve(n_shards);
+    for (int i = 0; i < n_shards; i++)
+        shards_.emplace_back(
+                new lru_primitive_cache_t(shard_capacity(capacity, i)));
+}
+
+status_t sharded_primitive_cache_t::set_capacity(int capacity) {
+    utils::lock_write_t lock_w(rw_mutex());
+    capacity_ = capacity;
+    const int n_active = n_active_shards(capacity);
+    if (n_active != n_active_shards_) {
+        // The keys move to other shards, drop the entries of the old mapping
+        for (auto &s : shards_)
+            CHECK(s->set_capacity(0));
+        n_active_shards_ = n_active;
+    }
+    for (size_t i = 0; i < shards_.size(); i++) {
+        CHECK(shards_[i]->set_capacity(shard_capacity(capacity, (int)i)));
+        CHECK(shards_[i]->set_capacity_bytes(
+                shard_capacity_bytes(capacity_bytes_, (int)i)));
+    }
+    return status::success;
+}
+
+int sharded_primitive_cache_t::get_capacity() const {
+    utils::lock_read_t lock_r(rw_mutex());
+    return capacity_;
+}
+
+// For undocumented API
+int sharded_primitive_cache_t::get_size() const {
+    int size = 0;
+    for (const auto &s : shards_)
+        size += s->get_size();
+    return size;
+}
+
+// The lookups share the lock, so that they only contend on the shards, and
+// the key keeps its shard until the lookup is done with it
+sharded_primitive_cache_t::value_t sharded_primitive_cache_t::get_or_add(
+        const key_t &key, const value_t &value) {
+    utils::lock_read_t lock_r(rw_mutex());
+    return shard(key).get_or_add(key, value);
+}
+
+void sharded_primitive_cache_t::remove_if_invalidated(const key_t &key) {
+    utils::lock_read_t lock_r(rw_mutex());
+    shard(key).remove_if_invalidated(key);
+}
+
+void sharded_primitive_cache_t::update_footprint(
+        const key_t &key, size_t footprint) {
+    utils::lock_read_t lock_r(rw_mutex());
+    shard(key).update_footprint(key, footprint);
+}
+
+status_t sharded_primitive_cache_t::set_capacity_bytes(size_t capacity) {
+    utils::lock_write_t lock_w(rw_mutex());
+    capacity_bytes_ = capacity;
+    for (size_t i = 0; i < shards_.size(); i++)
+        CHECK(shards_[i]->set_capacity_bytes(
+                shard_capacity_bytes(capacity, (int)i)));
+    return status::success;
+}
+
+size_t sharded_primitive_cache_t::get_capacity_bytes() const {
+    utils::lock_read_t lock_r(rw_mutex());
+    return capacity_bytes_;
+}
+
+// The lock is taken by the caller: set_capacity() changes the number of
+// active shards
+lru_primitive_cache_t &sharded_primitive_cache_t::shard(
+        const key_t &key) const {
+    return *shards_[std::hash<key_t>()(key) % n_active_shards_];
+}
+
+int sharded_primitive_cache_t::n_active_shards(int capacity) const {
+    return nstl::max(nstl::min(capacity, n_shards_), 1);
+}
+
+// Spreads the capacity over the active shards, the first ones take the
+// remainder
+int sharded_primitive_cache_t::shard_capacity(int capacity, int ishard) const {
+    const int n = n_active_shards(capacity);
+    if (ishard >= n) return 0;
+    return capacity / n + (ishard < capacity % n);
+}
+
+size_t sharded_primitive_cache_t::shard_capacity_bytes(
+        size_t capacity, int ishard) const {
+    // Keep a limited capacity limited for every shard
+    if (capacity == 0) return 0;
+    const size_t n = (size_t)n_active_shards_;
+    return nstl::max(capacity / n + ((size_t)ishard < capacity % n), (size_t)1);
+}
+
 } // namespace impl
 } // namespace dnnl
 
@@ -167,3 +354,19 @@ dnnl::impl::status_t dnnl_set_primitive_cache_capacity(int capacity) {
 #endif
     return dnnl::impl::status::success;
 }
+
+dnnl::impl::status_t dnnl_get_primitive_cache_capacity_bytes(size_t *capacity) {
+    if (capacity == nullptr) return dnnl::impl::status::invalid_arguments;
+    *capacity = 0;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    *capacity = dnnl::impl::primitive_cache().get_capacity_bytes();
+#endif
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_set_primitive_cache_capacity_bytes(size_t capacity) {
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    return dnnl::impl::primitive_cache().set_capacity_bytes(capacity);
+#endif
+    return dnnl::impl::status::success;
+}
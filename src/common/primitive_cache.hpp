@@ -21,6 +21,7 @@
 #include <list>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "c_types_map.hpp"
 #include "oneapi/dnnl/dnnl.h"
@@ -45,51 +46,120 @@ struct primitive_cache_t : public c_compatible {
     virtual status_t set_capacity(int capacity) = 0;
     virtual int get_capacity() const = 0;
 
+    // The limit of memory occupied by the cached primitives, 0 if unlimited
+    virtual status_t set_capacity_bytes(size_t capacity) = 0;
+    virtual size_t get_capacity_bytes() const = 0;
+
     virtual value_t get_or_add(const key_t &key, const value_t &value) = 0;
     virtual void remove_if_invalidated(const key_t &key) = 0;
+    // The footprint of a primitive is known only once it is created, that is
+    // after its entry has been added
+    virtual void update_footprint(const key_t &key, size_t footprint) = 0;
 
     virtual int get_size() const = 0;
 
 protected:
-    static utils::rw_mutex_t &rw_mutex() {
-        static utils::rw_mutex_t mutex;
-        return mutex;
-    }
+    // Each cache instance has its own lock so that independent instances
+    // (e.g. shards of a sharded cache) do not contend with each other
+    utils::rw_mutex_t &rw_mutex() const { return rw_mutex_; }
 
     void lock_read() { rw_mutex().lock_read(); }
     void lock_write() { rw_mutex().lock_write(); }
     void unlock_read() { rw_mutex().unlock_read(); }
     void unlock_write() { rw_mutex().unlock_write(); }
+
+private:
+    mutable utils::rw_mutex_t rw_mutex_;
 };
 
 // The cache uses LRU replacement policy
 struct lru_primitive_cache_t : public primitive_cache_t {
-    lru_primitive_cache_t(int capacity) : capacity_(capacity) {}
+    lru_primitive_cache_t(int capacity, size_t capacity_bytes = 0)
+        : capacity_(capacity), capacity_bytes_(capacity_bytes) {}
 
     ~lru_primitive_cache_t() override = default;
 
     status_t set_capacity(int capacity) override;
     int get_capacity() const override;
 
+    status_t set_capacity_bytes(size_t capacity) override;
+    size_t get_capacity_bytes() const override;
+
     value_t get_or_add(const key_t &key, const value_t &value) override;
     void remove_if_invalidated(const key_t &key) override;
+    void update_footprint(const key_t &key, size_t footprint) override;
 
     int get_size() const override;
 
 private:
+    struct entry_t {
+        entry_t(const key_t &key, const value_t &value)
+            : key(key), value(value) {}
+        key_t key;
+        value_t value;
+        size_t footprint = 0;
+    };
+
     void evict(size_t n);
+    void evict_to_capacity_bytes();
     void add(const key_t &key, const value_t &value);
     value_t get(const key_t &key);
 
     size_t capacity_;
-    using cache_list_t = std::list<std::pair<key_t, value_t>>;
+    size_t capacity_bytes_;
+    size_t footprint_ = 0; // total footprint of the entries
+    using cache_list_t = std::list<entry_t>;
     cache_list_t cache_list_;
     std::unordered_map<key_t, cache_list_t::iterator> cache_mapper_;
 };
 
+// The cache is split into independent LRU shards selected by the key hash.
+// A lookup locks only the shard the key belongs to, which reduces contention
+// when many threads create primitives concurrently. The capacity is divided
+// evenly between the shards, hence the replacement policy is LRU within a
+// shard only. A capacity lower than the number of shards leaves only as many
+// shards in use as there are entries, so that no key maps to an empty shard.
+struct sharded_primitive_cache_t : public primitive_cache_t {
+    sharded_primitive_cache_t(int capacity, int n_shards);
+
+    ~sharded_primitive_cache_t() override = default;
+
+    status_t set_capacity(int capacity) override;
+    int get_capacity() const override;
+
+    status_t set_capacity_bytes(size_t capacity) override;
+    size_t get_capacity_bytes() const override;
+
+    value_t get_or_add(const key_t &key, const value_t &value) override;
+    void remove_if_invalidated(const key_t &key) override;
+    void update_footprint(const key_t &key, size_t footprint) override;
+
+    int get_size() const override;
+
+private:
+    lru_primitive_cache_t &shard(const key_t &key) const;
+    int n_active_shards(int capacity) const;
+    int shard_capacity(int capacity, int ishard) const;
+    size_t shard_capacity_bytes(size_t capacity, int ishard) const;
+
+    int capacity_;
+    size_t capacity_bytes_ = 0;
+    int n_shards_;
+    // The number of shards the keys are spread over, the others stay empty
+    int n_active_shards_;
+    std::vector<std::unique_ptr<lru_primitive_cache_t>> shards_;
+};
+
 primitive_cache_t &primitive_cache();
 
+// Accounts the memory allocated by the calling thread for the primitive being
+// created, such as generated code, to weigh the primitive in the cache
+void add_primitive_creation_footprint(size_t bytes);
+size_t get_primitive_creation_footprint();
+void set_primitive_creation_footprint(size_t bytes);
+
 status_t DNNL_API get_primitive_cache_size(int *size);
+status_t DNNL_API set_primitive_cache_shards(int n_shards);
 
 } // namespace impl
 } // namespace dnnl
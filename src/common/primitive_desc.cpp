@@ -17,6 +17,7 @@
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
+#include "engine.hpp"
 #include "nstl.hpp"
 
 #include "primitive.hpp"
@@ -25,6 +26,12 @@
 using namespace dnnl::impl;
 using namespace dnnl::impl::status;
 
+int primitive_desc_t::get_max_threads(const primitive_attr_t *attr,
+        engine_t *engine, int &engine_max_threads) {
+    engine_max_threads = engine->max_threads();
+    return engine->kind() == engine_kind::cpu ? attr->max_threads_ : 0;
+}
+
 dnnl_primitive_desc::dnnl_primitive_desc(primitive_desc_t *pd, engine_t *engine)
     : pd_(pd), engine_(engine) {}
 
@@ -74,6 +74,12 @@ struct primitive_desc_t : public c_compatible {
         if ((arg & DNNL_ARG_ATTR_ZERO_POINTS)
                 && !attr()->zero_points_.defined(arg))
             return arg_usage_t::input;
+        const auto &wd = attr()->weights_decompression_;
+        if (wd.enabled_ && arg == DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_SCALES)
+            return arg_usage_t::input;
+        if (wd.enabled_ && wd.with_zero_points_
+                && arg == DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_ZERO_POINTS)
+            return arg_usage_t::input;
         if (arg == DNNL_ARG_SCRATCHPAD && !is_zero_md(scratchpad_md()))
             return arg_usage_t::output;
         for (int idx = 0; idx < attr()->post_ops_.len(); ++idx) {
@@ -127,6 +133,19 @@ struct primitive_desc_t : public c_compatible {
         return typeid(primitive_desc_t);
     }
 
+    /** returns the number of threads the primitive is limited to, 0 if it
+     * may use all of them. */
+    int max_threads() const { return max_threads_; }
+
+    /** returns the number of operations the primitive performs, as estimated
+     * for the automatic choice of the number of threads, 0 if unknown. */
+    virtual dim_t work_amount() const {
+        dim_t work = 0;
+        for (auto md : {src_md(), diff_src_md(), dst_md(), diff_dst_md()})
+            work = nstl::max(work, memory_desc_wrapper(md).nelems());
+        return work;
+    }
+
     /** returns the scratchpad size for the given scratchpad mode. */
     dim_t scratchpad_size(scratchpad_mode_t mode) const {
         if (mode != attr_.scratchpad_mode_) return 0;
@@ -245,17 +264,77 @@ struct primitive_desc_t : public c_compatible {
         return success;
     }
 
+    /* Creates a primitive descriptor with `create_pd(pd)` honoring the
+     * maximum number of threads attribute and the limit of the engine: the
+     * implementation is initialized for the number of threads it executes
+     * with. In the automatic mode, the descriptor is initialized for all the
+     * threads first to estimate the work, and again for fewer threads if the
+     * work is too small for all of them. */
+    template <typename pd_t, typename create_pd_t>
+    static status_t create_with_max_threads(pd_t **pd,
+            const primitive_attr_t *attr, engine_t *engine,
+            const create_pd_t &create_pd) {
+        int engine_max_threads = 0;
+        const int attr_max_threads
+                = get_max_threads(attr, engine, engine_max_threads);
+        max_threads_limit_scope_t engine_scope(engine_max_threads);
+        if (attr_max_threads != DNNL_MAX_THREADS_AUTO) {
+            max_threads_limit_scope_t scope(attr_max_threads);
+            CHECK(create_pd(pd));
+            static_cast<primitive_desc_t *>(*pd)->max_threads_
+                    = engine_max_threads > 0
+                            && (attr_max_threads == 0
+                                    || engine_max_threads < attr_max_threads)
+                    ? engine_max_threads
+                    : attr_max_threads;
+            return status::success;
+        }
+
+        CHECK(create_pd(pd));
+        const int nthr = static_cast<primitive_desc_t *>(*pd)->auto_nthr();
+        if (nthr >= dnnl_get_max_threads()) {
+            static_cast<primitive_desc_t *>(*pd)->max_threads_
+                    = engine_max_threads;
+            return status::success;
+        }
+
+        delete *pd;
+        *pd = nullptr;
+        max_threads_limit_scope_t scope(nthr);
+        CHECK(create_pd(pd));
+        static_cast<primitive_desc_t *>(*pd)->max_threads_ = nthr;
+        return status::success;
+    }
+
 protected:
     primitive_attr_t attr_;
     primitive_kind_t kind_;
 
     memory_desc_t scratchpad_md_;
+    int max_threads_ = 0;
 
     mutable pd_info_t info_;
 
     memory_tracking::registry_t scratchpad_registry_;
 
 protected:
+    /** returns the maximum number of threads attribute, 0 if it does not
+     * apply to the engine, and the limit of the engine in
+     * `engine_max_threads` */
+    static int get_max_threads(const primitive_attr_t *attr, engine_t *engine,
+            int &engine_max_threads);
+
+    /** returns the number of threads for the automatic mode, such that each
+     * thread gets enough work to compensate the cost of the synchronization */
+    int auto_nthr() const {
+        const dim_t min_work_per_thread = 64 * 1024;
+        const int nthr = dnnl_get_max_threads();
+        const dim_t work = work_amount();
+        if (work <= 0) return nthr;
+        return (int)nstl::min<dim_t>(
+                nthr, utils::div_up(work, min_work_per_thread));
+    }
+
     /** compares ws between fwd_pd and this (make sense to use for bwd_pd)
      * Expectation: this already set workspace, and this workspace should
      *              exactly match the one from fwd_pd */
@@ -34,6 +34,11 @@ status_t cvt_primitive_args(const primitive_desc_t *pd, int nargs,
     int n_inputs = 0, extra_inputs = 0;
     int n_outputs = 0, extra_outputs = 0;
 
+    auto is_weights_decompression_arg = [](int arg) {
+        return arg == DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_SCALES
+                || arg == DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_ZERO_POINTS;
+    };
+
     for (int i = 0; i < nargs; ++i) {
         int arg = c_args[i].arg;
         auto *mem = c_args[i].memory;
@@ -47,7 +52,8 @@ status_t cvt_primitive_args(const primitive_desc_t *pd, int nargs,
                 args[arg] = {mem, true};
                 n_inputs++;
                 extra_inputs += (arg == DNNL_ARG_ATTR_OUTPUT_SCALES)
-                        || (arg & DNNL_ARG_ATTR_ZERO_POINTS);
+                        || (arg & DNNL_ARG_ATTR_ZERO_POINTS)
+                        || is_weights_decompression_arg(arg);
                 break;
             case primitive_desc_t::arg_usage_t::output:
                 if (args.count(arg) != 0) return invalid_arguments;
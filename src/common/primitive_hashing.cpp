@@ -89,6 +89,9 @@ void key_t::init_mds(const primitive_desc_t *pd) {
         case primitive_kind::matmul: {
             break;
         }
+        case primitive_kind::multi_reorder: {
+            break;
+        }
         case primitive_kind::pooling:
         case primitive_kind::pooling_v2: {
             auto typed_pd = utils::downcast<const pooling_pd_t *>(pd);
@@ -130,6 +133,9 @@ void key_t::init_mds(const primitive_desc_t *pd) {
         case primitive_kind::zero_pad: {
             break;
         }
+        case primitive_kind::brgemm: {
+            break;
+        }
         default: assert(!"unknown primitive_kind");
     }
 }
@@ -215,6 +221,15 @@ size_t get_md_hash(const memory_desc_t &md) {
                     seed, md.format_desc.rnn_packed_desc.offset_compensation);
             seed = hash_combine(seed, md.format_desc.rnn_packed_desc.size);
             break;
+        case format_kind::sparse:
+            seed = hash_combine(seed,
+                    static_cast<size_t>(md.format_desc.sparse_desc.encoding));
+            seed = hash_combine(seed, md.format_desc.sparse_desc.oc_dim);
+            seed = hash_combine(seed, md.format_desc.sparse_desc.block_k);
+            seed = hash_combine(seed, md.format_desc.sparse_desc.block_n);
+            seed = hash_combine(seed, md.format_desc.sparse_desc.nnz_blocks);
+            seed = hash_combine(seed, md.format_desc.sparse_desc.size);
+            break;
         default: assert(!"unknown format_kind");
     }
 
@@ -244,6 +259,8 @@ size_t get_attr_hash(const primitive_attr_t &attr) {
     size_t seed = 0;
     // scratchpad_mode
     seed = hash_combine(seed, static_cast<size_t>(attr.scratchpad_mode_));
+    // max_threads
+    seed = hash_combine(seed, attr.max_threads_);
 
     if (!attr.output_scales_.has_default_values()) {
         // output_scales: mask
@@ -275,6 +292,12 @@ size_t get_attr_hash(const primitive_attr_t &attr) {
             // zero_points: zero_points[:]
             seed = get_array_hash(seed, zero_points, count);
         }
+    // weights_decompression
+    if (!attr.weights_decompression_.has_default_values()) {
+        const auto &wd = attr.weights_decompression_;
+        seed = hash_combine(seed, wd.group_size_);
+        seed = hash_combine(seed, wd.with_zero_points_);
+    }
     // post_ops: entry[:]
     for (int i = 0; i < attr.post_ops_.len(); i++) {
         const auto &entry = attr.post_ops_.entry_[i];
@@ -512,6 +535,20 @@ size_t get_desc_hash(const matmul_desc_t &desc) {
     return seed;
 }
 
+size_t get_desc_hash(const multi_reorder_desc_t &desc) {
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc.primitive_kind));
+    // Memory descriptors
+    seed = hash_combine(seed, get_md_hash(desc.src_md));
+    // N
+    seed = hash_combine(seed, desc.n);
+    // Array of mds
+    seed = get_array_hash(seed, desc.dst_mds.data(), desc.n);
+    // Combined hash for multi-destination reorder desc
+    return seed;
+}
+
 size_t get_desc_hash(const pooling_desc_t &desc) {
     size_t seed = 0;
     // Kinds
@@ -712,6 +749,35 @@ size_t get_desc_hash(const zero_pad_desc_t &desc) {
     return seed;
 }
 
+size_t get_desc_hash(const brgemm_desc_t &desc) {
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc.primitive_kind));
+    seed = hash_combine(seed, static_cast<size_t>(desc.batch_kind));
+    // Sizes
+    seed = hash_combine(seed, desc.M);
+    seed = hash_combine(seed, desc.N);
+    seed = hash_combine(seed, desc.K);
+    // Data types
+    seed = hash_combine(seed, static_cast<size_t>(desc.a_dt));
+    seed = hash_combine(seed, static_cast<size_t>(desc.b_dt));
+    seed = hash_combine(seed, static_cast<size_t>(desc.c_dt));
+    seed = hash_combine(seed, static_cast<size_t>(desc.d_dt));
+    seed = hash_combine(seed, static_cast<size_t>(desc.bias_dt));
+    // Leading dimensions and strides
+    seed = hash_combine(seed, desc.lda);
+    seed = hash_combine(seed, desc.ldb);
+    seed = hash_combine(seed, desc.ldc);
+    seed = hash_combine(seed, desc.ldd);
+    seed = hash_combine(seed, desc.stride_a);
+    seed = hash_combine(seed, desc.stride_b);
+    // Scaling factors
+    seed = hash_combine(seed, desc.alpha);
+    seed = hash_combine(seed, desc.beta);
+    // Combined hash for brgemm desc
+    return seed;
+}
+
 } // namespace primitive_hashing
 } // namespace impl
 } // namespace dnnl
@@ -51,6 +51,7 @@ struct cached_op_desc_t {
             CASE(layer_normalization)
             CASE(lrn)
             CASE(matmul)
+            CASE(multi_reorder)
             case primitive_kind::pooling_v2:
             CASE(pooling)
             CASE(prelu)
@@ -63,6 +64,7 @@ struct cached_op_desc_t {
             CASE(concat)
             CASE(sum)
             CASE(zero_pad)
+            CASE(brgemm)
             default: assert(!"unknown primitive kind");
         }
             // clang-format on
@@ -94,6 +96,7 @@ struct cached_op_desc_t {
             CASE(layer_normalization)
             CASE(lrn)
             CASE(matmul)
+            CASE(multi_reorder)
             case primitive_kind::pooling_v2:
             CASE(pooling)
             CASE(prelu)
@@ -105,6 +108,7 @@ struct cached_op_desc_t {
             CASE(softmax)
             CASE(sum)
             CASE(zero_pad)
+            CASE(brgemm)
             default: assert(!"unknown primitive kind");
         }
             // clang-format on
@@ -129,6 +133,7 @@ struct cached_op_desc_t {
     DECLARE_CONVERSION_OPERATOR(layer_normalization)
     DECLARE_CONVERSION_OPERATOR(lrn)
     DECLARE_CONVERSION_OPERATOR(matmul)
+    DECLARE_CONVERSION_OPERATOR(multi_reorder)
     DECLARE_CONVERSION_OPERATOR(pooling)
     DECLARE_CONVERSION_OPERATOR(pooling_v2)
     DECLARE_CONVERSION_OPERATOR(prelu)
@@ -140,6 +145,7 @@ struct cached_op_desc_t {
     DECLARE_CONVERSION_OPERATOR(softmax)
     DECLARE_CONVERSION_OPERATOR(sum)
     DECLARE_CONVERSION_OPERATOR(zero_pad)
+    DECLARE_CONVERSION_OPERATOR(brgemm)
 #undef DECLARE_CONVERSION_OPERATOR
 
     ~cached_op_desc_t() {
@@ -161,6 +167,7 @@ struct cached_op_desc_t {
             CASE(logsoftmax)
             CASE(lrn)
             CASE(matmul)
+            CASE(multi_reorder)
             case primitive_kind::pooling_v2:
             CASE(pooling)
             CASE(prelu)
@@ -172,6 +179,7 @@ struct cached_op_desc_t {
             CASE(softmax)
             CASE(sum)
             CASE(zero_pad)
+            CASE(brgemm)
             default: assert(!"unknown primitive_kind");
         }
             // clang-format on
@@ -236,6 +244,7 @@ size_t get_desc_hash(const inner_product_desc_t &desc);
 size_t get_desc_hash(const layer_normalization_desc_t &desc);
 size_t get_desc_hash(const lrn_desc_t &desc);
 size_t get_desc_hash(const matmul_desc_t &desc);
+size_t get_desc_hash(const multi_reorder_desc_t &desc);
 size_t get_desc_hash(const pooling_desc_t &desc);
 size_t get_desc_hash(const pooling_v2_desc_t &desc);
 size_t get_desc_hash(const prelu_desc_t &desc);
@@ -247,6 +256,7 @@ size_t get_desc_hash(const shuffle_desc_t &desc);
 size_t get_desc_hash(const softmax_desc_t &desc);
 size_t get_desc_hash(const sum_desc_t &desc);
 size_t get_desc_hash(const zero_pad_desc_t &desc);
+size_t get_desc_hash(const brgemm_desc_t &desc);
 
 template <typename T>
 size_t get_array_hash(size_t seed, const T *v, int size) {
@@ -313,6 +323,7 @@ struct hash<dnnl::impl::primitive_hashing::key_t> {
             CASE(layer_normalization)
             CASE(lrn)
             CASE(matmul)
+            CASE(multi_reorder)
             case primitive_kind::pooling_v2:
             CASE(pooling)
             CASE(prelu)
@@ -324,6 +335,7 @@ struct hash<dnnl::impl::primitive_hashing::key_t> {
             CASE(softmax)
             CASE(sum)
             CASE(zero_pad)
+            CASE(brgemm)
             default: assert(!"unknown primitive_kind");
         }
             // clang-format on
@@ -61,8 +61,12 @@ struct dnnl_primitive_desc_iterator : public dnnl::impl::c_compatible {
         pd_.reset();
         while (++idx_ != last_idx_) {
             dnnl::impl::primitive_desc_t *candidate_pd = nullptr;
-            auto s = impl_list_[idx_](
-                    &candidate_pd, op_desc_, &attr_, engine_, hint_fwd_pd_);
+            auto create_pd = [&](dnnl::impl::primitive_desc_t **pd) {
+                return impl_list_[idx_](
+                        pd, op_desc_, &attr_, engine_, hint_fwd_pd_);
+            };
+            auto s = dnnl::impl::primitive_desc_t::create_with_max_threads(
+                    &candidate_pd, &attr_, engine_, create_pd);
             if (s == dnnl::impl::status::success) {
                 pd_.reset(candidate_pd);
                 break;
@@ -70,7 +70,11 @@ status_t dnnl_reorder_primitive_desc_create(
     auto e = get_reorder_engine(src_engine, dst_engine);
     for (auto r = e->get_reorder_implementation_list(src_md, dst_md); *r; ++r) {
         reorder_pd_t *reorder_pd = nullptr;
-        if ((*r)(&reorder_pd, e, attr, src_engine, src_md, dst_engine, dst_md)
+        auto create_pd = [&](reorder_pd_t **pd) {
+            return (*r)(pd, e, attr, src_engine, src_md, dst_engine, dst_md);
+        };
+        if (primitive_desc_t::create_with_max_threads(
+                    &reorder_pd, attr, e, create_pd)
                 == success) {
             auto status = safe_ptr_assign(*reorder_pd_iface,
                     new reorder_primitive_desc_iface_t(
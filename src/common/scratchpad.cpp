@@ -14,7 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include "engine.hpp"
 #include "utils.hpp"
@@ -42,6 +44,16 @@ engine_t *get_cpu_engine() {
     return cpu_engine.get();
 }
 
+// The buffers shared between the engines are neither placed on the NUMA node
+// of any particular engine nor allocated with the allocator of an engine, so
+// they are not used for the engines bound to a node or having an allocator
+bool has_own_memory(engine_t *engine) {
+    return engine->kind() == engine_kind::cpu
+            && is_native_runtime(engine->runtime_kind())
+            && !utils::downcast<cpu::cpu_engine_t *>(engine)
+                        ->uses_shared_memory();
+}
+
 memory_storage_t *create_scratchpad_memory_storage(
         engine_t *engine, size_t size) {
     // XXX: if engine is a non-native CPU engine (read: SYCL) then create
@@ -146,6 +158,153 @@ thread_local memory_storage_t *global_scratchpad_t::mem_storage_ = nullptr;
 thread_local size_t global_scratchpad_t::size_ = 0;
 thread_local unsigned int global_scratchpad_t::reference_count_ = 0;
 
+/*
+  Process-wide pool of scratchpad buffers. Primitives that take their
+  scratchpad from the pool hold a buffer only for the duration of an
+  execution, so the memory is shared by all the primitives that are not
+  executed at the same time.
+
+  Buffer sizes are rounded up to size classes (four classes per power of two)
+  so that a buffer can be reused by primitives with slightly different
+  scratchpad sizes. Every trim_period releases the free buffers are trimmed,
+  largest first, down to the high-water mark of the memory in use observed
+  since the previous trim.
+*/
+struct scratchpad_pool_t {
+    struct block_t {
+        memory_storage_t *mem_storage;
+        size_t size;
+    };
+
+    static scratchpad_pool_t &instance() {
+        static scratchpad_pool_t pool;
+        return pool;
+    }
+
+    block_t acquire(size_t size) {
+        const size_t block_size = size_class(size);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // A buffer of the next power of two size class at most
+            auto it = free_.lower_bound(block_size);
+            if (it != free_.end() && it->first <= 2 * block_size) {
+                block_t block {it->second, it->first};
+                free_.erase(it);
+                stats_.reuses++;
+                on_acquire(block.size);
+                return block;
+            }
+        }
+
+        auto *mem_storage = create_scratchpad_memory_storage(
+                get_cpu_engine(), block_size);
+        if (mem_storage == nullptr) return {nullptr, 0};
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.allocations++;
+        stats_.bytes += block_size;
+        on_acquire(block_size);
+        return {mem_storage, block_size};
+    }
+
+    void release(const block_t &block) {
+        if (block.mem_storage == nullptr) return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.emplace(block.size, block.mem_storage);
+        stats_.bytes_in_use -= block.size;
+
+        if (++n_releases_ % trim_period != 0) return;
+        while (stats_.bytes > peak_bytes_in_use_ && !free_.empty()) {
+            auto it = std::prev(free_.end());
+            stats_.bytes -= it->first;
+            delete it->second;
+            free_.erase(it);
+        }
+        peak_bytes_in_use_ = stats_.bytes_in_use;
+    }
+
+    scratchpad_pool_stats_t stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+private:
+    static constexpr size_t min_block_size = 4096;
+    static constexpr size_t trim_period = 256;
+
+    scratchpad_pool_t() : stats_ {0, 0, 0, 0} {}
+
+    ~scratchpad_pool_t() {
+        for (auto &e : free_)
+            delete e.second;
+    }
+
+    static size_t size_class(size_t size) {
+        if (size <= min_block_size) return min_block_size;
+        size_t pow2 = min_block_size;
+        while (pow2 < size)
+            pow2 <<= 1;
+        return utils::rnd_up(size, pow2 / 8);
+    }
+
+    void on_acquire(size_t size) {
+        stats_.bytes_in_use += size;
+        peak_bytes_in_use_ = nstl::max(peak_bytes_in_use_, stats_.bytes_in_use);
+    }
+
+    mutable std::mutex mutex_;
+    std::multimap<size_t, memory_storage_t *> free_;
+    scratchpad_pool_stats_t stats_;
+    uint64_t peak_bytes_in_use_ = 0;
+    size_t n_releases_ = 0;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(scratchpad_pool_t);
+};
+
+/*
+  Implementation of the scratchpad_t interface that takes a buffer from the
+  scratchpad pool and returns it back on destruction
+*/
+struct pooled_scratchpad_t : public scratchpad_t {
+    pooled_scratchpad_t(size_t size)
+        : block_(scratchpad_pool_t::instance().acquire(size)) {}
+
+    ~pooled_scratchpad_t() override {
+        scratchpad_pool_t::instance().release(block_);
+    }
+
+    const memory_storage_t *get_memory_storage() const override {
+        return block_.mem_storage;
+    }
+
+    size_t size() const override { return block_.size; }
+
+private:
+    scratchpad_pool_t::block_t block_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(pooled_scratchpad_t);
+};
+
+bool use_scratchpad_pool(engine_t *engine) {
+    // The buffer is returned to the pool once the execution call returns, so
+    // the pool is limited to the runtimes that complete the computations
+    // before that. The pool is opt-in as it takes a lock twice per execution.
+    static const bool enabled = getenv_int("DNNL_SCRATCHPAD_POOL", 0) != 0;
+    return enabled && engine->kind() == engine_kind::cpu
+            && is_native_runtime(engine->runtime_kind())
+            && engine->runtime_kind() != runtime_kind::threadpool
+            && !has_own_memory(engine);
+}
+
+scratchpad_t *create_pooled_scratchpad(size_t size) {
+    return new pooled_scratchpad_t(size);
+}
+
+scratchpad_pool_stats_t get_scratchpad_pool_stats() {
+    return scratchpad_pool_t::instance().stats();
+}
+
 /*
    Scratchpad creation routine
 */
@@ -157,7 +316,8 @@ scratchpad_t *create_scratchpad(
      * from different engines.
      * lock global scratchpad to work with CPU engine only.
      */
-    if (use_global_scratchpad && engine->kind() == engine_kind_t::dnnl_cpu)
+    if (use_global_scratchpad && engine->kind() == engine_kind_t::dnnl_cpu
+            && !has_own_memory(engine))
         return new global_scratchpad_t(engine, size);
     else
         return new concurrent_scratchpad_t(engine, size);
@@ -169,3 +329,10 @@ scratchpad_t *create_scratchpad(
 
 } // namespace impl
 } // namespace dnnl
+
+dnnl_status_t dnnl_get_scratchpad_pool_stats(
+        dnnl_scratchpad_pool_stats_t *stats) {
+    if (stats == nullptr) return dnnl::impl::status::invalid_arguments;
+    *stats = dnnl::impl::get_scratchpad_pool_stats();
+    return dnnl::impl::status::success;
+}
@@ -33,6 +33,15 @@ struct scratchpad_t {
 scratchpad_t *create_scratchpad(
         engine_t *engine, size_t size, bool use_global_scratchpad);
 
+// Returns true if the primitives created on the engine may take their
+// scratchpad from the scratchpad pool for each execution instead of holding
+// one for their lifetime
+bool use_scratchpad_pool(engine_t *engine);
+scratchpad_t *create_pooled_scratchpad(size_t size);
+
+using scratchpad_pool_stats_t = dnnl_scratchpad_pool_stats_t;
+scratchpad_pool_stats_t get_scratchpad_pool_stats();
+
 } // namespace impl
 } // namespace dnnl
 #endif
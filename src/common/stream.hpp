@@ -47,6 +47,10 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
     /** blocks until all submitted primitives to the stream are completed */
     virtual dnnl::impl::status_t wait() = 0;
 
+    /** returns true if the submitted primitives may execute concurrently
+     * with each other */
+    virtual bool runs_concurrently() const { return false; }
+
     virtual void before_exec_hook() {}
     virtual void after_exec_hook() {}
 
@@ -69,7 +69,11 @@ status_t dnnl_sum_primitive_desc_create(primitive_desc_iface_t **sum_pd_iface,
 
     for (auto s = engine->get_sum_implementation_list(); *s; ++s) {
         sum_pd_t *sum_pd = nullptr;
-        if ((*s)(&sum_pd, engine, attr, dst_md, n, scales, src_mds)
+        auto create_pd = [&](sum_pd_t **pd) {
+            return (*s)(pd, engine, attr, dst_md, n, scales, src_mds);
+        };
+        if (primitive_desc_t::create_with_max_threads(
+                    &sum_pd, attr, engine, create_pd)
                 == success) {
             auto status = safe_ptr_assign(
                     *sum_pd_iface, new primitive_desc_iface_t(sum_pd, engine));
@@ -87,12 +87,19 @@ inline size_t data_type_size(data_type_t data_type) {
         case s32: return sizeof(prec_traits<s32>::type);
         case s8: return sizeof(prec_traits<s8>::type);
         case u8: return sizeof(prec_traits<u8>::type);
+        // The size of a byte holding two values, see memory_desc_wrapper
+        case s4:
+        case u4: return sizeof(uint8_t);
         case data_type::undef:
         default: assert(!"unknown data_type");
     }
     return (size_t)-1; /* not supposed to be reachable */
 }
 
+inline bool is_4bit_data_type(data_type_t data_type) {
+    return utils::one_of(data_type, data_type::s4, data_type::u4);
+}
+
 template <typename T>
 inline T max_value(data_type_t data_type) {
     using namespace data_type;
@@ -190,6 +197,13 @@ inline bool wino_desc_is_equal(const wino_desc_t &lhs, const wino_desc_t &rhs) {
             && lhs.r == rhs.r;
 }
 
+inline bool sparse_desc_is_equal(
+        const sparse_desc_t &lhs, const sparse_desc_t &rhs) {
+    return lhs.encoding == rhs.encoding && lhs.oc_dim == rhs.oc_dim
+            && lhs.block_k == rhs.block_k && lhs.block_n == rhs.block_n
+            && lhs.nnz_blocks == rhs.nnz_blocks && lhs.size == rhs.size;
+}
+
 inline bool rnn_packed_desc_is_equal(
         const rnn_packed_desc_t &lhs, const rnn_packed_desc_t &rhs) {
     bool ok = true && lhs.format == rhs.format && lhs.ldb == rhs.ldb
@@ -277,6 +291,9 @@ inline bool operator==(const memory_desc_t &lhs, const memory_desc_t &rhs) {
     else if (lhs.format_kind == format_kind::rnn_packed)
         return types::rnn_packed_desc_is_equal(lhs.format_desc.rnn_packed_desc,
                 rhs.format_desc.rnn_packed_desc);
+    else if (lhs.format_kind == format_kind::sparse)
+        return types::sparse_desc_is_equal(
+                lhs.format_desc.sparse_desc, rhs.format_desc.sparse_desc);
     return true;
 }
 
@@ -484,6 +501,21 @@ inline bool operator==(const reorder_desc_t &lhs, const reorder_desc_t &rhs) {
     return ret;
 }
 
+inline bool operator==(
+        const multi_reorder_desc_t &lhs, const multi_reorder_desc_t &rhs) {
+    bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
+            && COMPARE_DESC_MEMBERS(src_md)
+            && COMPARE_DESC_MEMBERS(n);
+
+    if (!ret) return ret;
+
+    for (int i = 0; i < lhs.n; i++) {
+        ret = COMPARE_DESC_MEMBERS(dst_mds[i]);
+        if (!ret) break;
+    }
+    return ret;
+}
+
 inline bool operator==(
         const resampling_desc_t &lhs, const resampling_desc_t &rhs) {
     bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
@@ -566,6 +598,28 @@ inline bool operator==(const zero_pad_desc_t &lhs, const zero_pad_desc_t &rhs) {
     bool ret = COMPARE_DESC_MEMBERS(primitive_kind);
     return ret;
 }
+
+inline bool operator==(const brgemm_desc_t &lhs, const brgemm_desc_t &rhs) {
+    bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
+            && COMPARE_DESC_MEMBERS(batch_kind)
+            && COMPARE_DESC_MEMBERS(M)
+            && COMPARE_DESC_MEMBERS(N)
+            && COMPARE_DESC_MEMBERS(K)
+            && COMPARE_DESC_MEMBERS(a_dt)
+            && COMPARE_DESC_MEMBERS(b_dt)
+            && COMPARE_DESC_MEMBERS(c_dt)
+            && COMPARE_DESC_MEMBERS(d_dt)
+            && COMPARE_DESC_MEMBERS(bias_dt)
+            && COMPARE_DESC_MEMBERS(lda)
+            && COMPARE_DESC_MEMBERS(ldb)
+            && COMPARE_DESC_MEMBERS(ldc)
+            && COMPARE_DESC_MEMBERS(ldd)
+            && COMPARE_DESC_MEMBERS(stride_a)
+            && COMPARE_DESC_MEMBERS(stride_b)
+            && COMPARE_DESC_MEMBERS(alpha)
+            && COMPARE_DESC_MEMBERS(beta);
+    return ret;
+}
 // clang-format on
 #undef COMPARE_DESC_MEMBERS
 #undef COMPARE_DESC_ARRAY_MEMBERS
@@ -731,7 +785,7 @@ inline bool memory_desc_sanity_check(int ndims, const dims_t dims,
     if (ndims == 0) return true;
 
     bool ok = dims != nullptr && 0 < ndims && ndims <= DNNL_MAX_NDIMS
-            && utils::one_of(data_type, f16, bf16, f32, s32, s8, u8);
+            && utils::one_of(data_type, f16, bf16, f32, s32, s8, u8, s4, u4);
     if (!ok) return false;
 
     bool has_runtime_dims = false;
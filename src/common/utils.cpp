@@ -24,6 +24,7 @@
 #endif
 
 #ifdef __linux__
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #endif
@@ -34,6 +35,7 @@
 #include <cstring>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "oneapi/dnnl/dnnl.h"
 
@@ -108,11 +110,88 @@ int getpagesize() {
 #endif
 }
 
+static setting_t<int> huge_pages_mode {dnnl_huge_pages_none};
+
+#ifdef __linux__
+namespace {
+int get_huge_pages_mode() {
+    if (!huge_pages_mode.initialized())
+        huge_pages_mode.set(
+                getenv_int("DNNL_HUGE_PAGES", huge_pages_mode.get()));
+    return huge_pages_mode.get();
+}
+
+// The buffers mapped from the explicit huge pages pool, which are released
+// with munmap() and their size. The registry is never destroyed, as buffers
+// may be released at exit.
+struct hugetlb_registry_t {
+    std::mutex mutex;
+    std::unordered_map<void *, size_t> sizes;
+    std::atomic<size_t> count {0};
+};
+
+hugetlb_registry_t &hugetlb_registry() {
+    static auto *registry = new hugetlb_registry_t();
+    return *registry;
+}
+
+// Allocates a buffer taking whole 2 MB pages, so that the pages are not
+// shared with the neighbouring allocations
+void *malloc_huge_pages(size_t size, int alignment) {
+    using namespace cpu;
+    if (alignment > PAGE_2M) return nullptr;
+    const size_t huge_size = utils::rnd_up(size, PAGE_2M);
+
+#ifdef MAP_HUGETLB
+    if (get_huge_pages_mode() == dnnl_huge_pages_hugetlb) {
+        void *ptr = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED) {
+            auto &registry = hugetlb_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.sizes.emplace(ptr, huge_size);
+            registry.count++;
+            return ptr;
+        }
+    }
+#endif
+
+    void *ptr = nullptr;
+    if (::posix_memalign(&ptr, PAGE_2M, huge_size) != 0) return nullptr;
+#ifdef MADV_HUGEPAGE
+    madvise(ptr, huge_size, MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+bool free_huge_pages(void *p) {
+    auto &registry = hugetlb_registry();
+    if (registry.count == 0) return false;
+
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.sizes.find(p);
+    if (it == registry.sizes.end()) return false;
+    munmap(p, it->second);
+    registry.sizes.erase(it);
+    registry.count--;
+    return true;
+}
+} // namespace
+#endif
+
 void *malloc(size_t size, int alignment) {
     void *ptr;
     if (memory_debug::is_mem_debug())
         return memory_debug::malloc(size, alignment);
 
+#ifdef __linux__
+    if (size >= cpu::PAGE_2M
+            && get_huge_pages_mode() != dnnl_huge_pages_none) {
+        ptr = malloc_huge_pages(size, alignment);
+        if (ptr) return ptr;
+    }
+#endif
+
 #ifdef _WIN32
     ptr = _aligned_malloc(size, alignment);
     int rc = ptr ? 0 : -1;
@@ -127,6 +206,10 @@ void free(void *p) {
 
     if (memory_debug::is_mem_debug()) return memory_debug::free(p);
 
+#ifdef __linux__
+    if (free_huge_pages(p)) return;
+#endif
+
 #ifdef _WIN32
     _aligned_free(p);
 #else
@@ -152,6 +235,13 @@ bool get_jit_dump() {
     return jit_dump.get();
 }
 
+static setting_t<bool> gemm_tune {false};
+bool get_gemm_tune() {
+    if (!gemm_tune.initialized())
+        gemm_tune.set(!!getenv_int("DNNL_GEMM_TUNE", gemm_tune.get()));
+    return gemm_tune.get();
+}
+
 static setting_t<unsigned> jit_profiling_flags {DNNL_JIT_PROFILE_VTUNE};
 unsigned get_jit_profiling_flags() {
     if (!jit_profiling_flags.initialized()) {
@@ -219,6 +309,21 @@ dnnl_status_t dnnl_set_jit_profiling_jitdumpdir(const char *dir) {
     return dnnl::impl::init_jit_profiling_jitdumpdir(dir, true);
 }
 
+dnnl_status_t dnnl_set_huge_pages_mode(dnnl_huge_pages_mode_t mode) {
+    using namespace dnnl::impl;
+    if (!utils::one_of(mode, dnnl_huge_pages_none, dnnl_huge_pages_madvise,
+                dnnl_huge_pages_hugetlb))
+        return status::invalid_arguments;
+    huge_pages_mode.set(mode);
+    return status::success;
+}
+
+dnnl_status_t dnnl_set_gemm_tune(int enabled) {
+    using namespace dnnl::impl;
+    gemm_tune.set(enabled);
+    return status::success;
+}
+
 dnnl_status_t dnnl_set_max_cpu_isa(dnnl_cpu_isa_t isa) {
     return dnnl::impl::cpu::platform::set_max_cpu_isa(isa);
 }
@@ -39,6 +39,7 @@
 #include "layer_normalization_pd.hpp"
 #include "lrn_pd.hpp"
 #include "matmul_pd.hpp"
+#include "multi_reorder_pd.hpp"
 #include "pooling_pd.hpp"
 #include "prelu_pd.hpp"
 #include "reduction_pd.hpp"
@@ -201,6 +202,13 @@ void attr2str(char *str, int len, int written, const primitive_attr_t *attr) {
                 dnnl_scratchpad_mode2str(spm));
     }
 
+    // same for the maximum number of threads
+    if (attr->max_threads_ == DNNL_MAX_THREADS_AUTO) {
+        DPRINT(str, len, written, "max_threads:auto;");
+    } else if (attr->max_threads_ > 0) {
+        DPRINT(str, len, written, "max_threads:%d;", attr->max_threads_);
+    }
+
     if (attr->has_default_values()) return;
 
     const scales_t &os = attr->output_scales_;
@@ -251,6 +259,12 @@ void attr2str(char *str, int len, int written, const primitive_attr_t *attr) {
         DPRINT(str, len, written, "';");
     }
 
+    const weights_decompression_t &wd = attr->weights_decompression_;
+    if (!wd.has_default_values()) {
+        DPRINT(str, len, written, "weights_decompression:" DFMT "%s;",
+                wd.group_size_, wd.with_zero_points_ ? ":zp" : "");
+    }
+
     const post_ops_t &po = attr->post_ops_;
     if (!po.has_default_values()) {
         DPRINT(str, len, written, "post_ops:'");
@@ -325,6 +339,7 @@ void flags2str(char *str, int len, int written, unsigned flags) {
 const char *prim_kind2str(dnnl_primitive_kind_t prim_kind) {
     switch ((int)prim_kind) {
         case primitive_kind::zero_pad: return "zero_pad";
+        case primitive_kind::brgemm: return "brgemm";
         default: return dnnl_prim_kind2str(prim_kind);
     }
 }
@@ -722,6 +737,33 @@ static void init_info_mem(const engine_t *e, pd_t *s, char *buffer) {
             attr_str, aux_str, prb_str);
 }
 
+template <typename pd_t>
+static void init_info_multi_reorder(engine_t *e, pd_t *s, char *buffer) {
+    DECL_DAT_AUX_PRB_STRS();
+
+    { // src
+        auto md = s->src_md();
+        DPRINT(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, "src_");
+        MD2STR(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, md);
+    }
+    { // dst
+        for (int i = 0; i < s->n_outputs(); ++i) {
+            auto md = s->dst_md(i);
+            DPRINT(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, " dst_");
+            MD2STR(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, md);
+        }
+    }
+
+    attr2str(attr_str, DNNL_VERBOSE_ATTR_LEN, attr_written, s->attr());
+
+    DPRINT(aux_str, DNNL_VERBOSE_AUX_LEN, aux_written, "n:%d", s->n_outputs());
+
+    dnnl_md2dim_str(prb_str, DNNL_VERBOSE_PRB_LEN, s->src_md());
+
+    verbose_templ(buffer, e, s->kind(), s->name(), prop_kind::undef, dat_str,
+            attr_str, aux_str, prb_str);
+}
+
 template <typename pd_t>
 static void init_info_reorder(engine_t *e, pd_t *s, char *buffer) {
     DECL_DAT_AUX_PRB_STRS();
@@ -1081,6 +1123,37 @@ void init_info_zero_pad(
             attr_str, aux_str, prb_str);
 }
 
+void init_info_brgemm(
+        const engine_t *e, const primitive_desc_t *s, char *buffer) {
+    DECL_DAT_AUX_PRB_STRS();
+
+    auto desc = reinterpret_cast<const brgemm_desc_t *>(s->op_desc());
+    DPRINT(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, "a_%s b_%s c_%s",
+            dnnl_dt2str(desc->a_dt), dnnl_dt2str(desc->b_dt),
+            dnnl_dt2str(desc->c_dt));
+    if (desc->d_dt != data_type::undef)
+        DPRINT(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, " d_%s",
+                dnnl_dt2str(desc->d_dt));
+    if (desc->bias_dt != data_type::undef)
+        DPRINT(dat_str, DNNL_VERBOSE_DAT_LEN, dat_written, " bia_%s",
+                dnnl_dt2str(desc->bias_dt));
+
+    attr2str(attr_str, DNNL_VERBOSE_ATTR_LEN, attr_written, s->attr());
+
+    const char *batch_kind = desc->batch_kind == dnnl_brgemm_batch_addr
+            ? "addr"
+            : desc->batch_kind == dnnl_brgemm_batch_offs ? "offs" : "strd";
+    DPRINT(aux_str, DNNL_VERBOSE_AUX_LEN, aux_written,
+            "batch:%s lda:" DFMT " ldb:" DFMT " ldc:" DFMT, batch_kind,
+            desc->lda, desc->ldb, desc->ldc);
+
+    DPRINT(prb_str, DNNL_VERBOSE_PRB_LEN, prb_written,
+            "m" DFMT "n" DFMT "k" DFMT, desc->M, desc->N, desc->K);
+
+    verbose_templ(buffer, e, s->kind(), s->name(), prop_kind::undef, dat_str,
+            attr_str, aux_str, prb_str);
+}
+
 template <typename pd_t>
 static void init_info_reduction(const engine_t *e, pd_t *s, char *buffer) {
     DECL_DAT_AUX_PRB_STRS();
@@ -1138,6 +1211,7 @@ void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
             CASE(lrn);
             CASE(logsoftmax);
             CASE(matmul);
+            CASE(multi_reorder);
             case primitive_kind::pooling_v2:
             CASE(pooling);
             CASE(prelu);
@@ -1151,6 +1225,9 @@ void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
             case primitive_kind::zero_pad:
                 init_info_zero_pad(engine, pd, &str_[0]);
                 break;
+            case primitive_kind::brgemm:
+                init_info_brgemm(engine, pd, &str_[0]);
+                break;
             default: assert(!"unknown primitive kind");
         }
 #undef CASE
@@ -21,6 +21,7 @@
 #include <limits.h>
 
 #include "common/bit_cast.hpp"
+#include "common/primitive_cache.hpp"
 #include "common/type_helpers.hpp"
 #include "common/utils.hpp"
 
@@ -1233,6 +1234,7 @@ public:
     virtual status_t create_kernel() {
         generate();
         jit_ker_ = getCode();
+        if (jit_ker_) add_primitive_creation_footprint(getSize());
         return (jit_ker_) ? status::success : status::runtime_error;
     }
 
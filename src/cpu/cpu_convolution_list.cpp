@@ -51,6 +51,7 @@ using namespace dnnl::impl::cpu::aarch64;
 #include "cpu/x64/jit_avx512_core_u8s8s32x_wino_convolution.hpp"
 #include "cpu/x64/jit_avx512_core_x8s8s32x_1x1_convolution.hpp"
 #include "cpu/x64/jit_avx512_core_x8s8s32x_convolution.hpp"
+#include "cpu/x64/jit_brgemm_conv.hpp"
 #include "cpu/x64/jit_sse41_1x1_convolution.hpp"
 #include "cpu/x64/jit_sse41_convolution.hpp"
 #include "cpu/x64/jit_uni_dw_convolution.hpp"
@@ -101,6 +102,7 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
         CPU_INSTANCE_X64(jit_avx512_core_f32_wino_conv_2x3_fwd_t)
         CPU_INSTANCE_X64(jit_avx512_core_f32_wino_conv_4x3_fwd_t)
         CPU_INSTANCE_X64(jit_avx512_common_convolution_winograd_fwd_t)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core, f32>)
         CPU_INSTANCE_X64(jit_avx512_common_convolution_fwd_t<f32>)
         CPU_INSTANCE_AARCH64_ACL(acl_wino_convolution_fwd_t)
         CPU_INSTANCE_X64(jit_avx2_dw_convolution_fwd_t)
@@ -121,8 +123,10 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, bf16, bf16, f32}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<bf16, bf16, f32>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<bf16, bf16, f32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_bf16, bf16, bf16, f32>)
         CPU_INSTANCE_X64(jit_uni_dw_convolution_fwd_t<avx512_core, bf16, f32>)
         CPU_INSTANCE_X64(jit_avx512_core_bf16_1x1_convolution_fwd_t<f32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16, bf16, bf16, f32>)
         CPU_INSTANCE_X64(jit_avx512_core_bf16_convolution_fwd_t)
         CPU_INSTANCE_X64(gemm_bf16_convolution_fwd_t<f32>)
         CPU_INSTANCE(ref_convolution_fwd_t<bf16, bf16, f32, f32>)
@@ -131,8 +135,10 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, bf16, bf16, bf16}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<bf16, bf16, bf16>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<bf16, bf16, bf16>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_bf16, bf16>)
         CPU_INSTANCE_X64(jit_uni_dw_convolution_fwd_t<avx512_core, bf16, bf16>)
         CPU_INSTANCE_X64(jit_avx512_core_bf16_1x1_convolution_fwd_t<bf16>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16, bf16>)
         CPU_INSTANCE_X64(jit_avx512_core_bf16_convolution_fwd_t)
         CPU_INSTANCE_X64(gemm_bf16_convolution_fwd_t<bf16>)
         CPU_INSTANCE(ref_convolution_fwd_t<bf16, bf16, bf16, f32>)
@@ -212,7 +218,9 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, s8, s8, f32}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<s8, s8, f32>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<s8, s8, f32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, s8, s8, f32>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t<s8, f32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_vnni, s8, s8, f32>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_convolution_fwd_t<s8, f32>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_1x1_convolution_fwd_t<avx2, s8, f32>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_convolution_fwd_t<avx2, s8, f32>)
@@ -226,7 +234,9 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, s8, s8, s32}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<s8, s8, s32>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<s8, s8, s32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, s8, s8, s32>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t<s8, s32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_vnni, s8, s8, s32>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_convolution_fwd_t<s8, s32>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_1x1_convolution_fwd_t<avx2, s8, s32>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_convolution_fwd_t<avx2, s8, s32>)
@@ -240,7 +250,9 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, s8, s8, s8}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<s8, s8, s8>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<s8, s8, s8>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, s8, s8, s8>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t<s8, s8>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_vnni, s8, s8, s8>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_convolution_fwd_t<s8, s8>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_1x1_convolution_fwd_t<avx2, s8, s8>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_convolution_fwd_t<avx2, s8, s8>)
@@ -255,7 +267,9 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, s8, s8, u8}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<s8, s8, u8>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<s8, s8, u8>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, s8, s8, u8>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t<s8, u8>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_vnni, s8, s8, u8>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_convolution_fwd_t<s8, u8>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_1x1_convolution_fwd_t<avx2, s8, u8>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_convolution_fwd_t<avx2, s8, u8>)
@@ -270,8 +284,10 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, u8, s8, f32}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<u8, s8, f32>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<u8, s8, f32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, u8, s8, f32>)
         CPU_INSTANCE_X64(jit_avx512_core_u8s8s32x_wino_convolution_fwd_t<f32>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t<u8, f32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_vnni, u8, s8, f32>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_convolution_fwd_t<u8, f32>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_1x1_convolution_fwd_t<avx2, u8, f32>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_convolution_fwd_t<avx2, u8, f32>)
@@ -284,8 +300,10 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, u8, s8, s32}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<u8, s8, s32>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<u8, s8, s32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, u8, s8, s32>)
         CPU_INSTANCE_X64(jit_avx512_core_u8s8s32x_wino_convolution_fwd_t<s32>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t<u8, s32>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_vnni, u8, s8, s32>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_convolution_fwd_t<u8, s32>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_1x1_convolution_fwd_t<avx2, u8, s32>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_convolution_fwd_t<avx2, u8, s32>)
@@ -298,8 +316,10 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, u8, s8, s8}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<u8, s8, s8>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<u8, s8, s8>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, u8, s8, s8>)
         CPU_INSTANCE_X64(jit_avx512_core_u8s8s32x_wino_convolution_fwd_t<s8>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t<u8, s8>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_vnni, u8, s8, s8>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_convolution_fwd_t<u8, s8>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_1x1_convolution_fwd_t<avx2, u8, s8>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_convolution_fwd_t<avx2, u8, s8>)
@@ -313,8 +333,10 @@ const std::map<conv_impl_key_t, std::vector<pd_create_f>> impl_list_map {
     {{forward, u8, s8, u8}, {
         CPU_INSTANCE_X64(jit_avx512_core_amx_1x1_convolution_fwd_t<u8, s8, u8>)
         CPU_INSTANCE_X64(jit_avx512_core_amx_convolution_fwd_t<u8, s8, u8>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, u8, s8, u8>)
         CPU_INSTANCE_X64(jit_avx512_core_u8s8s32x_wino_convolution_fwd_t<u8>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t<u8, u8>)
+        CPU_INSTANCE_X64(brgemm_convolution_fwd_t<avx512_core_vnni, u8, s8, u8>)
         CPU_INSTANCE_X64(jit_avx512_core_x8s8s32x_convolution_fwd_t<u8, u8>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_1x1_convolution_fwd_t<avx2, u8, u8>)
         CPU_INSTANCE_X64(jit_uni_x8s8s32x_convolution_fwd_t<avx2, u8, u8>)
@@ -25,6 +25,7 @@
 #include "common/c_types_map.hpp"
 #include "common/engine.hpp"
 
+#include "cpu/cpu_numa.hpp"
 #include "cpu/platform.hpp"
 
 #define CPU_INSTANCE(...) &primitive_desc_t::create<__VA_ARGS__::pd_t>,
@@ -68,6 +69,8 @@ public:
     static const engine_t::reorder_primitive_desc_create_f *
     get_reorder_implementation_list(
             const memory_desc_t *src_md, const memory_desc_t *dst_md);
+    static const engine_t::multi_reorder_primitive_desc_create_f *
+    get_multi_reorder_implementation_list();
     static const engine_t::sum_primitive_desc_create_f *
     get_sum_implementation_list();
     static const engine_t::primitive_desc_create_f *get_implementation_list(
@@ -106,7 +109,27 @@ public:
 
 class cpu_engine_t : public engine_t {
 public:
-    cpu_engine_t() : engine_t(engine_kind::cpu, get_cpu_native_runtime()) {}
+    cpu_engine_t(int numa_node = -1, dnnl_memory_allocate_f allocate = nullptr,
+            dnnl_memory_deallocate_f deallocate = nullptr)
+        : engine_t(engine_kind::cpu, get_cpu_native_runtime())
+        , numa_node_(numa_node)
+        , allocate_(allocate)
+        , deallocate_(deallocate) {}
+
+    // The NUMA node the engine allocates memory on and runs the primitives
+    // on, -1 if the engine spans the whole system
+    int numa_node() const { return numa_node_; }
+
+    // The user functions allocating the memory of the engine, nullptr if the
+    // library functions are used
+    dnnl_memory_allocate_f allocate() const { return allocate_; }
+    dnnl_memory_deallocate_f deallocate() const { return deallocate_; }
+
+    // Whether the memory of the engine may be taken from the buffers shared
+    // with the other engines
+    bool uses_shared_memory() const {
+        return numa_node_ < 0 && allocate_ == nullptr;
+    }
 
     /* implementation part */
 
@@ -131,6 +154,10 @@ public:
         return cpu_engine_impl_list_t::get_reorder_implementation_list(
                 src_md, dst_md);
     }
+    const multi_reorder_primitive_desc_create_f *
+    get_multi_reorder_implementation_list() const override {
+        return cpu_engine_impl_list_t::get_multi_reorder_implementation_list();
+    }
     const sum_primitive_desc_create_f *
     get_sum_implementation_list() const override {
         return cpu_engine_impl_list_t::get_sum_implementation_list();
@@ -140,15 +167,44 @@ public:
         return cpu_engine_impl_list_t::get_implementation_list(desc);
     }
 
-    device_id_t device_id() const override { return std::make_tuple(0, 0, 0); }
+    // The primitives created for different nodes or allocators are not
+    // interchangeable, as their resources are allocated on the node and with
+    // the allocator
+    device_id_t device_id() const override {
+        return std::make_tuple(0, numa_node_ + 1,
+                (uint64_t)reinterpret_cast<uintptr_t>(allocate_));
+    }
+
+    // The primitives of a node engine run on the CPUs of the node
+    int max_threads() const override {
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_THREADPOOL
+        if (numa_node_ >= 0) return (int)numa::get_node_cpus(numa_node_).size();
+#endif
+        return 0;
+    }
+
+private:
+    int numa_node_;
+    dnnl_memory_allocate_f allocate_;
+    dnnl_memory_deallocate_f deallocate_;
 };
 
+// Engine 0 spans the whole system. On a system with several NUMA nodes,
+// engine i + 1 is restricted to node i.
 class cpu_engine_factory_t : public engine_factory_t {
 public:
-    size_t count() const override { return 1; }
+    size_t count() const override {
+        const int nnodes = numa::get_num_nodes();
+        return nnodes > 1 ? nnodes + 1 : 1;
+    }
     status_t engine_create(engine_t **engine, size_t index) const override {
-        assert(index == 0);
-        *engine = new cpu_engine_t();
+        return engine_create(engine, index, nullptr, nullptr);
+    };
+    status_t engine_create(engine_t **engine, size_t index,
+            dnnl_memory_allocate_f allocate,
+            dnnl_memory_deallocate_f deallocate) const {
+        assert(index < count());
+        *engine = new cpu_engine_t((int)index - 1, allocate, deallocate);
         return status::success;
     };
 };
@@ -23,6 +23,7 @@
 #if DNNL_X64
 #include "cpu/x64/gemm_bf16_inner_product.hpp"
 #include "cpu/x64/jit_brgemm_inner_product.hpp"
+#include "cpu/x64/jit_brgemm_sparse_inner_product.hpp"
 using namespace dnnl::impl::cpu::x64;
 #endif
 
@@ -38,6 +39,8 @@ using namespace dnnl::impl::data_type;
 // clang-format off
 const pd_create_f impl_list[] = {
         /* f32 */
+        CPU_INSTANCE_X64(brgemm_sparse_inner_product_fwd_t<avx512_core, f32>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2, f32>)
         CPU_INSTANCE(gemm_inner_product_fwd_t<f32>)
         CPU_INSTANCE(gemm_inner_product_bwd_data_t<f32>)
         CPU_INSTANCE(gemm_inner_product_bwd_weights_t<f32>)
@@ -45,6 +48,8 @@ const pd_create_f impl_list[] = {
         CPU_INSTANCE(ref_inner_product_bwd_data_t<f32, f32, f32, f32>)
         CPU_INSTANCE(ref_inner_product_bwd_weights_t<f32>)
         /* bfloat16 */
+        CPU_INSTANCE_X64(brgemm_sparse_inner_product_fwd_t<avx512_core_bf16, bf16, bf16, f32>)
+        CPU_INSTANCE_X64(brgemm_sparse_inner_product_fwd_t<avx512_core_bf16, bf16>)
         CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx512_core_bf16, bf16, bf16, f32>)
         CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx512_core_bf16, bf16>)
         CPU_INSTANCE_X64(brgemm_inner_product_bwd_data_t<avx512_core_bf16, f32, bf16, bf16>)
@@ -60,6 +65,10 @@ const pd_create_f impl_list[] = {
         CPU_INSTANCE(ref_inner_product_fwd_t<bf16, bf16, bf16, f32>)
         CPU_INSTANCE(ref_inner_product_fwd_t<bf16, bf16, f32, f32>)
         /* int */
+        CPU_INSTANCE_X64(brgemm_sparse_inner_product_fwd_t<avx512_core_vnni, u8, s8, u8>)
+        CPU_INSTANCE_X64(brgemm_sparse_inner_product_fwd_t<avx512_core_vnni, u8, s8, s8>)
+        CPU_INSTANCE_X64(brgemm_sparse_inner_product_fwd_t<avx512_core_vnni, u8, s8, s32>)
+        CPU_INSTANCE_X64(brgemm_sparse_inner_product_fwd_t<avx512_core_vnni, u8, s8, f32>)
         CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8, u8, s8, u8>)
         CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8, u8, s8, s8>)
         CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8, u8, s8, s32>)
@@ -76,6 +85,18 @@ const pd_create_f impl_list[] = {
         CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx512_core_vnni, s8, s8, s8>)
         CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx512_core_vnni, s8, s8, s32>)
         CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx512_core_vnni, s8, s8, f32>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2_vnni, u8, s8, u8>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2_vnni, u8, s8, s8>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2_vnni, u8, s8, s32>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2_vnni, u8, s8, f32>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2_vnni, s8, s8, u8>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2_vnni, s8, s8, s8>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2_vnni, s8, s8, s32>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2_vnni, s8, s8, f32>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2, u8, s8, u8>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2, u8, s8, s8>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2, u8, s8, s32>)
+        CPU_INSTANCE_X64(brgemm_inner_product_fwd_t<avx2, u8, s8, f32>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t<u8, u8>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t<u8, s8>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t<u8, s32>)
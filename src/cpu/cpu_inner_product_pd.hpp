@@ -162,6 +162,10 @@ protected:
     status_t set_default_params() {
         using namespace format_tag;
 
+        // The sparse weights are supported by the dedicated implementations
+        if (weights_md_.format_kind == format_kind::sparse)
+            return status::unimplemented;
+
         auto set_default_src = [&]() {
             if (weights_md_.format_kind == format_kind::any) {
                 INIT_MEM_BY_TAG(utils::pick(ndims() - 2, ab, abc, abcd, abcde),
@@ -203,6 +207,10 @@ protected:
     status_t set_default_params() {
         using namespace format_tag;
 
+        // The sparse weights are supported by the dedicated implementations
+        if (weights_md_.format_kind == format_kind::sparse)
+            return status::unimplemented;
+
         auto set_default_diff_src = [&]() {
             if (weights_md_.format_kind == format_kind::any) {
                 INIT_MEM_BY_TAG(utils::pick(ndims() - 2, ab, abc, abcd, abcde),
@@ -243,6 +251,10 @@ protected:
     status_t set_default_params() {
         using namespace format_tag;
 
+        // The sparse weights are supported by the dedicated implementations
+        if (diff_weights_md_.format_kind == format_kind::sparse)
+            return status::unimplemented;
+
         auto set_default_src = [&]() {
             if (diff_weights_md_.format_kind == format_kind::any) {
                 INIT_MEM_BY_TAG(utils::pick(ndims() - 2, ab, abc, abcd, abcde),
@@ -19,6 +19,11 @@
 #include "cpu/ref_layer_normalization.hpp"
 #include "cpu/simple_layer_normalization.hpp"
 
+#if DNNL_X64
+#include "cpu/x64/jit_uni_layer_normalization.hpp"
+using namespace dnnl::impl::cpu::x64;
+#endif
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
@@ -30,6 +35,10 @@ using namespace dnnl::impl::data_type;
 
 // clang-format off
 const pd_create_f impl_list[] = {
+        CPU_INSTANCE_X64(jit_uni_layer_normalization_fwd_t<avx512_common>)
+        CPU_INSTANCE_X64(jit_uni_layer_normalization_bwd_t<avx512_common>)
+        CPU_INSTANCE_X64(jit_uni_layer_normalization_fwd_t<avx2>)
+        CPU_INSTANCE_X64(jit_uni_layer_normalization_bwd_t<avx2>)
         CPU_INSTANCE(simple_layer_normalization_fwd_t<f32>)
         CPU_INSTANCE(simple_layer_normalization_bwd_t<f32>)
         CPU_INSTANCE(simple_layer_normalization_fwd_t<bf16>)
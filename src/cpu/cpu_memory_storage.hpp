@@ -24,6 +24,8 @@
 #include "common/memory_storage.hpp"
 #include "common/utils.hpp"
 
+#include "cpu/cpu_engine.hpp"
+#include "cpu/cpu_numa.hpp"
 #include "cpu/platform.hpp"
 
 namespace dnnl {
@@ -64,9 +66,27 @@ public:
 
 protected:
     status_t init_allocate(size_t size) override {
-        void *ptr = malloc(size, platform::get_cache_line_size());
-        if (!ptr) return status::out_of_memory;
-        data_ = decltype(data_)(ptr, destroy);
+        auto *cpu_engine = utils::downcast<cpu_engine_t *>(engine());
+        const int numa_node = cpu_engine->numa_node();
+        // The buffer of a NUMA engine takes whole pages, so that binding them
+        // does not move the neighbouring allocations to the node
+        const size_t alignment = numa_node >= 0
+                ? (size_t)PAGE_4K
+                : (size_t)platform::get_cache_line_size();
+        if (numa_node >= 0) size = utils::rnd_up(size, PAGE_4K);
+
+        void *ptr = nullptr;
+        if (cpu_engine->allocate()) {
+            ptr = cpu_engine->allocate()(size, alignment);
+            if (!ptr) return status::out_of_memory;
+            data_ = decltype(data_)(ptr, cpu_engine->deallocate());
+        } else {
+            ptr = malloc(size, (int)alignment);
+            if (!ptr) return status::out_of_memory;
+            data_ = decltype(data_)(ptr, destroy);
+        }
+
+        if (numa_node >= 0) numa::bind_memory(ptr, size, numa_node);
         return status::success;
     }
 
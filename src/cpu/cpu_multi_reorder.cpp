@@ -0,0 +1,51 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "cpu/cpu_engine.hpp"
+
+#include "cpu/ref_multi_reorder.hpp"
+
+#if DNNL_X64
+#include "cpu/x64/jit_uni_multi_reorder.hpp"
+#endif
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+using mrpd_create_f
+        = dnnl::impl::engine_t::multi_reorder_primitive_desc_create_f;
+
+namespace {
+// clang-format off
+#define INSTANCE(...) __VA_ARGS__::pd_t::create,
+const mrpd_create_f cpu_multi_reorder_impl_list[] = {
+        DNNL_X64_ONLY(INSTANCE(x64::jit_uni_multi_reorder_t))
+        INSTANCE(ref_multi_reorder_t)
+        nullptr,
+};
+#undef INSTANCE
+// clang-format on
+} // namespace
+
+const mrpd_create_f *
+cpu_engine_impl_list_t::get_multi_reorder_implementation_list() {
+    return cpu_multi_reorder_impl_list;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,257 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+#include "common/dnnl_thread.hpp"
+#include "common/nstl.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_numa.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace numa {
+
+namespace {
+struct node_t {
+    int id; // system node id
+    std::vector<int> cpus;
+};
+
+#if defined(__linux__)
+// Parses a CPU list like "0-27,56-83"
+std::vector<int> parse_cpu_list(const char *str) {
+    std::vector<int> cpus;
+    while (*str) {
+        char *end = nullptr;
+        const long first = strtol(str, &end, 10);
+        if (end == str) break;
+        long last = first;
+        str = end;
+        if (*str == '-') {
+            last = strtol(str + 1, &end, 10);
+            str = end;
+        }
+        for (long c = first; c <= last; ++c)
+            cpus.push_back((int)c);
+        while (*str == ',' || *str == '\n')
+            ++str;
+    }
+    return cpus;
+}
+
+std::vector<node_t> detect_nodes() {
+    std::vector<node_t> nodes;
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return nodes;
+
+    const char *sys_dir = "/sys/devices/system/node";
+    DIR *dir = opendir(sys_dir);
+    if (!dir) return nodes;
+
+    while (struct dirent *entry = readdir(dir)) {
+        int id = -1;
+        if (sscanf(entry->d_name, "node%d", &id) != 1 || id < 0) continue;
+
+        char path[256];
+        snprintf(path, sizeof(path), "%s/node%d/cpulist", sys_dir, id);
+        FILE *f = fopen(path, "r");
+        if (!f) continue;
+        char buf[4096] = {0};
+        const bool ok = fgets(buf, sizeof(buf), f) != nullptr;
+        fclose(f);
+        if (!ok) continue;
+
+        node_t node {id, {}};
+        for (int cpu : parse_cpu_list(buf))
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+                node.cpus.push_back(cpu);
+        // Memory-only nodes and the nodes the process may not run on
+        if (!node.cpus.empty()) nodes.push_back(node);
+    }
+    closedir(dir);
+
+    std::sort(nodes.begin(), nodes.end(),
+            [](const node_t &a, const node_t &b) { return a.id < b.id; });
+    return nodes;
+}
+#endif
+
+const std::vector<node_t> &get_nodes() {
+#if defined(__linux__)
+    static const std::vector<node_t> nodes = detect_nodes();
+#else
+    static const std::vector<node_t> nodes;
+#endif
+    return nodes;
+}
+} // namespace
+
+int get_num_nodes() {
+    return nstl::max(1, (int)get_nodes().size());
+}
+
+const std::vector<int> &get_node_cpus(int node) {
+    static const std::vector<int> empty;
+    const auto &nodes = get_nodes();
+    if (node < 0 || node >= (int)nodes.size()) return empty;
+    return nodes[node].cpus;
+}
+
+void bind_memory(void *ptr, size_t size, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    const auto &nodes = get_nodes();
+    if (ptr == nullptr || size == 0 || node < 0 || node >= (int)nodes.size())
+        return;
+
+    // Not taken from <numaif.h> to avoid the dependency on libnuma
+    const int mpol_preferred = 1;
+    const unsigned mpol_mf_move = 1 << 1;
+
+    const int nbits = 8 * sizeof(unsigned long);
+    const int id = nodes[node].id;
+    std::vector<unsigned long> mask(id / nbits + 1, 0);
+    mask[id / nbits] = 1UL << (id % nbits);
+
+    // The preferred policy falls back to the other nodes instead of failing
+    // the allocation when the node runs out of memory. The result is
+    // deliberately ignored: the placement only affects the performance.
+    syscall(SYS_mbind, ptr, size, mpol_preferred, mask.data(),
+            mask.size() * nbits + 1, mpol_mf_move);
+#else
+    UNUSED(ptr);
+    UNUSED(size);
+    UNUSED(node);
+#endif
+}
+
+#if defined(__linux__) && DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
+namespace {
+cpu_set_t node_cpu_set(const std::vector<int> &cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+        CPU_SET(cpu, &set);
+    return set;
+}
+
+// The affinity of the thread before thread_binding_t bound it
+struct saved_affinity_t {
+    cpu_set_t set;
+    bool valid = false;
+};
+
+saved_affinity_t &saved_affinity() {
+    static thread_local saved_affinity_t saved;
+    return saved;
+}
+
+void save_and_bind(const cpu_set_t &set) {
+    auto &saved = saved_affinity();
+    saved.valid = sched_getaffinity(0, sizeof(saved.set), &saved.set) == 0
+            && sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+void restore() {
+    auto &saved = saved_affinity();
+    if (!saved.valid) return;
+    sched_setaffinity(0, sizeof(saved.set), &saved.set);
+    saved.valid = false;
+}
+} // namespace
+#endif
+
+void bind_threads(int node) {
+#if defined(__linux__) && DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
+    const auto &cpus = get_node_cpus(node);
+    if (cpus.empty()) return;
+
+    const cpu_set_t set = node_cpu_set(cpus);
+    auto bind = [&]() { sched_setaffinity(0, sizeof(set), &set); };
+
+    // The threads created later inherit the affinity of the calling thread,
+    // the ones already running parallel regions for it are bound explicitly
+    bind();
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+#pragma omp parallel num_threads((int)cpus.size())
+    bind();
+#endif
+#else
+    UNUSED(node);
+#endif
+}
+
+thread_binding_t::thread_binding_t(int node) {
+#if defined(__linux__) && DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
+    const auto &cpus = get_node_cpus(node);
+    if (cpus.empty()) return;
+
+    // Nothing to bind, nor to restore, when the application already runs the
+    // thread on the node
+    const cpu_set_t set = node_cpu_set(cpus);
+    cpu_set_t current;
+    if (sched_getaffinity(0, sizeof(current), &current) == 0
+            && CPU_EQUAL(&current, &set))
+        return;
+
+    nthr_ = (int)cpus.size();
+    save_and_bind(set);
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    // The threads of a nested team are not reused, there is no need to bind
+    // them ahead
+    if (omp_in_parallel()) return;
+#pragma omp parallel num_threads(nthr_)
+    if (omp_get_thread_num() != 0) save_and_bind(set);
+#endif
+#else
+    UNUSED(node);
+#endif
+}
+
+thread_binding_t::~thread_binding_t() {
+#if defined(__linux__) && DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
+    if (nthr_ == 0) return;
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    if (!omp_in_parallel()) {
+#pragma omp parallel num_threads(nthr_)
+        if (omp_get_thread_num() != 0) restore();
+    }
+#endif
+    restore();
+#endif
+}
+
+} // namespace numa
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,72 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_CPU_NUMA_HPP
+#define CPU_CPU_NUMA_HPP
+
+#include <stddef.h>
+#include <vector>
+
+#include "common/utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace numa {
+
+// The nodes are the NUMA nodes having CPUs the process may run on, numbered
+// from 0 in the order of the system node ids. The topology is only detected
+// on Linux, elsewhere the system is a single node.
+
+// Returns the number of nodes, 1 if the topology is unknown
+int get_num_nodes();
+
+// Returns the CPUs of the node the process may run on
+const std::vector<int> &get_node_cpus(int node);
+
+// Makes the pages of [ptr, ptr + size) allocated on the node, including the
+// pages already allocated. The range must be page aligned, as the policy
+// applies to whole pages.
+void bind_memory(void *ptr, size_t size, int node);
+
+// Restricts the calling thread to the CPUs of the node for good. With OpenMP,
+// the threads running the parallel regions it starts are restricted as well.
+// Only for the threads the library owns.
+void bind_threads(int node);
+
+// Restricts the calling thread, and with OpenMP the threads running the
+// parallel regions it starts, to the CPUs of the node while the object is
+// alive. Their affinity is restored afterwards, as the threads belong to the
+// application.
+struct thread_binding_t {
+    thread_binding_t(int node);
+    ~thread_binding_t();
+
+private:
+    // The number of threads bound, 0 if none
+    int nthr_ = 0;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(thread_binding_t);
+};
+
+} // namespace numa
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
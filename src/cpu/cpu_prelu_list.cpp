@@ -18,6 +18,11 @@
 
 #include "cpu/ref_prelu.hpp"
 
+#if DNNL_X64
+#include "cpu/x64/jit_uni_prelu.hpp"
+using namespace dnnl::impl::cpu::x64;
+#endif
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
@@ -29,6 +34,10 @@ using namespace dnnl::impl::data_type;
 
 // clang-format off
 const pd_create_f impl_list[] = {
+        CPU_INSTANCE_X64(jit_uni_prelu_fwd_t<avx512_common>)
+        CPU_INSTANCE_X64(jit_uni_prelu_bwd_t<avx512_common>)
+        CPU_INSTANCE_X64(jit_uni_prelu_fwd_t<avx2>)
+        CPU_INSTANCE_X64(jit_uni_prelu_bwd_t<avx2>)
         CPU_INSTANCE(ref_prelu_fwd_t<f32>)
         CPU_INSTANCE(ref_prelu_bwd_t<f32>)
         CPU_INSTANCE(ref_prelu_fwd_t<bf16>)
@@ -18,6 +18,11 @@
 
 #include "cpu/ref_reduction.hpp"
 
+#if DNNL_X64
+#include "cpu/x64/jit_uni_reduction.hpp"
+using namespace dnnl::impl::cpu::x64;
+#endif
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
@@ -29,6 +34,9 @@ using namespace dnnl::impl::data_type;
 
 // clang-format off
 const pd_create_f impl_list[] = {
+    CPU_INSTANCE_X64(jit_uni_reduction_t<avx512_common>)
+    CPU_INSTANCE_X64(jit_uni_reduction_t<avx2>)
+    CPU_INSTANCE_X64(jit_uni_reduction_t<sse41>)
     CPU_INSTANCE(ref_reduction_t<f32, f32, f32>)
     CPU_INSTANCE(ref_reduction_t<bf16, bf16, f32>)
     CPU_INSTANCE(ref_reduction_t<bf16, f32, f32>)
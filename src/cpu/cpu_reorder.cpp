@@ -27,6 +27,7 @@
 
 #include "cpu/rnn/rnn_reorders.hpp"
 #include "cpu/simple_reorder.hpp"
+#include "cpu/sparse_reorder.hpp"
 
 #if DNNL_X64
 #include "cpu/x64/jit_uni_reorder.hpp"
@@ -100,6 +101,7 @@ using impl_list_map_t = std::map<reorder_impl_key_t, std::vector<rpd_create_f>>;
 const impl_list_map_t regular_impl_list_map {
     // f32 -> bf16
     {{f32, bf16, 0}, {
+        sparse_reorder_t<f32, bf16>::pd_t::create,
         rnn_weights_reorder_t<f32, bf16>::pd_t::create,
 
         DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
@@ -130,6 +132,7 @@ const impl_list_map_t regular_impl_list_map {
 
     // f32 -> f32
     {{f32, f32, 0}, {
+        sparse_reorder_t<f32, f32>::pd_t::create,
         REG_FAST_DIRECT_COPY_F32_F32_COMMA
 
         DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
@@ -300,6 +303,7 @@ const impl_list_map_t regular_impl_list_map {
 
     // f32 -> s8
     {{f32, s8, 0}, {
+        sparse_reorder_t<f32, s8>::pd_t::create,
         DNNL_X64_ONLY(x64::wino_reorder_t<f32, s8>::pd_t::create,)
         rnn_weights_reorder_s8_t<f32>::pd_t::create,
         rnn_brgemm_weights_reorder_s8_t<f32, s8>::pd_t::create,
@@ -336,6 +340,7 @@ const impl_list_map_t regular_impl_list_map {
 
     // bf16 ->
     {{bf16, data_type::undef, 0}, {
+        sparse_reorder_t<bf16, bf16>::pd_t::create,
         rnn_weights_reorder_t<bf16, bf16>::pd_t::create,
 
         DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
@@ -402,6 +407,7 @@ const impl_list_map_t regular_impl_list_map {
 
     // s8 ->
     {{s8, data_type::undef, 0}, {
+        sparse_reorder_t<s8, s8>::pd_t::create,
         rnn_weights_reorder_s8_t<s8>::pd_t::create,
         rnn_brgemm_weights_reorder_s8_t<s8, s8>::pd_t::create,
 
@@ -467,6 +473,8 @@ const impl_list_map_t regular_impl_list_map {
 const impl_list_map_t comp_s8s8_impl_list_map {
     // f32 -> s8
     {{f32, s8, 2}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(f32, oi, s8, OI4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, io, s8, OI4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, oi, s8, OI4i32o4i, fmt_order::keep, spec::conv_req_comp),
@@ -478,6 +486,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
     }},
     // f32 -> s8
     {{f32, s8, 3}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(f32, any, s8, wio, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, oiw, s8, OIw4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, oiw, s8, OIw4i32o4i, fmt_order::keep, spec::conv_req_comp),
@@ -493,6 +503,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
         nullptr,
     }},
     {{f32, s8, 4}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(f32, any, s8, hwio, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, any, s8, wigo, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, goiw, s8, gOIw4i16o4i, fmt_order::keep, spec::conv_req_comp),
@@ -521,6 +533,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
         nullptr,
     }},
     {{f32, s8, 5}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(f32, any, s8, hwigo, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, any, s8, dhwio, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, goihw, s8, gOIhw4i16o4i, fmt_order::keep, spec::conv_req_comp),
@@ -549,6 +563,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
         nullptr,
     }},
     {{f32, s8, 6}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(f32, any, s8, dhwigo, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, goidhw, s8, gOIdhw4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(f32, goidhw, s8, gOIdhw2i8o4i, fmt_order::keep, spec::conv_req_comp),
@@ -558,6 +574,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
     }},
     // bf16 -> s8
     {{bf16, s8, 2}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(bf16, oi, s8, OI4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, io, s8, OI4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, oi, s8, OI4i32o4i, fmt_order::keep, spec::conv_req_comp),
@@ -569,6 +587,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
     }},
     // bf16 -> s8
     {{bf16, s8, 3}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(bf16, any, s8, wio, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, oiw, s8, OIw4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, oiw, s8, OIw4i32o4i, fmt_order::keep, spec::conv_req_comp),
@@ -584,6 +604,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
         nullptr,
     }},
     {{bf16, s8, 4}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(bf16, any, s8, hwio, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, any, s8, wigo, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, goiw, s8, gOIw4i16o4i, fmt_order::keep, spec::conv_req_comp),
@@ -612,6 +634,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
         nullptr,
     }},
     {{bf16, s8, 5}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(bf16, any, s8, hwigo, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, any, s8, dhwio, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, goihw, s8, gOIhw4i16o4i, fmt_order::keep, spec::conv_req_comp),
@@ -640,6 +664,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
         nullptr,
     }},
     {{bf16, s8, 6}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(bf16, any, s8, dhwigo, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, goidhw, s8, gOIdhw4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(bf16, goidhw, s8, gOIdhw2i8o4i, fmt_order::keep, spec::conv_req_comp),
@@ -649,6 +675,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
     }},
     // s8 -> s8
     {{s8, s8, 2}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(s8, oi, s8, OI4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, io, s8, OI4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, oi, s8, OI4i32o4i, fmt_order::keep, spec::conv_req_comp),
@@ -660,6 +688,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
     }},
     // s8 -> s8
     {{s8, s8, 3}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(s8, any, s8, wio, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, oiw, s8, OIw4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, oiw, s8, OIw4i32o4i, fmt_order::keep, spec::conv_req_comp),
@@ -675,6 +705,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
         nullptr,
     }},
     {{s8, s8, 4}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(s8, any, s8, hwio, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, any, s8, wigo, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, goiw, s8, gOIw4i16o4i, fmt_order::keep, spec::conv_req_comp),
@@ -703,6 +735,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
         nullptr,
     }},
     {{s8, s8, 5}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(s8, any, s8, hwigo, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, any, s8, dhwio, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, goihw, s8, gOIhw4i16o4i, fmt_order::keep, spec::conv_req_comp),
@@ -731,6 +765,8 @@ const impl_list_map_t comp_s8s8_impl_list_map {
         nullptr,
     }},
     {{s8, s8, 6}, {
+        DNNL_X64_ONLY(x64::jit_uni_reorder_create,)
+
         REG_SR(s8, any, s8, dhwigo, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, goidhw, s8, gOIdhw4i16o4i, fmt_order::keep, spec::conv_req_comp),
         REG_SR(s8, goidhw, s8, gOIdhw2i8o4i, fmt_order::keep, spec::conv_req_comp),
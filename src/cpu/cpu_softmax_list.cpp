@@ -40,6 +40,7 @@ const pd_create_f impl_list[] = {
         CPU_INSTANCE_X64(jit_uni_softmax_fwd_t<avx512_common>)
         CPU_INSTANCE_X64(jit_uni_softmax_bwd_t<avx512_common>)
         CPU_INSTANCE_X64(jit_uni_softmax_fwd_t<avx2>)
+        CPU_INSTANCE_X64(jit_uni_softmax_bwd_t<avx2>)
         CPU_INSTANCE_X64(jit_uni_softmax_fwd_t<sse41>)
 	CPU_INSTANCE_AARCH64(jit_uni_softmax_fwd_t<sve_512>)
         CPU_INSTANCE_AARCH64(jit_uni_softmax_bwd_t<sve_512>)
@@ -0,0 +1,243 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "common/memory.hpp"
+#include "common/memory_desc_wrapper.hpp"
+#include "common/nstl.hpp"
+#include "common/primitive.hpp"
+#include "common/primitive_exec_types.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_engine.hpp"
+#include "cpu/cpu_stream.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_THREADPOOL
+namespace {
+struct range_t {
+    const char *begin;
+    const char *end;
+
+    bool overlaps(const range_t &other) const {
+        return begin < other.end && other.begin < end;
+    }
+};
+
+bool overlap(const std::vector<range_t> &a, const std::vector<range_t> &b) {
+    for (const auto &ra : a)
+        for (const auto &rb : b)
+            if (ra.overlaps(rb)) return true;
+    return false;
+}
+} // namespace
+
+struct cpu_task_graph_t::task_t {
+    task_t(const primitive_iface_t *primitive_iface, const exec_ctx_t &ctx)
+        : primitive_iface(primitive_iface), ctx(ctx) {
+        // The primitive must outlive the execution even if the user destroys
+        // it right after the submission
+        const_cast<primitive_iface_t *>(primitive_iface)->retain();
+
+        for (const auto &arg : ctx.args()) {
+            const memory_t *mem = arg.second.mem;
+            if (mem == nullptr) continue;
+
+            void *handle = nullptr;
+            mem->get_data_handle(&handle);
+
+            // The size of a memory descriptor with an offset is not defined,
+            // so the data starts at the offset and takes the size of the
+            // descriptor without it
+            memory_desc_t md = *mem->md();
+            const dim_t offset0 = md.offset0;
+            md.offset0 = 0;
+            const memory_desc_wrapper mdw(md);
+            const size_t size = mdw.size();
+            if (handle == nullptr || size == 0) continue;
+
+            const char *begin = static_cast<const char *>(handle)
+                    + offset0 * mdw.data_type_size();
+            auto &ranges = arg.second.is_const ? reads : writes;
+            ranges.push_back({begin, begin + size});
+        }
+    }
+
+    ~task_t() { const_cast<primitive_iface_t *>(primitive_iface)->release(); }
+
+    // read-after-write, write-after-read and write-after-write
+    bool depends_on(const task_t &prev) const {
+        return overlap(writes, prev.writes) || overlap(writes, prev.reads)
+                || overlap(reads, prev.writes);
+    }
+
+    const primitive_iface_t *primitive_iface;
+    exec_ctx_t ctx;
+    std::vector<range_t> reads;
+    std::vector<range_t> writes;
+
+    // number of uncompleted tasks this one waits for
+    int ndeps = 0;
+    std::vector<task_t *> successors;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(task_t);
+};
+
+cpu_task_graph_t::cpu_task_graph_t(
+        int max_concurrency, int nthr, int numa_node)
+    : max_concurrency_(nstl::max(1, max_concurrency))
+    , nthr_(nstl::max(1, nthr))
+    , numa_node_(numa_node) {}
+
+cpu_task_graph_t::~cpu_task_graph_t() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    ready_cv_.notify_all();
+    for (auto &w : workers_)
+        w.join();
+}
+
+status_t cpu_task_graph_t::submit(
+        const primitive_iface_t *primitive_iface, const exec_ctx_t &ctx) {
+    std::unique_ptr<task_t> task(new task_t(primitive_iface, ctx));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // The workers are started with the first submission so that the
+        // streams used for the in-order execution only do not hold threads
+        if (workers_.empty()) {
+            for (int i = 0; i < max_concurrency_; ++i)
+                workers_.emplace_back(&cpu_task_graph_t::worker, this);
+        }
+
+        for (auto &prev : tasks_) {
+            if (!task->depends_on(*prev)) continue;
+            prev->successors.push_back(task.get());
+            task->ndeps++;
+        }
+        if (task->ndeps == 0) ready_.push_back(task.get());
+        tasks_.push_back(std::move(task));
+    }
+    ready_cv_.notify_one();
+
+    return status::success;
+}
+
+status_t cpu_task_graph_t::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [&]() { return tasks_.empty(); });
+
+    status_t status = status_;
+    status_ = status::success;
+    return status;
+}
+
+void cpu_task_graph_t::worker() {
+    // The worker threads belong to the stream, so they are bound for good
+    if (numa_node_ >= 0) numa::bind_threads(numa_node_);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        ready_cv_.wait(lock, [&]() { return stop_ || !ready_.empty(); });
+        if (ready_.empty()) return;
+
+        task_t *task = ready_.front();
+        ready_.pop_front();
+        nrunning_++;
+        const int nparallel = nstl::min(
+                max_concurrency_, nrunning_ + (int)ready_.size());
+        const int nthr = nstl::max(1, nthr_ / nparallel);
+
+        lock.unlock();
+        status_t status = run(task, nthr);
+        lock.lock();
+
+        nrunning_--;
+        if (status != status::success && status_ == status::success)
+            status_ = status;
+
+        bool has_ready = false;
+        for (auto *s : task->successors) {
+            if (--s->ndeps > 0) continue;
+            ready_.push_back(s);
+            has_ready = true;
+        }
+        if (has_ready) ready_cv_.notify_all();
+
+        std::unique_ptr<task_t> completed;
+        for (auto it = tasks_.begin(); it != tasks_.end(); ++it) {
+            if (it->get() != task) continue;
+            completed = std::move(*it);
+            tasks_.erase(it);
+            break;
+        }
+        if (tasks_.empty()) done_cv_.notify_all();
+
+        // Releasing the primitive may destroy it, do not hold the lock
+        lock.unlock();
+        completed.reset();
+        lock.lock();
+    }
+}
+
+status_t cpu_task_graph_t::run(task_t *task, int nthr) const {
+    // The limit applies to the calling thread only, so it only affects the
+    // primitives executed by this worker. It caps the parallel regions with
+    // an explicit number of threads as well, as the primitive may have been
+    // created for more threads than it gets.
+    max_threads_limit_scope_t scope(nthr);
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+    status_t status = status::success;
+    tbb::task_arena arena(nthr);
+    arena.execute([&]() {
+        status = task->primitive_iface->execute(task->ctx);
+    });
+    return status;
+#else
+    return task->primitive_iface->execute(task->ctx);
+#endif
+}
+#endif
+
+cpu_stream_t::cpu_stream_t(engine_t *engine, unsigned flags)
+    : stream_t(engine, flags) {
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_THREADPOOL
+    numa_node_ = utils::downcast<cpu_engine_t *>(engine)->numa_node();
+
+    if (flags & stream_flags::out_of_order) {
+        const int max_concurrency
+                = getenv_int("DNNL_CPU_STREAM_MAX_CONCURRENCY", 4);
+        const int nthr = numa_node_ >= 0
+                ? (int)numa::get_node_cpus(numa_node_).size()
+                : dnnl_get_max_threads();
+        task_graph_.reset(
+                new cpu_task_graph_t(max_concurrency, nthr, numa_node_));
+    }
+#endif
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
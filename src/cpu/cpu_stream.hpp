@@ -21,24 +21,107 @@
 
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
+#else
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #endif
 
 #include "common/c_types_map.hpp"
 #include "common/dnnl_thread.hpp"
 #include "common/stream.hpp"
 
+#include "cpu/cpu_numa.hpp"
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_THREADPOOL
+/* Executes the primitives submitted to an out-of-order stream asynchronously.
+ *
+ * A primitive depends on the earlier submitted primitives that have not
+ * completed yet if it writes to the memory they access or reads the memory
+ * they write to. The accessed memory is the address range of each execution
+ * argument: the constant arguments are read, the others are written.
+ *
+ * The primitives whose dependencies have completed are executed by a set of
+ * worker threads. The threads available to the stream are split evenly
+ * between the primitives that run or are ready to run at the same time, so
+ * that independent primitives execute concurrently on disjoint subsets of
+ * the threads. */
+struct cpu_task_graph_t {
+    cpu_task_graph_t(int max_concurrency, int nthr, int numa_node);
+    ~cpu_task_graph_t();
+
+    status_t submit(
+            const primitive_iface_t *primitive_iface, const exec_ctx_t &ctx);
+    // Blocks until all the submitted primitives complete and returns the
+    // first error they reported
+    status_t wait();
+
+private:
+    struct task_t;
+
+    void worker();
+    status_t run(task_t *task, int nthr) const;
+
+    const int max_concurrency_;
+    const int nthr_;
+    const int numa_node_;
+
+    std::mutex mutex_;
+    std::condition_variable ready_cv_;
+    std::condition_variable done_cv_;
+    // Submitted primitives that have not completed, in the submission order
+    std::vector<std::unique_ptr<task_t>> tasks_;
+    std::deque<task_t *> ready_;
+    std::vector<std::thread> workers_;
+    int nrunning_ = 0;
+    bool stop_ = false;
+    status_t status_ = status::success;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(cpu_task_graph_t);
+};
+#endif
+
 struct cpu_stream_t : public stream_t {
-    cpu_stream_t(engine_t *engine, unsigned flags) : stream_t(engine, flags) {}
+    cpu_stream_t(engine_t *engine, unsigned flags);
     virtual ~cpu_stream_t() = default;
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_THREADPOOL
+    dnnl::impl::status_t enqueue_primitive(
+            const primitive_iface_t *primitive_iface,
+            dnnl::impl::exec_ctx_t &ctx) override {
+        if (!task_graph_)
+            return stream_t::enqueue_primitive(primitive_iface, ctx);
+        return task_graph_->submit(primitive_iface, ctx);
+    }
+
+    dnnl::impl::status_t wait() override {
+        // In-order CPU execution is synchronous so return immediately
+        if (!task_graph_) return dnnl::impl::status::success;
+        return task_graph_->wait();
+    }
+
+    bool runs_concurrently() const override { return bool(task_graph_); }
+
+    void before_exec_hook() override {
+        // The out-of-order streams bind their worker threads instead
+        if (numa_node_ >= 0 && !task_graph_)
+            binding_.reset(new numa::thread_binding_t(numa_node_));
+    }
+
+    void after_exec_hook() override { binding_.reset(); }
+#else
     dnnl::impl::status_t wait() override {
         // CPU execution is synchronous so return immediately
         return dnnl::impl::status::success;
     }
+#endif
 
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     cpu_stream_t(engine_t *engine,
@@ -54,6 +137,11 @@ struct cpu_stream_t : public stream_t {
     void after_exec_hook() override {
         threadpool_utils::deactivate_threadpool();
     }
+#else
+private:
+    int numa_node_;
+    std::unique_ptr<numa::thread_binding_t> binding_;
+    std::unique_ptr<cpu_task_graph_t> task_graph_;
 #endif
 };
 
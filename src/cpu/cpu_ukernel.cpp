@@ -0,0 +1,348 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <limits>
+#include <memory>
+
+#include "oneapi/dnnl/dnnl_ukernel.h"
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/primitive.hpp"
+#include "common/primitive_attr.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#if DNNL_X64
+#include "cpu/x64/amx_tile_configure.hpp"
+#include "cpu/x64/brgemm/brgemm_ukernel.hpp"
+#endif
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::utils;
+
+struct dnnl_brgemm : public c_compatible {
+    dnnl_brgemm(const brgemm_desc_t &desc) : desc(desc) {}
+
+    bool with_post_ops() const { return desc.d_dt != data_type::undef; }
+
+    brgemm_desc_t desc;
+    primitive_attr_t attr;
+    // The generated kernel, shared with the other ukernels of the same
+    // parameters through the primitive cache
+    std::shared_ptr<primitive_t> ukernel;
+};
+
+namespace {
+
+#if DNNL_X64
+using ukernel_t = cpu::x64::brgemm_ukernel_t;
+
+const ukernel_t *get_ukernel(const_dnnl_brgemm_t brgemm) {
+    return utils::downcast<const ukernel_t *>(brgemm->ukernel.get());
+}
+
+status_t check_execute_args(const_dnnl_brgemm_t brgemm,
+        dnnl_brgemm_batch_kind_t batch_kind, dim_t batch_size, const void *C,
+        const void *D, const float *scales, const void *scratchpad) {
+    if (any_null(brgemm, C)) return invalid_arguments;
+    if (brgemm->desc.batch_kind != batch_kind) return invalid_arguments;
+    if (batch_size <= 0 || batch_size > std::numeric_limits<int>::max())
+        return invalid_arguments;
+
+    const ukernel_t *ukernel = get_ukernel(brgemm);
+    if (ukernel == nullptr) return invalid_arguments;
+    if (ukernel->pd()->is_amx() && scratchpad == nullptr)
+        return invalid_arguments;
+    if (brgemm->with_post_ops()) {
+        if (D == nullptr) return invalid_arguments;
+        if (ukernel->pd()->brg_.with_scales && scales == nullptr)
+            return invalid_arguments;
+    }
+    return success;
+}
+
+// The kernel loads a vector of scales even if the scale is common to all the
+// columns
+constexpr int max_simd_w = 16;
+const float *get_kernel_scales(const_dnnl_brgemm_t brgemm,
+        const float *scales, float common_scales[max_simd_w]) {
+    const auto &brg = get_ukernel(brgemm)->pd()->brg_;
+    if (!brg.with_scales || brg.is_oc_scale) return scales;
+    for (int i = 0; i < max_simd_w; i++)
+        common_scales[i] = scales[0];
+    return common_scales;
+}
+#endif
+
+template <typename data_t>
+void pack_B(dim_t K, dim_t N, const data_t *B, dim_t ldb, bool trans_b,
+        data_t *B_packed, dim_t ldb_packed) {
+    // Groups of vnni rows are interleaved so that the vnni values of the dot
+    // products of the kernel are contiguous
+    constexpr int vnni = 4 / sizeof(data_t);
+    const dim_t K_groups = div_up(K, vnni);
+
+    parallel_nd(K_groups, ldb_packed, [&](dim_t kg, dim_t n) {
+        data_t *b_packed = &B_packed[(kg * ldb_packed + n) * vnni];
+        for (int i = 0; i < vnni; i++) {
+            const dim_t k = kg * vnni + i;
+            if (k >= K || n >= N)
+                b_packed[i] = 0;
+            else
+                b_packed[i] = trans_b ? B[n * ldb + k] : B[k * ldb + n];
+        }
+    });
+}
+
+} // namespace
+
+status_t dnnl_brgemm_create(dnnl_brgemm_t *brgemm,
+        dnnl_brgemm_batch_kind_t batch_kind, dim_t M, dim_t N, dim_t K,
+        data_type_t a_dt, dim_t lda, data_type_t b_dt, dim_t ldb,
+        data_type_t c_dt, dim_t ldc, float alpha, float beta) {
+    if (brgemm == nullptr) return invalid_arguments;
+    if (!one_of(batch_kind, dnnl_brgemm_batch_addr, dnnl_brgemm_batch_offs,
+                dnnl_brgemm_batch_strd))
+        return invalid_arguments;
+    if (M <= 0 || N <= 0 || K <= 0) return invalid_arguments;
+    if (lda < K || ldb < N || ldc < N) return invalid_arguments;
+
+    brgemm_desc_t desc = brgemm_desc_t();
+    desc.primitive_kind = primitive_kind::brgemm;
+    desc.batch_kind = batch_kind;
+    desc.M = M;
+    desc.N = N;
+    desc.K = K;
+    desc.a_dt = a_dt;
+    desc.b_dt = b_dt;
+    desc.c_dt = c_dt;
+    desc.d_dt = data_type::undef;
+    desc.bias_dt = data_type::undef;
+    desc.lda = lda;
+    desc.ldb = ldb;
+    desc.ldc = ldc;
+    desc.ldd = ldc;
+    desc.stride_a = 0;
+    desc.stride_b = 0;
+    desc.alpha = alpha;
+    desc.beta = beta;
+
+    return safe_ptr_assign<dnnl_brgemm>(*brgemm, new dnnl_brgemm(desc));
+}
+
+status_t dnnl_brgemm_set_batch_strides(
+        dnnl_brgemm_t brgemm, dim_t stride_a, dim_t stride_b) {
+    if (brgemm == nullptr) return invalid_arguments;
+    if (brgemm->desc.batch_kind != dnnl_brgemm_batch_strd)
+        return invalid_arguments;
+
+    brgemm->desc.stride_a = stride_a;
+    brgemm->desc.stride_b = stride_b;
+    brgemm->ukernel.reset();
+    return success;
+}
+
+status_t dnnl_brgemm_set_post_ops(dnnl_brgemm_t brgemm, data_type_t d_dt,
+        dim_t ldd, data_type_t bias_dt, const primitive_attr_t *attr) {
+    if (brgemm == nullptr) return invalid_arguments;
+    if (d_dt == data_type::undef || ldd < brgemm->desc.N)
+        return invalid_arguments;
+
+    primitive_attr_t new_attr;
+    if (attr != nullptr) CHECK(new_attr.copy_from(*attr));
+    CHECK(brgemm->attr.copy_from(new_attr));
+
+    brgemm->desc.d_dt = d_dt;
+    brgemm->desc.ldd = ldd;
+    brgemm->desc.bias_dt = bias_dt;
+    brgemm->ukernel.reset();
+    return success;
+}
+
+status_t dnnl_brgemm_generate(dnnl_brgemm_t brgemm) {
+    if (brgemm == nullptr) return invalid_arguments;
+#if DNNL_X64
+    ukernel_t::pd_t pd(&brgemm->desc, &brgemm->attr);
+    if (!pd.is_initialized()) return out_of_memory;
+    CHECK(pd.init(nullptr));
+
+    // The ukernels are not bound to an engine
+    std::pair<std::shared_ptr<primitive_t>, bool> p;
+    CHECK(pd.create_primitive(p, nullptr));
+    brgemm->ukernel = p.first;
+    return success;
+#else
+    return unimplemented;
+#endif
+}
+
+status_t dnnl_brgemm_get_scratchpad_size(
+        const_dnnl_brgemm_t brgemm, size_t *size) {
+    if (any_null(brgemm, size)) return invalid_arguments;
+#if DNNL_X64
+    const ukernel_t *ukernel = get_ukernel(brgemm);
+    if (ukernel == nullptr) return invalid_arguments;
+    // The AMX kernels store the accumulators of a tile to convert them
+    *size = ukernel->pd()->is_amx() ? 1024 : 0;
+    return success;
+#else
+    return unimplemented;
+#endif
+}
+
+status_t dnnl_brgemm_set_hw_context(const_dnnl_brgemm_t brgemm) {
+    if (brgemm == nullptr) return invalid_arguments;
+#if DNNL_X64
+    const ukernel_t *ukernel = get_ukernel(brgemm);
+    if (ukernel == nullptr) return invalid_arguments;
+    if (ukernel->pd()->is_amx())
+        cpu::x64::amx_tile_configure(ukernel->palette());
+    return success;
+#else
+    return unimplemented;
+#endif
+}
+
+status_t dnnl_brgemm_release_hw_context() {
+#if DNNL_X64
+    using namespace cpu::x64;
+    if (mayiuse(amx_tile)) amx_tile_release();
+    return success;
+#else
+    return unimplemented;
+#endif
+}
+
+status_t dnnl_brgemm_execute_addr(const_dnnl_brgemm_t brgemm,
+        dim_t batch_size, const void **A_addrs, const void **B_addrs, void *C,
+        void *D, const void *bias, const float *scales, void *scratchpad) {
+#if DNNL_X64
+    using namespace cpu::x64;
+    CHECK(check_execute_args(brgemm, dnnl_brgemm_batch_addr, batch_size, C, D,
+            scales, scratchpad));
+    if (any_null(A_addrs, B_addrs)) return invalid_arguments;
+
+    const brgemm_kernel_t *kernel = get_ukernel(brgemm)->kernel();
+    float common_scales[max_simd_w];
+    scales = get_kernel_scales(brgemm, scales, common_scales);
+    if (brgemm->with_post_ops())
+        brgemm_kernel_execute_postops(kernel, (int)batch_size, A_addrs,
+                B_addrs, C, D, bias, scales, scratchpad);
+    else
+        brgemm_kernel_execute(
+                kernel, (int)batch_size, A_addrs, B_addrs, C, scratchpad);
+    return success;
+#else
+    return unimplemented;
+#endif
+}
+
+status_t dnnl_brgemm_execute_offs(const_dnnl_brgemm_t brgemm,
+        dim_t batch_size, const void *A, const dim_t *A_offsets, const void *B,
+        const dim_t *B_offsets, void *C, void *D, const void *bias,
+        const float *scales, void *scratchpad) {
+#if DNNL_X64
+    using namespace cpu::x64;
+    CHECK(check_execute_args(brgemm, dnnl_brgemm_batch_offs, batch_size, C, D,
+            scales, scratchpad));
+    if (any_null(A, A_offsets, B, B_offsets)) return invalid_arguments;
+
+    const brgemm_kernel_t *kernel = get_ukernel(brgemm)->kernel();
+    float common_scales[max_simd_w];
+    scales = get_kernel_scales(brgemm, scales, common_scales);
+    if (brgemm->with_post_ops())
+        brgemm_kernel_execute_postops(kernel, (int)batch_size, A, A_offsets,
+                B, B_offsets, C, D, bias, scales, scratchpad);
+    else
+        brgemm_kernel_execute(kernel, (int)batch_size, A, A_offsets, B,
+                B_offsets, C, scratchpad);
+    return success;
+#else
+    return unimplemented;
+#endif
+}
+
+status_t dnnl_brgemm_execute_strd(const_dnnl_brgemm_t brgemm,
+        dim_t batch_size, const void *A, const void *B, void *C, void *D,
+        const void *bias, const float *scales, void *scratchpad) {
+#if DNNL_X64
+    using namespace cpu::x64;
+    CHECK(check_execute_args(brgemm, dnnl_brgemm_batch_strd, batch_size, C, D,
+            scales, scratchpad));
+    if (any_null(A, B)) return invalid_arguments;
+
+    const brgemm_kernel_t *kernel = get_ukernel(brgemm)->kernel();
+    float common_scales[max_simd_w];
+    scales = get_kernel_scales(brgemm, scales, common_scales);
+    if (brgemm->with_post_ops())
+        brgemm_kernel_execute_postops(kernel, (int)batch_size, A, B, C, D,
+                bias, scales, scratchpad);
+    else
+        brgemm_kernel_execute(kernel, (int)batch_size, A, B, C, scratchpad);
+    return success;
+#else
+    return unimplemented;
+#endif
+}
+
+status_t dnnl_brgemm_destroy(dnnl_brgemm_t brgemm) {
+    delete brgemm;
+    return success;
+}
+
+status_t dnnl_brgemm_get_B_packed_size(
+        data_type_t b_dt, dim_t K, dim_t ldb_packed, size_t *size) {
+    if (size == nullptr || K <= 0 || ldb_packed <= 0)
+        return invalid_arguments;
+    if (!one_of(b_dt, data_type::f32, data_type::bf16, data_type::s8,
+                data_type::u8))
+        return invalid_arguments;
+
+    const size_t typesize = types::data_type_size(b_dt);
+    const dim_t vnni = 4 / typesize;
+    *size = rnd_up(K, vnni) * ldb_packed * typesize;
+    return success;
+}
+
+status_t dnnl_brgemm_pack_B(data_type_t b_dt, dim_t K, dim_t N, const void *B,
+        dim_t ldb, char trans_b, void *B_packed, dim_t ldb_packed) {
+    if (any_null(B, B_packed)) return invalid_arguments;
+    if (K <= 0 || N <= 0 || ldb_packed < N) return invalid_arguments;
+    if (!one_of(trans_b, 'N', 'n', 'T', 't')) return invalid_arguments;
+    const bool trans = one_of(trans_b, 'T', 't');
+    if (ldb < (trans ? K : N)) return invalid_arguments;
+
+    // The values are only moved, hence the types of their size
+    switch (b_dt) {
+        case data_type::f32:
+            pack_B(K, N, (const uint32_t *)B, ldb, trans, (uint32_t *)B_packed,
+                    ldb_packed);
+            break;
+        case data_type::bf16:
+            pack_B(K, N, (const uint16_t *)B, ldb, trans, (uint16_t *)B_packed,
+                    ldb_packed);
+            break;
+        case data_type::s8:
+        case data_type::u8:
+            pack_B(K, N, (const uint8_t *)B, ldb, trans, (uint8_t *)B_packed,
+                    ldb_packed);
+            break;
+        default: return invalid_arguments;
+    }
+    return success;
+}
@@ -14,8 +14,14 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <vector>
+
 #include "oneapi/dnnl/dnnl.h"
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#include "oneapi/dnnl/dnnl_threadpool.h"
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
 #endif
 
@@ -28,6 +34,7 @@
 
 #include "cpu/gemm/gemm.hpp"
 #include "cpu/gemm/gemm_msan_unpoison.hpp"
+#include "cpu/gemm/gemm_pack.hpp"
 #include "cpu/gemm/os_blas.hpp"
 
 #include "cpu/gemm/f32/ref_gemm_f32.hpp"
@@ -252,6 +259,167 @@ dnnl_status_t gemm_bf16bf16f32(const char *transa, const char *transb,
     return dnnl_unimplemented;
 }
 
+namespace {
+// Block of columns of C of a GEMM of a group, the unit of the work
+// distribution between the threads
+struct grouped_gemm_block_t {
+    dim_t gemm;
+    dim_t off_n, n;
+    double work;
+};
+
+// Matrix A shared by several GEMMs of a group and packed once
+struct grouped_gemm_pack_t {
+    const float *a;
+    dim_t m, k, lda;
+    dim_t max_n; // The largest N of the GEMMs sharing the matrix
+    dim_t ngemms;
+    float *packed;
+};
+} // namespace
+
+dnnl_status_t grouped_sgemm(const char *transa, const char *transb,
+        dim_t group_size, const dim_t *M, const dim_t *N, const dim_t *K,
+        const float *alpha, const float *const *A, const dim_t *lda,
+        const float *const *B, const dim_t *ldb, const float *beta,
+        float *const *C, const dim_t *ldc) {
+    if (utils::any_null(transa, transb, alpha, beta) || group_size < 0)
+        return dnnl_invalid_arguments;
+    if (group_size == 0) return dnnl_success;
+    if (utils::any_null(M, N, K, A, lda, B, ldb, C, ldc))
+        return dnnl_invalid_arguments;
+    // The matrices of a group cannot be packed by the user
+    if (!utils::one_of(*transa, 'N', 'n', 'T', 't')
+            || !utils::one_of(*transb, 'N', 'n', 'T', 't'))
+        return dnnl_invalid_arguments;
+
+    for (dim_t g = 0; g < group_size; g++) {
+        dnnl_status_t status = check_gemm_input(transa, transb, &M[g], &N[g],
+                &K[g], A[g], &lda[g], B[g], &ldb[g], C[g], &ldc[g], alpha,
+                beta, false);
+        if (status != dnnl_success) return status;
+    }
+
+    const bool is_trans_b = utils::one_of(*transb, 'T', 't');
+
+    // Find the matrices A shared by several GEMMs. The packed matrices have
+    // no alpha argument, so only the products with alpha equal to 1 can use
+    // them.
+    std::vector<dim_t> pack_idx(group_size, -1);
+    std::vector<grouped_gemm_pack_t> packs;
+    if (*alpha == 1.0f && pack_sgemm_supported()) {
+        using pack_key_t = std::tuple<const float *, dim_t, dim_t, dim_t>;
+        std::map<pack_key_t, dim_t> pack_map;
+        for (dim_t g = 0; g < group_size; g++) {
+            if (M[g] == 0 || N[g] == 0 || K[g] == 0) continue;
+            auto key = pack_key_t(A[g], M[g], K[g], lda[g]);
+            auto it = pack_map.find(key);
+            if (it == pack_map.end()) {
+                it = pack_map.emplace(key, (dim_t)packs.size()).first;
+                packs.push_back(
+                        {A[g], M[g], K[g], lda[g], N[g], 0, nullptr});
+            }
+            auto &pack = packs[it->second];
+            pack.max_n = nstl::max(pack.max_n, N[g]);
+            pack.ngemms++;
+            pack_idx[g] = it->second;
+        }
+        for (dim_t g = 0; g < group_size; g++)
+            if (pack_idx[g] >= 0 && packs[pack_idx[g]].ngemms < 2)
+                pack_idx[g] = -1;
+    }
+
+    // Split the GEMMs into blocks of columns of C, so that each thread gets
+    // several blocks of about the same amount of work.
+    const int nthr = dnnl_get_current_num_threads();
+    double total_work = 0;
+    for (dim_t g = 0; g < group_size; g++)
+        total_work += (double)M[g] * N[g] * nstl::max(K[g], dim_t(1));
+    if (total_work == 0) return dnnl_success;
+
+    constexpr dim_t min_block_n = 16;
+    const double block_work = total_work / (4 * nthr);
+    std::vector<grouped_gemm_block_t> blocks;
+    for (dim_t g = 0; g < group_size; g++) {
+        if (M[g] == 0 || N[g] == 0) continue;
+        double work = (double)M[g] * N[g] * nstl::max(K[g], dim_t(1));
+        dim_t nblocks = nstl::min((dim_t)std::ceil(work / block_work),
+                utils::div_up(N[g], min_block_n));
+        nblocks = nstl::max(nblocks, dim_t(1));
+        dim_t block_n = utils::div_up(N[g], nblocks);
+        for (dim_t off_n = 0; off_n < N[g]; off_n += block_n) {
+            dim_t n = nstl::min(block_n, N[g] - off_n);
+            blocks.push_back({g, off_n, n, work * n / N[g]});
+        }
+    }
+
+    std::vector<dnnl_status_t> thr_status(nthr, dnnl_success);
+
+    // Pack the shared matrices. The size is queried by the packing thread,
+    // since the layout of a packed matrix depends on the number of threads
+    // available to the caller.
+    const char *pack_id = "A";
+    parallel(nthr, [&](int ithr, int nthr_eff) {
+        for (size_t p = ithr; p < packs.size(); p += nthr_eff) {
+            auto &pack = packs[p];
+            if (pack.ngemms < 2) continue;
+            const dim_t ldb_pack = is_trans_b ? pack.max_n : pack.k;
+            size_t size = 0;
+            bool do_pack = true;
+            dnnl_status_t st = sgemm_pack_get_size(pack_id, transa, transb,
+                    &pack.m, &pack.max_n, &pack.k, &pack.lda, &ldb_pack,
+                    &size, &do_pack);
+            if (st != dnnl_success || !do_pack) continue;
+            pack.packed = (float *)malloc(size, 64);
+            if (!pack.packed) continue;
+            st = sgemm_pack(pack_id, transa, transb, &pack.m, &pack.max_n,
+                    &pack.k, &pack.lda, &ldb_pack, pack.a, pack.packed);
+            if (st != dnnl_success) {
+                free(pack.packed);
+                pack.packed = nullptr;
+            }
+        }
+    });
+
+    // Distribute the blocks by their work: the block goes to the thread the
+    // middle of its work falls to.
+    std::vector<double> work_mid(blocks.size());
+    double work_acc = 0;
+    for (size_t b = 0; b < blocks.size(); b++) {
+        work_mid[b] = work_acc + blocks[b].work / 2;
+        work_acc += blocks[b].work;
+    }
+
+    parallel(nthr, [&](int ithr, int nthr_eff) {
+        for (size_t b = 0; b < blocks.size(); b++) {
+            if ((int)(work_mid[b] * nthr_eff / work_acc) != ithr) continue;
+            const auto &blk = blocks[b];
+            const dim_t g = blk.gemm;
+            const float *b_blk
+                    = B[g] + (is_trans_b ? blk.off_n : blk.off_n * ldb[g]);
+            float *c_blk = C[g] + blk.off_n * ldc[g];
+            dim_t n = blk.n;
+
+            const float *packed
+                    = pack_idx[g] >= 0 ? packs[pack_idx[g]].packed : nullptr;
+            dnnl_status_t st = packed
+                    ? sgemm_compute("P", transb, &M[g], &n, &K[g], packed,
+                            &lda[g], b_blk, &ldb[g], beta, c_blk, &ldc[g])
+                    : extended_sgemm(transa, transb, &M[g], &n, &K[g], alpha,
+                            A[g], &lda[g], b_blk, &ldb[g], beta, c_blk,
+                            &ldc[g]);
+            if (st != dnnl_success) thr_status[ithr] = st;
+        }
+    });
+
+    for (auto &pack : packs)
+        if (pack.packed) free(pack.packed);
+
+    for (auto st : thr_status)
+        if (st != dnnl_success) return st;
+    return dnnl_success;
+}
+
 } // namespace cpu
 } // namespace impl
 } // namespace dnnl
@@ -266,6 +434,14 @@ dnnl_status_t dnnl_sgemm(char transa, char transb, dim_t M, dim_t N, dim_t K,
             &lda, &beta, C, &ldc);
 }
 
+dnnl_status_t dnnl_sgemm_grouped(char transa, char transb, dim_t group_size,
+        const dim_t *M, const dim_t *N, const dim_t *K, float alpha,
+        const float *const *A, const dim_t *lda, const float *const *B,
+        const dim_t *ldb, float beta, float *const *C, const dim_t *ldc) {
+    return grouped_sgemm(&transb, &transa, group_size, N, M, K, &alpha, B, ldb,
+            A, lda, &beta, C, ldc);
+}
+
 namespace {
 const char *c2f_offsetC(const char *offC) {
     if (offC) {
@@ -292,12 +468,46 @@ dnnl_status_t dnnl_gemm_s8s8s32(char transa, char transb, char offsetc, dim_t M,
             &K, &alpha, B, &ldb, &bo, A, &lda, &ao, &beta, C, &ldc, co);
 }
 
-extern "C" dnnl_status_t DNNL_API dnnl_gemm_bf16bf16f32(char transa,
-        char transb, dim_t M, dim_t N, dim_t K, float alpha,
-        const bfloat16_t *A, dim_t lda, const bfloat16_t *B, dim_t ldb,
-        float beta, float *C, dim_t ldc) {
-    return gemm_bf16bf16f32(&transb, &transa, &N, &M, &K, &alpha, B, &ldb, A,
-            &lda, &beta, C, &ldc);
+dnnl_status_t dnnl_gemm_bf16bf16f32(char transa, char transb, dim_t M,
+        dim_t N, dim_t K, float alpha, const uint16_t *A, dim_t lda,
+        const uint16_t *B, dim_t ldb, float beta, float *C, dim_t ldc) {
+    return gemm_bf16bf16f32(&transb, &transa, &N, &M, &K, &alpha,
+            (const bfloat16_t *)B, &ldb, (const bfloat16_t *)A, &lda, &beta, C,
+            &ldc);
+}
+
+namespace {
+// The packing routines use Fortran notation, where the matrices A and B of a
+// row-major product are swapped
+const char *c2f_identifier(char identifier) {
+    if (identifier == 'A' || identifier == 'a') return "B";
+    if (identifier == 'B' || identifier == 'b') return "A";
+    return "?";
+}
+} // namespace
+
+dnnl_status_t dnnl_gemm_bf16bf16f32_pack_get_size(char identifier,
+        char transa, char transb, dim_t M, dim_t N, dim_t K, dim_t lda,
+        dim_t ldb, size_t *size) {
+    if (size == nullptr) return dnnl_invalid_arguments;
+    return gemm_bf16bf16f32_pack_get_size(c2f_identifier(identifier), &transb,
+            &transa, &N, &M, &K, &ldb, &lda, size);
+}
+
+dnnl_status_t dnnl_gemm_bf16bf16f32_pack(char identifier, char transa,
+        char transb, dim_t M, dim_t N, dim_t K, dim_t lda, dim_t ldb,
+        const uint16_t *src, uint16_t *dst) {
+    return gemm_bf16bf16f32_pack(c2f_identifier(identifier), &transb, &transa,
+            &N, &M, &K, &ldb, &lda, (const bfloat16_t *)src,
+            (bfloat16_t *)dst);
+}
+
+dnnl_status_t dnnl_gemm_bf16bf16f32_compute(char transa, char transb,
+        dim_t M, dim_t N, dim_t K, const uint16_t *A, dim_t lda,
+        const uint16_t *B, dim_t ldb, float beta, float *C, dim_t ldc) {
+    return gemm_bf16bf16f32_compute(&transb, &transa, &N, &M, &K,
+            (const bfloat16_t *)B, &ldb, (const bfloat16_t *)A, &lda, &beta, C,
+            &ldc);
 }
 
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
@@ -338,14 +548,28 @@ dnnl_status_t dnnl_threadpool_interop_gemm_s8s8s32(char transa, char transb,
     return status;
 }
 
-extern "C" dnnl_status_t DNNL_API dnnl_threadpool_interop_gemm_bf16bf16f32(
-        char transa, char transb, dim_t M, dim_t N, dim_t K, float alpha,
-        const bfloat16_t *A, dim_t lda, const bfloat16_t *B, dim_t ldb,
-        float beta, float *C, dim_t ldc, void *th) {
+dnnl_status_t dnnl_threadpool_interop_gemm_bf16bf16f32(char transa,
+        char transb, dim_t M, dim_t N, dim_t K, float alpha, const uint16_t *A,
+        dim_t lda, const uint16_t *B, dim_t ldb, float beta, float *C,
+        dim_t ldc, void *th) {
+    threadpool_utils::activate_threadpool(
+            (dnnl::threadpool_interop::threadpool_iface *)th);
+    status_t status = gemm_bf16bf16f32(&transb, &transa, &N, &M, &K, &alpha,
+            (const bfloat16_t *)B, &ldb, (const bfloat16_t *)A, &lda, &beta, C,
+            &ldc);
+    threadpool_utils::deactivate_threadpool();
+    return status;
+}
+
+dnnl_status_t dnnl_threadpool_interop_sgemm_grouped(char transa, char transb,
+        dim_t group_size, const dim_t *M, const dim_t *N, const dim_t *K,
+        float alpha, const float *const *A, const dim_t *lda,
+        const float *const *B, const dim_t *ldb, float beta, float *const *C,
+        const dim_t *ldc, void *th) {
     threadpool_utils::activate_threadpool(
             (dnnl::threadpool_interop::threadpool_iface *)th);
-    status_t status = gemm_bf16bf16f32(&transb, &transa, &N, &M, &K, &alpha, B,
-            &ldb, A, &lda, &beta, C, &ldc);
+    status_t status = grouped_sgemm(&transb, &transa, group_size, N, M, K,
+            &alpha, B, ldb, A, lda, &beta, C, ldc);
     threadpool_utils::deactivate_threadpool();
     return status;
 }
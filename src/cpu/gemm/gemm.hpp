@@ -51,6 +51,15 @@ dnnl_status_t gemm_bf16bf16f32(const char *transa, const char *transb,
         const bfloat16_t *A, const dim_t *lda, const bfloat16_t *B,
         const dim_t *ldb, const float *beta, float *C, const dim_t *ldc);
 
+// Computes a group of GEMMs of different sizes with a single distribution of
+// the work between the threads. The GEMMs sharing the same matrix A reuse a
+// single packed copy of it if alpha is 1.
+dnnl_status_t grouped_sgemm(const char *transa, const char *transb,
+        dim_t group_size, const dim_t *M, const dim_t *N, const dim_t *K,
+        const float *alpha, const float *const *A, const dim_t *lda,
+        const float *const *B, const dim_t *ldb, const float *beta,
+        float *const *C, const dim_t *ldc);
+
 #if defined(USE_CBLAS)
 #define GEMM_IMPL_STR "gemm:blas"
 #elif DNNL_X64
@@ -21,6 +21,13 @@
 #include "cpu/matmul/gemm_x8s8s32x_matmul.hpp"
 #include "cpu/matmul/ref_matmul.hpp"
 
+#if DNNL_X64
+#include "cpu/x64/matmul/brgemm_decompress_matmul.hpp"
+#include "cpu/x64/matmul/brgemm_matmul.hpp"
+#include "cpu/x64/matmul/brgemm_sparse_matmul.hpp"
+using namespace dnnl::impl::cpu::x64;
+#endif
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
@@ -31,17 +38,45 @@ namespace {
 using namespace dnnl::impl::data_type;
 
 #define INSTANCE(...) &primitive_desc_t::create<__VA_ARGS__::pd_t>
+// clang-format off
 const pd_create_f impl_list[] = {
+        CPU_INSTANCE_X64(x64::matmul::brgemm_decompress_matmul_t<avx512_core, f32>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_sparse_matmul_t<avx512_core, f32>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core, f32>)
         INSTANCE(matmul::gemm_f32_matmul_t),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_decompress_matmul_t<avx512_core_bf16, bf16, f32>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_sparse_matmul_t<avx512_core_bf16, bf16, bf16, f32>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_bf16, bf16, bf16, f32>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16, bf16, bf16, f32>)
         INSTANCE(matmul::gemm_bf16_matmul_t<f32>),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_decompress_matmul_t<avx512_core_bf16, bf16>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_sparse_matmul_t<avx512_core_bf16, bf16>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_bf16, bf16>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16, bf16>)
         INSTANCE(matmul::gemm_bf16_matmul_t<bf16>),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_int8, s8, s8, f32>)
         INSTANCE(matmul::gemm_x8s8s32x_matmul_t<s8, s8, f32>),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_int8, s8, s8, s32>)
         INSTANCE(matmul::gemm_x8s8s32x_matmul_t<s8, s8, s32>),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_int8, s8, s8, s8>)
         INSTANCE(matmul::gemm_x8s8s32x_matmul_t<s8, s8, s8>),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_int8, s8, s8, u8>)
         INSTANCE(matmul::gemm_x8s8s32x_matmul_t<s8, s8, u8>),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_sparse_matmul_t<avx512_core_vnni, u8, s8, f32>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_int8, u8, s8, f32>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_vnni, u8, s8, f32>)
         INSTANCE(matmul::gemm_x8s8s32x_matmul_t<u8, s8, f32>),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_sparse_matmul_t<avx512_core_vnni, u8, s8, s32>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_int8, u8, s8, s32>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_vnni, u8, s8, s32>)
         INSTANCE(matmul::gemm_x8s8s32x_matmul_t<u8, s8, s32>),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_sparse_matmul_t<avx512_core_vnni, u8, s8, s8>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_int8, u8, s8, s8>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_vnni, u8, s8, s8>)
         INSTANCE(matmul::gemm_x8s8s32x_matmul_t<u8, s8, s8>),
+        CPU_INSTANCE_X64(x64::matmul::brgemm_sparse_matmul_t<avx512_core_vnni, u8, s8, u8>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_bf16_amx_int8, u8, s8, u8>)
+        CPU_INSTANCE_X64(x64::matmul::brgemm_matmul_t<avx512_core_vnni, u8, s8, u8>)
         INSTANCE(matmul::gemm_x8s8s32x_matmul_t<u8, s8, u8>),
         INSTANCE(matmul::ref_matmul_t<f32>),
         INSTANCE(matmul::ref_matmul_t<bf16, bf16, f32, f32>),
@@ -57,6 +92,7 @@ const pd_create_f impl_list[] = {
         /* eol */
         nullptr,
 };
+// clang-format on
 #undef INSTANCE
 } // namespace
 
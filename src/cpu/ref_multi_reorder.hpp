@@ -0,0 +1,129 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_REF_MULTI_REORDER_HPP
+#define CPU_REF_MULTI_REORDER_HPP
+
+#include "common/engine.hpp"
+#include "common/primitive.hpp"
+#include "common/reorder_pd.hpp"
+#include "common/stream.hpp"
+
+#include "cpu/cpu_multi_reorder_pd.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+/* Executes a separate reorder per destination, so the source is read as many
+ * times as there are destinations. */
+struct ref_multi_reorder_t : public primitive_t {
+    struct pd_t : public cpu_multi_reorder_pd_t {
+        using cpu_multi_reorder_pd_t::cpu_multi_reorder_pd_t;
+        pd_t(const pd_t &rhs) : cpu_multi_reorder_pd_t(rhs) { copy(rhs); }
+        ~pd_t() = default;
+
+        DECLARE_MULTI_REORDER_PD_T("ref:any", ref_multi_reorder_t);
+
+        status_t init(engine_t *engine) {
+            using sm = primitive_attr_t::skip_mask_t;
+            bool ok = attr()->has_default_values(
+                    sm::oscale_runtime | sm::post_ops);
+            if (!ok) return status::unimplemented;
+
+            for (int i = 0; i < n_; ++i) {
+                auto r_impls = engine->get_reorder_implementation_list(
+                        src_md(), dst_md(i));
+                for (auto r = r_impls; *r; ++r) {
+                    primitive_attr_t r_attr(*attr());
+                    r_attr.set_scratchpad_mode(scratchpad_mode::user);
+                    reorder_pd_t *r_pd = nullptr;
+
+                    if ((*r)(&r_pd, engine, &r_attr, engine, src_md(), engine,
+                                dst_md(i))
+                            == status::success) {
+                        reorder_pds_.emplace_back(r_pd);
+                        break;
+                    }
+                }
+            }
+            if (reorder_pds_.size() != (size_t)n_) return status::unimplemented;
+
+            init_scratchpad();
+            return status::success;
+        }
+
+        std::vector<std::unique_ptr<primitive_desc_t>> reorder_pds_;
+
+    private:
+        void copy(const pd_t &rhs) {
+            for (size_t i = 0; i < rhs.reorder_pds_.size(); ++i)
+                reorder_pds_.emplace_back(rhs.reorder_pds_[i]->clone());
+        }
+
+        void init_scratchpad() {
+            using namespace memory_tracking::names;
+            auto scratchpad = scratchpad_registry().registrar();
+            for (size_t i = 0; i < reorder_pds_.size(); i++) {
+                scratchpad.book(key_nested_multiple + (int)i,
+                        reorder_pds_[i]->scratchpad_registry());
+            }
+        }
+    };
+
+    ref_multi_reorder_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override {
+        const size_t n = pd()->reorder_pds_.size();
+        reorders_.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            CHECK(pd()->reorder_pds_[i]->create_primitive(
+                    reorders_[i], engine));
+        return status::success;
+    }
+
+    ~ref_multi_reorder_t() = default;
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        using namespace memory_tracking::names;
+        const auto &args = ctx.args();
+        const auto scales_it = args.find(DNNL_ARG_ATTR_OUTPUT_SCALES);
+
+        for (int i = 0; i < pd()->n_outputs(); ++i) {
+            exec_args_t r_args;
+            r_args[DNNL_ARG_SRC] = args.at(DNNL_ARG_FROM);
+            r_args[DNNL_ARG_DST] = args.at(DNNL_ARG_MULTIPLE_DST + i);
+            if (scales_it != args.end())
+                r_args[DNNL_ARG_ATTR_OUTPUT_SCALES] = scales_it->second;
+            exec_ctx_t r_ctx(ctx, std::move(r_args));
+
+            nested_scratchpad_t ns(ctx, key_nested_multiple + i, reorders_[i]);
+            r_ctx.set_scratchpad_grantor(ns.grantor());
+            CHECK(reorders_[i]->execute(r_ctx));
+        }
+        return status::success;
+    }
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+    std::vector<std::shared_ptr<primitive_t>> reorders_;
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
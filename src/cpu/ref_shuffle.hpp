@@ -75,6 +75,7 @@ struct ref_shuffle_t : public primitive_t {
         rev_transposed_ = (int *)malloc(
                 axis_size * sizeof(int), platform::get_cache_line_size());
         if (rev_transposed_ == nullptr) return dnnl_out_of_memory;
+        add_primitive_creation_footprint(axis_size * sizeof(int));
         parallel_nd(transpose_col, transpose_row, [&](int i, int j) {
             rev_transposed_[j * transpose_col + i] = i * transpose_row + j;
         });
@@ -0,0 +1,170 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_SPARSE_REORDER_HPP
+#define CPU_SPARSE_REORDER_HPP
+
+#include "common/dnnl_thread.hpp"
+#include "common/primitive.hpp"
+#include "common/primitive_desc.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_reorder_pd.hpp"
+#include "cpu/simple_q10n.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// Packs plain 2D weights into the block-sparse (bcsr) format. A block is
+// stored only if it has a non-zero element after the conversion. The reorder
+// fails with invalid_arguments if the weights have more non-zero blocks than
+// the destination memory descriptor can hold.
+template <data_type_t type_i, data_type_t type_o>
+struct sparse_reorder_t : public primitive_t {
+    struct pd_t : public cpu_reorder_pd_t {
+        using cpu_reorder_pd_t::cpu_reorder_pd_t;
+
+        DECLARE_COMMON_PD_T("sparse_reorder", sparse_reorder_t);
+
+        static status_t create(reorder_pd_t **reorder_pd, engine_t *engine,
+                const primitive_attr_t *attr, engine_t *src_engine,
+                const memory_desc_t *src_md, engine_t *dst_engine,
+                const memory_desc_t *dst_md) {
+            const memory_desc_wrapper id(src_md), od(dst_md);
+            bool args_ok = true && id.data_type() == type_i
+                    && od.data_type() == type_o && od.is_sparse_desc()
+                    && od.sparse_desc().encoding == sparse_encoding::bcsr
+                    && id.ndims() == 2 && id.is_blocking_desc()
+                    && id.blocking_desc().inner_nblks == 0
+                    && !id.has_runtime_dims_or_strides();
+            if (!args_ok) return status::invalid_arguments;
+
+            auto _pd = new pd_t(attr, src_engine->kind(), src_md,
+                    dst_engine->kind(), dst_md);
+            if (_pd == nullptr) return status::out_of_memory;
+            if (_pd->init(engine, src_engine, dst_engine) != status::success) {
+                delete _pd;
+                return status::unimplemented;
+            }
+            _pd->init_scratchpad_md();
+            return safe_ptr_assign(*reorder_pd, _pd);
+        }
+
+        status_t init(
+                engine_t *engine, engine_t *src_engine, engine_t *dst_engine) {
+            status_t status
+                    = cpu_reorder_pd_t::init(engine, src_engine, dst_engine);
+            if (status != status::success) return status;
+
+            bool ok = attr()->has_default_values(
+                              primitive_attr_t::skip_mask_t::oscale)
+                    && attr()->output_scales_.mask_ == 0
+                    && attr()->output_scales_.defined();
+            return ok ? status::success : status::unimplemented;
+        }
+    };
+
+    sparse_reorder_t(const pd_t *apd) : primitive_t(apd) {}
+
+    typedef typename prec_traits<type_i>::type in_data_t;
+    typedef typename prec_traits<type_o>::type out_data_t;
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        auto input = CTX_IN_MEM(const in_data_t *, DNNL_ARG_FROM);
+        auto output = CTX_OUT_MEM(char *, DNNL_ARG_TO);
+
+        const memory_desc_wrapper id(pd()->src_md());
+        const memory_desc_wrapper od(pd()->dst_md());
+        const auto &sd = od.sparse_desc();
+
+        const int oc_dim = sd.oc_dim;
+        const int block_k = sd.block_k;
+        const int block_n = sd.block_n;
+        const dim_t OC = od.dims()[oc_dim];
+        const dim_t nb_n = od.sparse_nb_n();
+        const dim_t nb_k = od.dims()[1 - oc_dim] / block_k;
+        const dim_t stride_oc = id.blocking_desc().strides[oc_dim];
+        const dim_t stride_ic = id.blocking_desc().strides[1 - oc_dim];
+        // the reduction dimension is interleaved within a dword for the
+        // low-precision data types to match the VNNI instructions
+        const int vnni = 4 / (int)sizeof(out_data_t);
+        const float alpha = pd()->attr()->output_scales_.scales_[0];
+
+        input += id.offset0();
+        auto offsets = reinterpret_cast<int32_t *>(output);
+        auto indices = offsets + nb_n + 1;
+        auto values = reinterpret_cast<out_data_t *>(
+                output + od.sparse_values_offset());
+
+        auto convert = [&](dim_t oc, dim_t ic) {
+            const auto in = input[oc * stride_oc + ic * stride_ic];
+            return (out_data_t)qz<in_data_t, out_data_t>()(
+                    in, out_data_t(), alpha, 0.f);
+        };
+
+        auto is_zero_block = [&](dim_t nb, dim_t kb) {
+            const dim_t oc_e = nstl::min(OC, (nb + 1) * block_n);
+            for_(dim_t oc = nb * block_n; oc < oc_e; oc++)
+            for (dim_t ic = kb * block_k; ic < (kb + 1) * block_k; ic++)
+                if ((float)convert(oc, ic) != 0.f) return false;
+            return true;
+        };
+
+        // First pass: count the non-zero blocks in each row of blocks
+        offsets[0] = 0;
+        parallel_nd(nb_n, [&](dim_t nb) {
+            int32_t nnz = 0;
+            for (dim_t kb = 0; kb < nb_k; kb++)
+                nnz += !is_zero_block(nb, kb);
+            offsets[nb + 1] = nnz;
+        });
+        for (dim_t nb = 0; nb < nb_n; nb++)
+            offsets[nb + 1] += offsets[nb];
+        if (offsets[nb_n] > sd.nnz_blocks) return status::invalid_arguments;
+
+        // Second pass: store the indices and the values of non-zero blocks
+        const dim_t block_size = (dim_t)block_k * block_n;
+        parallel_nd(nb_n, [&](dim_t nb) {
+            dim_t pos = offsets[nb];
+            for (dim_t kb = 0; kb < nb_k; kb++) {
+                if (is_zero_block(nb, kb)) continue;
+                indices[pos] = (int32_t)kb;
+                out_data_t *blk = values + pos * block_size;
+                for_(int k = 0; k < block_k; k++)
+                for (int n = 0; n < block_n; n++) {
+                    const dim_t oc = nb * block_n + n;
+                    const int off = (k / vnni) * block_n * vnni + n * vnni
+                            + k % vnni;
+                    blk[off] = oc < OC ? convert(oc, kb * block_k + k)
+                                       : out_data_t(0.f);
+                }
+                pos++;
+            }
+        });
+
+        return status::success;
+    }
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
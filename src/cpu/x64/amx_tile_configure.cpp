@@ -44,11 +44,36 @@ private:
     }
 };
 
+struct jit_amx_tilerelease_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_amx_tilerelease_t)
+
+    jit_amx_tilerelease_t()
+        : jit_generator(nullptr, MAX_CODE_SIZE, true, avx512_core_amx) {
+        create_kernel();
+    }
+
+    void tile_release() const { (*this)(); }
+
+private:
+    void generate() override {
+        preamble();
+
+        tilerelease();
+
+        postamble();
+    }
+};
+
 void amx_tile_configure(const char palette[64]) {
     static const jit_amx_tilecfg_t tilecfg;
     tilecfg.tile_configure(palette);
 };
 
+void amx_tile_release() {
+    static const jit_amx_tilerelease_t tilerelease;
+    tilerelease.tile_release();
+}
+
 } // namespace x64
 } // namespace cpu
 } // namespace impl
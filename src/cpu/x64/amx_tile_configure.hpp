@@ -23,6 +23,7 @@ namespace cpu {
 namespace x64 {
 
 void amx_tile_configure(const char palette[64]);
+void amx_tile_release();
 
 } // namespace x64
 } // namespace cpu
@@ -181,33 +181,57 @@ status_t brgemm_desc_init(brgemm_t *brg, cpu_isa_t isa,
     brg->dt_d = brg->dt_c;
     brg->dt_bias = brg->dt_c;
 
-    if (!IMPLICATION(brg->is_f32, mayiuse(avx512_core)))
-        return status::unimplemented;
-    if (!IMPLICATION(brg->is_bf16, mayiuse(avx512_core_bf16)))
-        return status::unimplemented;
-    if (!IMPLICATION(brg->is_int8, mayiuse(avx512_core_vnni)))
-        return status::unimplemented;
-
-    if (isa != isa_any) {
-        if (!one_of(isa, avx512_core, avx512_core_bf16, avx512_core_vnni,
-                    avx512_core_bf16_amx_bf16, avx512_core_bf16_amx_int8)) {
-            return status::invalid_arguments;
-        }
+    if (one_of(isa, avx2, avx2_vnni)) {
+        // The AVX2 kernels are generated on request only, isa_any stands for
+        // the AVX-512 and AMX ones
+        if (!mayiuse(isa)) return status::invalid_arguments;
+        if (brg->is_bf16) return status::unimplemented;
         brg->is_int8_amx = brg->is_bf16_amx = false;
-        if (brg->is_int8 && isa == avx512_core_bf16_amx_int8) {
-            if (!mayiuse(avx512_core_bf16_amx_int8))
-                return status::invalid_arguments;
-            brg->is_int8_amx = true;
-        }
-        if (brg->is_bf16 && isa == avx512_core_bf16_amx_bf16) {
-            if (!mayiuse(avx512_core_bf16_amx_bf16))
+    } else {
+        if (!IMPLICATION(brg->is_f32, mayiuse(avx512_core)))
+            return status::unimplemented;
+        if (!IMPLICATION(brg->is_bf16, mayiuse(avx512_core_bf16)))
+            return status::unimplemented;
+        if (!IMPLICATION(brg->is_int8, mayiuse(avx512_core_vnni)))
+            return status::unimplemented;
+
+        if (isa != isa_any) {
+            if (!one_of(isa, avx512_core, avx512_core_bf16, avx512_core_vnni,
+                        avx512_core_bf16_amx_bf16,
+                        avx512_core_bf16_amx_int8)) {
                 return status::invalid_arguments;
-            brg->is_bf16_amx = true;
+            }
+            brg->is_int8_amx = brg->is_bf16_amx = false;
+            if (brg->is_int8 && isa == avx512_core_bf16_amx_int8) {
+                if (!mayiuse(avx512_core_bf16_amx_int8))
+                    return status::invalid_arguments;
+                brg->is_int8_amx = true;
+            }
+            if (brg->is_bf16 && isa == avx512_core_bf16_amx_bf16) {
+                if (!mayiuse(avx512_core_bf16_amx_bf16))
+                    return status::invalid_arguments;
+                brg->is_bf16_amx = true;
+            }
+        } else {
+            brg->is_int8_amx
+                    = brg->is_int8 && mayiuse(avx512_core_bf16_amx_int8);
+            brg->is_bf16_amx
+                    = brg->is_bf16 && mayiuse(avx512_core_bf16_amx_bf16);
         }
-    } else {
-        brg->is_int8_amx = brg->is_int8 && mayiuse(avx512_core_bf16_amx_int8);
-        brg->is_bf16_amx = brg->is_bf16 && mayiuse(avx512_core_bf16_amx_bf16);
     }
+    // The ISA the kernel is generated for
+    if (one_of(isa, avx2, avx2_vnni))
+        brg->isa = isa;
+    else if (brg->is_int8_amx)
+        brg->isa = avx512_core_bf16_amx_int8;
+    else if (brg->is_bf16_amx)
+        brg->isa = avx512_core_bf16_amx_bf16;
+    else if (brg->is_int8)
+        brg->isa = avx512_core_vnni;
+    else if (brg->is_bf16)
+        brg->isa = avx512_core_bf16;
+    else
+        brg->isa = avx512_core;
     brg->req_s8s8_compensation
             = brg->is_int8 && !brg->is_int8_amx && brg->dt_a == data_type::s8;
     brg->LDA = (is_row_major()) ? (int)LDA : (int)LDB;
@@ -225,6 +249,7 @@ status_t brgemm_desc_init(brgemm_t *brg, cpu_isa_t isa,
     brg->with_sum = false;
     brg->sum_scale = 0;
     brg->with_scales = false;
+    brg->is_oc_scale = 0;
 
     brg->beta = beta;
     brg->alpha = alpha;
@@ -241,7 +266,43 @@ status_t brgemm_desc_init(brgemm_t *brg, cpu_isa_t isa,
 
     brg->ld_step = brg->rd_step = 4 / brg->typesize_A;
 
-    if (!brg->is_int8_amx && !brg->is_bf16_amx) {
+    if (one_of(brg->isa, avx2, avx2_vnni)) {
+        // Out of 16 Ymm registers, 3 are used for the broadcast and the
+        // temporary values and 1 for the tail mask. The int8 dot product
+        // without VNNI takes 2 more.
+        brg->ld_block = 8;
+        brg->ldb = brg->load_dim / brg->ld_block;
+        brg->ldb_tail = brg->load_dim % brg->ld_block;
+
+        brg->ld_block2 = 2;
+        brg->ldb2 = brg->ldb / brg->ld_block2;
+        brg->ldb2_tail = brg->ldb % brg->ld_block2;
+
+        if (brg->ldb2 == 0) brg->ld_block2 = nstl::max(1, brg->ldb2_tail);
+        brg->embd_bcst = false;
+
+        // A load_dim below ld_block still takes one load register, so the
+        // registers are counted with ld_block2 rather than ldb2_tail
+        int max_regs = (brg->is_int8 && brg->isa == avx2) ? 10 : 12;
+        max_regs /= brg->ld_block2 + 1;
+        int min_block = 2;
+
+        brg->bd_block = 1;
+        for (int m_block = max_regs; m_block >= min_block; m_block--) {
+            if (brg->bcast_dim % m_block == 0) {
+                brg->bd_block = m_block;
+                break;
+            }
+        }
+        if (brg->bd_block == 1)
+            brg->bd_block = nstl::min(max_regs, brg->bcast_dim);
+        brg->bdb = brg->bcast_dim / brg->bd_block;
+        brg->bdb_tail = brg->bcast_dim % brg->bd_block;
+
+        brg->rd_block = 16 / brg->typesize_A;
+        brg->rdb = brg->reduce_dim / brg->rd_block;
+        brg->rdb_tail = brg->reduce_dim % brg->rd_block;
+    } else if (!brg->is_int8_amx && !brg->is_bf16_amx) {
         brg->ld_block = 16;
         brg->ldb = brg->load_dim / brg->ld_block;
         brg->ldb_tail = brg->load_dim % brg->ld_block;
@@ -346,6 +407,20 @@ status_t brgemm_desc_init(brgemm_t *brg, cpu_isa_t isa,
     return status::success;
 }
 
+bool brgemm_post_ops_ok(const post_ops_t &p, bool is_int8) {
+    using namespace primitive_kind;
+    auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
+
+    switch (p.len()) {
+        case 0: return true;
+        case 1: return is_eltwise(0) || p.contain(sum, 0);
+        case 2:
+            return (p.contain(sum, 0) && is_eltwise(1))
+                    || (is_int8 && p.contain(sum, 1) && is_eltwise(0));
+        default: return false;
+    }
+}
+
 status_t brgemm_desc_add_postops(brgemm_t *brg, const primitive_attr_t *attr,
         impl::data_type_t dt_d, int LDD, impl::data_type_t dt_bias) {
     if (brg == nullptr) return status::invalid_arguments;
@@ -30,12 +30,15 @@ namespace x64 {
 /// @param brg Output BRGEMM descriptor
 /// @param isa Target ISA of BRGEMM kernel
 ///     If isa is equal to 'isa_any' maximum supported ISA on current
-//      hardware will be used for BRGEMM kernel generation
+//      hardware will be used for BRGEMM kernel generation. The AVX2 kernels
+///     (avx2 and avx2_vnni) are generated only if requested explicitly
 /// @param type Type of batch
 /// @param dt_a Data type of A matrix, can be
+///     AVX2: f32, u8(row-major layout), s8(column-major layout)
 ///     AVX512: f32, u8(row-major layout), s8(column-major layout), bf16
 ///     AMX: u8, s8, bf16
 /// @param dt_b Data type of B matrix
+///     AVX2: f32, s8(row-major layout), u8(column-major layout)
 ///     AVX512: f32, s8(row-major layout), u8(column-major layout), bf16
 ///     AMX: u8, s8, bf16
 /// @note
@@ -86,6 +89,19 @@ status_t brgemm_desc_add_postops(brgemm_t *brg, const primitive_attr_t *attr,
         impl::data_type_t dt_d, int LDD,
         impl::data_type_t dt_bias = impl::data_type::undef);
 
+/// Checks that the post-operations can be added to BRGEMM descriptor
+///
+/// @note
+///     The kernel applies at most one sum and one eltwise: a single eltwise
+///     or sum, a sum followed by an eltwise, and, for int8, an eltwise
+///     followed by a sum. Chains of several eltwise or binary post-operations
+///     are not supported.
+///
+/// @param p Post-operations of the primitive
+/// @param is_int8 Specifies whether the source is int8
+///
+bool brgemm_post_ops_ok(const post_ops_t &p, bool is_int8);
+
 /// Generates a BRGEMM kernel based on descriptor
 ///
 /// @param brg_kernel Output BRGEMM kernel
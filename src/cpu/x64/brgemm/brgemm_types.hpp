@@ -18,6 +18,7 @@
 #define CPU_X64_BRGEMM_BRGEMM_TYPES_HPP
 
 #include "common/primitive_attr.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -81,6 +82,7 @@ struct brgemm_t {
     bool is_int8, is_int8_amx;
     bool is_bf16, is_bf16_amx;
     bool is_f32;
+    cpu_isa_t isa;
 
     dim_t stride_a; // Offset in bytes
     dim_t stride_b;
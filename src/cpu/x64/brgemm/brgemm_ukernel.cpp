@@ -0,0 +1,103 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "cpu/x64/brgemm/brgemm_ukernel.hpp"
+
+#include "common/c_types_map.hpp"
+#include "common/utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::utils;
+using namespace dnnl::impl::data_type;
+
+namespace {
+brgemm_batch_kind_t get_brgemm_batch_kind(dnnl_brgemm_batch_kind_t kind) {
+    switch (kind) {
+        case dnnl_brgemm_batch_addr: return brgemm_addr;
+        case dnnl_brgemm_batch_offs: return brgemm_offs;
+        case dnnl_brgemm_batch_strd: return brgemm_strd;
+        default: return brgemm_batch_kind_t();
+    }
+}
+} // namespace
+
+status_t brgemm_ukernel_t::pd_t::init(engine_t *engine) {
+    const auto &d = desc_;
+
+    if (!one_of(d.batch_kind, dnnl_brgemm_batch_addr, dnnl_brgemm_batch_offs,
+                dnnl_brgemm_batch_strd))
+        return status::invalid_arguments;
+    // The s8 A matrices require a compensation of the s8s8 products the
+    // ukernel has no argument for
+    if (d.a_dt == s8) return status::unimplemented;
+
+    // The AVX2 kernels are generated only on the machines without AVX-512
+    cpu_isa_t isa = isa_any;
+    if (!mayiuse(avx512_core)) {
+        if (!mayiuse(avx2)) return status::unimplemented;
+        isa = mayiuse(avx2_vnni) ? avx2_vnni : avx2;
+    }
+
+    brgemm_strides_t strides;
+    strides.stride_a = d.stride_a;
+    strides.stride_b = d.stride_b;
+    CHECK(brgemm_desc_init(&brg_, isa, get_brgemm_batch_kind(d.batch_kind),
+            d.a_dt, d.b_dt, false, false, brgemm_row_major, d.alpha, d.beta,
+            d.lda, d.ldb, d.ldc, d.M, d.N, d.K, &strides));
+    if (brg_.dt_c != d.c_dt) return status::invalid_arguments;
+
+    if (!with_post_ops()) {
+        brg_.attr = attr();
+        return attr()->has_default_values() ? status::success
+                                            : status::unimplemented;
+    }
+
+    using smask_t = primitive_attr_t::skip_mask_t;
+    const auto &oscales = attr()->output_scales_;
+    bool ok = attr()->has_default_values(
+                      smask_t::oscale_runtime | smask_t::post_ops, d.d_dt)
+            && brgemm_post_ops_ok(attr()->post_ops_, brg_.is_int8)
+            && IMPLICATION(brg_.is_int8, one_of(oscales.mask_, 0, 1 << 1))
+            && IMPLICATION(!brg_.is_int8, oscales.has_default_values());
+    if (!ok) return status::unimplemented;
+
+    return brgemm_desc_add_postops(&brg_, attr(), d.d_dt, (int)d.ldd,
+            d.bias_dt);
+}
+
+status_t brgemm_ukernel_t::init(engine_t *engine) {
+    brgemm_t brg = pd()->brg_;
+    brg.attr = pd()->attr();
+
+    brgemm_kernel_t *kernel = nullptr;
+    const status_t status = brgemm_kernel_create(&kernel, brg);
+    kernel_.reset(kernel);
+    if (status != status::success) return status;
+
+    if (pd()->is_amx()) CHECK(brgemm_init_tiles(brg, palette_));
+    return status::success;
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+//vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
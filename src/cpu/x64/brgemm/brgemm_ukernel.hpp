@@ -0,0 +1,88 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_BRGEMM_BRGEMM_UKERNEL_HPP
+#define CPU_X64_BRGEMM_BRGEMM_UKERNEL_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/primitive_desc.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// A BRGEMM kernel generated for the ukernel API (dnnl_brgemm_*). It is a
+// primitive only to be stored in the primitive cache: the ukernel is called
+// by the user thread directly and is never executed on a stream.
+struct brgemm_ukernel_t : public primitive_t {
+    struct pd_t : public primitive_desc_t {
+        static constexpr auto base_pkind = primitive_kind::brgemm;
+
+        pd_t(const brgemm_desc_t *adesc, const primitive_attr_t *attr)
+            : primitive_desc_t(attr, base_pkind), desc_(*adesc) {}
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("brgemm:", brg_.isa, ""),
+                brgemm_ukernel_t);
+
+        status_t init(engine_t *engine);
+
+        const brgemm_desc_t *desc() const { return &desc_; }
+        const op_desc_t *op_desc() const override {
+            return reinterpret_cast<const op_desc_t *>(this->desc());
+        }
+
+        bool with_post_ops() const { return desc_.d_dt != data_type::undef; }
+        bool is_amx() const { return brg_.is_int8_amx || brg_.is_bf16_amx; }
+
+        // brg_.attr points to the attributes of the descriptor that
+        // initialized it, the copies of the descriptor do not use it
+        brgemm_t brg_;
+
+    private:
+        brgemm_desc_t desc_;
+    };
+
+    brgemm_ukernel_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        return status::unimplemented;
+    }
+
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+    const brgemm_kernel_t *kernel() const { return kernel_.get(); }
+    const char *palette() const { return palette_; }
+
+private:
+    std::unique_ptr<brgemm_kernel_t> kernel_;
+    char palette_[64];
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+//vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
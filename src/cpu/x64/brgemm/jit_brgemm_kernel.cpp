@@ -36,29 +36,38 @@ using namespace dnnl::impl::utils;
 using namespace Xbyak;
 
 struct jit_brgemm_kernel_base_t : public jit_generator {
-    jit_brgemm_kernel_base_t(const brgemm_t &abrg)
-        : jit_generator(nullptr, MAX_CODE_SIZE, true, avx512_common)
-        , brg(abrg)
-        , eltwise_injector_(nullptr) {
+    jit_brgemm_kernel_base_t(const brgemm_t &abrg, cpu_isa_t isa)
+        : jit_generator(nullptr, MAX_CODE_SIZE, true, isa), brg(abrg) {}
+
+    brgemm_t brg;
+};
+
+// The kernels for AVX-512 and AMX use Zmm registers, the ones for AVX2 and
+// AVX2 with VNNI (brg.isa) use Ymm registers
+template <cpu_isa_t isa>
+struct jit_brgemm_kernel_t : public jit_brgemm_kernel_base_t {
+    jit_brgemm_kernel_t(const brgemm_t &abrg)
+        : jit_brgemm_kernel_base_t(abrg, isa), eltwise_injector_(nullptr) {
         if (brg.with_eltwise) {
             const auto &p = brg.attr->post_ops_;
             const int eltwise_ind = p.find(primitive_kind::eltwise);
 
             post_ops_t::entry_t::eltwise_t eltwise;
             eltwise = p.entry_[eltwise_ind].eltwise;
-            eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx512_common>(
+            eltwise_injector_ = new jit_uni_eltwise_injector_f32<isa>(
                     this, eltwise, true, rax, Xbyak::Opmask(1));
         }
     }
 
-    ~jit_brgemm_kernel_base_t() override { delete eltwise_injector_; }
+    ~jit_brgemm_kernel_t() override { delete eltwise_injector_; }
 
-    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_brgemm_kernel_base_t)
-
-    brgemm_t brg;
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_brgemm_kernel_t)
 
 private:
-    jit_uni_eltwise_injector_f32<avx512_common> *eltwise_injector_;
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    static constexpr int max_vregs = cpu_isa_traits<isa>::n_vregs;
+
+    jit_uni_eltwise_injector_f32<isa> *eltwise_injector_;
 
     using reg64_t = const Xbyak::Reg64;
 
@@ -129,38 +138,48 @@ private:
     Xbyak::Opmask ld_full_mask = Xbyak::Opmask(2);
     Xbyak::Opmask ld_tail_mask = Xbyak::Opmask(3);
 
-    Xbyak::Zmm accm(int ld_block, int bd, int ld) {
-        return Xbyak::Zmm(31 - (bd * ld_block + ld));
+    Vmm accm(int ld_block, int bd, int ld) {
+        return Vmm(max_vregs - 1 - (bd * ld_block + ld));
     }
 #if defined(_N_BCST_1_LOAD)
-    Xbyak::Zmm bcst(int bd) {
-        int idx = 31 - (brg.ld_block2 * brg.bd_block) - bd;
+    Vmm bcst(int bd) {
+        int idx = max_vregs - 1 - (brg.ld_block2 * brg.bd_block) - bd;
         assert(idx > 0);
-        return Xbyak::Zmm(idx);
+        return Vmm(idx);
     }
-    Xbyak::Zmm load() { return Xbyak::Zmm(0); }
+    Vmm load() { return Vmm(0); }
 #else
-    Xbyak::Zmm load(int ld) {
-        int idx = 31 - (brg.ld_block2 * brg.bd_block) - ld;
+    Vmm load(int ld) {
+        int idx = max_vregs - 1 - (brg.ld_block2 * brg.bd_block) - ld;
         assert(idx > 0);
-        return Xbyak::Zmm(idx);
+        return Vmm(idx);
     }
-    Xbyak::Zmm bcst() { return Xbyak::Zmm(0); }
+    Vmm bcst() { return Vmm(0); }
 #endif
 
-    Xbyak::Zmm zmm_tmp_1() { return Xbyak::Zmm(0); }
-    Xbyak::Zmm zmm_tmp_2() { return Xbyak::Zmm(1); }
-    Xbyak::Zmm zmm_tmp_3() { return Xbyak::Zmm(2); }
-    Xbyak::Zmm zmm_inp_shift() { return Xbyak::Zmm(1); }
+    Vmm vmm_tmp_1() { return Vmm(0); }
+    Vmm vmm_tmp_2() { return Vmm(1); }
+    Vmm vmm_tmp_3() { return Vmm(2); }
+    Vmm vmm_inp_shift() { return Vmm(1); }
 
-    Xbyak::Zmm zmm_mask(const Xbyak::Zmm zmm_in, bool mask_flag, bool store,
+    // AVX2 only, the registers below are not used by the accumulators and the
+    // loads (see brgemm_desc_init()) and are set once by the kernel
+    Vmm vmm_tail_mask() { return Vmm(3); }
+    Vmm vmm_one_words() { return Vmm(4); }
+    Vmm vmm_dot_tmp() { return Vmm(5); }
+    Xbyak::Label l_tail_mask_table;
+    Xbyak::Label l_sum_scale;
+
+    bool is_avx2_vnni() const { return brg.isa == avx2_vnni; }
+
+    Vmm vmm_mask(const Vmm vmm_in, bool mask_flag, bool store,
             Xbyak::Opmask ktail_mask);
     Xbyak::Ymm ymm_mask(const Xbyak::Ymm ymm_in, bool mask_flag, bool store,
             Xbyak::Opmask ktail_mask);
 
-    void cvt2ps(data_type_t type_in, const Xbyak::Zmm zmm_in,
-            const Xbyak::Operand &op, bool mask_flag, bool store,
-            Xbyak::Opmask ktail_mask);
+    void cvt2ps(data_type_t type_in, const Vmm vmm_in, const reg64_t &reg,
+            int offset, bool is_tail);
+    void load_B(const Vmm vmm, int offset, bool is_tail);
 
     void read_params();
     void load_accumulators(
@@ -178,7 +197,7 @@ private:
     void restore_offsets();
     void set_A_B_matrices();
 
-    void gemm_microkernel_avx512(int bd_block2, bool is_bdb_tail, int ld_block,
+    void gemm_microkernel_uni(int bd_block2, bool is_bdb_tail, int ld_block,
             bool is_rd_tail, bool is_ld_tail);
     void gemm_microkernel_amx(int bd_block2, bool is_bdb_tail, int ld_block,
             bool is_rd_tail, bool is_ldb_tail);
@@ -190,6 +209,7 @@ private:
     void bdb_loop();
 
     void generate() override;
+    std::string persistent_cache_key() const override;
 
     int A_offset(int bd, int rd, bool is_amx = false);
     int B_offset(int ld, int rd, bool is_amx = false);
@@ -212,98 +232,150 @@ private:
     int scales_offset(int ld, bool is_tail = false);
 };
 
-int jit_brgemm_kernel_base_t::A_offset(int bd, int rd, bool is_amx) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::A_offset(int bd, int rd, bool is_amx) {
     return (is_amx) ? brg.typesize_A * (bd * brg.bd_block * brg.LDA)
                     : brg.typesize_A * (bd * brg.LDA + rd);
 }
-int jit_brgemm_kernel_base_t::B_offset(int ld, int rd, bool is_amx) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::B_offset(int ld, int rd, bool is_amx) {
     return (is_amx)
             ? brg.typesize_B * (brg.rd_step * ld * brg.ld_block)
             : brg.typesize_B * (rd * brg.LDB + brg.rd_step * ld * brg.ld_block);
 };
-int jit_brgemm_kernel_base_t::C_offset(int bd, int ld) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::C_offset(int bd, int ld) {
     return brg.typesize_C * (bd * brg.LDC + ld * brg.ld_block);
 }
-int jit_brgemm_kernel_base_t::D_offset(int bd, int ld) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::D_offset(int bd, int ld) {
     return brg.typesize_D * (bd * brg.LDD + ld * brg.ld_block);
 }
 
-int jit_brgemm_kernel_base_t::rdb_A_offset() {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::rdb_A_offset() {
     return brg.typesize_A * brg.rd_block;
 }
-int jit_brgemm_kernel_base_t::rdb_B_offset() {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::rdb_B_offset() {
     return brg.typesize_B * brg.rd_block * brg.LDB;
 }
 
-int jit_brgemm_kernel_base_t::ldb_B_offset(int ld_block2, bool is_tail) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::ldb_B_offset(int ld_block2, bool is_tail) {
     return (is_tail) ? brg.typesize_B * brg.ldb_tail * brg.ld_step
                      : brg.typesize_B * ld_block2 * brg.ld_block * brg.ld_step;
 }
-int jit_brgemm_kernel_base_t::ldb_C_offset(int ld_block2, bool is_tail) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::ldb_C_offset(int ld_block2, bool is_tail) {
     return (is_tail) ? brg.typesize_C * brg.ldb_tail
                      : brg.typesize_C * ld_block2 * brg.ld_block;
 }
-int jit_brgemm_kernel_base_t::ldb_D_offset(int ld_block2, bool is_tail) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::ldb_D_offset(int ld_block2, bool is_tail) {
     return (is_tail) ? brg.typesize_D * brg.ldb_tail
                      : brg.typesize_D * ld_block2 * brg.ld_block;
 }
 
-int jit_brgemm_kernel_base_t::bdb_A_offset(int bd_block2) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::bdb_A_offset(int bd_block2) {
     return brg.typesize_A * bd_block2 * brg.bd_block * brg.LDA;
 }
-int jit_brgemm_kernel_base_t::bdb_C_offset(int bd_block2) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::bdb_C_offset(int bd_block2) {
     return brg.typesize_C * bd_block2 * brg.bd_block * brg.LDC;
 }
-int jit_brgemm_kernel_base_t::bdb_D_offset(int bd_block2) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::bdb_D_offset(int bd_block2) {
     return brg.typesize_D * bd_block2 * brg.bd_block * brg.LDD;
 }
 
-int jit_brgemm_kernel_base_t::bias_offset(int ld, bool is_tail) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::bias_offset(int ld, bool is_tail) {
     return (is_tail) ? brg.typesize_bias * brg.ldb_tail
                      : brg.typesize_bias * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_base_t::compensations_offset(int ld, bool is_tail) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::compensations_offset(int ld, bool is_tail) {
     return (is_tail) ? sizeof(int32_t) * brg.ldb_tail
                      : sizeof(int32_t) * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_base_t::scales_offset(int ld, bool is_tail) {
+template <cpu_isa_t isa>
+int jit_brgemm_kernel_t<isa>::scales_offset(int ld, bool is_tail) {
     return (is_tail) ? brg.is_oc_scale * sizeof(float) * brg.ldb_tail
                      : brg.is_oc_scale * sizeof(float) * ld * brg.ld_block;
 }
-Xbyak::Zmm jit_brgemm_kernel_base_t::zmm_mask(const Xbyak::Zmm zmm_in,
-        bool mask_flag, bool store, Xbyak::Opmask ktail_mask) {
-    return mask_flag ? (store ? zmm_in | ktail_mask : zmm_in | ktail_mask | T_z)
-                     : zmm_in;
+template <cpu_isa_t isa>
+typename jit_brgemm_kernel_t<isa>::Vmm jit_brgemm_kernel_t<isa>::vmm_mask(
+        const Vmm vmm_in, bool mask_flag, bool store,
+        Xbyak::Opmask ktail_mask) {
+    assert(IMPLICATION(mask_flag, isa != avx2));
+    return mask_flag ? (store ? vmm_in | ktail_mask : vmm_in | ktail_mask | T_z)
+                     : vmm_in;
 }
 
-Xbyak::Ymm jit_brgemm_kernel_base_t::ymm_mask(const Xbyak::Ymm ymm_in,
+template <cpu_isa_t isa>
+Xbyak::Ymm jit_brgemm_kernel_t<isa>::ymm_mask(const Xbyak::Ymm ymm_in,
         bool mask_flag, bool store, Xbyak::Opmask ktail_mask) {
     return mask_flag ? (store ? ymm_in | ktail_mask : ymm_in | ktail_mask | T_z)
                      : ymm_in;
 }
 
-void jit_brgemm_kernel_base_t::cvt2ps(data_type_t type_in,
-        const Xbyak::Zmm zmm_in, const Xbyak::Operand &op, bool mask_flag,
-        bool store, Xbyak::Opmask ktail_mask) {
-    const Xbyak::Zmm zmm = zmm_mask(zmm_in, mask_flag, store, ktail_mask);
-    switch (type_in) {
-        case data_type::f32:
-        case data_type::s32: vmovups(zmm, op); break;
-        case data_type::bf16:
-            vpmovzxwd(zmm, op);
-            vpslld(zmm, zmm, 16);
-            break;
-        case data_type::s8: vpmovsxbd(zmm, op); break;
-        case data_type::u8: vpmovzxbd(zmm, op); break;
-        default: assert(!"unsupported data type");
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::cvt2ps(data_type_t type_in, const Vmm vmm_in,
+        const reg64_t &reg, int offset, bool is_tail) {
+    const auto addr = ptr[reg + offset];
+    if (isa == avx2 && is_tail) {
+        // Without the masked loads of AVX-512, the tail of the 1-byte values
+        // is loaded byte by byte not to read beyond the end of the row
+        switch (type_in) {
+            case data_type::f32:
+            case data_type::s32:
+                vmaskmovps(vmm_in, vmm_tail_mask(), addr);
+                break;
+            case data_type::s8:
+            case data_type::u8:
+                load_bytes_to_dword_extension(Xbyak::Ymm(vmm_in.getIdx()),
+                        reg, offset, type_in == data_type::s8, brg.ldb_tail);
+                break;
+            default: assert(!"unsupported data type");
+        }
+    } else {
+        const Vmm vmm = vmm_mask(vmm_in, is_tail, false, ld_tail_mask);
+        switch (type_in) {
+            case data_type::f32:
+            case data_type::s32: vmovups(vmm, addr); break;
+            case data_type::bf16:
+                vpmovzxwd(vmm, addr);
+                vpslld(vmm, vmm, 16);
+                break;
+            case data_type::s8: vpmovsxbd(vmm, addr); break;
+            case data_type::u8: vpmovzxbd(vmm, addr); break;
+            default: assert(!"unsupported data type");
+        }
     }
     if (!one_of(type_in, data_type::f32, data_type::bf16))
-        vcvtdq2ps(zmm_in, zmm_in);
+        vcvtdq2ps(vmm_in, vmm_in);
+}
+
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::load_B(
+        const Vmm vmm, int offset, bool is_tail) {
+    const auto addr = ptr[reg_aux_B + offset];
+    if (!is_tail)
+        vmovups(vmm, addr);
+    else if (isa == avx2)
+        // The tail of int8 B is a number of groups of 4 values, so it is
+        // loaded as dwords as well
+        vmaskmovps(vmm, vmm_tail_mask(), addr);
+    else
+        vmovups(vmm | ld_tail_mask | T_z, addr);
 }
 
-void jit_brgemm_kernel_base_t::read_params() {
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::read_params() {
     Label label_done;
 
     if (brg.layout == brgemm_row_major)
@@ -347,7 +419,8 @@ void jit_brgemm_kernel_base_t::read_params() {
     mov(ptr[rsp + reg_do_post_ops_offs_], reg_do_post_ops);
 }
 
-void jit_brgemm_kernel_base_t::load_accumulators(
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::load_accumulators(
         int bd_block2, bool is_bdb_tail, int ld_block2, bool is_ld_tail) {
     if (brg.is_int8_amx || brg.is_bf16_amx) {
         for_(int bdb = 0; bdb < bd_block2; bdb++)
@@ -359,18 +432,18 @@ void jit_brgemm_kernel_base_t::load_accumulators(
         int bd_block = (is_bdb_tail) ? brg.bdb_tail : brg.bd_block;
         for_(int bd = 0; bd < bd_block; bd++)
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm = accm(ld_block2, bd, ld);
-            vxorps(zmm, zmm, zmm);
+            auto vmm = accm(ld_block2, bd, ld);
+            vxorps(vmm, vmm, vmm);
         }
     }
 }
 
-void jit_brgemm_kernel_base_t::apply_alpha_beta(
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::apply_alpha_beta(
         int bd_block, int ld_block2, bool is_ld_tail) {
-    auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
-    auto zmm_beta = zmm_tmp_1();
-    auto zmm_alpha = zmm_tmp_2();
-    auto zmm_prev_dst = zmm_tmp_3();
+    auto vmm_beta = vmm_tmp_1();
+    auto vmm_alpha = vmm_tmp_2();
+    auto vmm_prev_dst = vmm_tmp_3();
 
     const bool apply_alpha = brg.alpha != 1.f;
     const bool apply_beta = brg.beta != 0.f;
@@ -381,39 +454,48 @@ void jit_brgemm_kernel_base_t::apply_alpha_beta(
 
     if (apply_beta && !use_vadd_for_beta) {
         mov(reg_tmp_gpr, float2int((float)brg.beta));
-        movq(Xmm(zmm_beta.getIdx()), reg_tmp_gpr);
-        vbroadcastss(zmm_beta, Xmm(zmm_beta.getIdx()));
+        uni_vmovq(Xmm(vmm_beta.getIdx()), reg_tmp_gpr);
+        vbroadcastss(vmm_beta, Xmm(vmm_beta.getIdx()));
     }
     if (apply_alpha) {
         mov(reg_tmp_gpr, float2int((float)brg.alpha));
-        movq(Xmm(zmm_alpha.getIdx()), reg_tmp_gpr);
-        vbroadcastss(zmm_alpha, Xmm(zmm_alpha.getIdx()));
+        uni_vmovq(Xmm(vmm_alpha.getIdx()), reg_tmp_gpr);
+        vbroadcastss(vmm_alpha, Xmm(vmm_alpha.getIdx()));
     }
     for_(int bd = 0; bd < bd_block; bd++)
     for (int ld = 0; ld < ld_block2; ld++) {
-        auto zmm = accm(ld_block2, bd, ld);
-        if (dq2ps_required) vcvtdq2ps(zmm, zmm);
-        if (apply_alpha) vmulps(zmm, zmm, zmm_alpha);
+        auto vmm = accm(ld_block2, bd, ld);
+        if (dq2ps_required) vcvtdq2ps(vmm, vmm);
+        if (apply_alpha) vmulps(vmm, vmm, vmm_alpha);
         if (apply_beta) {
-            auto ptr_C = ptr[reg_aux_C + C_offset(bd, ld)];
+            const int offset = C_offset(bd, ld);
             if (use_vadd_for_beta) {
-                auto zmm_masked = zmm | k_mask | T_z;
-                if (brg.is_int8)
-                    vpaddd(zmm_masked, zmm, ptr_C);
-                else
-                    vaddps(zmm_masked, zmm, ptr_C);
+                auto ptr_C = ptr[reg_aux_C + offset];
+                if (isa == avx2 && is_ld_tail) {
+                    vmaskmovps(vmm_prev_dst, vmm_tail_mask(), ptr_C);
+                    if (brg.is_int8)
+                        vpaddd(vmm, vmm, vmm_prev_dst);
+                    else
+                        vaddps(vmm, vmm, vmm_prev_dst);
+                } else {
+                    auto vmm_masked = vmm_mask(vmm, is_ld_tail, false,
+                            ld_tail_mask);
+                    if (brg.is_int8)
+                        vpaddd(vmm_masked, vmm, ptr_C);
+                    else
+                        vaddps(vmm_masked, vmm, ptr_C);
+                }
             } else {
-                cvt2ps(brg.dt_c, zmm_prev_dst, ptr_C, true, false, k_mask);
-                vfmadd231ps(zmm, zmm_prev_dst, zmm_beta);
+                cvt2ps(brg.dt_c, vmm_prev_dst, reg_aux_C, offset, is_ld_tail);
+                vfmadd231ps(vmm, vmm_prev_dst, vmm_beta);
             }
         }
     }
 }
 
-void jit_brgemm_kernel_base_t::store_accumulators_apply_post_ops(
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::store_accumulators_apply_post_ops(
         int bd_block, int ld_block2, bool is_ld_tail) {
-    auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
-
     // if (brg.is_int8 && alpha_or_beta_applicable && !beta_uses_vadd) ->
     // accumulated values are already converted to ps in apply_alpha_beta()
     const bool alpha_or_beta_applicable = brg.alpha != 1.0f || brg.beta != 0.f;
@@ -425,38 +507,50 @@ void jit_brgemm_kernel_base_t::store_accumulators_apply_post_ops(
     if (brg.with_bias) { mov(reg_aux_bias, ptr[rsp + reg_aux_bias_offs_]); }
     for_(int bd = 0; bd < bd_block; bd++)
     for (int ld = 0; ld < ld_block2; ld++) {
-        auto zmm = accm(ld_block2, bd, ld);
-        if (dq2ps_required) vcvtdq2ps(zmm, zmm);
+        auto vmm = accm(ld_block2, bd, ld);
+        if (dq2ps_required) vcvtdq2ps(vmm, vmm);
         if (brg.with_bias) {
-            auto zmm_bias = zmm_tmp_1();
-            auto ptr_bias = ptr[reg_aux_bias + bias_offset(ld)];
-            cvt2ps(brg.dt_bias, zmm_bias, ptr_bias, true, false, k_mask);
-            vaddps(zmm, zmm, zmm_bias);
+            auto vmm_bias = vmm_tmp_1();
+            cvt2ps(brg.dt_bias, vmm_bias, reg_aux_bias, bias_offset(ld),
+                    is_ld_tail);
+            vaddps(vmm, vmm, vmm_bias);
         }
     }
 
     if (brg.req_s8s8_compensation) {
         mov(reg_aux_compensation, ptr[rsp + reg_aux_comp_offs_]);
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm_comp = zmm_tmp_1();
+            auto vmm_comp = vmm_tmp_1();
             int comp_offset = compensations_offset(ld);
-            auto comp_addr
-                    = EVEX_compress_addr(reg_aux_compensation, comp_offset);
-            cvt2ps(data_type::s32, zmm_comp, comp_addr, true, false, k_mask);
+            cvt2ps(data_type::s32, vmm_comp, reg_aux_compensation, comp_offset,
+                    is_ld_tail);
 
             for (int bd = 0; bd < bd_block; bd++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                vaddps(zmm, zmm, zmm_comp);
+                auto vmm = accm(ld_block2, bd, ld);
+                vaddps(vmm, vmm, vmm_comp);
             }
         }
     }
     if (brg.with_scales) {
         mov(reg_aux_scales, ptr[rsp + reg_aux_scales_offs_]);
-        for (int bd = 0; bd < bd_block; bd++) {
+        if (isa == avx2) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                const Xbyak::Zmm zmm = zmm_mask(
-                        accm(ld_block2, bd, ld), true, false, k_mask);
-                vmulps(zmm, zmm, ptr[reg_aux_scales + scales_offset(ld)]);
+                auto vmm_scales = vmm_tmp_1();
+                cvt2ps(data_type::f32, vmm_scales, reg_aux_scales,
+                        scales_offset(ld), is_ld_tail);
+                for (int bd = 0; bd < bd_block; bd++) {
+                    auto vmm = accm(ld_block2, bd, ld);
+                    vmulps(vmm, vmm, vmm_scales);
+                }
+            }
+        } else {
+            auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
+            for (int bd = 0; bd < bd_block; bd++) {
+                for (int ld = 0; ld < ld_block2; ld++) {
+                    const Vmm vmm = vmm_mask(
+                            accm(ld_block2, bd, ld), true, false, k_mask);
+                    vmulps(vmm, vmm, ptr[reg_aux_scales + scales_offset(ld)]);
+                }
             }
         }
     }
@@ -470,69 +564,92 @@ void jit_brgemm_kernel_base_t::store_accumulators_apply_post_ops(
     }
 
     if (brg.with_eltwise && !sum_before_eltwise)
-        eltwise_injector_->compute_vector_range(32 - bd_block * ld_block2, 32);
+        eltwise_injector_->compute_vector_range(
+                max_vregs - bd_block * ld_block2, max_vregs);
 
     if (brg.with_sum) {
         const float *p_sum_scale = &brg.sum_scale;
-        if (*p_sum_scale != 1.f) mov(reg_ptr_sum_scale, (size_t)p_sum_scale);
+        // The scale is kept in the code, so that the code does not refer to
+        // the kernel object
+        if (*p_sum_scale != 1.f)
+            mov_label_address(reg_ptr_sum_scale, l_sum_scale);
+        auto vmm_sum_scale = vmm_tmp_2();
+        if (isa == avx2 && *p_sum_scale != 1.f)
+            vbroadcastss(vmm_sum_scale, ptr[reg_ptr_sum_scale]);
 
         for (int bd = 0; bd < bd_block; bd++) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                auto addr = ptr[reg_aux_D + D_offset(bd, ld)];
-
-                auto zmm_prev_dst = Xbyak::Zmm(0);
-                cvt2ps(brg.dt_d, zmm_prev_dst, addr, true, false, k_mask);
+                auto vmm = accm(ld_block2, bd, ld);
+                auto vmm_prev_dst = vmm_tmp_1();
+                cvt2ps(brg.dt_d, vmm_prev_dst, reg_aux_D, D_offset(bd, ld),
+                        is_ld_tail);
                 if (*p_sum_scale == 1.f)
-                    vaddps(zmm, zmm_prev_dst);
+                    vaddps(vmm, vmm_prev_dst);
+                else if (isa == avx2)
+                    vfmadd231ps(vmm, vmm_prev_dst, vmm_sum_scale);
                 else
-                    vfmadd231ps(zmm, zmm_prev_dst, zword_b[reg_ptr_sum_scale]);
+                    vfmadd231ps(vmm, vmm_prev_dst, zword_b[reg_ptr_sum_scale]);
             }
         }
     }
 
     if (brg.with_eltwise && sum_before_eltwise)
-        eltwise_injector_->compute_vector_range(32 - bd_block * ld_block2, 32);
+        eltwise_injector_->compute_vector_range(
+                max_vregs - bd_block * ld_block2, max_vregs);
 
     const bool dt_requires_saturation
             = one_of(brg.dt_d, data_type::u8, data_type::s8, data_type::s32);
-    auto zmm_lbound = zmm_tmp_1();
-    auto zmm_ubound = zmm_tmp_2();
+    auto vmm_lbound = vmm_tmp_1();
+    auto vmm_ubound = vmm_tmp_2();
     if (dt_requires_saturation) {
         init_saturate_f32(
-                zmm_lbound, zmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
+                vmm_lbound, vmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
     }
 
     for (int bd = 0; bd < bd_block; bd++) {
         if (dt_requires_saturation) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                saturate_f32(zmm, zmm_lbound, zmm_ubound, brg.dt_d);
-                vcvtps2dq(zmm, zmm);
+                auto vmm = accm(ld_block2, bd, ld);
+                saturate_f32(vmm, vmm_lbound, vmm_ubound, brg.dt_d);
+                vcvtps2dq(vmm, vmm);
             }
         }
         for (int ld = 0; ld < ld_block2; ld++) {
             auto addr = ptr[reg_aux_D + D_offset(bd, ld)];
-            auto zmm = accm(ld_block2, bd, ld);
-            auto ymm = Xbyak::Ymm(zmm.getIdx());
-            const Xbyak::Zmm r_zmm = zmm_mask(zmm, true, true, k_mask);
+            auto vmm = accm(ld_block2, bd, ld);
+            auto ymm = Xbyak::Ymm(vmm.getIdx());
+            if (isa == avx2) {
+                if (one_of(brg.dt_d, data_type::f32, data_type::s32)) {
+                    if (is_ld_tail)
+                        vmaskmovps(addr, vmm_tail_mask(), vmm);
+                    else
+                        vmovups(addr, vmm);
+                } else {
+                    store_data(brg.dt_d, ymm, reg_aux_D, D_offset(bd, ld),
+                            is_ld_tail ? brg.ldb_tail : brg.ld_block);
+                }
+                continue;
+            }
+            auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
+            const Vmm r_vmm = vmm_mask(vmm, true, true, k_mask);
             const Xbyak::Ymm r_ymm = ymm_mask(ymm, true, true, k_mask);
             switch (brg.dt_d) {
                 case data_type::f32:
-                case data_type::s32: vmovups(addr, r_zmm); break;
+                case data_type::s32: vmovups(addr, r_vmm); break;
                 case data_type::bf16:
-                    vcvtneps2bf16(ymm, zmm);
+                    vcvtneps2bf16(ymm, vmm);
                     vmovdqu16(addr, r_ymm);
                     break;
-                case data_type::s8: vpmovsdb(addr, r_zmm); break;
-                case data_type::u8: vpmovusdb(addr, r_zmm); break;
+                case data_type::s8: vpmovsdb(addr, r_vmm); break;
+                case data_type::u8: vpmovusdb(addr, r_vmm); break;
                 default: assert(!"unknown dst_dt");
             }
         }
     }
 }
 
-void jit_brgemm_kernel_base_t::store_accumulators_without_post_ops(
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::store_accumulators_without_post_ops(
         int bd_block, int ld_block2, bool is_ld_tail) {
 
     // if (brg.is_int8 && alpha_or_beta_applicable && !beta_uses_vadd) ->
@@ -542,33 +659,36 @@ void jit_brgemm_kernel_base_t::store_accumulators_without_post_ops(
             = brg.beta == 1.f && IMPLICATION(brg.is_int8, brg.alpha == 1.0f);
     const bool dt_requires_saturation = brg.is_int8
             && !IMPLICATION(alpha_or_beta_applicable, beta_uses_vadd);
-    auto zmm_lbound = zmm_tmp_1();
-    auto zmm_ubound = zmm_tmp_2();
+    auto vmm_lbound = vmm_tmp_1();
+    auto vmm_ubound = vmm_tmp_2();
     if (dt_requires_saturation) {
         init_saturate_f32(
-                zmm_lbound, zmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
+                vmm_lbound, vmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
     }
 
     for (int bd = 0; bd < bd_block; bd++) {
         if (dt_requires_saturation) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                saturate_f32(zmm, zmm_lbound, zmm_ubound, brg.dt_d);
-                vcvtps2dq(zmm, zmm);
+                auto vmm = accm(ld_block2, bd, ld);
+                saturate_f32(vmm, vmm_lbound, vmm_ubound, brg.dt_d);
+                vcvtps2dq(vmm, vmm);
             }
         }
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm = accm(ld_block2, bd, ld);
-            if (is_ld_tail)
-                vmovups(ptr[reg_aux_C + C_offset(bd, ld)] | ld_tail_mask | T_z,
-                        zmm);
+            auto vmm = accm(ld_block2, bd, ld);
+            auto addr = ptr[reg_aux_C + C_offset(bd, ld)];
+            if (!is_ld_tail)
+                vmovups(addr, vmm);
+            else if (isa == avx2)
+                vmaskmovps(addr, vmm_tail_mask(), vmm);
             else
-                vmovups(ptr[reg_aux_C + C_offset(bd, ld)], zmm);
+                vmovups(addr | ld_tail_mask | T_z, vmm);
         }
     }
 }
 
-void jit_brgemm_kernel_base_t::store_accumulators(
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::store_accumulators(
         int bd_block2, bool is_bdb_tail, int ld_block2, bool is_ld_tail) {
     const bool are_post_ops_applicable = one_of(true, brg.with_eltwise,
             brg.with_scales, brg.with_bias, brg.with_sum, brg.dt_d != brg.dt_c,
@@ -666,19 +786,22 @@ void jit_brgemm_kernel_base_t::store_accumulators(
     }
 }
 
-void jit_brgemm_kernel_base_t::restore_A_B_matrices() {
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::restore_A_B_matrices() {
     if (brg.type != brgemm_offs) {
         mov(reg_aux1_A, reg_A);
         mov(reg_aux1_B, reg_B);
     }
 }
-void jit_brgemm_kernel_base_t::restore_offsets() {
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::restore_offsets() {
     if (brg.type == brgemm_offs) {
         mov(reg_offset_A, ptr[rsp + origin_offset_A_offs_]);
         mov(reg_offset_B, ptr[rsp + origin_offset_B_offs_]);
     }
 }
-void jit_brgemm_kernel_base_t::set_A_B_matrices() {
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::set_A_B_matrices() {
     if (brg.type == brgemm_addr) {
         mov(reg_aux_A, ptr[reg_aux1_A]);
         mov(reg_aux_B, ptr[reg_aux1_B]);
@@ -704,7 +827,8 @@ void jit_brgemm_kernel_base_t::set_A_B_matrices() {
     add(reg_aux_B, reg_b_offset);
 }
 
-void jit_brgemm_kernel_base_t::gemm_microkernel_amx(int bd_block2,
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::gemm_microkernel_amx(int bd_block2,
         bool is_bdb_tail, int ld_block2, bool is_rd_tail, bool is_ld_tail) {
     MAYBE_UNUSED(is_rd_tail);
     auto tdpbxxd = [=](const Tmm &x1, const Tmm &x2, const Tmm &x3) {
@@ -748,16 +872,26 @@ void jit_brgemm_kernel_base_t::gemm_microkernel_amx(int bd_block2,
     mov(reg_ldb_loop, ptr[rsp + reg_ldb_loop_offs_]);
 }
 
-void jit_brgemm_kernel_base_t::gemm_microkernel_avx512(int bd_block2,
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::gemm_microkernel_uni(int bd_block2,
         bool is_bdb_tail, int ld_block2, bool is_rd_tail, bool is_ld_tail) {
     MAYBE_UNUSED(bd_block2);
-    auto dot_product = [=](Zmm z1, Zmm z2, Zmm z3) {
+    auto dot_product = [=](Vmm v1, Vmm v2, Vmm v3) {
         if (brg.is_f32)
-            vfmadd231ps(z1, z2, z3);
+            vfmadd231ps(v1, v2, v3);
         else if (brg.is_bf16)
-            vdpbf16ps(z1, z2, z3);
-        else if (brg.is_int8)
-            vpdpbusd(z1, z3, z2);
+            vdpbf16ps(v1, v2, v3);
+        else if (brg.is_int8) {
+            if (isa != avx2)
+                vpdpbusd(v1, v3, v2);
+            else if (is_avx2_vnni())
+                vpdpbusd(v1, v3, v2, Xbyak::VexEncoding);
+            else {
+                vpmaddubsw(vmm_dot_tmp(), v3, v2);
+                vpmaddwd(vmm_dot_tmp(), vmm_dot_tmp(), vmm_one_words());
+                vpaddd(v1, v1, vmm_dot_tmp());
+            }
+        }
     };
 
     int bd_block = (is_bdb_tail) ? brg.bdb_tail : brg.bd_block;
@@ -775,21 +909,21 @@ void jit_brgemm_kernel_base_t::gemm_microkernel_avx512(int bd_block2,
     } else
         rd_loop = brg.rd_block;
 
-    auto broadcast = [=](Zmm z1, size_t offset, bool is_tail) {
+    auto broadcast = [=](Vmm v1, size_t offset, bool is_tail) {
         if (is_tail) {
-            vpxord(z1, z1, z1);
-            Xmm xmm_tmp = Xmm(z1.getIdx());
+            uni_vpxor(v1, v1, v1);
+            Xmm xmm_tmp = Xmm(v1.getIdx());
             load_bytes(
                     xmm_tmp, reg_aux_A, offset, rd_tail_size * brg.typesize_A);
-            vpbroadcastd(z1, xmm_tmp);
+            vpbroadcastd(v1, xmm_tmp);
         } else {
             if (brg.is_f32)
-                vbroadcastss(z1, ptr[reg_aux_A + offset]);
+                vbroadcastss(v1, ptr[reg_aux_A + offset]);
             else if (brg.is_bf16 || brg.is_int8)
-                vpbroadcastd(z1, ptr[reg_aux_A + offset]);
+                vpbroadcastd(v1, ptr[reg_aux_A + offset]);
         }
 
-        if (brg.req_s8s8_compensation) vpaddb(z1, z1, zmm_inp_shift());
+        if (brg.req_s8s8_compensation) vpaddb(v1, v1, vmm_inp_shift());
     };
 
 #if defined(_N_BCST_1_LOAD)
@@ -801,33 +935,22 @@ void jit_brgemm_kernel_base_t::gemm_microkernel_avx512(int bd_block2,
             broadcast(bcst(bd), A_offset(bd, rd), is_tail_bcast);
         }
         for (int ld = 0; ld < ld_block2; ld++) {
-            if (is_ld_tail) {
-                vmovups(load() | ld_tail_mask | T_z,
-                        ptr[reg_aux_B + B_offset(ld, rd)]);
-            } else {
-                vmovups(load(), ptr[reg_aux_B + B_offset(ld, rd)]);
-            }
+            load_B(load(), B_offset(ld, rd), is_ld_tail);
             for (int bd = 0; bd < bd_block; bd++) {
-                auto zmm = accm(ld_block2, bd, ld);
+                auto vmm = accm(ld_block2, bd, ld);
                 if (is_emdbd)
                     vfmadd231ps(
-                            zmm, load(), zword_b[reg_aux_A + A_offset(bd, rd)]);
+                            vmm, load(), zword_b[reg_aux_A + A_offset(bd, rd)]);
                 else
-                    dot_product(zmm, load(), bcst(bd));
+                    dot_product(vmm, load(), bcst(bd));
             }
         }
     }
 #else
     for (int rd = 0; rd < rd_loop; rd += brg.rd_step) {
         int prefetch_count_B = 0;
-        for (int ld = 0; ld < ld_block2; ld++) {
-            if (is_ld_tail) {
-                vmovups(load(ld) | ld_tail_mask | T_z,
-                        ptr[reg_aux_B + B_offset(ld, rd)]);
-            } else {
-                vmovups(load(ld), ptr[reg_aux_B + B_offset(ld, rd)]);
-            }
-        }
+        for (int ld = 0; ld < ld_block2; ld++)
+            load_B(load(ld), B_offset(ld, rd), is_ld_tail);
         for (int bd = 0; bd < bd_block; bd++) {
             if (!is_emdbd) {
                 bool is_tail_bcast = is_rd_tail && rd_tail_size != 0
@@ -840,30 +963,32 @@ void jit_brgemm_kernel_base_t::gemm_microkernel_avx512(int bd_block2,
                         + brg.LDB * brg.rd_block * brg.typesize_B]);
             }
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
+                auto vmm = accm(ld_block2, bd, ld);
                 if (is_emdbd)
-                    vfmadd231ps(zmm, load(ld),
+                    vfmadd231ps(vmm, load(ld),
                             zword_b[reg_aux_A + A_offset(bd, rd)]);
                 else
-                    dot_product(zmm, load(ld), bcst());
+                    dot_product(vmm, load(ld), bcst());
             }
         }
     }
 #endif
 }
 
-void jit_brgemm_kernel_base_t::gemm_microkernel(int bd_block2, bool is_bdb_tail,
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::gemm_microkernel(int bd_block2, bool is_bdb_tail,
         int ld_block2, bool is_rd_tail, bool is_ld_tail) {
     if (brg.is_int8_amx || brg.is_bf16_amx) {
         gemm_microkernel_amx(
                 bd_block2, is_bdb_tail, ld_block2, is_rd_tail, is_ld_tail);
     } else {
-        gemm_microkernel_avx512(
+        gemm_microkernel_uni(
                 bd_block2, is_bdb_tail, ld_block2, is_rd_tail, is_ld_tail);
     }
 }
 
-void jit_brgemm_kernel_base_t::ldb_loop(int bd_block2, bool is_bdb_tail,
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::ldb_loop(int bd_block2, bool is_bdb_tail,
         int ld_block2, int ldb_loop_length, bool is_reg_tail, bool is_ld_tail) {
 
     auto ldb_shift = [&](int ld_block2, bool is_tail = false) {
@@ -935,7 +1060,13 @@ void jit_brgemm_kernel_base_t::ldb_loop(int bd_block2, bool is_bdb_tail,
         if (brg.req_s8s8_compensation) {
             mov(ptr[rsp + reg_bdb_loop_offs_], reg_bdb_loop);
             mov(reg_s8_input_shift, 128);
-            vpbroadcastb(zmm_inp_shift(), reg_s8_input_shift.cvt8());
+            if (isa == avx2) {
+                // no broadcast from a general purpose register before AVX-512
+                const Xmm xmm_shift = Xmm(vmm_inp_shift().getIdx());
+                uni_vmovq(xmm_shift, reg_s8_input_shift);
+                vpbroadcastb(vmm_inp_shift(), xmm_shift);
+            } else
+                vpbroadcastb(vmm_inp_shift(), reg_s8_input_shift.cvt8());
             mov(reg_bdb_loop, ptr[rsp + reg_bdb_loop_offs_]);
         }
 
@@ -988,7 +1119,8 @@ void jit_brgemm_kernel_base_t::ldb_loop(int bd_block2, bool is_bdb_tail,
     jg(ldb_loop_label, T_NEAR);
 }
 
-void jit_brgemm_kernel_base_t::bdb_loop() {
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::bdb_loop() {
     auto do_ldb_loop = [=](int bd_block2, bool is_bdb_tail) {
         if (brg.ldb2 > 0) {
             const bool is_ld_reg_tail = false;
@@ -1017,7 +1149,7 @@ void jit_brgemm_kernel_base_t::bdb_loop() {
         add(reg_D, bdb_D_offset(bd_block2));
         add(reg_a_offset, bdb_A_offset(bd_block2));
     };
-    auto bdb_loop_avx512 = [=]() {
+    auto bdb_loop_uni = [=]() {
         Label bdb_loop_label;
         mov(reg_bdb_loop, brg.bdb);
         L_aligned(bdb_loop_label, 64);
@@ -1049,24 +1181,39 @@ void jit_brgemm_kernel_base_t::bdb_loop() {
     if (brg.is_int8_amx || brg.is_bf16_amx)
         bdb_loop_amx();
     else
-        bdb_loop_avx512();
+        bdb_loop_uni();
     if (brg.bdb_tail > 0) do_ldb_loop(1, true);
 }
 
-void jit_brgemm_kernel_base_t::generate() {
+template <cpu_isa_t isa>
+void jit_brgemm_kernel_t<isa>::generate() {
     preamble();
 
     sub(rsp, stack_space_needed_);
 
-    const auto full_mask = size_t {0xffffffffffffffff};
-    const auto tail_mask = size_t((1 << brg.ldb_tail) - 1);
+    if (isa == avx2) {
+        if (brg.ldb_tail > 0) {
+            mov_label_address(rax, l_tail_mask_table);
+            vmovups(vmm_tail_mask(),
+                    ptr[rax + (brg.ld_block - brg.ldb_tail) * sizeof(float)]);
+        }
+        if (brg.is_int8 && !is_avx2_vnni()) {
+            const Xmm xmm_one_words = Xmm(vmm_one_words().getIdx());
+            mov(eax, 0x00010001);
+            vmovd(xmm_one_words, eax);
+            vpbroadcastd(vmm_one_words(), xmm_one_words);
+        }
+    } else {
+        const auto full_mask = size_t {0xffffffffffffffff};
+        const auto tail_mask = size_t((1 << brg.ldb_tail) - 1);
 
-    reg64_t reg_mask = rax;
+        reg64_t reg_mask = rax;
 
-    mov(reg_mask, full_mask);
-    kmovq(ld_full_mask, reg_mask);
-    mov(reg_mask, tail_mask);
-    kmovq(ld_tail_mask, reg_mask);
+        mov(reg_mask, full_mask);
+        kmovq(ld_full_mask, reg_mask);
+        mov(reg_mask, tail_mask);
+        kmovq(ld_tail_mask, reg_mask);
+    }
 
     read_params();
 
@@ -1084,10 +1231,58 @@ void jit_brgemm_kernel_base_t::generate() {
     postamble();
 
     if (brg.with_eltwise) eltwise_injector_->prepare_table();
+
+    if (brg.with_sum && brg.sum_scale != 1.f) {
+        align(4);
+        L(l_sum_scale);
+        dd(float2int(brg.sum_scale));
+    }
+
+    if (isa == avx2 && brg.ldb_tail > 0) {
+        // The mask of the tail of ld_block elements starts at
+        // (ld_block - ldb_tail) elements before the zeros
+        align(32);
+        L(l_tail_mask_table);
+        for (int i = 0; i < brg.ld_block; i++)
+            dd(0xffffffff);
+        for (int i = 0; i < brg.ld_block; i++)
+            dd(0);
+    }
+}
+
+// The code is defined by the fields of the descriptor and by the post-ops
+// of the attributes, of which the order of sum and eltwise matters
+template <cpu_isa_t isa>
+std::string jit_brgemm_kernel_t<isa>::persistent_cache_key() const {
+    using jit_utils::code_cache::append_key;
+    std::string key;
+    append_key(key, brg.bcast_dim, brg.load_dim, brg.reduce_dim, brg.LDA,
+            brg.LDB, brg.LDC, brg.LDD, brg.alpha, brg.beta);
+    append_key(key, brg.bdb, brg.bd_block, brg.bdb_tail, brg.bdb2,
+            brg.bd_block2, brg.bdb2_tail, brg.ldb, brg.ld_block, brg.ldb_tail,
+            brg.ldb2, brg.ld_block2, brg.ldb2_tail, brg.rdb, brg.rd_block,
+            brg.rdb_tail, brg.rd_step, brg.ld_step);
+    append_key(key, brg.dt_a, brg.dt_b, brg.dt_c, brg.dt_d, brg.dt_bias,
+            brg.typesize_A, brg.typesize_B, brg.typesize_C, brg.typesize_D,
+            brg.typesize_bias);
+    append_key(key, brg.is_int8, brg.is_int8_amx, brg.is_bf16,
+            brg.is_bf16_amx, brg.is_f32, brg.isa, brg.stride_a, brg.stride_b,
+            brg.layout, brg.type, brg.embd_bcst);
+    append_key(key, brg.with_bias, brg.with_sum, brg.sum_scale,
+            brg.with_eltwise, brg.with_scales, brg.req_s8s8_compensation,
+            brg.is_oc_scale);
+    if ((brg.with_sum || brg.with_eltwise)
+            && !jit_utils::code_cache::append_post_ops_key(
+                    key, brg.attr->post_ops_))
+        return std::string();
+    return key;
 }
 
 brgemm_kernel_t::brgemm_kernel_t(const brgemm_t abrd) {
-    brgemm_kernel_ = new jit_brgemm_kernel_base_t(abrd);
+    if (one_of(abrd.isa, avx2, avx2_vnni))
+        brgemm_kernel_ = new jit_brgemm_kernel_t<avx2>(abrd);
+    else
+        brgemm_kernel_ = new jit_brgemm_kernel_t<avx512_common>(abrd);
 }
 
 status_t brgemm_kernel_t::create_kernel() {
@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include <cstdint>
+#include <vector>
 #if defined(_MSC_VER)
 #include <malloc.h>
 #endif
@@ -25,6 +26,7 @@
 #include "common/dnnl_traits.hpp"
 #include "common/nstl.hpp"
 #include "common/utils.hpp"
+#include "common/verbose.hpp"
 
 #include "cpu/platform.hpp"
 
@@ -37,6 +39,7 @@
 #include "cpu/x64/gemm/gemm_info.hpp"
 #include "cpu/x64/gemm/gemm_partition.hpp"
 #include "cpu/x64/gemm/gemm_threading.hpp"
+#include "cpu/x64/gemm/gemm_tune.hpp"
 #include "cpu/x64/gemm/gemm_utils.hpp"
 #include "cpu/x64/gemm/gemv_driver.hpp"
 
@@ -1626,129 +1629,19 @@ static dnnl_status_t call_no_copy_sgemm(
 }
 
 template <typename a_type, typename b_type, typename c_type>
-static dnnl_status_t gemm_threading_driver(
-        gemm_info_t<a_type, b_type, c_type> *arg) {
-
-    auto packing = (arg->packing != pack_type::none);
-    auto is_a_packed = (arg->transa == packed);
-    auto is_b_packed = (arg->transb == packed);
-    constexpr bool is_int8 = utils::one_of(
-            data_traits<a_type>::data_type, data_type::s8, data_type::u8);
-    constexpr bool is_bf16 = data_traits<a_type>::data_type == data_type::bf16;
-
-    if ((arg->m <= 0) || (arg->n <= 0)) return dnnl_success;
-
-    if (!is_a_packed && !is_b_packed && jump_to_gemv_s8x8s32(arg))
-        return dnnl_success;
-
-    if (!is_a_packed && !is_b_packed
-            && jump_to_gemm_smalln_tn(arg) == dnnl_success)
-        return dnnl_success;
-
-    if (!is_a_packed && !is_b_packed && jump_to_gemv(arg) == dnnl_success)
-        return dnnl_success;
-
-    if (is_a_packed && arg->bo != 0)
-        if (!arg->a_packed->has_row_sums()) return dnnl_invalid_arguments;
-
-    if (is_b_packed && arg->ao != 0)
-        if (!arg->b_packed->has_col_sums()) return dnnl_invalid_arguments;
-
-    auto nthr_max = dnnl_get_current_num_threads();
-    int nthr_goal = nthr_max;
-
-    adjust_thread_count<c_type>(arg->m, arg->n, arg->k, &nthr_goal);
-
-    const gemm_threading_t *force_threading = nullptr;
-    gemm_threading_t force_k_decomp;
-
-    // Initialize per-thread data.
-    // Note: to support k blocking with non-packed GEMM, threading must be
-    //   chosen now and force_threading set.
-    if (!packing) {
-        // Override choice of thread count if data is pre-packed for a particular
-        //  number of threads.
-        if (is_a_packed && is_b_packed)
-            if (arg->a_packed->threading() != arg->b_packed->threading())
-                return dnnl_invalid_arguments;
-        if (is_a_packed)
-            force_threading = &arg->a_packed->threading();
-        else if (is_b_packed)
-            force_threading = &arg->b_packed->threading();
-        else if (arg->m <= 768 && arg->n <= 768 && arg->k >= 2048 && is_bf16) {
-            // Try k-partitioning.
-            set_thread_opts_pack(nthr_goal, force_k_decomp, arg);
-
-            // Decide partition type later if no partitions in k-dimension.
-            if (force_k_decomp.nthrs_k > 1) force_threading = &force_k_decomp;
-        } else if (arg->n <= 128 && arg->k >= 3072 && is_int8) {
-            // Use k-partitioning if necessary.
-            // Use 3D decomposition from pack api without n-partitioning.
-            set_thread_opts_pack(
-                    nthr_goal, force_k_decomp, arg, true, true, false);
-
-            // Decide partition type later if no partitions in k-dimension.
-            if (force_k_decomp.nthrs_k > 1 && force_k_decomp.nthrs_m > 1)
-                force_threading = &force_k_decomp;
-        }
-
-        if (force_threading) {
-            nthr_goal = force_threading->nthrs();
-            arg->update_blocking(*force_threading);
-        }
-    } else {
-        // Prepare packed data layout.
-        gemm_pack_storage_t *pack_dst = arg->pack_dst;
-        bool do_a = (arg->packing == pack_type::pack_a);
-
-        pack_dst->which() = do_a ? matrix_id::a : matrix_id::b;
-        pack_dst->setup(nthr_goal, do_a && is_int8, !do_a && is_int8);
-
-        auto &thread_info = pack_dst->threading();
-        force_threading = &thread_info;
+static dnnl_status_t gemm_threading_execute(
+        gemm_info_t<a_type, b_type, c_type> *arg, int nthr_goal,
+        const gemm_threading_t *force_threading, bool nocopy) {
 
-        nthr_goal = set_thread_opts(nthr_goal, nthr_max, thread_info, arg);
-        arg->update_blocking(thread_info);
-
-        if (thread_info.copy != copy_type::no_copy) {
-            for (int ithr = 0; ithr < nthr_goal; ithr++) {
-                if (!pack_dst->is_first_thread_in_slice(ithr)) continue;
-
-                auto slice = thread_info.get_thread_slice(
-                        ithr, arg->m, arg->n, arg->k);
-
-                auto m = slice.m, n = slice.n, k = slice.k;
-
-                auto m_padd = (thread_info.copy == copy_type::shared_a)
-                        ? get_m_padd_parallel_a(
-                                ithr, m, arg, thread_info.nthrs())
-                        : get_m_padd(ithr, m, arg);
-                auto n_padd = get_n_padd(ithr, n, k, arg);
-                auto k_padd = get_k_padd(ithr, k, arg);
-
-                do_a ? pack_dst->set_blocking(ithr, m, k, m_padd, k_padd)
-                     : pack_dst->set_blocking(ithr, k, n, k_padd, n_padd);
-            }
-        } else {
-            auto ld = do_a ? gemm_utils::get_ld_padd<a_type>(arg->m)
-                           : gemm_utils::get_ld_padd<b_type>(arg->k);
-
-            pack_dst->set_nocopy(0, no_trans, ld, do_a ? arg->k : arg->n);
-        }
-
-        do_a ? pack_dst->finalize<a_type, c_type>()
-             : pack_dst->finalize<b_type, c_type>();
-
-        if (arg->measure_only) return dnnl_success;
-    }
-
-    if (nocopy_checker(nthr_goal, arg))
-        return call_no_copy_sgemm(nthr_goal, arg);
+    if (nocopy) return call_no_copy_sgemm(nthr_goal, arg);
 
     if (nthr_goal == 1)
         return gemm_kernel_driver(0, arg->m, arg->n, arg->k, arg->a, arg->b,
                 arg->beta, arg->c, arg->ldc, arg->offsetc, arg->co, arg);
 
+    auto packing = (arg->packing != pack_type::none);
+    auto nthr_max = dnnl_get_current_num_threads();
+
     bool k_blocking = force_threading && (force_threading->nthrs_k > 1);
     bool k_summing = k_blocking && !packing;
 
@@ -1931,6 +1824,283 @@ static dnnl_status_t gemm_threading_driver(
     return result;
 }
 
+// Candidate decompositions timed by the threading autotuning, in addition to
+// the one chosen by the default heuristics.
+template <typename a_type, typename b_type, typename c_type>
+static std::vector<gemm_threading_t> gemm_tune_candidates(
+        int nthr, const gemm_info_t<a_type, b_type, c_type> *arg) {
+
+    std::vector<gemm_threading_t> candidates;
+    auto add_candidate = [&](const gemm_threading_t &t) {
+        if (t.nthrs() < 1) return;
+        for (const auto &c : candidates)
+            if (c == t) return;
+        candidates.push_back(t);
+    };
+
+    gemm_threading_t t;
+    t.block_m = t.block_n = t.block_k = -1;
+    t.thread_m = t.thread_n = t.thread_k = -1;
+    t.nthrs_k = 1;
+    t.copy = copy_type::nonshared;
+
+    t.partition = partition_type::row_1d;
+    t.nthrs_m = nthr;
+    t.nthrs_n = 1;
+    add_candidate(t);
+
+    if (nthr > 1) {
+        t.partition = partition_type::col_1d;
+        t.nthrs_m = 1;
+        t.nthrs_n = nthr;
+        add_candidate(t);
+
+        // 2D grid with the smallest perimeter of the blocks of C.
+        int best_nthr_m = 1;
+        double best_perimeter = 0;
+        for (int nthr_m = 2; nthr_m < nthr; nthr_m++) {
+            if (nthr % nthr_m != 0) continue;
+            double perimeter = (double)arg->m / nthr_m
+                    + (double)arg->n / (nthr / nthr_m);
+            if (best_nthr_m == 1 || perimeter < best_perimeter) {
+                best_nthr_m = nthr_m;
+                best_perimeter = perimeter;
+            }
+        }
+        if (best_nthr_m > 1) {
+            t.partition = partition_type::col_major_2d;
+            t.nthrs_m = best_nthr_m;
+            t.nthrs_n = nthr / best_nthr_m;
+            add_candidate(t);
+        }
+
+        // 3D decomposition of the pack API, partitioning k if profitable.
+        gemm_threading_t t_3d;
+        set_thread_opts_pack(nthr, t_3d, arg);
+        add_candidate(t_3d);
+    }
+
+    // No-copy kernels choose the decomposition themselves.
+    if (data_traits<a_type>::data_type == data_type::f32 && mayiuse(avx)) {
+        t.partition = partition_type::row_1d;
+        t.nthrs_m = nthr;
+        t.nthrs_n = 1;
+        t.copy = copy_type::no_copy;
+        add_candidate(t);
+    }
+
+    return candidates;
+}
+
+// Runs the GEMM with the decomposition chosen by the default heuristics, which
+// may be forced to a k-partitioning, or with an explicit one.
+template <typename a_type, typename b_type, typename c_type>
+static dnnl_status_t gemm_tune_run(gemm_info_t<a_type, b_type, c_type> arg,
+        int nthr_goal, const gemm_threading_t *threading, bool heuristic) {
+
+    if (threading) {
+        nthr_goal = threading->nthrs();
+        arg.update_blocking(*threading);
+    }
+
+    if (!heuristic && threading->copy == copy_type::no_copy)
+        return call_no_copy_sgemm(nthr_goal, &arg);
+
+    bool nocopy = heuristic && nocopy_checker(nthr_goal, &arg);
+    return gemm_threading_execute(&arg, nthr_goal, threading, nocopy);
+}
+
+template <typename a_type, typename b_type, typename c_type>
+static dnnl_status_t gemm_tune_driver(gemm_info_t<a_type, b_type, c_type> *arg,
+        int nthr_max, int nthr_goal, const gemm_threading_t *force_threading) {
+
+    gemm_tune_key_t key = {get_max_cpu_isa_mask(),
+            data_traits<a_type>::data_type, data_traits<b_type>::data_type,
+            data_traits<c_type>::data_type, arg->transa, arg->transb, arg->m,
+            arg->n, arg->k, arg->lda, arg->ldb, arg->ldc, nthr_max};
+
+    gemm_tune_entry_t entry;
+    if (gemm_tune_lookup(key, entry))
+        return gemm_tune_run(*arg, nthr_goal,
+                entry.heuristic ? force_threading : &entry.threading,
+                entry.heuristic);
+
+    // Each candidate computes the complete result. C is restored before each
+    // run if beta is non-zero, so that the last successful run leaves the
+    // expected values.
+    dim_t c_size = arg->ldc * (arg->n - 1) + arg->m;
+    c_type *c_orig = nullptr;
+    if (arg->beta != 0.0f) {
+        c_orig = (c_type *)malloc(sizeof(c_type) * c_size, PAGE_4K);
+        if (!c_orig) return dnnl_out_of_memory;
+        utils::array_copy(c_orig, arg->c, c_size);
+    }
+
+    // Warm-up run.
+    dnnl_status_t result
+            = gemm_tune_run(*arg, nthr_goal, force_threading, true);
+    if (result != dnnl_success) {
+        if (c_orig) dnnl::impl::free(c_orig);
+        return result;
+    }
+
+    auto candidates = gemm_tune_candidates(nthr_goal, arg);
+    auto run_candidate = [&](int idx) {
+        if (c_orig) utils::array_copy(arg->c, c_orig, c_size);
+        bool heuristic = idx < 0;
+        return gemm_tune_run(*arg, nthr_goal,
+                heuristic ? force_threading : &candidates[idx], heuristic);
+    };
+
+    // Index -1 stands for the default heuristics.
+    int best = -1;
+    double best_time = 0;
+    for (int idx = -1; idx < (int)candidates.size(); idx++) {
+        double start = get_msec();
+        result = run_candidate(idx);
+        double time = get_msec() - start;
+        if (result != dnnl_success) continue;
+        if (idx == -1 || time < best_time) {
+            best = idx;
+            best_time = time;
+        }
+    }
+
+    if (result != dnnl_success) result = run_candidate(best);
+    if (c_orig) dnnl::impl::free(c_orig);
+
+    entry.heuristic = best < 0;
+    entry.threading = best < 0 ? gemm_threading_t() : candidates[best];
+    if (result == dnnl_success) gemm_tune_record(key, entry);
+
+    return result;
+}
+
+template <typename a_type, typename b_type, typename c_type>
+static dnnl_status_t gemm_threading_driver(
+        gemm_info_t<a_type, b_type, c_type> *arg) {
+
+    auto packing = (arg->packing != pack_type::none);
+    auto is_a_packed = (arg->transa == packed);
+    auto is_b_packed = (arg->transb == packed);
+    constexpr bool is_int8 = utils::one_of(
+            data_traits<a_type>::data_type, data_type::s8, data_type::u8);
+    constexpr bool is_bf16 = data_traits<a_type>::data_type == data_type::bf16;
+
+    if ((arg->m <= 0) || (arg->n <= 0)) return dnnl_success;
+
+    if (!is_a_packed && !is_b_packed && jump_to_gemv_s8x8s32(arg))
+        return dnnl_success;
+
+    if (!is_a_packed && !is_b_packed
+            && jump_to_gemm_smalln_tn(arg) == dnnl_success)
+        return dnnl_success;
+
+    if (!is_a_packed && !is_b_packed && jump_to_gemv(arg) == dnnl_success)
+        return dnnl_success;
+
+    if (is_a_packed && arg->bo != 0)
+        if (!arg->a_packed->has_row_sums()) return dnnl_invalid_arguments;
+
+    if (is_b_packed && arg->ao != 0)
+        if (!arg->b_packed->has_col_sums()) return dnnl_invalid_arguments;
+
+    auto nthr_max = dnnl_get_current_num_threads();
+    int nthr_goal = nthr_max;
+
+    adjust_thread_count<c_type>(arg->m, arg->n, arg->k, &nthr_goal);
+
+    const gemm_threading_t *force_threading = nullptr;
+    gemm_threading_t force_k_decomp;
+
+    // Initialize per-thread data.
+    // Note: to support k blocking with non-packed GEMM, threading must be
+    //   chosen now and force_threading set.
+    if (!packing) {
+        // Override choice of thread count if data is pre-packed for a particular
+        //  number of threads.
+        if (is_a_packed && is_b_packed)
+            if (arg->a_packed->threading() != arg->b_packed->threading())
+                return dnnl_invalid_arguments;
+        if (is_a_packed)
+            force_threading = &arg->a_packed->threading();
+        else if (is_b_packed)
+            force_threading = &arg->b_packed->threading();
+        else if (arg->m <= 768 && arg->n <= 768 && arg->k >= 2048 && is_bf16) {
+            // Try k-partitioning.
+            set_thread_opts_pack(nthr_goal, force_k_decomp, arg);
+
+            // Decide partition type later if no partitions in k-dimension.
+            if (force_k_decomp.nthrs_k > 1) force_threading = &force_k_decomp;
+        } else if (arg->n <= 128 && arg->k >= 3072 && is_int8) {
+            // Use k-partitioning if necessary.
+            // Use 3D decomposition from pack api without n-partitioning.
+            set_thread_opts_pack(
+                    nthr_goal, force_k_decomp, arg, true, true, false);
+
+            // Decide partition type later if no partitions in k-dimension.
+            if (force_k_decomp.nthrs_k > 1 && force_k_decomp.nthrs_m > 1)
+                force_threading = &force_k_decomp;
+        }
+
+        if (get_gemm_tune() && !is_a_packed && !is_b_packed
+                && !arg->force_nocopy)
+            return gemm_tune_driver(arg, nthr_max, nthr_goal, force_threading);
+
+        if (force_threading) {
+            nthr_goal = force_threading->nthrs();
+            arg->update_blocking(*force_threading);
+        }
+    } else {
+        // Prepare packed data layout.
+        gemm_pack_storage_t *pack_dst = arg->pack_dst;
+        bool do_a = (arg->packing == pack_type::pack_a);
+
+        pack_dst->which() = do_a ? matrix_id::a : matrix_id::b;
+        pack_dst->setup(nthr_goal, do_a && is_int8, !do_a && is_int8);
+
+        auto &thread_info = pack_dst->threading();
+        force_threading = &thread_info;
+
+        nthr_goal = set_thread_opts(nthr_goal, nthr_max, thread_info, arg);
+        arg->update_blocking(thread_info);
+
+        if (thread_info.copy != copy_type::no_copy) {
+            for (int ithr = 0; ithr < nthr_goal; ithr++) {
+                if (!pack_dst->is_first_thread_in_slice(ithr)) continue;
+
+                auto slice = thread_info.get_thread_slice(
+                        ithr, arg->m, arg->n, arg->k);
+
+                auto m = slice.m, n = slice.n, k = slice.k;
+
+                auto m_padd = (thread_info.copy == copy_type::shared_a)
+                        ? get_m_padd_parallel_a(
+                                ithr, m, arg, thread_info.nthrs())
+                        : get_m_padd(ithr, m, arg);
+                auto n_padd = get_n_padd(ithr, n, k, arg);
+                auto k_padd = get_k_padd(ithr, k, arg);
+
+                do_a ? pack_dst->set_blocking(ithr, m, k, m_padd, k_padd)
+                     : pack_dst->set_blocking(ithr, k, n, k_padd, n_padd);
+            }
+        } else {
+            auto ld = do_a ? gemm_utils::get_ld_padd<a_type>(arg->m)
+                           : gemm_utils::get_ld_padd<b_type>(arg->k);
+
+            pack_dst->set_nocopy(0, no_trans, ld, do_a ? arg->k : arg->n);
+        }
+
+        do_a ? pack_dst->finalize<a_type, c_type>()
+             : pack_dst->finalize<b_type, c_type>();
+
+        if (arg->measure_only) return dnnl_success;
+    }
+
+    return gemm_threading_execute(
+            arg, nthr_goal, force_threading, nocopy_checker(nthr_goal, arg));
+}
+
 template <typename a_type, typename b_type, typename c_type>
 dnnl_status_t gemm_driver(const char *transA, const char *transB,
         const char *offsetC, const dim_t *m, const dim_t *n, const dim_t *k,
@@ -0,0 +1,176 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/utils.hpp"
+
+#include "cpu/x64/gemm/gemm_tune.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+namespace {
+
+struct gemm_tune_key_hash_t {
+    size_t operator()(const gemm_tune_key_t &key) const {
+        size_t seed = 0;
+        seed = hash_combine(seed, static_cast<unsigned>(key.isa));
+        seed = hash_combine(seed, static_cast<int>(key.a_dt));
+        seed = hash_combine(seed, static_cast<int>(key.b_dt));
+        seed = hash_combine(seed, static_cast<int>(key.c_dt));
+        seed = hash_combine(seed, key.transa);
+        seed = hash_combine(seed, key.transb);
+        seed = hash_combine(seed, key.m);
+        seed = hash_combine(seed, key.n);
+        seed = hash_combine(seed, key.k);
+        seed = hash_combine(seed, key.lda);
+        seed = hash_combine(seed, key.ldb);
+        seed = hash_combine(seed, key.ldc);
+        seed = hash_combine(seed, key.nthr);
+        return seed;
+    }
+};
+
+// Each line of the file holds one entry:
+// isa a_dt b_dt c_dt transa transb m n k lda ldb ldc nthr : heuristic copy
+// partition nthrs_m nthrs_n nthrs_k thread_m thread_n thread_k block_m block_n
+// block_k
+const char *tune_file_format
+        = "%x %d %d %d %d %d %lld %lld %lld %lld %lld %lld %d"
+          " : %d %d %d %d %d %d %lld %lld %lld %lld %lld %lld\n";
+
+// The entries of the file are not trusted: an explicit variant must use at
+// most the threads of its key, and the no-copy variant exists for f32 only
+bool entry_ok(const gemm_tune_key_t &key, const gemm_tune_entry_t &entry) {
+    using namespace data_type;
+    if (key.nthr <= 0) return false;
+    if (entry.heuristic) return true;
+
+    const auto &t = entry.threading;
+    const bool copy_ok
+            = utils::one_of(t.copy, copy_type::nonshared, copy_type::shared_a)
+            || (t.copy == copy_type::no_copy
+                    && utils::everyone_is(f32, key.a_dt, key.b_dt, key.c_dt));
+    const bool partition_ok = utils::one_of(t.partition, partition_type::row_1d,
+            partition_type::col_1d, partition_type::col_major_2d,
+            partition_type::mnk_3d);
+    return copy_ok && partition_ok && t.nthrs_m > 0 && t.nthrs_n > 0
+            && t.nthrs_k > 0 && t.nthrs() <= key.nthr;
+}
+
+struct gemm_tune_table_t {
+    gemm_tune_table_t() {
+        const char *name = "DNNL_GEMM_TUNE_FILE";
+        // The length of the value is returned negated for an empty buffer.
+        const int len = -getenv(name, nullptr, 0);
+        if (len <= 0) return;
+        std::vector<char> buf(len + 1);
+        if (getenv(name, buf.data(), len + 1) != len) return;
+        file_ = buf.data();
+
+        FILE *fp = impl::fopen(file_.c_str(), "r");
+        if (!fp) return;
+
+        unsigned isa;
+        int dt[3], trans[2], nthr, heuristic, copy, partition, nthrs[3];
+        long long mnk[3], ld[3], thread[3], block[3];
+        // Later lines override the earlier ones for the same key. The entries
+        // tuned for other ISAs are loaded but never looked up.
+        while (fscanf(fp, tune_file_format, &isa, &dt[0], &dt[1], &dt[2],
+                       &trans[0], &trans[1], &mnk[0], &mnk[1], &mnk[2],
+                       &ld[0], &ld[1], &ld[2], &nthr, &heuristic, &copy,
+                       &partition, &nthrs[0], &nthrs[1], &nthrs[2],
+                       &thread[0], &thread[1], &thread[2], &block[0],
+                       &block[1], &block[2])
+                == 25) {
+            gemm_tune_key_t key = {(cpu_isa_t)isa, (data_type_t)dt[0],
+                    (data_type_t)dt[1], (data_type_t)dt[2], trans[0],
+                    trans[1], mnk[0], mnk[1], mnk[2], ld[0], ld[1], ld[2],
+                    nthr};
+            gemm_tune_entry_t entry;
+            entry.heuristic = heuristic != 0;
+            entry.threading = {nthrs[0], nthrs[1], nthrs[2], block[0],
+                    block[1], block[2], thread[0], thread[1], thread[2],
+                    (partition_type)partition, (copy_type)copy};
+            if (entry_ok(key, entry)) entries_[key] = entry;
+        }
+        fclose(fp);
+    }
+
+    bool lookup(const gemm_tune_key_t &key, gemm_tune_entry_t &entry) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) return false;
+        entry = it->second;
+        return true;
+    }
+
+    void record(const gemm_tune_key_t &key, const gemm_tune_entry_t &entry) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        entries_[key] = entry;
+        if (file_.empty()) return;
+
+        FILE *fp = impl::fopen(file_.c_str(), "a");
+        if (!fp) return;
+        const auto &t = entry.threading;
+        fprintf(fp, tune_file_format, (unsigned)key.isa, (int)key.a_dt,
+                (int)key.b_dt, (int)key.c_dt, key.transa, key.transb,
+                (long long)key.m, (long long)key.n, (long long)key.k,
+                (long long)key.lda, (long long)key.ldb, (long long)key.ldc,
+                key.nthr, (int)entry.heuristic, (int)t.copy, (int)t.partition,
+                t.nthrs_m, t.nthrs_n, t.nthrs_k, (long long)t.thread_m,
+                (long long)t.thread_n, (long long)t.thread_k,
+                (long long)t.block_m, (long long)t.block_n,
+                (long long)t.block_k);
+        fclose(fp);
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<gemm_tune_key_t, gemm_tune_entry_t,
+            gemm_tune_key_hash_t>
+            entries_;
+    std::string file_;
+};
+
+gemm_tune_table_t &tune_table() {
+    // Leaked to be usable from the destructors of other static objects.
+    static gemm_tune_table_t *table = new gemm_tune_table_t();
+    return *table;
+}
+
+} // namespace
+
+bool gemm_tune_lookup(const gemm_tune_key_t &key, gemm_tune_entry_t &entry) {
+    return tune_table().lookup(key, entry);
+}
+
+void gemm_tune_record(
+        const gemm_tune_key_t &key, const gemm_tune_entry_t &entry) {
+    tune_table().record(key, entry);
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
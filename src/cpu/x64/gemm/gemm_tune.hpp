@@ -0,0 +1,67 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_GEMM_GEMM_TUNE_HPP
+#define CPU_X64_GEMM_GEMM_TUNE_HPP
+
+#include "common/c_types_map.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+#include "cpu/x64/gemm/gemm_threading.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Signature of a GEMM problem the threading is tuned for. The ISA keeps the
+// variants tuned on one CPU from being used on another one.
+struct gemm_tune_key_t {
+    cpu_isa_t isa;
+    data_type_t a_dt, b_dt, c_dt;
+    int transa, transb;
+    dim_t m, n, k;
+    dim_t lda, ldb, ldc;
+    int nthr;
+
+    bool operator==(const gemm_tune_key_t &rhs) const {
+        return isa == rhs.isa && a_dt == rhs.a_dt && b_dt == rhs.b_dt && c_dt == rhs.c_dt
+                && transa == rhs.transa && transb == rhs.transb && m == rhs.m
+                && n == rhs.n && k == rhs.k && lda == rhs.lda
+                && ldb == rhs.ldb && ldc == rhs.ldc && nthr == rhs.nthr;
+    }
+};
+
+// Fastest variant found for a signature: either the decomposition chosen by
+// the default heuristics, or an explicit one.
+struct gemm_tune_entry_t {
+    bool heuristic;
+    gemm_threading_t threading;
+};
+
+// Process-wide table of the tuned variants. The table is loaded from the file
+// named by DNNL_GEMM_TUNE_FILE, if any, and the new variants are appended to
+// it.
+bool gemm_tune_lookup(const gemm_tune_key_t &key, gemm_tune_entry_t &entry);
+void gemm_tune_record(
+        const gemm_tune_key_t &key, const gemm_tune_entry_t &entry);
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -113,7 +113,7 @@ struct jit_uni_eltwise_injector_f32 {
     void compute_vector_range(const injector_utils::vmm_index_set_t &vmm_idxs);
     void compute_vector(size_t idx) { compute_vector_range({idx}); }
     void prepare_table(bool gen_table = true);
-    void load_table_addr() { h->mov(p_table, l_table); }
+    void load_table_addr() { h->mov_label_address(p_table, l_table); }
 
 private:
     const alg_kind_t alg_;
@@ -1000,6 +1000,22 @@ void _jit_avx512_common_conv_fwd_kernel<Vmm>::compute_loop(
     if (jcp.ndims == 5) pop(reg_oi);
 }
 
+// The kernel code is defined by jcp only, which is stored as is except for the
+// post-ops entries living outside of the structure.
+template <typename Vmm>
+std::string
+_jit_avx512_common_conv_fwd_kernel<Vmm>::persistent_cache_key() const {
+    std::string key(reinterpret_cast<const char *>(&jcp), sizeof(jcp));
+    const auto &po = jcp.post_ops;
+    const size_t po_offt = reinterpret_cast<const char *>(&po)
+            - reinterpret_cast<const char *>(&jcp);
+    std::fill(key.begin() + po_offt, key.begin() + po_offt + sizeof(po), '\0');
+
+    if (!jit_utils::code_cache::append_post_ops_key(key, po))
+        return std::string();
+    return key;
+}
+
 template <typename Vmm>
 void _jit_avx512_common_conv_fwd_kernel<Vmm>::generate() {
     int iw = jcp.iw;
@@ -124,6 +124,7 @@ private:
     inline void compute_loop(int ur_w, int pad_l, int pad_r);
 
     void generate() override;
+    std::string persistent_cache_key() const override;
 
     inline size_t get_output_offset(int oi, int n_oc_block) {
         const bool is_nxc_layout = is_dst_layout_nxc();
@@ -0,0 +1,260 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/amx_tile_configure.hpp"
+#include "cpu/x64/jit_brgemm_conv.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::data_type;
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::utils;
+
+using namespace nstl;
+
+template <cpu_isa_t isa, data_type_t src_type, data_type_t wei_type,
+        data_type_t dst_type>
+void brgemm_convolution_fwd_t<isa, src_type, wei_type,
+        dst_type>::execute_forward(const exec_ctx_t &ctx) const {
+    auto src_ = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
+    auto weights_ = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
+    auto bias = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+
+    auto src = const_cast<src_data_t *>(src_);
+    auto weights = const_cast<wei_data_t *>(weights_);
+
+    memory_tracking::grantor_t scratchpad = ctx.get_scratchpad_grantor();
+    const size_t bia_dt_size = pd()->with_bias()
+            ? types::data_type_size(pd()->desc()->bias_desc.data_type)
+            : 0;
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper weights_d(pd()->weights_md(0));
+
+    const float *oscales = pd()->attr()->output_scales_.scales_;
+
+    const auto &jbgp = pd()->jbgp_;
+
+    src_data_t **addr_A_global = scratchpad.template get<src_data_t *>(
+            key_brgemm_primitive_addr_a);
+    wei_data_t **addr_B_global = scratchpad.template get<wei_data_t *>(
+            key_brgemm_primitive_addr_b);
+    char *c_buffer_global = (jbgp.use_buffer)
+            ? scratchpad.template get<char>(key_brgemm_primitive_buffer)
+            : nullptr;
+    const bool is_amx = one_of(
+            jbgp.isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
+    char *wsp_tile_base = is_amx
+            ? scratchpad.template get<char>(key_conv_amx_tile_buffer)
+            : nullptr;
+
+    const bool are_post_ops_applicable = one_of(true, jbgp.with_sum,
+            jbgp.with_bias, jbgp.with_scales, jbgp.with_eltwise,
+            jbgp.acc_dt != jbgp.dst_dt, jbgp.signed_input);
+
+    size_t offset = weights_d.size() - weights_d.additional_buffer_size();
+    int32_t *compensation = (jbgp.signed_input)
+            ? reinterpret_cast<int32_t *>(&weights[offset])
+            : nullptr;
+
+    const int ndims = jbgp.ndims;
+    const int nb_ic_full = jbgp.ic / jbgp.ic_block;
+    const bool has_ic_tail = jbgp.K_tail > 0;
+    const int ow_border_l = jbgp.ow_full_s;
+    const int ow_segs = ow_border_l + jbgp.nb_ow + (jbgp.ow - jbgp.ow_full_e);
+
+    // Channels are addressed by element in nspc layouts and by block in
+    // blocked ones
+    const auto src_off = [&](int n, int ic, int id, int ih, int iw) {
+        const int c = jbgp.is_nspc ? ic : ic / jbgp.ic_block;
+        if (ndims == 3) return src_d.blk_off(n, c, iw);
+        if (ndims == 4) return src_d.blk_off(n, c, ih, iw);
+        return src_d.blk_off(n, c, id, ih, iw);
+    };
+    const auto dst_off = [&](int n, int oc, int od, int oh, int ow) {
+        const int c = jbgp.is_nspc ? oc : oc / jbgp.oc_block;
+        if (ndims == 3) return dst_d.blk_off(n, c, ow);
+        if (ndims == 4) return dst_d.blk_off(n, c, oh, ow);
+        return dst_d.blk_off(n, c, od, oh, ow);
+    };
+    const auto wei_off = [&](int ocb, int icb, int kd, int kh, int kw) {
+        if (ndims == 3) return weights_d.blk_off(ocb, icb, kw);
+        if (ndims == 4) return weights_d.blk_off(ocb, icb, kh, kw);
+        return weights_d.blk_off(ocb, icb, kd, kh, kw);
+    };
+
+    const auto ker = [&](const int ithr, int &last_brg_ker_idx, int n, int od,
+                             int oh, int ow_s, int M_kind, int ocb) {
+        src_data_t **addr_A = addr_A_global + ithr * jbgp.gemm_batch_size;
+        wei_data_t **addr_B = addr_B_global + ithr * jbgp.gemm_batch_size;
+        char *c_buffer = (jbgp.use_buffer) ? c_buffer_global
+                        + ithr * types::data_type_size(jbgp.acc_dt) * jbgp.LDC
+                                * jbgp.M
+                                           : nullptr;
+        char *wsp_tile = is_amx ? wsp_tile_base + ithr * 1024 : nullptr;
+
+        const int oc = ocb * jbgp.oc_block;
+        const bool is_oc_tail = (jbgp.oc - oc < jbgp.oc_block);
+
+        // Segments are either fully inside of the src width or consist of a
+        // single point, so the kw range of the first point fits all of them.
+        const int id_s = od * jbgp.stride_d - jbgp.f_pad;
+        const int ih_s = oh * jbgp.stride_h - jbgp.t_pad;
+        const int iw_s = ow_s * jbgp.stride_w - jbgp.l_pad;
+        int kd_s {0}, kd_f {0}, kh_s {0}, kh_f {0}, kw_s {0}, kw_f {0};
+        brgemm_convolution_utils::get_kernel_range(
+                id_s, jbgp.id, jbgp.kd, jbgp.dilate_d, kd_s, kd_f);
+        brgemm_convolution_utils::get_kernel_range(
+                ih_s, jbgp.ih, jbgp.kh, jbgp.dilate_h, kh_s, kh_f);
+        brgemm_convolution_utils::get_kernel_range(
+                iw_s, jbgp.iw, jbgp.kw, jbgp.dilate_w, kw_s, kw_f);
+
+        const auto init_batch = [&](int icb_s, int icb_e) {
+            int bs = 0;
+            for_(int icb = icb_s; icb < icb_e; icb++)
+            for_(int kd = kd_s; kd < kd_f; kd++)
+            for_(int kh = kh_s; kh < kh_f; kh++)
+            for (int kw = kw_s; kw < kw_f; kw++) {
+                const int id = id_s + kd * (jbgp.dilate_d + 1);
+                const int ih = ih_s + kh * (jbgp.dilate_h + 1);
+                const int iw = iw_s + kw * (jbgp.dilate_w + 1);
+                addr_A[bs] = src + src_off(n, icb * jbgp.ic_block, id, ih, iw);
+                addr_B[bs] = weights + wei_off(ocb, icb, kd, kh, kw);
+                bs++;
+            }
+            return bs;
+        };
+
+        const auto call_brgemm = [&](int brg_ker_idx, int bs, bool do_postops) {
+            auto brg_kernel = brg_kernels_[brg_ker_idx].get();
+            if (is_amx && brg_ker_idx != last_brg_ker_idx) {
+                amx_tile_configure(&brg_kernel_palettes_[brg_ker_idx][0]);
+                last_brg_ker_idx = brg_ker_idx;
+            }
+            auto ptr_D = dst + dst_off(n, oc, od, oh, ow_s);
+            char *ptr_C = (jbgp.use_buffer) ? c_buffer : (char *)ptr_D;
+            if (do_postops) {
+                auto bias_w
+                        = jbgp.with_bias ? bias + bia_dt_size * oc : nullptr;
+                brgemm_kernel_execute_postops(brg_kernel, bs, (void **)addr_A,
+                        (void **)addr_B, (void *)ptr_C, (void *)ptr_D,
+                        (void *)bias_w, &oscales[jbgp.is_oc_scale * oc],
+                        is_amx ? (void *)wsp_tile
+                               : (jbgp.signed_input ? &compensation[oc]
+                                                    : nullptr));
+            } else {
+                brgemm_kernel_execute(brg_kernel, bs, (void **)addr_A,
+                        (void **)addr_B, (void *)ptr_C,
+                        is_amx ? (void *)wsp_tile : nullptr);
+            }
+        };
+
+        const int bs = init_batch(0, nb_ic_full);
+        if (bs > 0) {
+            const int brg_ker_idx = pd()->get_brg_kernel_idx(
+                    true, M_kind, is_oc_tail, false);
+            call_brgemm(brg_ker_idx, bs,
+                    are_post_ops_applicable && !has_ic_tail);
+        }
+        if (has_ic_tail) {
+            const int bs_tail = init_batch(nb_ic_full, nb_ic_full + 1);
+            const int brg_ker_idx = pd()->get_brg_kernel_idx(
+                    bs == 0, M_kind, is_oc_tail, true);
+            call_brgemm(brg_ker_idx, bs_tail, are_post_ops_applicable);
+        }
+    };
+
+    const int work_amount
+            = jbgp.mb * jbgp.od * jbgp.oh * ow_segs * jbgp.nb_oc;
+
+    parallel(jbgp.nthr, [&](const int ithr, const int nthr) {
+        if (ithr >= work_amount) return;
+
+        int start {0}, end {0};
+        balance211(work_amount, nthr, ithr, start, end);
+
+        int n {0}, odi {0}, ohi {0}, owsi {0}, ocb {0};
+        nd_iterator_init(start, n, jbgp.mb, odi, jbgp.od, ohi, jbgp.oh, owsi,
+                ow_segs, ocb, jbgp.nb_oc);
+        int last_brg_ker_idx = -1;
+        while (start < end) {
+            int ow_s {0}, M_kind {brg_conv_M_point};
+            if (owsi < ow_border_l) {
+                ow_s = owsi;
+            } else if (owsi < ow_border_l + jbgp.nb_ow) {
+                ow_s = jbgp.ow_full_s + (owsi - ow_border_l) * jbgp.ow_block;
+                M_kind = (jbgp.ow_full_e - ow_s < jbgp.ow_block)
+                        ? brg_conv_M_tail
+                        : brg_conv_M_block;
+            } else {
+                ow_s = jbgp.ow_full_e + (owsi - ow_border_l - jbgp.nb_ow);
+            }
+            ker(ithr, last_brg_ker_idx, n, odi, ohi, ow_s, M_kind, ocb);
+            ++start;
+            nd_iterator_step(n, jbgp.mb, odi, jbgp.od, ohi, jbgp.oh, owsi,
+                    ow_segs, ocb, jbgp.nb_oc);
+        }
+    });
+}
+
+template struct brgemm_convolution_fwd_t<avx512_core, f32>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16, bf16>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16, bf16, bf16, f32>;
+template struct brgemm_convolution_fwd_t<avx512_core_vnni, u8, s8, f32>;
+template struct brgemm_convolution_fwd_t<avx512_core_vnni, u8, s8, s32>;
+template struct brgemm_convolution_fwd_t<avx512_core_vnni, u8, s8, u8>;
+template struct brgemm_convolution_fwd_t<avx512_core_vnni, u8, s8, s8>;
+template struct brgemm_convolution_fwd_t<avx512_core_vnni, s8, s8, f32>;
+template struct brgemm_convolution_fwd_t<avx512_core_vnni, s8, s8, s32>;
+template struct brgemm_convolution_fwd_t<avx512_core_vnni, s8, s8, u8>;
+template struct brgemm_convolution_fwd_t<avx512_core_vnni, s8, s8, s8>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_bf16, bf16>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_bf16, bf16, bf16,
+        f32>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, u8, s8,
+        f32>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, u8, s8,
+        s32>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, u8, s8,
+        u8>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, u8, s8,
+        s8>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, s8, s8,
+        f32>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, s8, s8,
+        s32>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, s8, s8,
+        u8>;
+template struct brgemm_convolution_fwd_t<avx512_core_bf16_amx_int8, s8, s8,
+        s8>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,194 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_BRGEMM_CONV_HPP
+#define CPU_X64_BRGEMM_CONV_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_convolution_pd.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+#include "cpu/x64/cpu_barrier.hpp"
+#include "cpu/x64/jit_brgemm_conv_utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+namespace {
+// Output width is processed either by full blocks of ow_block points, by the
+// last incomplete block, or point by point near the borders
+enum { brg_conv_M_block = 0, brg_conv_M_tail = 1, brg_conv_M_point = 2 };
+static const int max_num_brg_kernels_conv = 2 * 3 * 2 * 2;
+
+inline int get_brg_conv_kernel_index(const jit_brgemm_primitive_conf_t &jbgp,
+        bool do_initialization, int M_kind, bool is_N_tail, bool is_K_tail) {
+    auto vM = (M_kind == brg_conv_M_block)
+            ? jbgp.M
+            : (M_kind == brg_conv_M_tail) ? jbgp.M_tail : 1;
+    auto vN = (is_N_tail) ? jbgp.N_tail : jbgp.N;
+    auto vK = (is_K_tail) ? jbgp.K_tail : jbgp.K;
+    if (vM == 0 || vN == 0 || vK == 0 || jbgp.LDA < vK || jbgp.LDB < vN
+            || jbgp.LDC < vN)
+        return -1;
+
+    int idx = 12 * (int)do_initialization + 4 * M_kind + 2 * (int)is_N_tail
+            + (int)is_K_tail;
+
+    assert(idx < max_num_brg_kernels_conv);
+    return idx;
+}
+
+} // namespace
+
+template <cpu_isa_t isa, impl::data_type_t src_type,
+        impl::data_type_t wei_type = src_type,
+        impl::data_type_t dst_type = src_type>
+struct brgemm_convolution_fwd_t : public primitive_t {
+    struct pd_t : public cpu_convolution_fwd_pd_t {
+        pd_t(const convolution_desc_t *adesc, const primitive_attr_t *attr,
+                const typename pd_t::base_class *hint_fwd_pd)
+            : cpu_convolution_fwd_pd_t(adesc, attr, hint_fwd_pd), jbgp_() {}
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("brgconv:", isa, ""),
+                brgemm_convolution_fwd_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+            using smask_t = primitive_attr_t::skip_mask_t;
+            const bool is_int8 = utils::one_of(src_type, u8, s8);
+            const auto skip_mask = is_int8
+                    ? smask_t::oscale | smask_t::post_ops
+                    : smask_t::post_ops;
+
+            bool ok = true && is_fwd()
+                    && set_default_alg_kind(alg_kind::convolution_direct)
+                    && expect_data_types(src_type, wei_type, data_type::undef,
+                            dst_type, is_int8 ? s32 : f32)
+                    && IMPLICATION(with_bias(),
+                            (is_int8
+                                    && utils::one_of(bias_md_.data_type, f32,
+                                            s32, s8, u8))
+                                    || (src_type == bf16
+                                            && utils::one_of(
+                                                    bias_md_.data_type, f32,
+                                                    bf16))
+                                    || (src_type == f32
+                                            && bias_md_.data_type == f32))
+                    && attr()->has_default_values(skip_mask, dst_type)
+                    && !has_zero_dim_memory();
+            if (!ok) return status::unimplemented;
+
+            CHECK(brgemm_convolution_utils::init_conf(isa, jbgp_, *desc(),
+                    src_md_, weights_md_, dst_md_, bias_md_, *attr(),
+                    dnnl_get_max_threads()));
+
+            const float alpha = 1.0;
+            const float beta = 1.0;
+            const float beta_init = 0.0;
+            for_(int i_init = 0; i_init < 2; i_init++)
+            for_(int i_M = 0; i_M < 3; i_M++)
+            for_(int i_N = 0; i_N < 2; i_N++)
+            for (int i_K = 0; i_K < 2; i_K++) {
+                auto vbeta = (i_init) ? beta_init : beta;
+                auto vM = (i_M == brg_conv_M_block)
+                        ? jbgp_.M
+                        : (i_M == brg_conv_M_tail) ? jbgp_.M_tail : 1;
+                auto vN = (i_N) ? jbgp_.N_tail : jbgp_.N;
+                auto vK = (i_K) ? jbgp_.K_tail : jbgp_.K;
+
+                int idx = get_brg_kernel_idx(i_init, i_M, i_N, i_K);
+                if (idx < 0) continue;
+                brgemm_t &brg = brg_descs_[idx];
+                CHECK(brgemm_desc_init(&brg, isa, jbgp_.brg_type, src_type,
+                        wei_type, false, false, brgemm_row_major, alpha, vbeta,
+                        jbgp_.LDA, jbgp_.LDB, jbgp_.LDC, vM, vN, vK));
+
+                auto dt_d = dst_type;
+                auto LDD = jbgp_.LDD;
+                CHECK(brgemm_desc_add_postops(
+                        &brg, attr(), dt_d, LDD, jbgp_.bia_dt));
+            }
+
+            auto scratchpad = scratchpad_registry().registrar();
+            brgemm_convolution_utils::init_scratchpad(scratchpad, jbgp_);
+
+            return status::success;
+        }
+
+        int get_brg_kernel_idx(bool do_initialization, int M_kind,
+                bool is_N_tail, bool is_K_tail) const {
+            return get_brg_conv_kernel_index(
+                    jbgp_, do_initialization, M_kind, is_N_tail, is_K_tail);
+        }
+
+        brgemm_t brg_descs_[max_num_brg_kernels_conv];
+        jit_brgemm_primitive_conf_t jbgp_;
+    };
+
+    brgemm_convolution_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override {
+        for_(int i_M = 0; i_M < 3; i_M++)
+        for_(int i_N = 0; i_N < 2; i_N++)
+        for_(int i_K = 0; i_K < 2; i_K++)
+        for (int i_init = 0; i_init < 2; i_init++) {
+            int idx = pd()->get_brg_kernel_idx(i_init, i_M, i_N, i_K);
+            if (idx < 0) continue;
+
+            brgemm_kernel_t *ker = nullptr;
+            CHECK(brgemm_kernel_create(&ker, pd()->brg_descs_[idx]));
+            CHECK(safe_ptr_assign(brg_kernels_[idx], ker));
+            if (utils::one_of(isa, avx512_core_bf16_amx_int8,
+                        avx512_core_bf16_amx_bf16))
+                CHECK(brgemm_init_tiles(
+                        pd()->brg_descs_[idx], &brg_kernel_palettes_[idx][0]));
+        }
+
+        return status::success;
+    }
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        execute_forward(ctx);
+        return status::success;
+    }
+
+private:
+    void execute_forward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    typedef typename prec_traits<src_type>::type src_data_t;
+    typedef typename prec_traits<wei_type>::type wei_data_t;
+    typedef typename prec_traits<dst_type>::type dst_data_t;
+
+    std::unique_ptr<brgemm_kernel_t> brg_kernels_[max_num_brg_kernels_conv];
+    char brg_kernel_palettes_[max_num_brg_kernels_conv][64];
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,388 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_types.h"
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
+#include "cpu/x64/jit_brgemm_conv_utils.hpp"
+#include "cpu/x64/jit_generator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::format_tag;
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+using namespace prop_kind;
+using namespace data_type;
+
+namespace brgemm_convolution_utils {
+
+format_tag_t get_brgemm_conv_weights_tag(
+        cpu_isa_t isa, int oc_block, data_type_t wei_dt, int n_sp_dims) {
+    using namespace format_tag;
+
+    if (isa == avx512_core_bf16_amx_int8)
+        return pick(n_sp_dims - 1, OIw16i16o4i, OIhw16i16o4i, OIdhw16i16o4i);
+    if (isa == avx512_core_bf16_amx_bf16)
+        return pick(
+                n_sp_dims - 1, OIw16i16o2i, OIhw16i16o2i, format_tag::undef);
+
+    switch (oc_block) {
+        case 64:
+            switch (wei_dt) {
+                case f32: return pick(n_sp_dims - 1, OIw16i64o, OIhw16i64o,
+                                  OIdhw16i64o);
+                case bf16: return pick(n_sp_dims - 1, OIw8i64o2i, OIhw8i64o2i,
+                                   OIdhw8i64o2i);
+                case s8: return pick(n_sp_dims - 1, OIw4i64o4i, OIhw4i64o4i,
+                                 OIdhw4i64o4i);
+                default: return format_tag::undef;
+            }
+        case 32:
+            switch (wei_dt) {
+                case f32: return pick(n_sp_dims - 1, OIw16i32o, OIhw16i32o,
+                                  OIdhw16i32o);
+                case bf16: return pick(n_sp_dims - 1, OIw8i32o2i, OIhw8i32o2i,
+                                   OIdhw8i32o2i);
+                case s8: return pick(n_sp_dims - 1, OIw4i32o4i, OIhw4i32o4i,
+                                 OIdhw4i32o4i);
+                default: return format_tag::undef;
+            }
+        case 16:
+            switch (wei_dt) {
+                case f32: return pick(n_sp_dims - 1, OIw16i16o, OIhw16i16o,
+                                  OIdhw16i16o);
+                case bf16: return pick(n_sp_dims - 1, OIw8i16o2i, OIhw8i16o2i,
+                                   OIdhw8i16o2i);
+                case s8: return pick(n_sp_dims - 1, OIw4i16o4i, OIhw4i16o4i,
+                                 OIdhw4i16o4i);
+                default: return format_tag::undef;
+            }
+        default: return format_tag::undef;
+    }
+}
+
+// Every output point must be covered by at least one kernel tap, otherwise
+// the brgemm batch for it is empty
+bool every_output_has_taps(const jit_brgemm_primitive_conf_t &jbgp) {
+    auto dim_ok = [](int o_size, int i_size, int k_size, int stride, int pad,
+                          int dilate) {
+        for (int o = 0; o < o_size; o++) {
+            int k_s {0}, k_f {0};
+            get_kernel_range(
+                    o * stride - pad, i_size, k_size, dilate, k_s, k_f);
+            if (k_s >= k_f) return false;
+        }
+        return true;
+    };
+
+    return dim_ok(jbgp.od, jbgp.id, jbgp.kd, jbgp.stride_d, jbgp.f_pad,
+                   jbgp.dilate_d)
+            && dim_ok(jbgp.oh, jbgp.ih, jbgp.kh, jbgp.stride_h, jbgp.t_pad,
+                    jbgp.dilate_h)
+            && dim_ok(jbgp.ow, jbgp.iw, jbgp.kw, jbgp.stride_w, jbgp.l_pad,
+                    jbgp.dilate_w);
+}
+
+status_t init_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
+        const convolution_desc_t &cd, memory_desc_t &src_md,
+        memory_desc_t &weights_md, memory_desc_t &dst_md,
+        memory_desc_t &bias_md, const primitive_attr_t &attr, int nthreads) {
+    const memory_desc_wrapper src_d(&src_md);
+    const memory_desc_wrapper weights_d(&weights_md);
+    const memory_desc_wrapper dst_d(&dst_md);
+
+    if (!mayiuse(isa)) return status::unimplemented;
+
+    // Grouped and depthwise convolutions are served by dedicated kernels
+    const bool with_groups = weights_d.ndims() == src_d.ndims() + 1;
+    if (with_groups) return status::unimplemented;
+
+    const int ndims = src_d.ndims();
+    const bool is_1d = ndims == 3;
+    const bool is_3d = ndims == 5;
+
+    jbgp = zero<decltype(jbgp)>();
+    jbgp.ndims = ndims;
+    jbgp.isa = isa;
+    jbgp.prop_kind = cd.prop_kind;
+    jbgp.ngroups = 1;
+    jbgp.mb = src_d.dims()[0];
+    jbgp.oc_without_padding = dst_d.dims()[1];
+    jbgp.oc = jbgp.oc_without_padding;
+    jbgp.ic_without_padding = src_d.dims()[1];
+    jbgp.ic = jbgp.ic_without_padding;
+    jbgp.id = is_3d ? src_d.dims()[2] : 1;
+    jbgp.ih = is_1d ? 1 : src_d.dims()[ndims - 2];
+    jbgp.iw = src_d.dims()[ndims - 1];
+    jbgp.od = is_3d ? dst_d.dims()[2] : 1;
+    jbgp.oh = is_1d ? 1 : dst_d.dims()[ndims - 2];
+    jbgp.ow = dst_d.dims()[ndims - 1];
+    jbgp.kd = is_3d ? weights_d.dims()[2] : 1;
+    jbgp.kh = is_1d ? 1 : weights_d.dims()[ndims - 2];
+    jbgp.kw = weights_d.dims()[ndims - 1];
+    jbgp.f_pad = is_3d ? cd.padding[0][0] : 0;
+    jbgp.t_pad = is_1d ? 0 : cd.padding[0][ndims - 4];
+    jbgp.l_pad = cd.padding[0][ndims - 3];
+    jbgp.stride_d = is_3d ? cd.strides[0] : 1;
+    jbgp.stride_h = is_1d ? 1 : cd.strides[ndims - 4];
+    jbgp.stride_w = cd.strides[ndims - 3];
+    jbgp.dilate_d = is_3d ? cd.dilates[0] : 0;
+    jbgp.dilate_h = is_1d ? 0 : cd.dilates[ndims - 4];
+    jbgp.dilate_w = cd.dilates[ndims - 3];
+
+    const int ext_kw = calculate_extended_filter_size(jbgp.kw, jbgp.dilate_w);
+    const int ext_kh = calculate_extended_filter_size(jbgp.kh, jbgp.dilate_h);
+    const int ext_kd = calculate_extended_filter_size(jbgp.kd, jbgp.dilate_d);
+    jbgp.r_pad = calculate_end_padding(
+            jbgp.l_pad, jbgp.ow, jbgp.iw, jbgp.stride_w, ext_kw);
+    jbgp.b_pad = calculate_end_padding(
+            jbgp.t_pad, jbgp.oh, jbgp.ih, jbgp.stride_h, ext_kh);
+    jbgp.back_pad = calculate_end_padding(
+            jbgp.f_pad, jbgp.od, jbgp.id, jbgp.stride_d, ext_kd);
+
+    if (!every_output_has_taps(jbgp)) return status::unimplemented;
+
+    const int full_simd_w = 16;
+    jbgp.simd_w = full_simd_w;
+
+    jbgp.with_bias = cd.bias_desc.format_kind != format_kind::undef;
+    jbgp.src_dt = src_d.data_type();
+    jbgp.dst_dt = dst_d.data_type();
+    jbgp.wei_dt = weights_d.data_type();
+    jbgp.bia_dt = jbgp.with_bias ? cd.bias_desc.data_type : data_type::undef;
+
+    const bool is_amx
+            = one_of(isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
+    const bool is_int8 = one_of(jbgp.src_dt, u8, s8) && jbgp.wei_dt == s8;
+    const bool is_bf16 = everyone_is(bf16, jbgp.src_dt, jbgp.wei_dt)
+            && one_of(jbgp.dst_dt, bf16, f32);
+    const bool is_f32 = everyone_is(f32, jbgp.src_dt, jbgp.wei_dt, jbgp.dst_dt);
+
+    if (!IMPLICATION(is_int8,
+                one_of(isa, avx512_core_vnni, avx512_core_bf16_amx_int8)))
+        return status::unimplemented;
+    if (!IMPLICATION(is_bf16,
+                one_of(isa, avx512_core_bf16, avx512_core_bf16_amx_bf16)))
+        return status::unimplemented;
+    if (!IMPLICATION(is_f32, isa == avx512_core)) return status::unimplemented;
+
+    if (is_int8) {
+        jbgp.acc_dt = s32;
+        jbgp.with_scales = true;
+    } else if (is_bf16 || is_f32) {
+        jbgp.acc_dt = f32;
+    } else
+        return status::unimplemented;
+
+    // The s8s8 compensation stored with the weights accounts for all kernel
+    // taps, so it is only valid when no output point touches the padding.
+    jbgp.signed_input = isa == avx512_core_vnni && jbgp.src_dt == s8;
+    if (jbgp.signed_input
+            && !everyone_is(0, jbgp.l_pad, jbgp.r_pad, jbgp.t_pad, jbgp.b_pad,
+                    jbgp.f_pad, jbgp.back_pad))
+        return status::unimplemented;
+
+    const auto &p = attr.post_ops_;
+    jbgp.with_sum = p.find(primitive_kind::sum) != -1;
+    const int eltwise_ind = p.find(primitive_kind::eltwise);
+    jbgp.with_eltwise = eltwise_ind != -1;
+    if (jbgp.with_eltwise) jbgp.eltwise = p.entry_[eltwise_ind].eltwise;
+    if (!brgemm_post_ops_ok(attr.post_ops_, one_of(jbgp.src_dt, u8, s8)))
+        return status::unimplemented;
+    if (jbgp.with_scales) {
+        const auto &oscales = attr.output_scales_;
+        jbgp.is_oc_scale = oscales.mask_ == 1 << 1;
+
+        // only common and per-oc-channel scales are supported
+        const bool oscales_ok = one_of(oscales.mask_, 0, 1 << 1);
+        if (!oscales_ok) return status::unimplemented;
+    }
+
+    // Blocked activations are supported for f32 and bf16 on avx512 only:
+    // AMX needs a wider reduction block than nChw16c provides and int8
+    // kernels traditionally work with nhwc.
+    const bool allow_blocked = !is_int8 && !is_amx;
+    auto set_or_check_tags = [&]() -> status_t {
+        const format_tag_t nspc_tag = pick(ndims - 3, nwc, nhwc, ndhwc);
+        const format_tag_t blocked_tag = allow_blocked
+                ? pick(ndims - 3, nCw16c, nChw16c, nCdhw16c)
+                : format_tag::undef;
+        const format_tag_t default_tag
+                = allow_blocked ? blocked_tag : nspc_tag;
+
+        if (src_d.format_kind() == format_kind::any) {
+            CHECK(memory_desc_init_by_tag(src_md, default_tag));
+            jbgp.src_tag = default_tag;
+        } else {
+            jbgp.src_tag = memory_desc_matches_one_of_tag(
+                    src_md, nspc_tag, blocked_tag);
+        }
+
+        if (dst_d.format_kind() == format_kind::any) {
+            CHECK(memory_desc_init_by_tag(dst_md, jbgp.src_tag));
+            jbgp.dst_tag = jbgp.src_tag;
+        } else {
+            jbgp.dst_tag = memory_desc_matches_one_of_tag(
+                    dst_md, nspc_tag, blocked_tag);
+        }
+
+        if (one_of(format_tag::undef, jbgp.src_tag, jbgp.dst_tag)
+                || jbgp.src_tag != jbgp.dst_tag)
+            return status::unimplemented;
+
+        if (jbgp.with_bias && bias_md.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(bias_md, x));
+
+        jbgp.is_nspc = jbgp.src_tag == nspc_tag;
+        return status::success;
+    };
+
+    CHECK(set_or_check_tags());
+
+    if (is_amx) {
+        jbgp.ic_block = (is_int8 ? 4 : 2) * jbgp.simd_w;
+        jbgp.oc_block = jbgp.simd_w;
+    } else if (!jbgp.is_nspc) {
+        jbgp.ic_block = jbgp.simd_w;
+        jbgp.oc_block = jbgp.simd_w;
+        // blocked src is zero padded, so there is no reduction tail
+        jbgp.ic = rnd_up(jbgp.ic, jbgp.ic_block);
+        // kernels do not write the padded area of blocked dst
+        if (jbgp.oc % jbgp.oc_block != 0) return status::unimplemented;
+    } else {
+        jbgp.ic_block = jbgp.simd_w;
+        if (jbgp.oc >= 4 * jbgp.simd_w)
+            jbgp.oc_block = 4 * jbgp.simd_w;
+        else if (jbgp.oc >= 2 * jbgp.simd_w)
+            jbgp.oc_block = 2 * jbgp.simd_w;
+        else
+            jbgp.oc_block = jbgp.simd_w;
+    }
+
+    memory_desc_t want_wei_md = weights_md;
+    jbgp.wei_tag = get_brgemm_conv_weights_tag(
+            isa, jbgp.oc_block, jbgp.wei_dt, ndims - 2);
+    if (jbgp.wei_tag == format_tag::undef) return status::unimplemented;
+    CHECK(memory_desc_init_by_tag(want_wei_md, jbgp.wei_tag));
+    if (jbgp.signed_input) {
+        want_wei_md.extra.flags = 0 | memory_extra_flags::compensation_conv_s8s8
+                | memory_extra_flags::scale_adjust;
+        want_wei_md.extra.compensation_mask = (1 << 0);
+        want_wei_md.extra.scale_adjust = platform::s8s8_weights_scale_factor();
+    }
+    if (weights_md.format_kind == format_kind::any)
+        weights_md = want_wei_md;
+    else if (!(want_wei_md == weights_md))
+        return status::unimplemented;
+
+    jbgp.nb_ic = div_up(jbgp.ic, jbgp.ic_block);
+    jbgp.nb_oc = div_up(jbgp.oc, jbgp.oc_block);
+
+    // Split each row of output into the points that see the whole kernel
+    // width ([ow_full_s, ow_full_e), processed by blocks of ow_block) and
+    // border points that are processed one by one with a reduced batch.
+    jbgp.ow_full_s = jbgp.ow_full_e = jbgp.ow;
+    for (int ow = 0; ow < jbgp.ow; ow++) {
+        int kw_s {0}, kw_f {0};
+        get_kernel_range(ow * jbgp.stride_w - jbgp.l_pad, jbgp.iw, jbgp.kw,
+                jbgp.dilate_w, kw_s, kw_f);
+        if (kw_s == 0 && kw_f == jbgp.kw) {
+            if (jbgp.ow_full_s == jbgp.ow) jbgp.ow_full_s = ow;
+            jbgp.ow_full_e = ow + 1;
+        }
+    }
+    if (jbgp.ow_full_s == jbgp.ow) jbgp.ow_full_s = jbgp.ow_full_e = 0;
+    const int ow_full = jbgp.ow_full_e - jbgp.ow_full_s;
+    const int ow_border = jbgp.ow - ow_full;
+
+    // AMX kernels do not support a tail inside of a tile, so keep the block
+    // within a single tile height.
+    const int max_M = is_amx ? 16 : 64, min_M = is_amx ? 16 : 8;
+    jbgp.ow_block = nstl::max(1, nstl::min(ow_full, max_M));
+    auto work_amount = [&](int ow_block) {
+        const int nb_ow_full = div_up(ow_full, ow_block);
+        return (dim_t)jbgp.mb * jbgp.od * jbgp.oh * jbgp.nb_oc
+                * (nb_ow_full + ow_border);
+    };
+    while (jbgp.ow_block > min_M && work_amount(jbgp.ow_block) < nthreads)
+        jbgp.ow_block = div_up(jbgp.ow_block, 2);
+    jbgp.nb_ow = div_up(ow_full, jbgp.ow_block);
+
+    jbgp.M = jbgp.ow_block;
+    jbgp.M_tail = ow_full % jbgp.ow_block;
+    jbgp.K = jbgp.ic_block;
+    jbgp.K_tail = jbgp.ic % jbgp.ic_block;
+    jbgp.N = jbgp.oc_block;
+    jbgp.N_tail = jbgp.oc % jbgp.oc_block;
+
+    // A rows are output points along width, so the leading dimension of A
+    // steps over stride_w input points.
+    jbgp.LDA = jbgp.stride_w
+            * (jbgp.is_nspc ? jbgp.ic_without_padding : jbgp.ic_block);
+    jbgp.LDB = jbgp.N;
+    jbgp.LDD = jbgp.is_nspc ? jbgp.oc_without_padding : jbgp.oc_block;
+
+    // When the reduction is split into a main part and a tail, the partial
+    // result is accumulated in a buffer unless dst can hold it as is.
+    const bool is_k_split = jbgp.K_tail > 0 && jbgp.ic >= jbgp.ic_block;
+    jbgp.use_buffer = is_k_split
+            && (jbgp.dst_dt != jbgp.acc_dt || jbgp.with_sum);
+    jbgp.LDC = jbgp.use_buffer ? jbgp.N : jbgp.LDD;
+
+    jbgp.gemm_batch_size = jbgp.nb_ic * jbgp.kd * jbgp.kh * jbgp.kw;
+    jbgp.brg_type = brgemm_addr;
+    jbgp.nthr = nthreads;
+
+    return status::success;
+}
+
+void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+        const jit_brgemm_primitive_conf_t &jbgp) {
+    size_t sc_size = sizeof(void *);
+    size_t n_elems = (size_t)jbgp.nthr * jbgp.gemm_batch_size;
+    if (jbgp.brg_type == brgemm_addr) {
+        scratchpad.book(key_brgemm_primitive_addr_a, n_elems, sc_size, 64);
+        scratchpad.book(key_brgemm_primitive_addr_b, n_elems, sc_size, 64);
+    }
+    if (jbgp.use_buffer) {
+        size_t nelements = (size_t)jbgp.nthr * jbgp.LDC * jbgp.M;
+        scratchpad.book(key_brgemm_primitive_buffer, nelements,
+                types::data_type_size(jbgp.acc_dt));
+    }
+    if (one_of(jbgp.isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16))
+        scratchpad.book(
+                key_conv_amx_tile_buffer, jbgp.nthr * 1024, sizeof(char));
+}
+
+} // namespace brgemm_convolution_utils
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,62 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_BRGEMM_CONV_UTILS_HPP
+#define CPU_X64_BRGEMM_CONV_UTILS_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+
+#include "cpu/cpu_convolution_pd.hpp"
+#include "cpu/cpu_engine.hpp"
+#include "cpu/platform.hpp"
+#include "cpu/x64/jit_brgemm_primitive_conf.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+namespace brgemm_convolution_utils {
+
+status_t init_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
+        const convolution_desc_t &cd, memory_desc_t &src_md,
+        memory_desc_t &weights_md, memory_desc_t &dst_md,
+        memory_desc_t &bias_md, const primitive_attr_t &attr, int nthreads);
+
+void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+        const jit_brgemm_primitive_conf_t &jbgp);
+
+// Returns the range [k_s, k_f) of kernel taps that hit the source for an
+// output point whose first tap starts at input coordinate 'i_start'
+inline void get_kernel_range(int i_start, int i_size, int k_size,
+        int dilate, int &k_s, int &k_f) {
+    const int dil = dilate + 1;
+    k_s = i_start < 0 ? utils::div_up(-i_start, dil) : 0;
+    k_f = i_size > i_start ? utils::div_up(i_size - i_start, dil) : 0;
+    k_s = nstl::min(k_s, k_size);
+    k_f = nstl::min(k_f, k_size);
+}
+
+} // namespace brgemm_convolution_utils
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
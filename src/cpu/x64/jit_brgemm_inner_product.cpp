@@ -232,6 +232,19 @@ template struct brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8, s8, s8,
         u8>;
 template struct brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8, s8, s8,
         s8>;
+template struct brgemm_inner_product_fwd_t<avx2, f32>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni, u8, s8, f32>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni, u8, s8, s32>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni, u8, s8, u8>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni, u8, s8, s8>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni, s8, s8, f32>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni, s8, s8, s32>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni, s8, s8, u8>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni, s8, s8, s8>;
+template struct brgemm_inner_product_fwd_t<avx2, u8, s8, f32>;
+template struct brgemm_inner_product_fwd_t<avx2, u8, s8, s32>;
+template struct brgemm_inner_product_fwd_t<avx2, u8, s8, u8>;
+template struct brgemm_inner_product_fwd_t<avx2, u8, s8, s8>;
 
 template <cpu_isa_t isa, data_type_t src_type, data_type_t wei_type,
         data_type_t dst_type>
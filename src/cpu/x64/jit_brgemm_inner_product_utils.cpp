@@ -419,7 +419,11 @@ status_t init_ip_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
     const memory_desc_wrapper dst_d(&dst_md);
 
     using namespace prop_kind;
-    if (!mayiuse(avx512_common)) return status::unimplemented;
+    if (!mayiuse(isa)) return status::unimplemented;
+    // The AVX2 kernels are meant for the platforms without AVX-512, where
+    // the AVX-512 implementations are not available
+    const bool is_avx2 = one_of(isa, avx2_vnni, avx2);
+    if (is_avx2 && mayiuse(avx512_core)) return status::unimplemented;
 
     int ndims = src_d.ndims();
     if (weights_d.ndims() != ndims || dst_d.ndims() != 2)
@@ -466,8 +470,15 @@ status_t init_ip_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
             ? pick_by_prop_kind(jbgp.prop_kind, ipd.bias_desc.data_type,
                     data_type::undef, ipd.diff_bias_desc.data_type)
             : data_type::undef;
-    jbgp.signed_input = isa == avx512_core_vnni && jbgp.src_dt == s8;
+    // The s8s8 case needs a dot product that does not saturate: the weights
+    // would have to be scaled down by half otherwise, losing precision
+    if (isa == avx2 && jbgp.src_dt == s8) return status::unimplemented;
+    jbgp.signed_input
+            = one_of(isa, avx512_core_vnni, avx2_vnni) && jbgp.src_dt == s8;
     const bool is_int8 = one_of(jbgp.src_dt, u8, s8) && jbgp.wei_dt == s8;
+    const bool is_f32
+            = one_of(jbgp.prop_kind, forward_training, forward_inference)
+            && everyone_is(f32, jbgp.src_dt, jbgp.wei_dt, jbgp.dst_dt);
     const bool is_bf16
             = everyone_is(bf16, jbgp.src_dt, jbgp.wei_dt, jbgp.dst_dt)
             || pick_by_prop_kind(jbgp.prop_kind,
@@ -479,7 +490,8 @@ status_t init_ip_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
                             && jbgp.wei_dt == f32);
 
     if (!IMPLICATION(is_int8,
-                one_of(isa, avx512_core_vnni, avx512_core_bf16_amx_int8)))
+                one_of(isa, avx512_core_vnni, avx512_core_bf16_amx_int8,
+                        avx2_vnni, avx2)))
         return status::unimplemented;
     if (!IMPLICATION(is_bf16, isa == avx512_core_bf16))
         return status::unimplemented;
@@ -489,6 +501,8 @@ status_t init_ip_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
         jbgp.with_scales = true;
     } else if (is_bf16) {
         jbgp.acc_dt = f32;
+    } else if (is_f32 && isa == avx2) {
+        jbgp.acc_dt = f32;
     } else
         return status::unimplemented;
 
@@ -528,8 +542,8 @@ status_t init_ip_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
                     | memory_extra_flags::compensation_conv_s8s8
                     | memory_extra_flags::scale_adjust;
             want_wei_md.extra.compensation_mask = (1 << 0);
-            want_wei_md.extra.scale_adjust
-                    = platform::s8s8_weights_scale_factor();
+            // The weights are not scaled, see signed_input above
+            want_wei_md.extra.scale_adjust = 1.f;
         }
         if (weights_md.format_kind == format_kind::any) {
             weights_md = want_wei_md;
@@ -55,6 +55,8 @@ struct jit_brgemm_primitive_conf_t {
     int nb_oc_blocking;
     int nb_ic_blocking;
     int nb_os_blocking;
+    int ow_full_s, ow_full_e; // ow range where all kw taps are inside src
+    bool is_nspc;
 
     data_type_t src_dt;
     data_type_t dst_dt;
@@ -0,0 +1,60 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/jit_brgemm_sparse_inner_product.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::data_type;
+
+template <cpu_isa_t isa, data_type_t src_type, data_type_t wei_type,
+        data_type_t dst_type>
+void brgemm_sparse_inner_product_fwd_t<isa, src_type, wei_type,
+        dst_type>::execute_forward(const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto weights = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS);
+    auto bias = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+
+    brgemm_sparse_utils::execute(pd()->jbsp_, brg_kernels_, src, weights,
+            bias, dst, pd()->attr()->output_scales_.scales_,
+            ctx.get_scratchpad_grantor());
+}
+
+template struct brgemm_sparse_inner_product_fwd_t<avx512_core, f32>;
+template struct brgemm_sparse_inner_product_fwd_t<avx512_core_bf16, bf16>;
+template struct brgemm_sparse_inner_product_fwd_t<avx512_core_bf16, bf16, bf16,
+        f32>;
+template struct brgemm_sparse_inner_product_fwd_t<avx512_core_vnni, u8, s8,
+        f32>;
+template struct brgemm_sparse_inner_product_fwd_t<avx512_core_vnni, u8, s8,
+        s32>;
+template struct brgemm_sparse_inner_product_fwd_t<avx512_core_vnni, u8, s8,
+        u8>;
+template struct brgemm_sparse_inner_product_fwd_t<avx512_core_vnni, u8, s8,
+        s8>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,265 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_desc_wrapper.hpp"
+#include "common/nstl.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/jit_brgemm_sparse_utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+namespace brgemm_sparse_utils {
+
+using namespace dnnl::impl::data_type;
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+int get_brg_kernel_index(
+        const jit_brgemm_sparse_conf_t &jbsp, bool is_M_tail, bool is_N_tail) {
+    const dim_t vM = is_M_tail ? jbsp.M_tail : jbsp.M_blk;
+    const dim_t vN = is_N_tail ? jbsp.N_tail : jbsp.block_n;
+    if (vM == 0 || vN == 0) return -1;
+
+    const int idx = 2 * (int)is_M_tail + (int)is_N_tail;
+    assert(idx < max_num_brg_kernels);
+    return idx;
+}
+
+status_t init_conf(cpu_isa_t isa, jit_brgemm_sparse_conf_t &jbsp, int oc_dim,
+        dim_t M, dim_t N, dim_t K, memory_desc_t &src_md,
+        const memory_desc_t &weights_md, memory_desc_t &dst_md,
+        memory_desc_t &bias_md, const primitive_attr_t &attr, int nthreads) {
+    using namespace format_tag;
+
+    const memory_desc_wrapper weights_d(&weights_md);
+    // The sparsity is chosen by the user, it is never picked for `any`
+    if (!weights_d.is_sparse_desc()) return status::unimplemented;
+    const auto &sd = weights_d.sparse_desc();
+    if (sd.encoding != sparse_encoding::bcsr || sd.oc_dim != oc_dim
+            || K % sd.block_k != 0)
+        return status::unimplemented;
+
+    jbsp = zero<decltype(jbsp)>();
+    jbsp.isa = isa;
+    jbsp.M = M;
+    jbsp.N = N;
+    jbsp.K = K;
+    jbsp.block_k = sd.block_k;
+    jbsp.block_n = sd.block_n;
+    jbsp.values_offset = weights_d.sparse_values_offset();
+
+    jbsp.src_dt = src_md.data_type;
+    jbsp.wei_dt = weights_md.data_type;
+    jbsp.dst_dt = dst_md.data_type;
+    jbsp.with_bias = bias_md.format_kind != format_kind::undef;
+    jbsp.bia_dt = jbsp.with_bias ? bias_md.data_type : data_type::undef;
+
+    const bool is_int8 = jbsp.src_dt == u8 && jbsp.wei_dt == s8;
+    const bool is_bf16 = everyone_is(bf16, jbsp.src_dt, jbsp.wei_dt)
+            && one_of(jbsp.dst_dt, bf16, f32);
+    const bool is_f32 = everyone_is(f32, jbsp.src_dt, jbsp.wei_dt, jbsp.dst_dt);
+    if (!(is_int8 || is_bf16 || is_f32)) return status::unimplemented;
+    if (!IMPLICATION(is_int8, isa == avx512_core_vnni)
+            || !IMPLICATION(is_bf16, isa == avx512_core_bf16)
+            || !IMPLICATION(is_f32, isa == avx512_core))
+        return status::unimplemented;
+    // The blocks of the input channels are interleaved as in VNNI formats
+    if (!IMPLICATION(!is_f32, sd.block_k == 4)) return status::unimplemented;
+    jbsp.acc_dt = is_int8 ? s32 : f32;
+
+    const auto &p = attr.post_ops_;
+    jbsp.with_sum = p.find(primitive_kind::sum) != -1;
+    jbsp.with_eltwise = p.find(primitive_kind::eltwise) != -1;
+    if (!brgemm_post_ops_ok(p, is_int8)) return status::unimplemented;
+    jbsp.with_scales = is_int8;
+    if (jbsp.with_scales) {
+        const auto &oscales = attr.output_scales_;
+        // only common and per-oc-channel scales are supported
+        if (!one_of(oscales.mask_, 0, 1 << 1)) return status::unimplemented;
+        jbsp.is_oc_scale = oscales.mask_ == 1 << 1;
+    }
+
+    if (src_md.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(src_md, ab));
+    if (dst_md.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(dst_md, ab));
+    if (jbsp.with_bias && bias_md.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(bias_md, bias_md.ndims == 1 ? x : ab));
+    if (!memory_desc_matches_tag(src_md, ab)
+            || !memory_desc_matches_tag(dst_md, ab)
+            || !IMPLICATION(jbsp.with_bias,
+                    memory_desc_matches_tag(
+                            bias_md, bias_md.ndims == 1 ? x : ab)))
+        return status::unimplemented;
+
+    // The rows of the source are shared by all the columns of the
+    // destination, the blocks of the weights are shared by the rows
+    const dim_t max_M_blk = 64;
+    jbsp.M_blk = nstl::min(M, max_M_blk);
+    jbsp.nb_m = div_up(M, jbsp.M_blk);
+    jbsp.M_tail = M % jbsp.M_blk;
+    jbsp.nb_n = weights_d.sparse_nb_n();
+    jbsp.N_tail = N % jbsp.block_n;
+    jbsp.nb_k = K / jbsp.block_k;
+
+    jbsp.use_buffer = jbsp.dst_dt != jbsp.acc_dt || jbsp.with_sum;
+    jbsp.LDA = K;
+    jbsp.LDD = N;
+    jbsp.LDC = jbsp.use_buffer ? jbsp.block_n : jbsp.LDD;
+
+    jbsp.nthr = nthreads;
+
+    return status::success;
+}
+
+status_t init_brg_descs(brgemm_t brg_descs[max_num_brg_kernels],
+        const jit_brgemm_sparse_conf_t &jbsp, const primitive_attr_t *attr) {
+    const float alpha = 1.0;
+    const float beta = 0.0;
+    for_(int i_M = 0; i_M < 2; i_M++)
+    for (int i_N = 0; i_N < 2; i_N++) {
+        const int idx = get_brg_kernel_index(jbsp, i_M, i_N);
+        if (idx < 0) continue;
+
+        const dim_t vM = i_M ? jbsp.M_tail : jbsp.M_blk;
+        const dim_t vN = i_N ? jbsp.N_tail : jbsp.block_n;
+
+        // Every matrix B of the batch is a single block of the weights
+        brgemm_t &brg = brg_descs[idx];
+        CHECK(brgemm_desc_init(&brg, jbsp.isa, brgemm_addr, jbsp.src_dt,
+                jbsp.wei_dt, false, false, brgemm_row_major, alpha, beta,
+                jbsp.LDA, jbsp.block_n, jbsp.LDC, vM, vN, jbsp.block_k));
+        CHECK(brgemm_desc_add_postops(
+                &brg, attr, jbsp.dst_dt, (int)jbsp.LDD, jbsp.bia_dt));
+    }
+    return status::success;
+}
+
+void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+        const jit_brgemm_sparse_conf_t &jbsp) {
+    const size_t n_addr = (size_t)jbsp.nthr * jbsp.nb_k;
+    scratchpad.book(key_brgemm_primitive_addr_a, n_addr, sizeof(void *), 64);
+    scratchpad.book(key_brgemm_primitive_addr_b, n_addr, sizeof(void *), 64);
+    if (jbsp.use_buffer) {
+        const size_t nelems = (size_t)jbsp.nthr * jbsp.M_blk * jbsp.LDC;
+        scratchpad.book(key_brgemm_primitive_buffer, nelems,
+                types::data_type_size(jbsp.acc_dt));
+    }
+}
+
+void execute(const jit_brgemm_sparse_conf_t &jbsp,
+        const std::unique_ptr<brgemm_kernel_t> brg_kernels[],
+        const char *src, const char *weights, const char *bias, char *dst,
+        const float *oscales, const memory_tracking::grantor_t &scratchpad) {
+    const size_t src_dt_size = types::data_type_size(jbsp.src_dt);
+    const size_t dst_dt_size = types::data_type_size(jbsp.dst_dt);
+    const size_t bia_dt_size
+            = jbsp.with_bias ? types::data_type_size(jbsp.bia_dt) : 0;
+    const size_t acc_dt_size = types::data_type_size(jbsp.acc_dt);
+    const size_t block_size = (size_t)jbsp.block_k * jbsp.block_n
+            * types::data_type_size(jbsp.wei_dt);
+
+    const int32_t *offsets = reinterpret_cast<const int32_t *>(weights);
+    const int32_t *indices = offsets + jbsp.nb_n + 1;
+    const char *values = weights + jbsp.values_offset;
+
+    // The rows of blocks without stored blocks still get the post-ops: they
+    // are computed with a single block of zeros
+    static const float zero_block[4 * 16] = {0.f};
+    assert(block_size <= sizeof(zero_block));
+
+    const void **addr_A_global = scratchpad.template get<const void *>(
+            key_brgemm_primitive_addr_a);
+    const void **addr_B_global = scratchpad.template get<const void *>(
+            key_brgemm_primitive_addr_b);
+    char *c_buffer_global = jbsp.use_buffer
+            ? scratchpad.template get<char>(key_brgemm_primitive_buffer)
+            : nullptr;
+
+    const bool are_post_ops_applicable = one_of(true, jbsp.with_sum,
+            jbsp.with_bias, jbsp.with_scales, jbsp.with_eltwise,
+            jbsp.acc_dt != jbsp.dst_dt);
+
+    const dim_t work_amount = jbsp.nb_n * jbsp.nb_m;
+    parallel(jbsp.nthr, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        balance211(work_amount, nthr, ithr, start, end);
+        if (start >= end) return;
+
+        const void **addr_A = addr_A_global + ithr * jbsp.nb_k;
+        const void **addr_B = addr_B_global + ithr * jbsp.nb_k;
+        char *c_buffer = jbsp.use_buffer
+                ? c_buffer_global + ithr * jbsp.M_blk * jbsp.LDC * acc_dt_size
+                : nullptr;
+
+        // The blocks of the weights stay in cache for all the rows of the
+        // destination
+        dim_t nb {0}, mb {0};
+        nd_iterator_init(start, nb, jbsp.nb_n, mb, jbsp.nb_m);
+        while (start < end) {
+            const dim_t m = mb * jbsp.M_blk;
+            const dim_t n = nb * jbsp.block_n;
+            const bool is_M_tail = jbsp.M - m < jbsp.M_blk;
+            const bool is_N_tail = jbsp.N - n < jbsp.block_n;
+            const int brg_ker_idx
+                    = get_brg_kernel_index(jbsp, is_M_tail, is_N_tail);
+            const auto brg_kernel = brg_kernels[brg_ker_idx].get();
+
+            const char *src_m = src + m * jbsp.LDA * src_dt_size;
+            const int32_t first = offsets[nb];
+            const int bs = offsets[nb + 1] - first;
+            for (int i = 0; i < bs; i++) {
+                const dim_t k = (dim_t)indices[first + i] * jbsp.block_k;
+                addr_A[i] = src_m + k * src_dt_size;
+                addr_B[i] = values + (first + i) * block_size;
+            }
+            if (bs == 0) {
+                addr_A[0] = src_m;
+                addr_B[0] = zero_block;
+            }
+
+            char *ptr_D = dst + (m * jbsp.LDD + n) * dst_dt_size;
+            char *ptr_C = jbsp.use_buffer ? c_buffer : ptr_D;
+            if (are_post_ops_applicable) {
+                const char *bias_w
+                        = jbsp.with_bias ? bias + n * bia_dt_size : nullptr;
+                brgemm_kernel_execute_postops(brg_kernel, nstl::max(bs, 1),
+                        addr_A, addr_B, ptr_C, ptr_D, bias_w,
+                        &oscales[jbsp.is_oc_scale * n]);
+            } else {
+                brgemm_kernel_execute(brg_kernel, nstl::max(bs, 1), addr_A,
+                        addr_B, ptr_C);
+            }
+
+            ++start;
+            nd_iterator_step(nb, jbsp.nb_n, mb, jbsp.nb_m);
+        }
+    });
+}
+
+} // namespace brgemm_sparse_utils
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
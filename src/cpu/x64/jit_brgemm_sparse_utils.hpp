@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_BRGEMM_SPARSE_UTILS_HPP
+#define CPU_X64_JIT_BRGEMM_SPARSE_UTILS_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/memory_tracking.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Configuration of the forward inner product and matmul with block-sparse
+// weights. The destination is computed by blocks of M_blk rows and block_n
+// columns, each of them by a single BRGEMM call with a batch of the stored
+// blocks of the corresponding row of blocks of the weights.
+struct jit_brgemm_sparse_conf_t {
+    cpu_isa_t isa;
+    dim_t M, N, K;
+    int block_k, block_n;
+    dim_t nb_m, nb_n, nb_k;
+    dim_t M_blk, M_tail, N_tail;
+    dim_t LDA, LDC, LDD;
+    size_t values_offset;
+    data_type_t src_dt, wei_dt, dst_dt, acc_dt, bia_dt;
+    bool with_bias, with_sum, with_eltwise, with_scales, is_oc_scale;
+    bool use_buffer;
+    int nthr;
+};
+
+namespace brgemm_sparse_utils {
+
+constexpr int max_num_brg_kernels = 2 * 2;
+
+// Returns -1 if the kernel is not needed
+int get_brg_kernel_index(
+        const jit_brgemm_sparse_conf_t &jbsp, bool is_M_tail, bool is_N_tail);
+
+// The output channels are the dimension oc_dim of the weights. The source,
+// the destination and the bias are expected in the plain layouts.
+status_t init_conf(cpu_isa_t isa, jit_brgemm_sparse_conf_t &jbsp, int oc_dim,
+        dim_t M, dim_t N, dim_t K, memory_desc_t &src_md,
+        const memory_desc_t &weights_md, memory_desc_t &dst_md,
+        memory_desc_t &bias_md, const primitive_attr_t &attr, int nthreads);
+
+status_t init_brg_descs(brgemm_t brg_descs[max_num_brg_kernels],
+        const jit_brgemm_sparse_conf_t &jbsp, const primitive_attr_t *attr);
+
+void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+        const jit_brgemm_sparse_conf_t &jbsp);
+
+void execute(const jit_brgemm_sparse_conf_t &jbsp,
+        const std::unique_ptr<brgemm_kernel_t> brg_kernels[],
+        const char *src, const char *weights, const char *bias, char *dst,
+        const float *oscales, const memory_tracking::grantor_t &scratchpad);
+
+} // namespace brgemm_sparse_utils
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -18,13 +18,17 @@
 #define CPU_X64_JIT_GENERATOR_HPP
 
 #include <limits.h>
+#include <string>
+#include <vector>
 
 #include "common/bit_cast.hpp"
+#include "common/primitive_cache.hpp"
 #include "common/type_helpers.hpp"
 #include "common/utils.hpp"
 
 #include "cpu/x64/cpu_isa_traits.hpp"
 
+#include "cpu/x64/jit_utils/jit_code_cache.hpp"
 #include "cpu/x64/jit_utils/jit_utils.hpp"
 
 #if defined(_WIN32) && !defined(__GNUC__)
@@ -1681,14 +1685,55 @@ public:
         (*fptr)(std::forward<kernel_args_t>(args)...);
     }
 
+    // Loads the absolute address of a label. The address is recorded, so
+    // that the code can be relocated when it comes from the persistent code
+    // cache.
+    void mov_label_address(const Xbyak::Reg64 &reg, const Xbyak::Label &l) {
+        mov(reg, l);
+        code_relocs_.push_back(getSize() - sizeof(uint64_t));
+    }
+
     virtual status_t create_kernel() {
-        generate();
+        // Code emitted before generate() cannot be reproduced from the cache
+        const std::string key
+                = getSize() == 0 ? code_cache_key() : std::string();
+        const bool from_cache = !key.empty() && load_cached_code(key);
+        if (!from_cache) generate();
         jit_ker_ = getCode();
+        if (jit_ker_ && !from_cache && !key.empty())
+            jit_utils::code_cache::store(
+                    name(), key, jit_ker_, getSize(), code_relocs_);
+        if (jit_ker_) add_primitive_creation_footprint(getSize());
         return (jit_ker_) ? status::success : status::runtime_error;
     }
 
 private:
     const cpu_isa_t max_cpu_isa_;
+    // Offsets of the absolute addresses of labels in the code
+    std::vector<size_t> code_relocs_;
+
+    std::string code_cache_key() const {
+        if (!jit_utils::code_cache::is_enabled()) return std::string();
+        const std::string key = persistent_cache_key();
+        if (key.empty()) return key;
+        return std::to_string((unsigned)max_cpu_isa_) + ":" + key;
+    }
+
+    bool load_cached_code(const std::string &key) {
+        jit_utils::code_cache::entry_t e;
+        if (!jit_utils::code_cache::load(name(), key, e)) return false;
+        db(e.code.data(), e.code.size());
+        if (!is_initialized()) {
+            resetSize();
+            return false;
+        }
+        // The code refers to itself by absolute addresses, update them to the
+        // new location
+        const auto top = reinterpret_cast<uint64_t>(CodeGenerator::getCode());
+        for (const auto &r : e.relocs)
+            rewrite(r.first, top + r.second, sizeof(uint64_t));
+        return true;
+    }
     const Xbyak::uint8 *getCode() {
         this->ready();
         if (!is_initialized()) return nullptr;
@@ -1707,6 +1752,15 @@ private:
 
 protected:
     virtual void generate() = 0;
+
+    // A kernel which code is fully defined by the returned key may be stored
+    // in the persistent code cache (see DNNL_JIT_CACHE_DIR). The kernel must
+    // not refer by absolute address to any memory outside of the code (e.g.
+    // to static tables or to the kernel parameters), must load the addresses
+    // of labels with mov_label_address(), and must not rely on any state set
+    // in generate(), as generate() is skipped on a cache hit.
+    virtual std::string persistent_cache_key() const { return std::string(); }
+
     const Xbyak::uint8 *jit_ker_ = nullptr;
 };
 
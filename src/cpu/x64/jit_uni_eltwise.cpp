@@ -142,6 +142,17 @@ struct jit_uni_kernel_t : public jit_uni_eltwise_kernel {
                 reg_injector_table, injector_mask, is_fwd, pd_->use_dst()));
     }
 
+    // The code is defined by the descriptor, the data type and the isa. The
+    // pow algorithm calls powf() by absolute address and is not cached.
+    std::string persistent_cache_key() const override {
+        const auto &desc = *pd_->desc();
+        std::string key;
+        if (desc.alg_kind == alg_kind::eltwise_pow) return key;
+        jit_utils::code_cache::append_key(key, isa, desc.alg_kind, desc.alpha,
+                desc.beta, pd_->is_fwd(), pd_->use_dst(), data_type());
+        return key;
+    }
+
     void generate() override {
         const bool is_fwd = pd_->is_fwd();
         preamble();
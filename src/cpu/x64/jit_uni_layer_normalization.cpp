@@ -0,0 +1,887 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <functional>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/nstl.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/jit_avx512_core_bf16cvt.hpp"
+#include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/jit_uni_layer_normalization.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::utils;
+using namespace memory_tracking::names;
+
+namespace lnorm_impl {
+
+using namespace Xbyak;
+
+struct call_params_t {
+    const void *src, *diff_dst;
+    void *dst; // diff_src for backward
+    const float *scale; // gamma of the row part, beta follows C floats later
+    float *diff_scale; // diff_gamma of the row part, diff_beta as for scale
+    float *mean, *var; // statistics of the first row
+    float *partials; // backward: the partial sums of the first row
+    size_t n_rows;
+};
+
+template <cpu_isa_t isa>
+struct jit_lnorm_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_lnorm_kernel_t)
+
+    jit_lnorm_kernel_t(const jit_lnorm_kernel_conf_t &conf) : conf_(conf) {
+        if (conf_.dt == data_type::bf16 && !mayiuse(avx512_core_bf16))
+            bf16_emu_.reset(new bf16_emulation_t(this, bf16_emu_zmm_1,
+                    bf16_emu_zmm_2, bf16_emu_zmm_3, reg_bf16_emu,
+                    bf16_emu_zmm_4, bf16_emu_zmm_5));
+    }
+
+    void operator()(const call_params_t *p) const {
+        jit_generator::operator()(p);
+    }
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+
+    static constexpr bool is_avx512 = isa == avx512_common;
+    static constexpr int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+    // the backward kernel keeps two accumulators and two inputs per unroll
+    static constexpr int unroll_fwd = 4;
+    static constexpr int unroll_bwd = 2;
+
+    const jit_lnorm_kernel_conf_t conf_;
+
+    Reg64 reg_param = abi_param1;
+    Reg64 reg_src = r8;
+    Reg64 reg_diff_dst = r9;
+    Reg64 reg_dst = r10;
+    Reg64 reg_scale = r11;
+    Reg64 reg_diff_scale = r12;
+    Reg64 reg_mean = r13;
+    Reg64 reg_var = r14;
+    Reg64 reg_partials = rsi;
+    Reg64 reg_rows = rbp;
+    Reg64 reg_off = rax;
+    Reg64 reg_tmp = rbx;
+    Reg64 reg_cnt = rdx;
+    Reg64 reg_bf16_emu = r15;
+
+    Opmask k_tail = Opmask(1);
+
+    // forward: vacc [0, 4), vsrc [4, 8)
+    // backward: vacc [0, 2), vacc_x [2, 4), vsrc [4, 6), vdiff_dst [6, 8)
+    Vmm vacc(int i) const { return Vmm(i); }
+    Vmm vacc_x(int i) const { return Vmm(unroll_bwd + i); }
+    Vmm vsrc(int i) const { return Vmm(4 + i); }
+    Vmm vdiff_dst(int i) const { return Vmm(6 + i); }
+    Vmm vmean = Vmm(8);
+    Vmm vinv_sqrtvar = Vmm(9);
+    Vmm vgamma = Vmm(10);
+    Vmm vtmp = Vmm(11);
+    Vmm vdd_gamma = Vmm(12);
+    Vmm vdd_gamma_x = Vmm(13);
+    Vmm vtail_mask = Vmm(14);
+    Vmm vtmp2 = Vmm(15);
+
+    Xmm xtmp = Xmm(15);
+
+    std::unique_ptr<bf16_emulation_t> bf16_emu_ = nullptr;
+    Zmm bf16_emu_zmm_1 = Zmm(26);
+    Zmm bf16_emu_zmm_2 = Zmm(27);
+    Zmm bf16_emu_zmm_3 = Zmm(28);
+    Zmm bf16_emu_zmm_4 = Zmm(29);
+    Zmm bf16_emu_zmm_5 = Zmm(30);
+    Ymm bf16_cvt_ymm = Ymm(31);
+
+    bool is_bf16() const { return conf_.dt == data_type::bf16; }
+    int dt_size() const { return types::data_type_size(conf_.dt); }
+    int tail() const { return conf_.len % simd_w; }
+
+    Address data_ptr(const Reg64 &base, int disp) {
+        return ptr[base + reg_off * dt_size() + disp * dt_size()];
+    }
+    Address f32_ptr(const Reg64 &base, dim_t disp) {
+        return ptr[base + reg_off * sizeof(float) + disp * sizeof(float)];
+    }
+
+    void load(const Vmm &vmm, const Address &addr, bool tail, bool is_f32) {
+        if (is_avx512) {
+            const auto vmm_ld = tail ? vmm | k_tail | T_z : vmm;
+            if (is_bf16() && !is_f32) {
+                vpmovzxwd(vmm_ld, addr);
+                vpslld(vmm, vmm, 0x10);
+            } else
+                vmovups(vmm_ld, addr);
+        } else {
+            if (tail)
+                uni_vmovups_tail(vmm, vtail_mask, addr);
+            else
+                uni_vmovups(vmm, addr);
+        }
+    }
+
+    void store(const Address &addr, const Vmm &vmm, bool tail, bool is_f32) {
+        if (is_avx512) {
+            const auto addr_st = tail ? addr | k_tail : addr;
+            if (is_bf16() && !is_f32) {
+                if (bf16_emu_)
+                    bf16_emu_->vcvtneps2bf16(bf16_cvt_ymm, Zmm(vmm.getIdx()));
+                else
+                    vcvtneps2bf16(bf16_cvt_ymm, vmm);
+                vmovdqu16(addr_st, bf16_cvt_ymm);
+            } else
+                vmovups(addr_st, vmm);
+        } else {
+            if (tail)
+                uni_vmovups_tail(addr, vtail_mask, vmm);
+            else
+                uni_vmovups(addr, vmm);
+        }
+    }
+
+    void load_scalar_const(const Xmm &x, float v) {
+        mov(reg_tmp, float2int(v));
+        uni_vmovq(x, reg_tmp);
+    }
+
+    // Sums the elements of `v` into its lowest element
+    void horizontal_sum(const Vmm &v) {
+        if (is_avx512) {
+            const Zmm z(v.getIdx()), ztmp(vtmp2.getIdx());
+            vshuff32x4(ztmp, z, z, 0x4E);
+            vaddps(z, z, ztmp);
+            vshuff32x4(ztmp, z, z, 0xB1);
+            vaddps(z, z, ztmp);
+        } else {
+            const Ymm y(v.getIdx()), ytmp(vtmp2.getIdx());
+            vperm2f128(ytmp, y, y, 0x01);
+            vaddps(y, y, ytmp);
+        }
+        const Xmm x(v.getIdx());
+        vhaddps(x, x, x);
+        vhaddps(x, x, x);
+    }
+
+    // Calls op(unroll_idx, offset, is_tail) for each vector of a row part,
+    // `reg_off` holding the offset (in elements) of the unrolled block
+    template <typename F>
+    void loop_over_row(int unroll, F op) {
+        const dim_t n_vecs = conf_.len / simd_w;
+        const dim_t n_unrolled = n_vecs / unroll;
+
+        xor_(reg_off, reg_off);
+        if (n_unrolled > 0) {
+            Label unroll_loop;
+            mov(reg_cnt, n_unrolled);
+            L(unroll_loop);
+            {
+                for (int i = 0; i < unroll; i++)
+                    op(i, i * simd_w, false);
+                add(reg_off, unroll * simd_w);
+                dec(reg_cnt);
+                jnz(unroll_loop, T_NEAR);
+            }
+        }
+        const int rem = n_vecs % unroll;
+        for (int i = 0; i < rem; i++)
+            op(i, i * simd_w, false);
+        if (tail() > 0) op(rem, rem * simd_w, true);
+    }
+
+    void reduce_accumulators(int unroll, const std::function<Vmm(int)> &acc) {
+        for (int i = 1; i < unroll; i++)
+            vaddps(acc(0), acc(0), acc(i));
+        horizontal_sum(acc(0));
+    }
+
+    // vinv_sqrtvar = 1 / sqrt(var + eps), var is taken from memory
+    void compute_inv_sqrtvar(const Xmm &xvar) {
+        load_scalar_const(xtmp, conf_.eps);
+        vaddss(xvar, xvar, xtmp);
+        vsqrtss(xvar, xvar, xvar);
+        load_scalar_const(xtmp, 1.f);
+        vdivss(xvar, xtmp, xvar);
+        uni_vbroadcastss(vinv_sqrtvar, xvar);
+    }
+
+    void generate_fwd_row() {
+        const Xmm xmean = Xmm(vmean.getIdx());
+        const Xmm xvar = Xmm(vinv_sqrtvar.getIdx());
+        const Xmm xacc = Xmm(vacc(0).getIdx());
+
+        if (conf_.calculate_stats) {
+            auto zero_acc = [&]() {
+                for (int i = 0; i < unroll_fwd; i++)
+                    uni_vpxor(vacc(i), vacc(i), vacc(i));
+            };
+            auto acc = [&](int i) { return vacc(i); };
+
+            // mean, the following passes hit the row part in cache
+            zero_acc();
+            loop_over_row(unroll_fwd, [&](int i, int off, bool tail) {
+                load(vsrc(i), data_ptr(reg_src, off), tail, false);
+                vaddps(vacc(i), vacc(i), vsrc(i));
+            });
+            reduce_accumulators(unroll_fwd, acc);
+            load_scalar_const(xtmp, (float)conf_.len);
+            vdivss(xmean, xacc, xtmp);
+            uni_vbroadcastss(vmean, xmean);
+
+            // variance
+            zero_acc();
+            loop_over_row(unroll_fwd, [&](int i, int off, bool tail) {
+                load(vsrc(i), data_ptr(reg_src, off), tail, false);
+                if (is_avx512 && tail)
+                    vsubps(vsrc(i) | k_tail | T_z, vsrc(i), vmean);
+                else
+                    vsubps(vsrc(i), vsrc(i), vmean);
+                if (!is_avx512 && tail) vandps(vsrc(i), vsrc(i), vtail_mask);
+                vfmadd231ps(vacc(i), vsrc(i), vsrc(i));
+            });
+            reduce_accumulators(unroll_fwd, acc);
+            load_scalar_const(xtmp, (float)conf_.len);
+            vdivss(xvar, xacc, xtmp);
+
+            if (conf_.save_stats) {
+                vmovss(ptr[reg_mean], xmean);
+                vmovss(ptr[reg_var], xvar);
+            }
+        } else if (conf_.compute_data) {
+            vmovss(xmean, ptr[reg_mean]);
+            uni_vbroadcastss(vmean, xmean);
+            vmovss(xvar, ptr[reg_var]);
+        }
+
+        if (!conf_.compute_data) return;
+
+        compute_inv_sqrtvar(xvar);
+        loop_over_row(unroll_fwd, [&](int i, int off, bool tail) {
+            const Vmm v = vsrc(i);
+            load(v, data_ptr(reg_src, off), tail, false);
+            vsubps(v, v, vmean);
+            vmulps(v, v, vinv_sqrtvar);
+            if (conf_.use_scaleshift) {
+                // vacc is free at this point, use it for gamma
+                load(vacc(i), f32_ptr(reg_scale, off), tail, true);
+                load(vtmp, f32_ptr(reg_scale, off + conf_.C), tail, true);
+                vfmadd213ps(v, vacc(i), vtmp);
+            }
+            store(data_ptr(reg_dst, off), v, tail, false);
+        });
+    }
+
+    void generate_bwd_row() {
+        const Xmm xmean = Xmm(vmean.getIdx());
+        const Xmm xvar = Xmm(vinv_sqrtvar.getIdx());
+        const Xmm xdd_gamma = Xmm(vdd_gamma.getIdx());
+        const Xmm xdd_gamma_x = Xmm(vdd_gamma_x.getIdx());
+        const bool need_dd_sums
+                = !conf_.use_global_stats && conf_.compute_data;
+
+        vmovss(xmean, ptr[reg_mean]);
+        uni_vbroadcastss(vmean, xmean);
+        vmovss(xvar, ptr[reg_var]);
+        compute_inv_sqrtvar(xvar);
+
+        if (conf_.calculate_stats || conf_.compute_diff_ss) {
+            for (int i = 0; i < unroll_bwd; i++) {
+                uni_vpxor(vacc(i), vacc(i), vacc(i));
+                uni_vpxor(vacc_x(i), vacc_x(i), vacc_x(i));
+            }
+            loop_over_row(unroll_bwd, [&](int i, int off, bool tail) {
+                const Vmm dd = vdiff_dst(i), x = vsrc(i);
+                load(dd, data_ptr(reg_diff_dst, off), tail, false);
+                load(x, data_ptr(reg_src, off), tail, false);
+                vsubps(x, x, vmean);
+                if (conf_.compute_diff_ss) {
+                    // diff_gamma += dd * x_hat, diff_beta += dd
+                    vmulps(vtmp2, x, vinv_sqrtvar);
+                    load(vtmp, f32_ptr(reg_diff_scale, off), tail, true);
+                    vfmadd231ps(vtmp, vtmp2, dd);
+                    store(f32_ptr(reg_diff_scale, off), vtmp, tail, true);
+                    load(vtmp, f32_ptr(reg_diff_scale, off + conf_.C), tail,
+                            true);
+                    vaddps(vtmp, vtmp, dd);
+                    store(f32_ptr(reg_diff_scale, off + conf_.C), vtmp, tail,
+                            true);
+                }
+                if (conf_.calculate_stats) {
+                    if (conf_.use_scaleshift) {
+                        load(vgamma, f32_ptr(reg_scale, off), tail, true);
+                        vmulps(dd, dd, vgamma);
+                    }
+                    vaddps(vacc(i), vacc(i), dd);
+                    vfmadd231ps(vacc_x(i), dd, x);
+                }
+            });
+
+            if (conf_.calculate_stats) {
+                reduce_accumulators(unroll_bwd, [&](int i) { return vacc(i); });
+                reduce_accumulators(
+                        unroll_bwd, [&](int i) { return vacc_x(i); });
+                vmovss(xdd_gamma, Xmm(vacc(0).getIdx()));
+                vmulss(xdd_gamma_x, Xmm(vacc_x(0).getIdx()),
+                        Xmm(vinv_sqrtvar.getIdx()));
+                if (!conf_.compute_data) {
+                    vmovss(ptr[reg_partials], xdd_gamma);
+                    vmovss(ptr[reg_partials + sizeof(float)], xdd_gamma_x);
+                }
+            }
+        }
+
+        if (!conf_.compute_data) return;
+
+        if (need_dd_sums) {
+            if (!conf_.calculate_stats) {
+                vmovss(xdd_gamma, ptr[reg_partials]);
+                vmovss(xdd_gamma_x, ptr[reg_partials + sizeof(float)]);
+            }
+            load_scalar_const(xtmp, (float)conf_.C);
+            vdivss(xdd_gamma, xdd_gamma, xtmp);
+            vdivss(xdd_gamma_x, xdd_gamma_x, xtmp);
+            uni_vbroadcastss(vdd_gamma, xdd_gamma);
+            uni_vbroadcastss(vdd_gamma_x, xdd_gamma_x);
+        }
+
+        // diff_src = (dd * gamma - (dd_gamma + x_hat * dd_gamma_x) / C)
+        //         * inv_sqrtvar
+        loop_over_row(unroll_bwd, [&](int i, int off, bool tail) {
+            const Vmm dd = vdiff_dst(i), x = vsrc(i);
+            load(dd, data_ptr(reg_diff_dst, off), tail, false);
+            if (conf_.use_scaleshift) {
+                load(vgamma, f32_ptr(reg_scale, off), tail, true);
+                vmulps(dd, dd, vgamma);
+            }
+            if (need_dd_sums) {
+                load(x, data_ptr(reg_src, off), tail, false);
+                vsubps(x, x, vmean);
+                vmulps(x, x, vinv_sqrtvar);
+                vfmadd213ps(x, vdd_gamma_x, vdd_gamma);
+                vsubps(dd, dd, x);
+            }
+            vmulps(dd, dd, vinv_sqrtvar);
+            store(data_ptr(reg_dst, off), dd, tail, false);
+        });
+    }
+
+    void generate() override {
+        preamble();
+
+#define PARAM_OFF(x) offsetof(call_params_t, x)
+        mov(reg_src, ptr[reg_param + PARAM_OFF(src)]);
+        mov(reg_diff_dst, ptr[reg_param + PARAM_OFF(diff_dst)]);
+        mov(reg_dst, ptr[reg_param + PARAM_OFF(dst)]);
+        mov(reg_scale, ptr[reg_param + PARAM_OFF(scale)]);
+        mov(reg_diff_scale, ptr[reg_param + PARAM_OFF(diff_scale)]);
+        mov(reg_mean, ptr[reg_param + PARAM_OFF(mean)]);
+        mov(reg_var, ptr[reg_param + PARAM_OFF(var)]);
+        mov(reg_partials, ptr[reg_param + PARAM_OFF(partials)]);
+        mov(reg_rows, ptr[reg_param + PARAM_OFF(n_rows)]);
+#undef PARAM_OFF
+
+        if (tail() > 0) {
+            if (is_avx512) {
+                mov(reg_tmp.cvt32(), (1 << tail()) - 1);
+                kmovw(k_tail, reg_tmp.cvt32());
+            } else {
+                static const uint32_t mask_f32[14]
+                        = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                                0xffffffff, 0xffffffff, 0xffffffff, 0, 0, 0,
+                                0, 0, 0, 0};
+                mov(reg_tmp,
+                        reinterpret_cast<size_t>(&mask_f32[7 - tail()]));
+                vmovups(vtail_mask, ptr[reg_tmp]);
+            }
+        }
+        if (bf16_emu_) bf16_emu_->init_vcvtneps2bf16();
+
+        Label row_loop;
+        L(row_loop);
+        {
+            if (conf_.is_fwd)
+                generate_fwd_row();
+            else
+                generate_bwd_row();
+
+            const int64_t row_stride = conf_.C * dt_size();
+            add(reg_src, row_stride);
+            add(reg_dst, row_stride);
+            if (!conf_.is_fwd) {
+                add(reg_diff_dst, row_stride);
+                add(reg_partials, conf_.partial_stride * sizeof(float));
+            }
+            add(reg_mean, sizeof(float));
+            add(reg_var, sizeof(float));
+            dec(reg_rows);
+            jnz(row_loop, T_NEAR);
+        }
+
+        postamble();
+    }
+};
+
+} // namespace lnorm_impl
+
+namespace {
+
+jit_lnorm_kernel_conf_t make_kernel_conf(const layer_normalization_pd_t *pd,
+        dim_t len, bool calculate_stats, bool save_stats, bool compute_data) {
+    jit_lnorm_kernel_conf_t kc;
+    kc.dt = pd->src_md()->data_type;
+    kc.is_fwd = pd->is_fwd();
+    kc.len = len;
+    kc.C = pd->norm_axis();
+    kc.calculate_stats = calculate_stats;
+    kc.save_stats = save_stats;
+    kc.compute_data = compute_data;
+    kc.use_global_stats = pd->use_global_stats();
+    kc.use_scaleshift = pd->use_scaleshift();
+    kc.compute_diff_ss = !pd->is_fwd() && pd->use_scaleshift()
+            && pd->desc()->prop_kind == prop_kind::backward;
+    kc.partial_stride = 0;
+    kc.eps = pd->desc()->layer_norm_epsilon;
+    return kc;
+}
+
+status_t init_lnorm_conf(jit_lnorm_conf_t &conf, cpu_isa_t isa,
+        const layer_normalization_pd_t *pd) {
+    const bool is_fwd = pd->is_fwd();
+    const memory_desc_wrapper src_d(pd->src_md());
+    const int ndims = pd->ndims();
+
+    // plain dense data with the normalized dimension being the innermost one
+    const bool data_ok = src_d.is_blocking_desc()
+            && src_d.blocking_desc().inner_nblks == 0
+            && src_d.blocking_desc().strides[ndims - 1] == 1
+            && src_d.is_dense() && !src_d.has_runtime_dims_or_strides()
+            && IMPLICATION(!is_fwd,
+                    memory_desc_wrapper(pd->diff_src_md()) == src_d);
+    if (!data_ok) return status::unimplemented;
+
+    // statistics are expected in the order of the rows, no reorders here
+    const bool stats_used = !is_fwd || !pd->stats_are_tmp();
+    if (stats_used) {
+        memory_desc_t compatible_stat_md = *pd->src_md();
+        compatible_stat_md.data_type = data_type::f32;
+        compatible_stat_md.ndims -= 1;
+        CHECK(memory_desc_init_by_blocking_desc(
+                compatible_stat_md, pd->src_md()->format_desc.blocking));
+        if (compatible_stat_md != *pd->stat_md()) return status::unimplemented;
+    }
+
+    conf.N = pd->across_axis();
+    conf.C = pd->norm_axis();
+    conf.nthr = dnnl_get_max_threads();
+
+    const int simd_w = isa == avx512_common ? 16 : 8;
+    const dim_t dt_size = types::data_type_size(pd->src_md()->data_type);
+    const dim_t L2_size = platform::get_per_core_cache_size(2);
+    // bytes of a row touched by a pass: src and dst, or src, diff_dst and
+    // diff_src
+    const dim_t row_bytes = conf.C * dt_size * (is_fwd ? 2 : 3);
+    const dim_t min_chunk = 16 * simd_w;
+
+    conf.split_c = (conf.N < conf.nthr || row_bytes > L2_size)
+            && conf.C >= 2 * min_chunk;
+    if (conf.split_c) {
+        // backward computes diff_gamma/diff_beta of a chunk for all the rows
+        // in one go, hence splits the rows into as many chunks as threads
+        dim_t nchunks = is_fwd ? div_up(conf.nthr, conf.N) : conf.nthr;
+        nchunks = nstl::max(nchunks, div_up(row_bytes, L2_size / 2));
+        conf.C_blk = nstl::max(
+                min_chunk, rnd_up(div_up(conf.C, nchunks), (dim_t)simd_w));
+        conf.nchunks = div_up(conf.C, conf.C_blk);
+        conf.C_tail = conf.C - (conf.nchunks - 1) * conf.C_blk;
+    } else {
+        conf.C_blk = conf.C_tail = conf.C;
+        conf.nchunks = 1;
+    }
+
+    const bool global = pd->use_global_stats();
+    if (is_fwd) {
+        if (!conf.split_c) {
+            conf.ker = make_kernel_conf(pd, conf.C, !global,
+                    !global && pd->is_training(), true);
+        } else {
+            conf.ker = make_kernel_conf(pd, conf.C_blk, false, false, true);
+            conf.ker_stats
+                    = make_kernel_conf(pd, conf.C_blk, true, true, false);
+        }
+    } else {
+        if (!conf.split_c) {
+            conf.ker = make_kernel_conf(pd, conf.C, !global, false, true);
+        } else {
+            conf.ker = make_kernel_conf(pd, conf.C_blk, false, false, true);
+            conf.ker_stats
+                    = make_kernel_conf(pd, conf.C_blk, !global, true, false);
+            conf.ker.partial_stride = conf.ker_stats.partial_stride
+                    = 2 * conf.nchunks;
+        }
+    }
+    if (!conf.split_c) conf.ker_stats = conf.ker;
+    conf.ker_tail = conf.ker;
+    conf.ker_tail.len = conf.C_tail;
+    conf.ker_stats_tail = conf.ker_stats;
+    conf.ker_stats_tail.len = conf.C_tail;
+
+    return status::success;
+}
+
+// statistics kernels are needed only when a row is split between threads
+bool need_stats_kernel(const layer_normalization_pd_t *pd,
+        const jit_lnorm_conf_t &conf) {
+    if (!conf.split_c) return false;
+    return !pd->use_global_stats() || conf.ker_stats.compute_diff_ss;
+}
+
+template <cpu_isa_t isa>
+status_t create_kernels(const layer_normalization_pd_t *pd,
+        const jit_lnorm_conf_t &conf,
+        std::unique_ptr<lnorm_impl::jit_lnorm_kernel_t<isa>> &kernel,
+        std::unique_ptr<lnorm_impl::jit_lnorm_kernel_t<isa>> &kernel_tail,
+        std::unique_ptr<lnorm_impl::jit_lnorm_kernel_t<isa>> &kernel_stats,
+        std::unique_ptr<lnorm_impl::jit_lnorm_kernel_t<isa>>
+                &kernel_stats_tail) {
+    using kernel_t = lnorm_impl::jit_lnorm_kernel_t<isa>;
+    const bool has_tail = conf.C_tail != conf.C_blk;
+
+    CHECK(safe_ptr_assign(kernel, new kernel_t(conf.ker)));
+    CHECK(kernel->create_kernel());
+    if (has_tail) {
+        CHECK(safe_ptr_assign(kernel_tail, new kernel_t(conf.ker_tail)));
+        CHECK(kernel_tail->create_kernel());
+    }
+    if (need_stats_kernel(pd, conf)) {
+        CHECK(safe_ptr_assign(kernel_stats, new kernel_t(conf.ker_stats)));
+        CHECK(kernel_stats->create_kernel());
+        if (has_tail) {
+            CHECK(safe_ptr_assign(
+                    kernel_stats_tail, new kernel_t(conf.ker_stats_tail)));
+            CHECK(kernel_stats_tail->create_kernel());
+        }
+    }
+    return status::success;
+}
+
+} // namespace
+
+template <cpu_isa_t isa>
+status_t jit_uni_layer_normalization_fwd_t<isa>::pd_t::init_conf() {
+    return init_lnorm_conf(conf_, isa, this);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_layer_normalization_fwd_t<isa>::pd_t::init_scratchpad() {
+    if (!conf_.split_c) return;
+    auto scratchpad = scratchpad_registry().registrar();
+    if (!stats_are_src())
+        scratchpad.template book<float>(
+                key_lnorm_reduction, 2 * conf_.N * conf_.nchunks);
+    if (stats_are_tmp()) {
+        scratchpad.template book<float>(key_lnorm_tmp_mean, conf_.N);
+        scratchpad.template book<float>(key_lnorm_tmp_var, conf_.N);
+    }
+}
+
+template <cpu_isa_t isa>
+jit_uni_layer_normalization_fwd_t<isa>::jit_uni_layer_normalization_fwd_t(
+        const pd_t *apd)
+    : primitive_t(apd) {}
+
+template <cpu_isa_t isa>
+jit_uni_layer_normalization_fwd_t<isa>::~jit_uni_layer_normalization_fwd_t()
+        = default;
+
+template <cpu_isa_t isa>
+status_t jit_uni_layer_normalization_fwd_t<isa>::init(engine_t *engine) {
+    return create_kernels<isa>(pd(), pd()->conf_, kernel_, kernel_tail_,
+            kernel_stats_, kernel_stats_tail_);
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_layer_normalization_fwd_t<isa>::execute(
+        const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+    auto scaleshift = CTX_IN_MEM(const float *, DNNL_ARG_SCALE_SHIFT);
+
+    const auto &conf = pd()->conf_;
+    auto scratchpad = ctx.get_scratchpad_grantor();
+
+    float *mean = nullptr, *variance = nullptr;
+    if (pd()->stats_are_src()) {
+        mean = const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_MEAN));
+        variance = const_cast<float *>(
+                CTX_IN_MEM(const float *, DNNL_ARG_VARIANCE));
+    } else if (pd()->is_training()) {
+        mean = CTX_OUT_MEM(float *, DNNL_ARG_MEAN);
+        variance = CTX_OUT_MEM(float *, DNNL_ARG_VARIANCE);
+    } else if (conf.split_c) {
+        mean = scratchpad.template get<float>(key_lnorm_tmp_mean);
+        variance = scratchpad.template get<float>(key_lnorm_tmp_var);
+    }
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const dim_t dt_size = src_d.data_type_size();
+    src += src_d.offset0() * dt_size;
+    dst += src_d.offset0() * dt_size;
+
+    const dim_t N = conf.N, C = conf.C;
+
+    auto call_kernel = [&](const lnorm_impl::jit_lnorm_kernel_t<isa> *ker,
+                               dim_t n, dim_t c, dim_t n_rows, float *m,
+                               float *v) {
+        lnorm_impl::call_params_t p;
+        p.src = src + (n * C + c) * dt_size;
+        p.diff_dst = nullptr;
+        p.dst = dst + (n * C + c) * dt_size;
+        p.scale = scaleshift ? scaleshift + c : nullptr;
+        p.diff_scale = nullptr;
+        p.mean = m;
+        p.var = v;
+        p.partials = nullptr;
+        p.n_rows = n_rows;
+        (*ker)(&p);
+    };
+    auto chunk_kernel = [&](dim_t ch, bool stats) {
+        const bool is_tail = ch == conf.nchunks - 1 && kernel_tail_;
+        if (stats)
+            return is_tail ? kernel_stats_tail_.get() : kernel_stats_.get();
+        return is_tail ? kernel_tail_.get() : kernel_.get();
+    };
+
+    if (!conf.split_c) {
+        parallel(conf.nthr, [&](const int ithr, const int nthr) {
+            dim_t start {0}, end {0};
+            balance211(N, nthr, ithr, start, end);
+            if (start >= end) return;
+            call_kernel(kernel_.get(), start, 0, end - start,
+                    mean ? mean + start : nullptr,
+                    variance ? variance + start : nullptr);
+        });
+        return status::success;
+    }
+
+    const dim_t nchunks = conf.nchunks;
+    if (!pd()->stats_are_src()) {
+        float *partials = scratchpad.template get<float>(key_lnorm_reduction);
+        parallel_nd(N, nchunks, [&](dim_t n, dim_t ch) {
+            float *part = &partials[2 * (n * nchunks + ch)];
+            call_kernel(chunk_kernel(ch, true), n, ch * conf.C_blk, 1, part,
+                    part + 1);
+        });
+        // Chan et al. combination of the chunk statistics
+        parallel_nd(N, [&](dim_t n) {
+            const float *part = &partials[2 * n * nchunks];
+            float m = 0.f, v = 0.f;
+            for (dim_t ch = 0; ch < nchunks; ch++) {
+                const dim_t len = ch == nchunks - 1 ? conf.C_tail : conf.C_blk;
+                m += len * part[2 * ch];
+            }
+            m /= C;
+            for (dim_t ch = 0; ch < nchunks; ch++) {
+                const dim_t len = ch == nchunks - 1 ? conf.C_tail : conf.C_blk;
+                const float d = part[2 * ch] - m;
+                v += len * (part[2 * ch + 1] + d * d);
+            }
+            mean[n] = m;
+            variance[n] = v / C;
+        });
+    }
+    parallel_nd(N, nchunks, [&](dim_t n, dim_t ch) {
+        call_kernel(chunk_kernel(ch, false), n, ch * conf.C_blk, 1, mean + n,
+                variance + n);
+    });
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_layer_normalization_bwd_t<isa>::pd_t::init_conf() {
+    return init_lnorm_conf(conf_, isa, this);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_layer_normalization_bwd_t<isa>::pd_t::init_scratchpad() {
+    auto scratchpad = scratchpad_registry().registrar();
+    if (conf_.split_c) {
+        if (!use_global_stats())
+            scratchpad.template book<float>(
+                    key_lnorm_reduction, 2 * conf_.N * conf_.nchunks);
+    } else if (conf_.ker.compute_diff_ss) {
+        scratchpad.template book<float>(
+                key_lnorm_reduction, 2 * conf_.C * conf_.nthr);
+    }
+}
+
+template <cpu_isa_t isa>
+jit_uni_layer_normalization_bwd_t<isa>::jit_uni_layer_normalization_bwd_t(
+        const pd_t *apd)
+    : primitive_t(apd) {}
+
+template <cpu_isa_t isa>
+jit_uni_layer_normalization_bwd_t<isa>::~jit_uni_layer_normalization_bwd_t()
+        = default;
+
+template <cpu_isa_t isa>
+status_t jit_uni_layer_normalization_bwd_t<isa>::init(engine_t *engine) {
+    return create_kernels<isa>(pd(), pd()->conf_, kernel_, kernel_tail_,
+            kernel_stats_, kernel_stats_tail_);
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_layer_normalization_bwd_t<isa>::execute(
+        const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto diff_dst = CTX_IN_MEM(const char *, DNNL_ARG_DIFF_DST);
+    auto scaleshift = CTX_IN_MEM(const float *, DNNL_ARG_SCALE_SHIFT);
+    auto mean = const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_MEAN));
+    auto variance = const_cast<float *>(
+            CTX_IN_MEM(const float *, DNNL_ARG_VARIANCE));
+    auto diff_src = CTX_OUT_MEM(char *, DNNL_ARG_DIFF_SRC);
+    auto diff_scaleshift = CTX_OUT_MEM(float *, DNNL_ARG_DIFF_SCALE_SHIFT);
+
+    const auto &conf = pd()->conf_;
+    auto scratchpad = ctx.get_scratchpad_grantor();
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper diff_data_d(pd()->diff_src_md());
+    const dim_t dt_size = src_d.data_type_size();
+    src += src_d.offset0() * dt_size;
+    diff_dst += diff_data_d.offset0() * dt_size;
+    diff_src += diff_data_d.offset0() * dt_size;
+
+    const dim_t N = conf.N, C = conf.C;
+    const bool compute_diff_ss = conf.ker.compute_diff_ss;
+
+    auto call_kernel = [&](const lnorm_impl::jit_lnorm_kernel_t<isa> *ker,
+                               dim_t n, dim_t c, dim_t n_rows,
+                               float *diff_scale, float *partials) {
+        lnorm_impl::call_params_t p;
+        p.src = src + (n * C + c) * dt_size;
+        p.diff_dst = diff_dst + (n * C + c) * dt_size;
+        p.dst = diff_src + (n * C + c) * dt_size;
+        p.scale = scaleshift ? scaleshift + c : nullptr;
+        p.diff_scale = diff_scale;
+        p.mean = mean + n;
+        p.var = variance + n;
+        p.partials = partials;
+        p.n_rows = n_rows;
+        (*ker)(&p);
+    };
+
+    if (!conf.split_c) {
+        float *reduce = compute_diff_ss
+                ? scratchpad.template get<float>(key_lnorm_reduction)
+                : nullptr;
+        // Fewer threads than requested may run, e.g. in a nested region,
+        // so only the partials of the threads that ran are reduced
+        int nthr_used = 1;
+        parallel(conf.nthr, [&](const int ithr, const int nthr) {
+            if (ithr == 0) nthr_used = nthr;
+            float *my_diff_ss = nullptr;
+            if (compute_diff_ss) {
+                my_diff_ss = reduce + 2 * C * ithr;
+                for (dim_t c = 0; c < 2 * C; c++)
+                    my_diff_ss[c] = 0.f;
+            }
+            dim_t start {0}, end {0};
+            balance211(N, nthr, ithr, start, end);
+            if (start >= end) return;
+            call_kernel(
+                    kernel_.get(), start, 0, end - start, my_diff_ss, nullptr);
+        });
+        if (compute_diff_ss) {
+            parallel_nd(C, [&](dim_t c) {
+                float diff_gamma = 0.f, diff_beta = 0.f;
+                for (int ithr = 0; ithr < nthr_used; ithr++) {
+                    diff_gamma += reduce[2 * C * ithr + c];
+                    diff_beta += reduce[2 * C * ithr + C + c];
+                }
+                diff_scaleshift[c] = diff_gamma;
+                diff_scaleshift[C + c] = diff_beta;
+            });
+        }
+        return status::success;
+    }
+
+    const dim_t nchunks = conf.nchunks;
+    float *partials = pd()->use_global_stats()
+            ? nullptr
+            : scratchpad.template get<float>(key_lnorm_reduction);
+    auto chunk_kernel = [&](dim_t ch, bool stats) {
+        const bool is_tail = ch == nchunks - 1 && kernel_tail_;
+        if (stats)
+            return is_tail ? kernel_stats_tail_.get() : kernel_stats_.get();
+        return is_tail ? kernel_tail_.get() : kernel_.get();
+    };
+
+    // a chunk is owned by a single thread for all the rows, so it accumulates
+    // diff_gamma and diff_beta directly in the destination
+    if (kernel_stats_) {
+        parallel_nd(nchunks, [&](dim_t ch) {
+            const dim_t c = ch * conf.C_blk;
+            float *diff_scale = nullptr;
+            if (compute_diff_ss) {
+                const dim_t len = ch == nchunks - 1 ? conf.C_tail : conf.C_blk;
+                diff_scale = diff_scaleshift + c;
+                for (dim_t i = 0; i < len; i++)
+                    diff_scale[i] = diff_scale[C + i] = 0.f;
+            }
+            call_kernel(chunk_kernel(ch, true), 0, c, N, diff_scale,
+                    partials ? partials + 2 * ch : nullptr);
+        });
+    }
+    if (partials) {
+        parallel_nd(N, [&](dim_t n) {
+            float *part = &partials[2 * n * nchunks];
+            for (dim_t ch = 1; ch < nchunks; ch++) {
+                part[0] += part[2 * ch];
+                part[1] += part[2 * ch + 1];
+            }
+        });
+    }
+    parallel_nd(N, nchunks, [&](dim_t n, dim_t ch) {
+        call_kernel(chunk_kernel(ch, false), n, ch * conf.C_blk, 1, nullptr,
+                partials ? partials + 2 * n * nchunks : nullptr);
+    });
+
+    return status::success;
+}
+
+template struct jit_uni_layer_normalization_fwd_t<avx512_common>;
+template struct jit_uni_layer_normalization_fwd_t<avx2>;
+template struct jit_uni_layer_normalization_bwd_t<avx512_common>;
+template struct jit_uni_layer_normalization_bwd_t<avx2>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,186 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_LAYER_NORMALIZATION_HPP
+#define CPU_X64_JIT_UNI_LAYER_NORMALIZATION_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_layer_normalization_pd.hpp"
+#include "cpu/platform.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+struct jit_lnorm_kernel_conf_t {
+    data_type_t dt;
+    bool is_fwd;
+    dim_t len; // elements of a row processed by a kernel call
+    dim_t C; // elements in a row of the tensor
+    // forward: compute mean and variance of the row (part),
+    // backward: compute sum(dd * gamma) and sum(dd * gamma * x_hat)
+    bool calculate_stats;
+    // store computed statistics, these are partial ones when !compute_data
+    bool save_stats;
+    bool compute_data; // forward: dst, backward: diff_src
+    bool use_global_stats;
+    bool use_scaleshift;
+    bool compute_diff_ss;
+    dim_t partial_stride; // backward: floats between the partial sums of rows
+    float eps;
+};
+
+// Rows are normalized by a single kernel call each, with the statistics
+// computed from the row kept in cache, unless there are fewer rows than
+// threads or a row does not fit L2. In the latter case the rows are split
+// into `nchunks` chunks of `C_blk` channels processed by different threads,
+// and the per chunk statistics are combined between the passes.
+struct jit_lnorm_conf_t {
+    dim_t N, C;
+    bool split_c;
+    dim_t C_blk, C_tail, nchunks;
+    int nthr;
+    jit_lnorm_kernel_conf_t ker, ker_tail, ker_stats, ker_stats_tail;
+};
+
+namespace lnorm_impl {
+template <cpu_isa_t isa>
+struct jit_lnorm_kernel_t;
+}
+
+template <cpu_isa_t isa>
+struct jit_uni_layer_normalization_fwd_t : public primitive_t {
+    struct pd_t : public cpu_layer_normalization_fwd_pd_t {
+        using cpu_layer_normalization_fwd_pd_t::
+                cpu_layer_normalization_fwd_pd_t;
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", isa, ""),
+                jit_uni_layer_normalization_fwd_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+            const auto dt = src_md()->data_type;
+            bool ok = mayiuse(isa) && is_fwd() && !has_zero_dim_memory()
+                    && utils::one_of(dt, f32, bf16)
+                    && dst_md()->data_type == dt
+                    && stat_md()->data_type == f32
+                    && IMPLICATION(dt == bf16,
+                            is_superset(isa, avx512_common)
+                                    && mayiuse(avx512_core))
+                    && platform::has_data_type_support(dt)
+                    && check_scale_shift_data_type()
+                    && attr()->has_default_values()
+                    && set_default_formats_common();
+            if (!ok) return status::unimplemented;
+
+            CHECK(init_conf());
+
+            init_scratchpad();
+
+            return status::success;
+        }
+
+        jit_lnorm_conf_t conf_;
+
+    private:
+        status_t init_conf();
+        void init_scratchpad();
+    };
+
+    jit_uni_layer_normalization_fwd_t(const pd_t *apd);
+    ~jit_uni_layer_normalization_fwd_t();
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<lnorm_impl::jit_lnorm_kernel_t<isa>> kernel_,
+            kernel_tail_, kernel_stats_, kernel_stats_tail_;
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_layer_normalization_bwd_t : public primitive_t {
+    struct pd_t : public cpu_layer_normalization_bwd_pd_t {
+        using cpu_layer_normalization_bwd_pd_t::
+                cpu_layer_normalization_bwd_pd_t;
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", isa, ""),
+                jit_uni_layer_normalization_bwd_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+            const auto dt = src_md()->data_type;
+            bool ok = mayiuse(isa) && is_bwd() && !has_zero_dim_memory()
+                    && set_default_formats_common()
+                    && utils::one_of(dt, f32, bf16)
+                    && diff_src_md()->data_type == dt
+                    && stat_md()->data_type == f32
+                    && IMPLICATION(dt == bf16,
+                            is_superset(isa, avx512_common)
+                                    && mayiuse(avx512_core))
+                    && platform::has_data_type_support(dt)
+                    && check_scale_shift_data_type()
+                    && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            CHECK(init_conf());
+
+            init_scratchpad();
+
+            return status::success;
+        }
+
+        jit_lnorm_conf_t conf_;
+
+    private:
+        status_t init_conf();
+        void init_scratchpad();
+    };
+
+    jit_uni_layer_normalization_bwd_t(const pd_t *apd);
+    ~jit_uni_layer_normalization_bwd_t();
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<lnorm_impl::jit_lnorm_kernel_t<isa>> kernel_,
+            kernel_tail_, kernel_stats_, kernel_stats_tail_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
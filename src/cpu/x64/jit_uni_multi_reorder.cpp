@@ -0,0 +1,255 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_desc_wrapper.hpp"
+#include "common/nstl.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+#include "cpu/platform.hpp"
+
+#include "cpu/x64/jit_uni_multi_reorder.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::types;
+
+namespace {
+dim_t lcm(dim_t a, dim_t b) {
+    dim_t x = a, y = b;
+    while (y) {
+        const dim_t t = x % y;
+        x = y;
+        y = t;
+    }
+    return a / x * b;
+}
+} // namespace
+
+status_t jit_uni_multi_reorder_t::pd_t::init_chunking() {
+    std::vector<memory_desc_wrapper> mdws {memory_desc_wrapper(src_md())};
+    for (int i = 0; i < n_outputs(); ++i)
+        mdws.emplace_back(dst_md(i));
+
+    for (const auto &mdw : mdws)
+        if (!mdw.is_blocking_desc()) return status::unimplemented;
+
+    const memory_desc_wrapper &src_d = mdws[0];
+    const int ndims = src_d.ndims();
+    const dim_t *dims = src_d.dims();
+
+    // A chunk must start and end at the block boundaries of the chunked
+    // dimension, and the outer dimensions are processed one index at a time
+    // so they must not be blocked at all
+    auto dim_ok = [&](int d) {
+        for (const auto &mdw : mdws)
+            if (mdw.padded_dims()[d] != dims[d]
+                    || mdw.padded_offsets()[d] != 0)
+                return false;
+        return true;
+    };
+    auto dim_blk = [&](int d) {
+        dim_t blk = 1;
+        for (const auto &mdw : mdws) {
+            dims_t blocks;
+            mdw.compute_blocks(blocks);
+            blk = lcm(blk, blocks[d]);
+        }
+        return blk;
+    };
+
+    const size_t dt_size = data_type_size(src_d.data_type());
+    const size_t src_size = src_d.nelems(true) * dt_size;
+    const size_t nthr = dnnl_get_max_threads();
+    // Leave room in L2 for the destination lines being written, but do not
+    // make the chunks so large that some of the threads stay idle
+    const size_t chunk_size_max = nstl::max<size_t>(4096,
+            nstl::min<size_t>(platform::get_per_core_cache_size(2) / 2,
+                    utils::div_up(src_size, nthr)));
+
+    int chunk_dim = -1;
+    dim_t inner = 0;
+    for (int d = 0; d < ndims; ++d) {
+        if (!dim_ok(d)) break;
+
+        chunk_dim = d;
+        inner = 1;
+        for (int k = d + 1; k < ndims; ++k)
+            inner *= src_d.padded_dims()[k];
+
+        if (dim_blk(d) * inner * dt_size <= chunk_size_max) break;
+        if (dim_blk(d) != 1) break;
+    }
+    if (chunk_dim < 0) return status::unimplemented;
+
+    const dim_t blk = dim_blk(chunk_dim);
+    const dim_t nblks = dims[chunk_dim] / blk;
+    dim_t chunk_nblks = 1;
+    for (dim_t k = 1; k <= nblks; ++k)
+        if (nblks % k == 0 && k * blk * inner * dt_size <= chunk_size_max)
+            chunk_nblks = k;
+
+    chunk_dim_ = chunk_dim;
+    chunk_ = chunk_nblks * blk;
+    nchunks_ = dims[chunk_dim] / chunk_;
+    for (int d = 0; d < chunk_dim; ++d)
+        nchunks_ *= dims[d];
+
+    return status::success;
+}
+
+memory_desc_t jit_uni_multi_reorder_t::pd_t::chunk_md(
+        const memory_desc_t &md) const {
+    memory_desc_t cmd = md;
+    for (int d = 0; d < chunk_dim_; ++d)
+        cmd.dims[d] = cmd.padded_dims[d] = 1;
+    cmd.dims[chunk_dim_] = cmd.padded_dims[chunk_dim_] = chunk_;
+    cmd.offset0 = 0;
+    return cmd;
+}
+
+status_t jit_uni_multi_reorder_t::pd_t::init(engine_t *engine) {
+    using sm = primitive_attr_t::skip_mask_t;
+    bool ok = attr()->has_default_values(sm::oscale_runtime | sm::post_ops)
+            && attr()->output_scales_.mask_ == 0;
+    if (!ok) return status::unimplemented;
+
+    CHECK(init_chunking());
+
+    const memory_desc_t src_chunk_md = chunk_md(*src_md());
+    for (int i = 0; i < n_outputs(); ++i) {
+        const memory_desc_t dst_chunk_md = chunk_md(*dst_md(i));
+
+        auto prb = tr::prb_t();
+        CHECK(tr::prb_init(prb, src_chunk_md, dst_chunk_md, attr()));
+        if (prb.req_comp() || prb.scale_type == tr::scale_type_t::MANY)
+            return status::unimplemented;
+
+        tr::prb_normalize(prb);
+        tr::prb_simplify(prb);
+
+        tr::kernel_t::desc_t ker_desc;
+        CHECK(tr::kernel_t::desc_init(ker_desc, prb));
+
+        prbs_.push_back(prb);
+        ker_descs_.push_back(ker_desc);
+    }
+
+    return status::success;
+}
+
+status_t jit_uni_multi_reorder_t::init(engine_t *engine) {
+    for (const auto &ker_desc : pd()->ker_descs_) {
+        kernels_.emplace_back(tr::kernel_t::create(ker_desc));
+        if (!kernels_.back()) return status::out_of_memory;
+        CHECK(kernels_.back()->create_kernel());
+    }
+    return status::success;
+}
+
+/* Runs the kernel over the nodes of the problem it does not process itself,
+ * sequentially, as the whole chunk belongs to the calling thread. */
+void jit_uni_multi_reorder_t::execute_chunk(
+        int idx, const char *in, char *out, const float *scales) const {
+    const auto &prb = pd()->prbs_[idx];
+    const int ndims_ker = pd()->ker_descs_[idx].prb.ndims;
+    const int ndims_drv = prb.ndims - ndims_ker;
+    const tr::node_t *ns = prb.nodes + ndims_ker;
+
+    const size_t itype_sz = data_type_size(prb.itype);
+    const size_t otype_sz = data_type_size(prb.otype);
+    in += prb.ioff * itype_sz;
+    out += prb.ooff * otype_sz;
+
+    size_t work = 1;
+    for (int d = 0; d < ndims_drv; ++d)
+        work *= ns[d].n;
+
+    size_t pos[tr::max_ndims] = {0};
+    ptrdiff_t i_off = 0, o_off = 0;
+    for (size_t w = 0; w < work; ++w) {
+        tr::call_param_t c;
+        c.in = in + i_off * itype_sz;
+        c.out = out + o_off * otype_sz;
+        c.scale = scales;
+        c.compensation_scratch = nullptr;
+        (*kernels_[idx])(&c);
+
+        for (int d = 0; d < ndims_drv; ++d) {
+            if (++pos[d] < ns[d].n) {
+                i_off += ns[d].is;
+                o_off += ns[d].os;
+                break;
+            }
+            pos[d] = 0;
+            i_off -= (ptrdiff_t)(ns[d].n - 1) * ns[d].is;
+            o_off -= (ptrdiff_t)(ns[d].n - 1) * ns[d].os;
+        }
+    }
+}
+
+status_t jit_uni_multi_reorder_t::execute(const exec_ctx_t &ctx) const {
+    auto in = CTX_IN_MEM(const char *, DNNL_ARG_FROM);
+    DEFINE_SCALES_BUFFER(scales);
+
+    const int n = pd()->n_outputs();
+    std::vector<char *> outs(n);
+    std::vector<memory_desc_wrapper> dst_ds;
+    for (int i = 0; i < n; ++i) {
+        outs[i] = CTX_OUT_MEM(char *, DNNL_ARG_MULTIPLE_DST + i);
+        dst_ds.emplace_back(pd()->dst_md(i));
+    }
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const size_t itype_sz = src_d.data_type_size();
+    const int chunk_dim = pd()->chunk_dim_;
+    const dim_t chunk = pd()->chunk_;
+    const dim_t *dims = src_d.dims();
+
+    parallel_nd(pd()->nchunks_, [&](dim_t ic) {
+        dims_t pos = {0};
+        dim_t rem = ic;
+        const dim_t nchunks_dim = dims[chunk_dim] / chunk;
+        pos[chunk_dim] = (rem % nchunks_dim) * chunk;
+        rem /= nchunks_dim;
+        for (int d = chunk_dim - 1; d >= 0; --d) {
+            pos[d] = rem % dims[d];
+            rem /= dims[d];
+        }
+
+        const char *chunk_in = in + src_d.off_v(pos) * itype_sz;
+        for (int i = 0; i < n; ++i) {
+            char *chunk_out = outs[i]
+                    + dst_ds[i].off_v(pos) * dst_ds[i].data_type_size();
+            execute_chunk(i, chunk_in, chunk_out, scales);
+        }
+    });
+
+    return status::success;
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
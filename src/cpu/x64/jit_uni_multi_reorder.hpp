@@ -0,0 +1,82 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_MULTI_REORDER_HPP
+#define CPU_X64_JIT_UNI_MULTI_REORDER_HPP
+
+#include <memory>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+
+#include "cpu/cpu_multi_reorder_pd.hpp"
+#include "cpu/x64/jit_uni_reorder.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+/* The source is split into chunks along an outer logical dimension so that a
+ * chunk fits into L2. Each thread takes a chunk and runs the reorder kernels
+ * of all the destinations over it, hence the source is streamed from memory
+ * once and the destinations after the first one read it from the cache.
+ *
+ * All the chunks have the same shape and strides, so a single transposition
+ * problem (and kernel) per destination describes every chunk and only the
+ * base offsets differ. */
+struct jit_uni_multi_reorder_t : public primitive_t {
+    struct pd_t : public cpu_multi_reorder_pd_t {
+        using cpu_multi_reorder_pd_t::cpu_multi_reorder_pd_t;
+
+        DECLARE_MULTI_REORDER_PD_T("jit:uni", jit_uni_multi_reorder_t);
+
+        status_t init(engine_t *engine);
+
+        /* the chunk spans [pos, pos + chunk_) of chunk_dim_ and a single
+         * index of each dimension before chunk_dim_ */
+        int chunk_dim_ = 0;
+        dim_t chunk_ = 0;
+        dim_t nchunks_ = 0;
+
+        std::vector<tr::prb_t> prbs_;
+        std::vector<tr::kernel_t::desc_t> ker_descs_;
+
+    private:
+        status_t init_chunking();
+        memory_desc_t chunk_md(const memory_desc_t &md) const;
+    };
+
+    jit_uni_multi_reorder_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    void execute_chunk(
+            int idx, const char *in, char *out, const float *scales) const;
+
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+    std::vector<std::unique_ptr<tr::kernel_t>> kernels_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
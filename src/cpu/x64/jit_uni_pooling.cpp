@@ -55,7 +55,10 @@ struct trans_wrapper_t {
             prb.ooff = 0;
             prb.scale_type = scale_type_t::NONE;
             prb.beta = 0;
+            prb.req_s8s8_comp = prb.req_asymmetric_comp = false;
+            prb.scale_adjust = 1.f;
             prb.nodes[0].ss = prb.nodes[1].ss = 1;
+            prb.nodes[0].cs = prb.nodes[1].cs = 0;
 
             prb.itype = inp_dt;
             prb.otype = out_dt;
@@ -0,0 +1,691 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/bfloat16.hpp"
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/nstl.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/jit_avx512_core_bf16cvt.hpp"
+#include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/jit_uni_prelu.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::utils;
+
+status_t init_prelu_conf(jit_prelu_conf_t &conf, cpu_isa_t isa, bool is_fwd,
+        const memory_desc_t &data_md, const memory_desc_t &weights_md) {
+    using namespace format_tag;
+
+    const memory_desc_wrapper data_d(data_md);
+    const memory_desc_wrapper weights_d(weights_md);
+    const int ndims = data_d.ndims();
+
+    if (!data_d.is_blocking_desc() || !data_d.is_dense(true)
+            || data_d.has_runtime_dims_or_strides() || ndims < 2
+            || !weights_d.is_blocking_desc() || !weights_d.is_dense(true))
+        return status::unimplemented;
+
+    conf.bcast = get_rhs_arg_broadcasting_strategy(weights_md, data_d);
+    conf.dt = data_d.data_type();
+    conf.is_fwd = is_fwd;
+    conf.N = data_d.dims()[0];
+    conf.C = data_d.dims()[1];
+    conf.SP = 1;
+    for (int d = 2; d < ndims; d++)
+        conf.SP *= data_d.dims()[d];
+    conf.nelems = data_d.nelems(true);
+    conf.nthr = dnnl_get_max_threads();
+
+    const int simd_w = isa == avx512_common ? 16 : 8;
+
+    // weights should keep the channels one after another, which holds for
+    // any dense layout of [1, C, 1, ...] unless C is blocked twice
+    const auto &w_bd = weights_d.blocking_desc();
+    const bool wei_channels_dense = w_bd.inner_nblks == 0
+            || (w_bd.inner_nblks == 1 && w_bd.inner_idxs[0] == 1);
+
+    switch (conf.bcast) {
+        case broadcasting_strategy_t::no_broadcast: {
+            memory_desc_t data_md_no_offset = data_md;
+            data_md_no_offset.offset0 = weights_md.offset0;
+            if (!(weights_md == data_md_no_offset))
+                return status::unimplemented;
+            conf.kind = prelu_kernel_kind_t::elementwise;
+            conf.tail = conf.nelems % simd_w;
+            break;
+        }
+        case broadcasting_strategy_t::scalar:
+            conf.kind = prelu_kernel_kind_t::scalar_weight;
+            conf.tail = conf.nelems % simd_w;
+            break;
+        case broadcasting_strategy_t::per_oc_spatial:
+            if (!data_d.matches_one_of_tag(ncw, nchw, ncdhw)
+                    || !wei_channels_dense)
+                return status::unimplemented;
+            conf.kind = prelu_kernel_kind_t::scalar_weight;
+            conf.tail = conf.SP % simd_w;
+            break;
+        case broadcasting_strategy_t::per_oc: {
+            const auto blocked_tag = data_d.matches_one_of_tag(nCw16c, nChw16c,
+                    nCdhw16c, nCw8c, nChw8c, nCdhw8c);
+            const bool is_channels_last = data_d.matches_one_of_tag(
+                                                  nc, nwc, nhwc, ndhwc)
+                    != undef;
+            if ((blocked_tag == undef && !is_channels_last)
+                    || !wei_channels_dense
+                    || weights_d.padded_dims()[1] != data_d.padded_dims()[1])
+                return status::unimplemented;
+
+            conf.kind = prelu_kernel_kind_t::vector_weights;
+            if (is_channels_last) {
+                conf.row_len = conf.C;
+                conf.n_rows = conf.N * conf.SP;
+                conf.rows_per_wei_blk = conf.n_rows;
+                conf.n_wei_blks = 1;
+            } else {
+                conf.row_len = data_d.blocking_desc().inner_blks[0];
+                conf.n_wei_blks = data_d.padded_dims()[1] / conf.row_len;
+                conf.n_rows = conf.N * conf.n_wei_blks * conf.SP;
+                conf.rows_per_wei_blk = conf.SP;
+            }
+            conf.tail = conf.row_len % simd_w;
+            break;
+        }
+        default: return status::unimplemented;
+    }
+
+    return status::success;
+}
+
+namespace prelu_impl {
+
+using namespace Xbyak;
+
+struct call_params_t {
+    // keep all sizes at 8 bytes -- jit code expects this
+    const void *src, *weights, *diff_dst;
+    void *dst; // diff_src for backward
+    void *diff_weights; // f32 partial sums unless the kernel is elementwise
+    size_t work_amount; // elements, or rows for vector weights
+};
+
+template <cpu_isa_t isa>
+struct jit_prelu_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_prelu_kernel_t)
+
+    jit_prelu_kernel_t(const jit_prelu_conf_t &conf) : conf_(conf) {
+        if (conf_.dt == data_type::bf16 && !mayiuse(avx512_core_bf16))
+            bf16_emu_.reset(new bf16_emulation_t(this, bf16_emu_zmm_1,
+                    bf16_emu_zmm_2, bf16_emu_zmm_3, bf16_emu_gpr,
+                    bf16_emu_zmm_4, bf16_emu_zmm_5));
+    }
+
+    void operator()(const call_params_t *p) const {
+        jit_generator::operator()(p);
+    }
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+
+    static constexpr bool is_avx512 = isa == avx512_common;
+    static constexpr int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+    static constexpr int unroll = is_avx512 ? 4 : 2;
+
+    const jit_prelu_conf_t conf_;
+
+    Reg64 reg_param = abi_param1;
+    Reg64 reg_tmp = rax;
+    Reg64 reg_src = r8;
+    Reg64 reg_wei = r9;
+    Reg64 reg_diff_dst = r10;
+    Reg64 reg_dst = r11;
+    Reg64 reg_diff_wei = r12;
+    Reg64 reg_work = r13;
+    Reg64 reg_row_off = r14;
+
+    Opmask k_tail = Opmask(2);
+    Opmask k_cmp = Opmask(3);
+
+    Vmm vsrc(int i) const { return Vmm(i); }
+    Vmm vwei(int i) const { return Vmm(unroll + i); }
+    Vmm vdiff_dst(int i) const { return Vmm(2 * unroll + i); }
+    Vmm vtmp(int i) const { return Vmm(3 * unroll + i); }
+    Vmm vacc(int i) const { return Vmm(4 * unroll + i); }
+    Vmm vzero = Vmm(5 * unroll);
+    Vmm vtail_mask = Vmm(5 * unroll + 1);
+    Vmm vcmp_mask = Vmm(5 * unroll + 2);
+    Vmm vhtmp = Vmm(is_avx512 ? 28 : 5 * unroll + 3);
+
+    std::unique_ptr<bf16_emulation_t> bf16_emu_ = nullptr;
+    Ymm bf16_cvt_ymm = Ymm(22);
+    Zmm bf16_emu_zmm_1 = Zmm(23);
+    Zmm bf16_emu_zmm_2 = Zmm(24);
+    Zmm bf16_emu_zmm_3 = Zmm(25);
+    Zmm bf16_emu_zmm_4 = Zmm(26);
+    Zmm bf16_emu_zmm_5 = Zmm(27);
+    Reg64 bf16_emu_gpr = r15;
+
+    bool is_bf16() const { return conf_.dt == data_type::bf16; }
+    int dt_size() const { return types::data_type_size(conf_.dt); }
+    bool reduces_diff_weights() const {
+        return !conf_.is_fwd && conf_.kind != prelu_kernel_kind_t::elementwise;
+    }
+
+    void load(const Vmm &vmm, const Address &addr, bool tail,
+            bool is_f32 = false) {
+        if (is_avx512) {
+            const auto vmm_ld = tail ? vmm | k_tail | T_z : vmm;
+            if (is_bf16() && !is_f32) {
+                vpmovzxwd(vmm_ld, addr);
+                vpslld(vmm, vmm, 0x10);
+            } else
+                vmovups(vmm_ld, addr);
+        } else {
+            if (tail)
+                uni_vmovups_tail(vmm, vtail_mask, addr);
+            else
+                uni_vmovups(vmm, addr);
+        }
+    }
+
+    void store(const Address &addr, const Vmm &vmm, bool tail,
+            bool is_f32 = false) {
+        if (is_avx512) {
+            const auto addr_st = tail ? addr | k_tail : addr;
+            if (is_bf16() && !is_f32) {
+                if (bf16_emu_)
+                    bf16_emu_->vcvtneps2bf16(bf16_cvt_ymm, Zmm(vmm.getIdx()));
+                else
+                    vcvtneps2bf16(bf16_cvt_ymm, vmm);
+                vmovdqu16(addr_st, bf16_cvt_ymm);
+            } else
+                vmovups(addr_st, vmm);
+        } else {
+            if (tail)
+                uni_vmovups_tail(addr, vtail_mask, vmm);
+            else
+                uni_vmovups(addr, vmm);
+        }
+    }
+
+    void broadcast_weight(const Vmm &vmm) {
+        if (is_bf16()) {
+            movzx(reg_tmp.cvt32(), word[reg_wei]);
+            shl(reg_tmp.cvt32(), 16);
+            uni_vmovq(Xmm(vmm.getIdx()), reg_tmp);
+            uni_vbroadcastss(vmm, Xmm(vmm.getIdx()));
+        } else
+            uni_vbroadcastss(vmm, ptr[reg_wei]);
+    }
+
+    // Processes the i-th vector located at `off` bytes from the data pointers.
+    // Unless the weights are elementwise they are expected in vwei(i) already.
+    void compute_vector(int i, const Reg64 &reg_off, int64_t off, bool tail) {
+        const Vmm s = vsrc(i), w = vwei(i), dd = vdiff_dst(i), t = vtmp(i);
+
+        load(s, ptr[reg_src + reg_off + off], tail);
+        if (conf_.kind == prelu_kernel_kind_t::elementwise)
+            load(w, ptr[reg_wei + reg_off + off], tail);
+
+        if (conf_.is_fwd) {
+            // dst = max(src, 0) + weights * min(src, 0)
+            uni_vminps(t, s, vzero);
+            uni_vmaxps(s, s, vzero);
+            uni_vfmadd231ps(s, t, w);
+            store(ptr[reg_dst + reg_off + off], s, tail);
+            return;
+        }
+
+        // diff_src = src > 0 ? diff_dst : weights * diff_dst
+        load(dd, ptr[reg_diff_dst + reg_off + off], tail);
+        uni_vmulps(t, dd, w);
+        if (is_avx512) {
+            vcmpps(k_cmp, s, vzero, _cmp_nle_us);
+            vmovups(t | k_cmp, dd);
+        } else {
+            vcmpps(vcmp_mask, s, vzero, _cmp_nle_us);
+            vblendvps(t, t, dd, vcmp_mask);
+        }
+        store(ptr[reg_dst + reg_off + off], t, tail);
+
+        // diff_weights = diff_dst * min(src, 0)
+        uni_vminps(s, s, vzero);
+        if (reduces_diff_weights())
+            uni_vfmadd231ps(vacc(i), s, dd);
+        else {
+            uni_vmulps(s, s, dd);
+            store(ptr[reg_diff_wei + reg_off + off], s, tail);
+        }
+    }
+
+    void horizontal_sum(const Vmm &v) {
+        if (is_avx512) {
+            const Zmm z(v.getIdx()), ztmp(vhtmp.getIdx());
+            vshuff32x4(ztmp, z, z, 0x4E);
+            uni_vaddps(v, v, vhtmp);
+            vshuff32x4(ztmp, z, z, 0xB1);
+            uni_vaddps(v, v, vhtmp);
+        } else {
+            const Ymm y(v.getIdx()), ytmp(vhtmp.getIdx());
+            vperm2f128(ytmp, y, y, 0x01);
+            uni_vaddps(v, v, vhtmp);
+        }
+        uni_vshufps(vhtmp, v, v, 0x4E);
+        uni_vaddps(v, v, vhtmp);
+        uni_vshufps(vhtmp, v, v, 0xB1);
+        uni_vaddps(v, v, vhtmp);
+    }
+
+    // Walks `work_amount` elements with the same or with per-element weights
+    void generate_flat() {
+        Label unroll_loop, vector_loop, tail, end;
+
+        if (conf_.kind == prelu_kernel_kind_t::scalar_weight)
+            for (int i = 0; i < unroll; i++)
+                broadcast_weight(vwei(i));
+        if (reduces_diff_weights())
+            for (int i = 0; i < unroll; i++)
+                uni_vpxor(vacc(i), vacc(i), vacc(i));
+        xor_(reg_row_off, reg_row_off);
+
+        const int vlen_dt = simd_w * dt_size();
+        L(unroll_loop);
+        {
+            cmp(reg_work, unroll * simd_w);
+            jl(vector_loop, T_NEAR);
+            for (int i = 0; i < unroll; i++)
+                compute_vector(i, reg_row_off, i * vlen_dt, false);
+            add(reg_row_off, unroll * vlen_dt);
+            sub(reg_work, unroll * simd_w);
+            jmp(unroll_loop, T_NEAR);
+        }
+        L(vector_loop);
+        {
+            cmp(reg_work, simd_w);
+            jl(tail, T_NEAR);
+            compute_vector(0, reg_row_off, 0, false);
+            add(reg_row_off, vlen_dt);
+            sub(reg_work, simd_w);
+            jmp(vector_loop, T_NEAR);
+        }
+        L(tail);
+        if (conf_.tail > 0) {
+            cmp(reg_work, 0);
+            jle(end, T_NEAR);
+            compute_vector(0, reg_row_off, 0, true);
+        }
+        L(end);
+
+        if (reduces_diff_weights()) {
+            for (int i = 1; i < unroll; i++)
+                uni_vaddps(vacc(0), vacc(0), vacc(i));
+            horizontal_sum(vacc(0));
+            uni_vmovss(ptr[reg_diff_wei], Xmm(vacc(0).getIdx()));
+        }
+    }
+
+    // Walks `work_amount` rows of `row_len` channels. The channels are split
+    // into groups of vectors, the weights of a group stay in registers while
+    // the rows are traversed, as do the diff_weights partial sums.
+    void generate_rows() {
+        const int row_len = conf_.row_len;
+        const int n_vectors = div_up(row_len, simd_w);
+        const int64_t row_stride = (int64_t)row_len * dt_size();
+
+        for (int v_start = 0; v_start < n_vectors; v_start += unroll) {
+            const int n_vregs = nstl::min(unroll, n_vectors - v_start);
+            const bool has_tail = conf_.tail > 0
+                    && v_start + n_vregs == n_vectors;
+            auto is_tail = [&](int i) { return has_tail && i == n_vregs - 1; };
+            auto wei_off = [&](int i) {
+                return (int64_t)(v_start + i) * simd_w * dt_size();
+            };
+
+            for (int i = 0; i < n_vregs; i++) {
+                load(vwei(i), ptr[reg_wei + wei_off(i)], is_tail(i));
+                if (reduces_diff_weights())
+                    uni_vpxor(vacc(i), vacc(i), vacc(i));
+            }
+
+            Label row_loop;
+            xor_(reg_row_off, reg_row_off);
+            mov(reg_tmp, ptr[reg_param + offsetof(call_params_t, work_amount)]);
+            L(row_loop);
+            {
+                for (int i = 0; i < n_vregs; i++)
+                    compute_vector(i, reg_row_off, wei_off(i), is_tail(i));
+                add(reg_row_off, row_stride);
+                dec(reg_tmp);
+                jnz(row_loop, T_NEAR);
+            }
+
+            if (reduces_diff_weights()) {
+                for (int i = 0; i < n_vregs; i++) {
+                    const auto addr = ptr[reg_diff_wei
+                            + (v_start + i) * simd_w * sizeof(float)];
+                    load(vtmp(i), addr, is_tail(i), true);
+                    uni_vaddps(vacc(i), vacc(i), vtmp(i));
+                    store(addr, vacc(i), is_tail(i), true);
+                }
+            }
+        }
+    }
+
+    void generate() override {
+        preamble();
+
+#define PARAM_OFF(x) offsetof(call_params_t, x)
+        mov(reg_src, ptr[reg_param + PARAM_OFF(src)]);
+        mov(reg_wei, ptr[reg_param + PARAM_OFF(weights)]);
+        mov(reg_dst, ptr[reg_param + PARAM_OFF(dst)]);
+        mov(reg_work, ptr[reg_param + PARAM_OFF(work_amount)]);
+        if (!conf_.is_fwd) {
+            mov(reg_diff_dst, ptr[reg_param + PARAM_OFF(diff_dst)]);
+            mov(reg_diff_wei, ptr[reg_param + PARAM_OFF(diff_weights)]);
+        }
+#undef PARAM_OFF
+
+        if (is_avx512) {
+            mov(reg_tmp.cvt32(), (1 << conf_.tail) - 1);
+            kmovw(k_tail, reg_tmp.cvt32());
+        } else if (conf_.tail > 0) {
+            static const uint32_t mask_f32[14]
+                    = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                            0xffffffff, 0xffffffff, 0xffffffff, 0, 0, 0, 0, 0,
+                            0, 0};
+            mov(reg_tmp, reinterpret_cast<size_t>(&mask_f32[7 - conf_.tail]));
+            vmovups(vtail_mask, ptr[reg_tmp]);
+        }
+        if (bf16_emu_) bf16_emu_->init_vcvtneps2bf16();
+        uni_vpxor(vzero, vzero, vzero);
+
+        if (conf_.kind == prelu_kernel_kind_t::vector_weights)
+            generate_rows();
+        else
+            generate_flat();
+
+        postamble();
+    }
+};
+
+} // namespace prelu_impl
+
+namespace {
+// Stores the f32 reduction result into diff_weights of the data type
+void store_diff_weights(
+        void *diff_weights, data_type_t dt, dim_t off, float v) {
+    if (dt == data_type::bf16)
+        static_cast<bfloat16_t *>(diff_weights)[off] = v;
+    else
+        static_cast<float *>(diff_weights)[off] = v;
+}
+} // namespace
+
+template <cpu_isa_t isa>
+jit_uni_prelu_fwd_t<isa>::jit_uni_prelu_fwd_t(const pd_t *apd)
+    : primitive_t(apd) {}
+
+template <cpu_isa_t isa>
+jit_uni_prelu_fwd_t<isa>::~jit_uni_prelu_fwd_t() = default;
+
+template <cpu_isa_t isa>
+status_t jit_uni_prelu_fwd_t<isa>::init(engine_t *engine) {
+    CHECK(safe_ptr_assign(
+            kernel_, new prelu_impl::jit_prelu_kernel_t<isa>(pd()->conf_)));
+    return kernel_->create_kernel();
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_prelu_fwd_t<isa>::execute(const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto weights = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+
+    const memory_desc_wrapper data_d(pd()->src_md(0));
+    const memory_desc_wrapper weights_d(pd()->weights_md(0));
+    const auto &conf = pd()->conf_;
+    const size_t dt_size = data_d.data_type_size();
+    const int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+
+    src += data_d.offset0() * dt_size;
+    dst += data_d.offset0() * dt_size;
+    weights += weights_d.offset0() * dt_size;
+
+    auto call_kernel = [&](dim_t data_off, dim_t wei_off, dim_t work_amount) {
+        prelu_impl::call_params_t p;
+        p.src = src + data_off * dt_size;
+        p.weights = weights + wei_off * dt_size;
+        p.diff_dst = nullptr;
+        p.dst = dst + data_off * dt_size;
+        p.diff_weights = nullptr;
+        p.work_amount = work_amount;
+        (*kernel_)(&p);
+    };
+
+    switch (conf.bcast) {
+        case broadcasting_strategy_t::no_broadcast:
+        case broadcasting_strategy_t::scalar: {
+            const bool is_elementwise
+                    = conf.bcast == broadcasting_strategy_t::no_broadcast;
+            const dim_t n_vectors = div_up(conf.nelems, simd_w);
+            parallel(0, [&](const int ithr, const int nthr) {
+                dim_t start {0}, end {0};
+                balance211(n_vectors, nthr, ithr, start, end);
+                const dim_t e_start = start * simd_w;
+                const dim_t e_end = nstl::min(end * simd_w, conf.nelems);
+                if (e_start >= e_end) return;
+                call_kernel(e_start, is_elementwise ? e_start : 0,
+                        e_end - e_start);
+            });
+            break;
+        }
+        case broadcasting_strategy_t::per_oc_spatial:
+            parallel_nd(conf.N, conf.C, [&](dim_t n, dim_t c) {
+                call_kernel((n * conf.C + c) * conf.SP, c, conf.SP);
+            });
+            break;
+        case broadcasting_strategy_t::per_oc:
+            parallel(0, [&](const int ithr, const int nthr) {
+                dim_t start {0}, end {0};
+                balance211(conf.n_rows, nthr, ithr, start, end);
+                // a single call per run of rows sharing the weights
+                while (start < end) {
+                    const dim_t wei_blk = start / conf.rows_per_wei_blk;
+                    const dim_t run_end = nstl::min(
+                            end, (wei_blk + 1) * conf.rows_per_wei_blk);
+                    call_kernel(start * conf.row_len,
+                            (wei_blk % conf.n_wei_blks) * conf.row_len,
+                            run_end - start);
+                    start = run_end;
+                }
+            });
+            break;
+        default: assert(!"unsupported broadcast strategy");
+    }
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+void jit_uni_prelu_bwd_t<isa>::pd_t::init_scratchpad() {
+    using namespace memory_tracking::names;
+    auto scratchpad = scratchpad_registry().registrar();
+    switch (conf_.bcast) {
+        case broadcasting_strategy_t::scalar:
+            scratchpad.template book<float>(key_prelu_reduction, conf_.nthr);
+            break;
+        case broadcasting_strategy_t::per_oc_spatial:
+            scratchpad.template book<float>(
+                    key_prelu_reduction, conf_.N * conf_.C);
+            break;
+        case broadcasting_strategy_t::per_oc:
+            scratchpad.template book<float>(key_prelu_reduction,
+                    conf_.nthr * conf_.n_wei_blks * conf_.row_len);
+            break;
+        default: break;
+    }
+}
+
+template <cpu_isa_t isa>
+jit_uni_prelu_bwd_t<isa>::jit_uni_prelu_bwd_t(const pd_t *apd)
+    : primitive_t(apd) {}
+
+template <cpu_isa_t isa>
+jit_uni_prelu_bwd_t<isa>::~jit_uni_prelu_bwd_t() = default;
+
+template <cpu_isa_t isa>
+status_t jit_uni_prelu_bwd_t<isa>::init(engine_t *engine) {
+    CHECK(safe_ptr_assign(
+            kernel_, new prelu_impl::jit_prelu_kernel_t<isa>(pd()->conf_)));
+    return kernel_->create_kernel();
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_prelu_bwd_t<isa>::execute(const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto weights = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS);
+    auto diff_dst = CTX_IN_MEM(const char *, DNNL_ARG_DIFF_DST);
+    auto diff_src = CTX_OUT_MEM(char *, DNNL_ARG_DIFF_SRC);
+    auto diff_weights = CTX_OUT_MEM(char *, DNNL_ARG_DIFF_WEIGHTS);
+
+    const memory_desc_wrapper data_d(pd()->src_md(0));
+    const memory_desc_wrapper diff_data_d(pd()->diff_src_md(0));
+    const memory_desc_wrapper weights_d(pd()->weights_md(0));
+    const memory_desc_wrapper diff_weights_d(pd()->diff_weights_md(0));
+    const auto &conf = pd()->conf_;
+    const size_t dt_size = data_d.data_type_size();
+    const int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+
+    src += data_d.offset0() * dt_size;
+    diff_dst += diff_data_d.offset0() * dt_size;
+    diff_src += diff_data_d.offset0() * dt_size;
+    weights += weights_d.offset0() * dt_size;
+    diff_weights += diff_weights_d.offset0() * dt_size;
+
+    auto scratchpad = ctx.get_scratchpad_grantor();
+    float *partials = scratchpad.template get<float>(
+            memory_tracking::names::key_prelu_reduction);
+
+    auto call_kernel = [&](dim_t data_off, dim_t wei_off, dim_t work_amount,
+                               void *diff_wei) {
+        prelu_impl::call_params_t p;
+        p.src = src + data_off * dt_size;
+        p.weights = weights + wei_off * dt_size;
+        p.diff_dst = diff_dst + data_off * dt_size;
+        p.dst = diff_src + data_off * dt_size;
+        p.diff_weights = diff_wei;
+        p.work_amount = work_amount;
+        (*kernel_)(&p);
+    };
+
+    switch (conf.bcast) {
+        case broadcasting_strategy_t::no_broadcast:
+        case broadcasting_strategy_t::scalar: {
+            const bool is_elementwise
+                    = conf.bcast == broadcasting_strategy_t::no_broadcast;
+            const dim_t n_vectors = div_up(conf.nelems, simd_w);
+            // Fewer threads than requested may run, e.g. in a nested region,
+            // so only the partials of the threads that ran are reduced
+            int nthr_used = 1;
+            parallel(conf.nthr, [&](const int ithr, const int nthr) {
+                if (ithr == 0) nthr_used = nthr;
+                dim_t start {0}, end {0};
+                balance211(n_vectors, nthr, ithr, start, end);
+                const dim_t e_start = start * simd_w;
+                const dim_t e_end = nstl::min(end * simd_w, conf.nelems);
+                if (!is_elementwise) partials[ithr] = 0.f;
+                if (e_start >= e_end) return;
+                call_kernel(e_start, is_elementwise ? e_start : 0,
+                        e_end - e_start,
+                        is_elementwise ? (void *)(diff_weights
+                                + e_start * dt_size)
+                                       : (void *)&partials[ithr]);
+            });
+            if (!is_elementwise) {
+                float sum = 0.f;
+                for (int ithr = 0; ithr < nthr_used; ithr++)
+                    sum += partials[ithr];
+                store_diff_weights(diff_weights, conf.dt, 0, sum);
+            }
+            break;
+        }
+        case broadcasting_strategy_t::per_oc_spatial:
+            parallel_nd(conf.N, conf.C, [&](dim_t n, dim_t c) {
+                call_kernel((n * conf.C + c) * conf.SP, c, conf.SP,
+                        &partials[n * conf.C + c]);
+            });
+            parallel_nd(conf.C, [&](dim_t c) {
+                float sum = 0.f;
+                for (dim_t n = 0; n < conf.N; n++)
+                    sum += partials[n * conf.C + c];
+                store_diff_weights(diff_weights, conf.dt, c, sum);
+            });
+            break;
+        case broadcasting_strategy_t::per_oc: {
+            const dim_t C_padded = conf.n_wei_blks * conf.row_len;
+            int nthr_used = 1;
+            parallel(conf.nthr, [&](const int ithr, const int nthr) {
+                if (ithr == 0) nthr_used = nthr;
+                float *thr_partials = &partials[ithr * C_padded];
+                for (dim_t c = 0; c < C_padded; c++)
+                    thr_partials[c] = 0.f;
+
+                dim_t start {0}, end {0};
+                balance211(conf.n_rows, nthr, ithr, start, end);
+                while (start < end) {
+                    const dim_t wei_blk = start / conf.rows_per_wei_blk;
+                    const dim_t run_end = nstl::min(
+                            end, (wei_blk + 1) * conf.rows_per_wei_blk);
+                    const dim_t wei_off
+                            = (wei_blk % conf.n_wei_blks) * conf.row_len;
+                    call_kernel(start * conf.row_len, wei_off, run_end - start,
+                            &thr_partials[wei_off]);
+                    start = run_end;
+                }
+            });
+            parallel_nd(C_padded, [&](dim_t c) {
+                float sum = 0.f;
+                for (int ithr = 0; ithr < nthr_used; ithr++)
+                    sum += partials[ithr * C_padded + c];
+                store_diff_weights(diff_weights, conf.dt, c, sum);
+            });
+            break;
+        }
+        default: assert(!"unsupported broadcast strategy");
+    }
+
+    return status::success;
+}
+
+template struct jit_uni_prelu_fwd_t<avx2>;
+template struct jit_uni_prelu_fwd_t<avx512_common>;
+template struct jit_uni_prelu_bwd_t<avx2>;
+template struct jit_uni_prelu_bwd_t<avx512_common>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
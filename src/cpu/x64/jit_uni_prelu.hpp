@@ -0,0 +1,167 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_PRELU_HPP
+#define CPU_X64_JIT_UNI_PRELU_HPP
+
+#include <memory>
+
+#include "common/broadcast_strategy.hpp"
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_prelu_pd.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// How the data tensor is walked by the kernels, depends on the broadcast
+// strategy of the weights and on the data layout:
+// - elementwise:    weights have the layout of the data (no_broadcast);
+// - scalar_weight:  a single weight for every element passed to the kernel
+//                   (scalar, and per_oc_spatial with a call per channel);
+// - vector_weights: the data is a sequence of rows of `row_len` channels
+//                   sharing a vector of weights (per_oc for channels-last
+//                   and channel-blocked layouts).
+enum class prelu_kernel_kind_t { elementwise, scalar_weight, vector_weights };
+
+struct jit_prelu_conf_t {
+    broadcasting_strategy_t bcast;
+    prelu_kernel_kind_t kind;
+    data_type_t dt;
+    bool is_fwd;
+
+    dim_t N, C, SP;
+    dim_t nelems; // with padding
+    dim_t row_len; // vector_weights: channels in a row
+    dim_t n_rows; // vector_weights: number of rows
+    dim_t rows_per_wei_blk; // vector_weights: rows sharing the same weights
+    dim_t n_wei_blks; // vector_weights: number of distinct weight vectors
+    int tail; // elements past the last full vector of a call (or a row)
+    int nthr;
+};
+
+status_t init_prelu_conf(jit_prelu_conf_t &conf, cpu_isa_t isa, bool is_fwd,
+        const memory_desc_t &data_md, const memory_desc_t &weights_md);
+
+namespace prelu_impl {
+template <cpu_isa_t isa>
+struct jit_prelu_kernel_t;
+}
+
+template <cpu_isa_t isa>
+struct jit_uni_prelu_fwd_t : public primitive_t {
+    struct pd_t : public cpu_prelu_fwd_pd_t {
+        using cpu_prelu_fwd_pd_t::cpu_prelu_fwd_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", isa, ""), jit_uni_prelu_fwd_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+            const auto dt = src_md(0)->data_type;
+            bool ok = mayiuse(isa) && is_fwd() && !has_zero_dim_memory()
+                    && set_default_formats() && utils::one_of(dt, f32, bf16)
+                    && weights_md(0)->data_type == dt
+                    && IMPLICATION(dt == bf16,
+                            is_superset(isa, avx512_common)
+                                    && mayiuse(avx512_core))
+                    && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            return init_prelu_conf(
+                    conf_, isa, true, *src_md(0), *weights_md(0));
+        }
+
+        jit_prelu_conf_t conf_;
+    };
+
+    jit_uni_prelu_fwd_t(const pd_t *apd);
+    ~jit_uni_prelu_fwd_t();
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<prelu_impl::jit_prelu_kernel_t<isa>> kernel_;
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_prelu_bwd_t : public primitive_t {
+    struct pd_t : public cpu_prelu_bwd_pd_t {
+        using cpu_prelu_bwd_pd_t::cpu_prelu_bwd_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", isa, ""), jit_uni_prelu_bwd_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+            const auto dt = src_md(0)->data_type;
+            bool ok = mayiuse(isa) && !is_fwd() && !has_zero_dim_memory()
+                    && set_default_formats() && utils::one_of(dt, f32, bf16)
+                    && weights_md(0)->data_type == dt
+                    && *diff_src_md(0) == *src_md(0)
+                    && *diff_weights_md(0) == *weights_md(0)
+                    && IMPLICATION(dt == bf16,
+                            is_superset(isa, avx512_common)
+                                    && mayiuse(avx512_core))
+                    && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            CHECK(init_prelu_conf(
+                    conf_, isa, false, *src_md(0), *weights_md(0)));
+
+            init_scratchpad();
+
+            return status::success;
+        }
+
+        jit_prelu_conf_t conf_;
+
+    private:
+        void init_scratchpad();
+    };
+
+    jit_uni_prelu_bwd_t(const pd_t *apd);
+    ~jit_uni_prelu_bwd_t();
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<prelu_impl::jit_prelu_kernel_t<isa>> kernel_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
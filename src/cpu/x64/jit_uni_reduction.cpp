@@ -0,0 +1,745 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <float.h>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/nstl.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/jit_avx512_core_bf16cvt.hpp"
+#include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/jit_uni_reduction.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::utils;
+
+namespace reduction_impl {
+
+using namespace Xbyak;
+
+struct call_params_t {
+    // keep all sizes at 8 bytes -- jit code expects this
+    const void *src;
+    void *dst;
+    size_t reduce_size; // number of reduced points
+    size_t work_amount; // number of outputs
+};
+
+template <cpu_isa_t isa>
+struct jit_reduction_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_reduction_kernel_t)
+
+    jit_reduction_kernel_t(const jit_reduction_kernel_conf_t &conf)
+        : conf_(conf) {
+        if (conf_.dst_dt == data_type::bf16 && !mayiuse(avx512_core_bf16))
+            bf16_emu_.reset(new bf16_emulation_t(this, bf16_emu_zmm_1,
+                    bf16_emu_zmm_2, bf16_emu_zmm_3, bf16_emu_gpr,
+                    bf16_emu_zmm_4, bf16_emu_zmm_5));
+    }
+
+    void operator()(const call_params_t *p) const {
+        jit_generator::operator()(p);
+    }
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    // load_data and store_data helpers do not support zmm registers
+    using Vmm_ls = typename utils::conditional<isa == sse41, Xmm, Ymm>::type;
+
+    static constexpr bool is_avx512 = isa == avx512_common;
+    static constexpr int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+    static constexpr int unroll = 4;
+
+    const jit_reduction_kernel_conf_t conf_;
+
+    Reg64 reg_param = abi_param1;
+    Reg64 reg_tmp = rax;
+    Reg64 reg_stride = rbx;
+    Reg64 reg_src = r8;
+    Reg64 reg_dst = r9;
+    Reg64 reg_reduce_size = r10;
+    Reg64 reg_work = r11;
+    Reg64 reg_src_row = r12;
+    Reg64 reg_reduce_cnt = r13;
+
+    Opmask k_tail = Opmask(2);
+    Opmask k_one = Opmask(3);
+
+    Vmm vacc(int i) const { return Vmm(1 + i); }
+    Vmm vsrc(int i) const { return Vmm(1 + unroll + i); }
+    Vmm vtmp = Vmm(9);
+    Vmm vabs_mask = Vmm(10);
+    Vmm vdiv = Vmm(11);
+    Vmm vinit = Vmm(12);
+    Vmm veps = Vmm(13);
+    Vmm vzero = Vmm(14);
+
+    std::unique_ptr<bf16_emulation_t> bf16_emu_ = nullptr;
+    Ymm bf16_cvt_ymm = Ymm(22);
+    Zmm bf16_emu_zmm_1 = Zmm(23);
+    Zmm bf16_emu_zmm_2 = Zmm(24);
+    Zmm bf16_emu_zmm_3 = Zmm(25);
+    Zmm bf16_emu_zmm_4 = Zmm(26);
+    Zmm bf16_emu_zmm_5 = Zmm(27);
+    Reg64 bf16_emu_gpr = r15;
+
+    bool is_acc_f32() const { return conf_.acc_dt == data_type::f32; }
+    bool is_norm() const {
+        using namespace alg_kind;
+        return one_of(conf_.alg, reduction_norm_lp_max, reduction_norm_lp_sum,
+                reduction_norm_lp_power_p_max, reduction_norm_lp_power_p_sum);
+    }
+    int src_dt_size() const { return types::data_type_size(conf_.src_dt); }
+    int dst_dt_size() const { return types::data_type_size(conf_.dst_dt); }
+
+    // Initial value of the accumulator in its own data type
+    int init_value_bits() const {
+        using namespace alg_kind;
+        using namespace data_type;
+        float lowest = 0.f, max = 0.f;
+        switch (conf_.src_dt) {
+            case f32:
+                lowest = nstl::numeric_limits<float>::lowest();
+                max = nstl::numeric_limits<float>::max();
+                break;
+            case bf16:
+                lowest = nstl::numeric_limits<bfloat16_t>::lowest();
+                max = nstl::numeric_limits<bfloat16_t>::max();
+                break;
+            case s32:
+                // s32 inputs are only the partials combined in s32
+                return conf_.alg == reduction_max
+                        ? nstl::numeric_limits<int32_t>::lowest()
+                        : conf_.alg == reduction_min
+                                ? nstl::numeric_limits<int32_t>::max()
+                                : conf_.alg == reduction_mul ? 1 : 0;
+            case s8:
+                lowest = nstl::numeric_limits<int8_t>::lowest();
+                max = nstl::numeric_limits<int8_t>::max();
+                break;
+            case u8:
+                lowest = nstl::numeric_limits<uint8_t>::lowest();
+                max = nstl::numeric_limits<uint8_t>::max();
+                break;
+            default: assert(!"unsupported data type");
+        }
+        float init = conf_.alg == reduction_max
+                ? lowest
+                : conf_.alg == reduction_min
+                        ? max
+                        : conf_.alg == reduction_mul ? 1.f : 0.f;
+        return is_acc_f32() ? float2int(init) : (int)init;
+    }
+
+    void broadcast_value(const Vmm &vmm, int bits) {
+        Xmm xmm(vmm.getIdx());
+        mov(reg_tmp.cvt32(), bits);
+        uni_vmovq(xmm, reg_tmp);
+        uni_vbroadcastss(vmm, xmm);
+    }
+
+    // Loads n elements of src converting them to the accumulation data type
+    void load(const Vmm &vmm, const Reg64 &reg, int64_t offset, int n) {
+        using namespace data_type;
+        const bool is_int_src = one_of(conf_.src_dt, s8, u8);
+        if (is_avx512) {
+            auto vmm_ld = n < simd_w
+                    ? vmm | (n == 1 ? k_one : k_tail) | T_z
+                    : vmm;
+            const auto addr = ptr[reg + offset];
+            switch (conf_.src_dt) {
+                case f32:
+                case s32: vmovups(vmm_ld, addr); break;
+                case bf16:
+                    vpmovzxwd(vmm_ld, addr);
+                    vpslld(vmm, vmm, 0x10);
+                    break;
+                case s8: vpmovsxbd(vmm_ld, addr); break;
+                case u8: vpmovzxbd(vmm_ld, addr); break;
+                default: assert(!"unsupported data type");
+            }
+        } else {
+            const auto vmm_ls = Vmm_ls(vmm.getIdx());
+            if (n == simd_w && one_of(conf_.src_dt, f32, s32))
+                uni_vmovups(vmm, ptr[reg + offset]);
+            else
+                load_data(conf_.src_dt, vmm_ls, reg, offset, n);
+        }
+        if (is_int_src && is_acc_f32()) uni_vcvtdq2ps(vmm, vmm);
+    }
+
+    // Stores n elements of vmm converting them to the destination data type
+    void store(const Vmm &vmm, const Reg64 &reg, int64_t offset, int n) {
+        using namespace data_type;
+        if (is_avx512) {
+            auto addr = ptr[reg + offset];
+            if (n < simd_w) addr = addr | (n == 1 ? k_one : k_tail);
+            switch (conf_.dst_dt) {
+                case f32:
+                case s32: vmovups(addr, vmm); break;
+                case bf16:
+                    if (bf16_emu_)
+                        bf16_emu_->vcvtneps2bf16(
+                                bf16_cvt_ymm, Zmm(vmm.getIdx()));
+                    else
+                        vcvtneps2bf16(bf16_cvt_ymm, vmm);
+                    vmovdqu16(addr, bf16_cvt_ymm);
+                    break;
+                case s8: vpmovsdb(addr, vmm); break;
+                case u8:
+                    vpmaxsd(vmm, vmm, vzero);
+                    vpmovusdb(addr, vmm);
+                    break;
+                default: assert(!"unsupported data type");
+            }
+        } else {
+            const auto vmm_ls = Vmm_ls(vmm.getIdx());
+            if (n == simd_w && one_of(conf_.dst_dt, f32, s32))
+                uni_vmovups(ptr[reg + offset], vmm);
+            else
+                store_data(conf_.dst_dt, vmm_ls, reg, offset, n);
+        }
+    }
+
+    void accumulate(const Vmm &vacc, const Vmm &vsrc, bool apply_power) {
+        using namespace alg_kind;
+        if (is_acc_f32()) {
+            if (apply_power && is_norm()) {
+                if (conf_.p == 1.f)
+                    uni_vandps(vsrc, vsrc, vabs_mask);
+                else
+                    uni_vmulps(vsrc, vsrc, vsrc);
+            }
+            switch (conf_.alg) {
+                case reduction_max: uni_vmaxps(vacc, vacc, vsrc); break;
+                case reduction_min: uni_vminps(vacc, vacc, vsrc); break;
+                case reduction_mul: uni_vmulps(vacc, vacc, vsrc); break;
+                default: uni_vaddps(vacc, vacc, vsrc); break;
+            }
+        } else {
+            switch (conf_.alg) {
+                case reduction_max: uni_vpmaxsd(vacc, vacc, vsrc); break;
+                case reduction_min:
+                    if (isa != sse41)
+                        vpminsd(vacc, vacc, vsrc);
+                    else
+                        pminsd(vacc, vsrc);
+                    break;
+                case reduction_mul: uni_vpmulld(vacc, vacc, vsrc); break;
+                default: uni_vpaddd(vacc, vacc, vsrc); break;
+            }
+        }
+    }
+
+    void finalize(const Vmm &vacc) {
+        using namespace alg_kind;
+        if (!conf_.finalize) return;
+
+        if (!is_acc_f32()) {
+            // the mean of integers is truncated as in the reference
+            if (conf_.alg != reduction_mean) return;
+            uni_vcvtdq2ps(vacc, vacc);
+            uni_vdivps(vacc, vacc, vdiv);
+            if (isa != sse41)
+                vcvttps2dq(vacc, vacc);
+            else
+                cvttps2dq(vacc, vacc);
+            return;
+        }
+
+        switch (conf_.alg) {
+            case reduction_mean: uni_vdivps(vacc, vacc, vdiv); break;
+            case reduction_norm_lp_max:
+            case reduction_norm_lp_power_p_max:
+                uni_vmaxps(vacc, vacc, veps);
+                break;
+            case reduction_norm_lp_sum:
+            case reduction_norm_lp_power_p_sum:
+                uni_vaddps(vacc, vacc, veps);
+                break;
+            default: break;
+        }
+        const bool take_root = one_of(
+                conf_.alg, reduction_norm_lp_max, reduction_norm_lp_sum);
+        if (take_root && conf_.p == 2.f) uni_vsqrtps(vacc, vacc);
+    }
+
+    // Reduces the vector to its first element
+    void horizontal_reduce(const Vmm &v) {
+        if (is_avx512) {
+            const Zmm z(v.getIdx()), ztmp(vtmp.getIdx());
+            vshuff32x4(ztmp, z, z, 0x4E);
+            accumulate(v, vtmp, false);
+            vshuff32x4(ztmp, z, z, 0xB1);
+            accumulate(v, vtmp, false);
+        } else if (isa == avx2) {
+            const Ymm y(v.getIdx()), ytmp(vtmp.getIdx());
+            vperm2f128(ytmp, y, y, 0x01);
+            accumulate(v, vtmp, false);
+        }
+        uni_vshufps(vtmp, v, v, 0x4E);
+        accumulate(v, vtmp, false);
+        uni_vshufps(vtmp, v, v, 0xB1);
+        accumulate(v, vtmp, false);
+    }
+
+    // Reduces the rows for `n_vregs` vectors of the inner elements
+    void compute_inner_vectors(int n_vregs, bool tail) {
+        const int n = tail ? conf_.tail : simd_w;
+
+        for (int i = 0; i < n_vregs; i++)
+            uni_vmovups(vacc(i), vinit);
+
+        mov(reg_src_row, reg_src);
+        mov(reg_reduce_cnt, reg_reduce_size);
+        Label reduce_loop;
+        L(reduce_loop);
+        {
+            for (int i = 0; i < n_vregs; i++) {
+                load(vsrc(i), reg_src_row, i * simd_w * src_dt_size(), n);
+                accumulate(vacc(i), vsrc(i), conf_.apply_power);
+            }
+            add(reg_src_row, reg_stride);
+            dec(reg_reduce_cnt);
+            jnz(reduce_loop, T_NEAR);
+        }
+
+        for (int i = 0; i < n_vregs; i++) {
+            finalize(vacc(i));
+            store(vacc(i), reg_dst, i * simd_w * dst_dt_size(), n);
+        }
+    }
+
+    void generate_vectorize_inner() {
+        Label unroll_loop, vector_loop, tail, end;
+
+        L(unroll_loop);
+        {
+            cmp(reg_work, unroll * simd_w);
+            jl(vector_loop, T_NEAR);
+            compute_inner_vectors(unroll, false);
+            add(reg_src, unroll * simd_w * src_dt_size());
+            add(reg_dst, unroll * simd_w * dst_dt_size());
+            sub(reg_work, unroll * simd_w);
+            jmp(unroll_loop, T_NEAR);
+        }
+        L(vector_loop);
+        {
+            cmp(reg_work, simd_w);
+            jl(tail, T_NEAR);
+            compute_inner_vectors(1, false);
+            add(reg_src, simd_w * src_dt_size());
+            add(reg_dst, simd_w * dst_dt_size());
+            sub(reg_work, simd_w);
+            jmp(vector_loop, T_NEAR);
+        }
+        L(tail);
+        if (conf_.tail > 0) {
+            cmp(reg_work, 0);
+            jle(end, T_NEAR);
+            compute_inner_vectors(1, true);
+        }
+        L(end);
+    }
+
+    void generate_contiguous() {
+        Label row_loop, unroll_loop, vector_loop, scalar_loop, row_end, end;
+
+        L(row_loop);
+        {
+            cmp(reg_work, 0);
+            jle(end, T_NEAR);
+
+            for (int i = 0; i < unroll; i++)
+                uni_vmovups(vacc(i), vinit);
+            mov(reg_src_row, reg_src);
+            mov(reg_reduce_cnt, reg_reduce_size);
+
+            L(unroll_loop);
+            {
+                cmp(reg_reduce_cnt, unroll * simd_w);
+                jl(vector_loop, T_NEAR);
+                for (int i = 0; i < unroll; i++) {
+                    load(vsrc(i), reg_src_row, i * simd_w * src_dt_size(),
+                            simd_w);
+                    accumulate(vacc(i), vsrc(i), conf_.apply_power);
+                }
+                add(reg_src_row, unroll * simd_w * src_dt_size());
+                sub(reg_reduce_cnt, unroll * simd_w);
+                jmp(unroll_loop, T_NEAR);
+            }
+            L(vector_loop);
+            {
+                cmp(reg_reduce_cnt, simd_w);
+                jl(scalar_loop, T_NEAR);
+                load(vsrc(0), reg_src_row, 0, simd_w);
+                accumulate(vacc(0), vsrc(0), conf_.apply_power);
+                add(reg_src_row, simd_w * src_dt_size());
+                sub(reg_reduce_cnt, simd_w);
+                jmp(vector_loop, T_NEAR);
+            }
+
+            for (int i = 1; i < unroll; i++)
+                accumulate(vacc(0), vacc(i), false);
+            horizontal_reduce(vacc(0));
+
+            // only the first element is meaningful from here on
+            L(scalar_loop);
+            {
+                cmp(reg_reduce_cnt, 0);
+                jle(row_end, T_NEAR);
+                load(vsrc(0), reg_src_row, 0, 1);
+                accumulate(vacc(0), vsrc(0), conf_.apply_power);
+                add(reg_src_row, src_dt_size());
+                dec(reg_reduce_cnt);
+                jmp(scalar_loop, T_NEAR);
+            }
+
+            L(row_end);
+            finalize(vacc(0));
+            store(vacc(0), reg_dst, 0, 1);
+
+            add(reg_src, reg_stride);
+            add(reg_dst, dst_dt_size());
+            dec(reg_work);
+            jmp(row_loop, T_NEAR);
+        }
+        L(end);
+    }
+
+    void generate() override {
+        preamble();
+
+#define PARAM_OFF(x) offsetof(call_params_t, x)
+        mov(reg_src, ptr[reg_param + PARAM_OFF(src)]);
+        mov(reg_dst, ptr[reg_param + PARAM_OFF(dst)]);
+        mov(reg_reduce_size, ptr[reg_param + PARAM_OFF(reduce_size)]);
+        mov(reg_work, ptr[reg_param + PARAM_OFF(work_amount)]);
+#undef PARAM_OFF
+        mov(reg_stride, conf_.src_stride * src_dt_size());
+
+        if (is_avx512) {
+            mov(reg_tmp.cvt32(), (1 << conf_.tail) - 1);
+            kmovw(k_tail, reg_tmp.cvt32());
+            mov(reg_tmp.cvt32(), 1);
+            kmovw(k_one, reg_tmp.cvt32());
+        }
+        if (bf16_emu_) bf16_emu_->init_vcvtneps2bf16();
+
+        broadcast_value(vinit, init_value_bits());
+        broadcast_value(vabs_mask, 0x7fffffff);
+        broadcast_value(vdiv, float2int((float)conf_.div));
+        broadcast_value(veps, float2int(conf_.eps));
+        uni_vpxor(vzero, vzero, vzero);
+
+        if (conf_.vectorize_inner)
+            generate_vectorize_inner();
+        else
+            generate_contiguous();
+
+        postamble();
+    }
+};
+
+} // namespace reduction_impl
+
+template <cpu_isa_t isa>
+status_t jit_uni_reduction_t<isa>::pd_t::init_conf() {
+    using namespace alg_kind;
+    using namespace data_type;
+
+    const memory_desc_wrapper src_d(src_md());
+    const memory_desc_wrapper dst_d(dst_md());
+    const int ndims = src_d.ndims();
+    const auto &src_dims = src_d.dims();
+    const auto &dst_dims = dst_d.dims();
+
+    if (!src_d.is_blocking_desc() || !src_d.is_dense(true)
+            || src_d.has_runtime_dims_or_strides() || src_d.has_zero_dim())
+        return status::unimplemented;
+
+    dims_t blocks;
+    src_d.compute_blocks(blocks);
+    for (int d = 0; d < ndims; d++) {
+        // a blocked reduced dim would reduce over the padding as well
+        if (src_dims[d] != dst_dims[d] && blocks[d] != 1)
+            return status::unimplemented;
+    }
+
+    // The destination should have the layout of the source, as the kernels
+    // walk both of them in the same order
+    memory_desc_t expected_dst_md = *src_md();
+    expected_dst_md.data_type = dst_d.data_type();
+    expected_dst_md.offset0 = dst_d.offset0();
+    for (int d = 0; d < ndims; d++)
+        if (src_dims[d] != dst_dims[d])
+            memory_desc_reduce_dim(expected_dst_md, d);
+    if (!(*dst_md() == expected_dst_md)) return status::unimplemented;
+
+    // Walk the physical dimensions from the outermost to the innermost one,
+    // the reduced ones should go one after another
+    const auto &bd = src_d.blocking_desc();
+    const int max_phys_dims = DNNL_MAX_NDIMS + DNNL_MAX_NDIMS;
+    dim_t phys_sizes[max_phys_dims], phys_strides[max_phys_dims];
+    bool phys_reduced[max_phys_dims];
+    int n_phys = 0;
+    for (int d = 0; d < ndims; d++) {
+        phys_sizes[n_phys] = src_d.padded_dims()[d] / blocks[d];
+        phys_strides[n_phys] = bd.strides[d];
+        phys_reduced[n_phys] = src_dims[d] != dst_dims[d];
+        n_phys++;
+    }
+    dim_t inner_stride = 1;
+    for (int iblk = bd.inner_nblks - 1; iblk >= 0; iblk--) {
+        phys_sizes[n_phys] = bd.inner_blks[iblk];
+        phys_strides[n_phys] = inner_stride;
+        phys_reduced[n_phys] = false;
+        inner_stride *= bd.inner_blks[iblk];
+        n_phys++;
+    }
+
+    dim_t outer = 1, reduce = 1, inner = 1;
+    int phase = 0; // 0 - outer, 1 - reduced, 2 - inner
+    dim_t prev_stride = -1;
+    for (int i = 0; i < n_phys; i++) {
+        // pick the next dimension by stride, skipping the trivial ones
+        int next = -1;
+        for (int j = 0; j < n_phys; j++) {
+            if (phys_sizes[j] == 1
+                    || (prev_stride >= 0 && phys_strides[j] >= prev_stride))
+                continue;
+            if (next < 0 || phys_strides[j] > phys_strides[next]) next = j;
+        }
+        if (next < 0) break;
+        prev_stride = phys_strides[next];
+
+        if (phys_reduced[next]) {
+            if (phase == 2) return status::unimplemented;
+            phase = 1;
+            reduce *= phys_sizes[next];
+        } else if (phase == 0) {
+            outer *= phys_sizes[next];
+        } else {
+            phase = 2;
+            inner *= phys_sizes[next];
+        }
+    }
+
+    const auto alg = desc()->alg_kind;
+    const auto acc_dt = types::default_accum_data_type(
+            src_d.data_type(), dst_d.data_type());
+    const bool is_norm = one_of(alg, reduction_norm_lp_max,
+            reduction_norm_lp_sum, reduction_norm_lp_power_p_max,
+            reduction_norm_lp_power_p_sum);
+    const bool ok = one_of(acc_dt, f32, s32)
+            && IMPLICATION(is_norm,
+                    acc_dt == f32 && one_of(desc()->p, 1.f, 2.f)
+                            // the padded area of dst has to stay zero
+                            && dst_d.nelems(true) == dst_d.nelems());
+    if (!ok) return status::unimplemented;
+
+    const int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+    const bool vectorize_inner = inner > 1;
+
+    conf_.outer = outer;
+    conf_.reduce = reduce;
+    conf_.inner = inner;
+    conf_.inner_blk = nstl::min(rnd_up(inner, simd_w), (dim_t)4 * simd_w);
+    conf_.nthr = dnnl_get_max_threads();
+
+    // Split the reduction between threads only when the independent work is
+    // not enough to occupy them and each thread gets a reasonable amount of
+    // the reduced points
+    const dim_t work_amount
+            = vectorize_inner ? outer * div_up(inner, conf_.inner_blk) : outer;
+    const dim_t min_reduce_per_thr = vectorize_inner ? 16 : 16 * simd_w;
+    conf_.nthr_reduce = 1;
+    if (work_amount < conf_.nthr && reduce >= 2 * min_reduce_per_thr)
+        conf_.nthr_reduce = (int)nstl::min(
+                conf_.nthr / work_amount, reduce / min_reduce_per_thr);
+
+    auto &ker = conf_.ker;
+    ker.src_dt = src_d.data_type();
+    ker.dst_dt = conf_.nthr_reduce > 1 ? acc_dt : dst_d.data_type();
+    ker.acc_dt = acc_dt;
+    ker.alg = alg;
+    ker.p = desc()->p;
+    ker.eps = desc()->eps;
+    ker.vectorize_inner = vectorize_inner;
+    ker.apply_power = true;
+    ker.finalize = conf_.nthr_reduce == 1;
+    ker.src_stride = vectorize_inner ? inner : reduce;
+    ker.div = reduce;
+    ker.tail = vectorize_inner ? inner % simd_w : 0;
+
+    // The partials are reduced as a [nthr_reduce][outer * inner] tensor
+    auto &ker_c = conf_.ker_combine;
+    ker_c = ker;
+    ker_c.src_dt = acc_dt;
+    ker_c.dst_dt = dst_d.data_type();
+    ker_c.vectorize_inner = true;
+    ker_c.apply_power = false;
+    ker_c.finalize = true;
+    ker_c.src_stride = outer * inner;
+    ker_c.tail = (outer * inner) % simd_w;
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+void jit_uni_reduction_t<isa>::pd_t::init_scratchpad() {
+    using namespace memory_tracking::names;
+    if (conf_.nthr_reduce == 1) return;
+
+    auto scratchpad = scratchpad_registry().registrar();
+    scratchpad.book(key_reduction,
+            conf_.nthr_reduce * conf_.outer * conf_.inner,
+            types::data_type_size(conf_.ker.acc_dt));
+}
+
+template <cpu_isa_t isa>
+jit_uni_reduction_t<isa>::jit_uni_reduction_t(const pd_t *apd)
+    : primitive_t(apd) {}
+
+template <cpu_isa_t isa>
+jit_uni_reduction_t<isa>::~jit_uni_reduction_t() = default;
+
+template <cpu_isa_t isa>
+status_t jit_uni_reduction_t<isa>::init(engine_t *engine) {
+    const auto &conf = pd()->conf_;
+    CHECK(safe_ptr_assign(kernel_,
+            new reduction_impl::jit_reduction_kernel_t<isa>(conf.ker)));
+    CHECK(kernel_->create_kernel());
+    if (conf.nthr_reduce > 1) {
+        CHECK(safe_ptr_assign(kernel_combine_,
+                new reduction_impl::jit_reduction_kernel_t<isa>(
+                        conf.ker_combine)));
+        CHECK(kernel_combine_->create_kernel());
+    }
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_reduction_t<isa>::execute(const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const auto &conf = pd()->conf_;
+    const dim_t outer = conf.outer, reduce = conf.reduce, inner = conf.inner;
+    const dim_t inner_blk = conf.inner_blk;
+    const dim_t n_inner_blks = div_up(inner, inner_blk);
+    const size_t src_dt_size = src_d.data_type_size();
+    const size_t dst_dt_size = dst_d.data_type_size();
+    const size_t acc_dt_size = types::data_type_size(conf.ker.acc_dt);
+
+    src += src_d.offset0() * src_dt_size;
+    dst += dst_d.offset0() * dst_dt_size;
+
+    auto call_kernel = [](const reduction_impl::jit_reduction_kernel_t<isa> *k,
+                               const char *src_ptr, char *dst_ptr,
+                               dim_t reduce_size, dim_t work_amount) {
+        reduction_impl::call_params_t p;
+        p.src = src_ptr;
+        p.dst = dst_ptr;
+        p.reduce_size = reduce_size;
+        p.work_amount = work_amount;
+        (*k)(&p);
+    };
+
+    if (conf.nthr_reduce == 1) {
+        if (conf.ker.vectorize_inner) {
+            parallel_nd(outer, n_inner_blks, [&](dim_t o, dim_t ib) {
+                const dim_t i = ib * inner_blk;
+                call_kernel(kernel_.get(),
+                        src + (o * reduce * inner + i) * src_dt_size,
+                        dst + (o * inner + i) * dst_dt_size, reduce,
+                        nstl::min(inner_blk, inner - i));
+            });
+        } else {
+            parallel(conf.nthr, [&](const int ithr, const int nthr) {
+                dim_t start {0}, end {0};
+                balance211(outer, nthr, ithr, start, end);
+                if (start >= end) return;
+                call_kernel(kernel_.get(), src + start * reduce * src_dt_size,
+                        dst + start * dst_dt_size, reduce, end - start);
+            });
+        }
+        return status::success;
+    }
+
+    // Two-level reduction: partials of the reduce ranges first...
+    auto scratchpad = ctx.get_scratchpad_grantor();
+    char *partials = scratchpad.template get<char>(
+            memory_tracking::names::key_reduction);
+    const dim_t nthr_reduce = conf.nthr_reduce;
+    const dim_t nelems = outer * inner;
+
+    if (conf.ker.vectorize_inner) {
+        parallel_nd(nthr_reduce, outer, n_inner_blks,
+                [&](dim_t ir, dim_t o, dim_t ib) {
+                    dim_t r_start {0}, r_end {0};
+                    balance211(reduce, nthr_reduce, ir, r_start, r_end);
+                    const dim_t i = ib * inner_blk;
+                    call_kernel(kernel_.get(),
+                            src + ((o * reduce + r_start) * inner + i)
+                                    * src_dt_size,
+                            partials + (ir * nelems + o * inner + i)
+                                    * acc_dt_size,
+                            r_end - r_start, nstl::min(inner_blk, inner - i));
+                });
+    } else {
+        parallel_nd(nthr_reduce, outer, [&](dim_t ir, dim_t o) {
+            dim_t r_start {0}, r_end {0};
+            balance211(reduce, nthr_reduce, ir, r_start, r_end);
+            call_kernel(kernel_.get(),
+                    src + (o * reduce + r_start) * src_dt_size,
+                    partials + (ir * outer + o) * acc_dt_size, r_end - r_start,
+                    1);
+        });
+    }
+
+    // ...and then their combination into the destination
+    const dim_t n_blks = div_up(nelems, inner_blk);
+    parallel_nd(n_blks, [&](dim_t blk) {
+        const dim_t e = blk * inner_blk;
+        call_kernel(kernel_combine_.get(), partials + e * acc_dt_size,
+                dst + e * dst_dt_size, nthr_reduce,
+                nstl::min(inner_blk, nelems - e));
+    });
+
+    return status::success;
+}
+
+template struct jit_uni_reduction_t<sse41>;
+template struct jit_uni_reduction_t<avx2>;
+template struct jit_uni_reduction_t<avx512_common>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
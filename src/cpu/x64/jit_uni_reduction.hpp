@@ -0,0 +1,134 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_REDUCTION_HPP
+#define CPU_X64_JIT_UNI_REDUCTION_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_reduction_pd.hpp"
+#include "cpu/platform.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+struct jit_reduction_kernel_conf_t {
+    data_type_t src_dt, dst_dt, acc_dt;
+    alg_kind_t alg;
+    float p, eps;
+    // true:  reduce rows of `src_stride` elements apart, vectorizing over the
+    //        elements of a row, each being a separate output;
+    // false: reduce contiguous runs of elements, `src_stride` elements apart,
+    //        one output per run.
+    bool vectorize_inner;
+    bool apply_power; // accumulate |src|^p, false when combining partials
+    bool finalize; // apply mean/norm and convert to dst_dt
+    dim_t src_stride;
+    dim_t div; // number of reduced points, used by mean
+    int tail; // inner % simd_w when vectorizing over the inner elements
+};
+
+// The reduction is viewed as a dense [outer][reduce][inner] tensor with the
+// destination being [outer][inner]. When there is not enough independent
+// work for all the threads the reduce dimension is split between
+// `nthr_reduce` threads, which write partial results to the scratchpad, and
+// the partials are combined by a second kernel.
+struct jit_reduction_conf_t {
+    dim_t outer, reduce, inner;
+    dim_t inner_blk; // inner elements processed by a single kernel call
+    dim_t outer_blk; // outputs processed by a single kernel call
+    int nthr, nthr_reduce;
+    jit_reduction_kernel_conf_t ker, ker_combine;
+};
+
+namespace reduction_impl {
+template <cpu_isa_t isa>
+struct jit_reduction_kernel_t;
+}
+
+template <cpu_isa_t isa>
+struct jit_uni_reduction_t : public primitive_t {
+    struct pd_t : public cpu_reduction_pd_t {
+        using cpu_reduction_pd_t::cpu_reduction_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", isa, ""), jit_uni_reduction_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+            const auto src_dt = src_md()->data_type;
+            const auto dst_dt = dst_md()->data_type;
+
+            bool ok = mayiuse(isa) && utils::one_of(src_dt, f32, bf16, s8, u8)
+                    && utils::one_of(dst_dt, f32, bf16, s32, s8, u8)
+                    && IMPLICATION(utils::one_of(src_dt, f32, bf16),
+                            utils::one_of(dst_dt, f32, bf16))
+                    && IMPLICATION(dst_dt == bf16, src_dt == bf16)
+                    && IMPLICATION(utils::one_of(bf16, src_dt, dst_dt),
+                            is_superset(isa, avx512_common)
+                                    && mayiuse(avx512_core))
+                    && platform::has_data_type_support(src_dt)
+                    && platform::has_data_type_support(dst_dt)
+                    && set_default_params() == status::success
+                    && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            CHECK(init_conf());
+
+            init_scratchpad();
+
+            return status::success;
+        }
+
+        jit_reduction_conf_t conf_;
+
+    private:
+        status_t init_conf();
+        void init_scratchpad();
+    };
+
+    jit_uni_reduction_t(const pd_t *apd);
+    ~jit_uni_reduction_t();
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<reduction_impl::jit_reduction_kernel_t<isa>> kernel_;
+    std::unique_ptr<reduction_impl::jit_reduction_kernel_t<isa>>
+            kernel_combine_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -67,6 +67,19 @@ namespace tr {
  * between kernel and threading driver. */
 const size_t ker_prb_size_min = 64;
 
+/* appends the fields of the problem the kernels depend on to a key of the
+ * persistent code cache */
+static void append_prb_key(std::string &key, const prb_t &prb) {
+    using jit_utils::code_cache::append_key;
+    append_key(key, prb.itype, prb.otype, prb.ndims);
+    for (int d = 0; d < prb.ndims; ++d) {
+        const auto &n = prb.nodes[d];
+        append_key(key, n.n, n.is, n.os, n.ss, n.cs);
+    }
+    append_key(key, prb.ioff, prb.ooff, prb.scale_type, prb.beta,
+            prb.req_s8s8_comp, prb.req_asymmetric_comp, prb.scale_adjust);
+}
+
 /* kernel */
 struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_reorder_kernel_f32)
@@ -135,7 +148,10 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                 && utils::one_of(p.beta, 0.f, 1.f) /* anything else? */
                 && simple_impl_desc_init(p, nullptr) && mayiuse(sse41)
                 && IMPLICATION((p.itype == bf16 || p.otype == bf16),
-                        mayiuse(avx512_core));
+                        mayiuse(avx512_core))
+                && IMPLICATION(p.req_comp(),
+                        p.otype == s8 && utils::one_of(p.itype, f32, bf16, s8)
+                                && p.beta == 0.f);
         if (!ok) return false;
 
         const ptrdiff_t max_stride = (1LL << 31) - 1;
@@ -143,7 +159,8 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
             const ptrdiff_t cms = max_stride / p.nodes[d].n;
             bool strides_ok = true
                     && p.nodes[d].is < cms / (int)data_type_size(p.itype)
-                    && p.nodes[d].os < cms / (int)data_type_size(p.otype);
+                    && p.nodes[d].os < cms / (int)data_type_size(p.otype)
+                    && p.nodes[d].cs < cms / (int)sizeof(int32_t);
             if (!strides_ok) return false;
         }
 
@@ -166,6 +183,10 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         assert(d < prb_.ndims);
         return (int)prb_.nodes[d].ss;
     }
+    int cs(int d) {
+        assert(d < prb_.ndims);
+        return (int)prb_.nodes[d].cs;
+    }
 
     Address i_addr(int i_off) {
         return ptr[reg_ptr_in + reg_off_in + i_off * itype_sz];
@@ -179,11 +200,17 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         return ptr[reg_ptr_scale + reg_off_scale + s_off * stype_sz];
     }
 
+    Address c_addr(int c_off) {
+        return ptr[reg_ptr_comp + reg_off_comp + c_off * ctype_sz];
+    }
+
     void step(int off, int prev_i_off, int prev_o_off, int prev_s_off,
-            int &i_off, int &o_off, int &s_off, int step_size = 1) {
+            int prev_c_off, int &i_off, int &o_off, int &s_off, int &c_off,
+            int step_size = 1) {
         i_off = prev_i_off;
         o_off = prev_o_off;
         s_off = prev_s_off;
+        c_off = prev_c_off;
 
         if (off == 0) return;
 
@@ -197,12 +224,14 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
             i_off += is(d);
             o_off += os(d);
             s_off += ss(d);
+            c_off += cs(d);
 
             if (off % n(d)) break;
 
             i_off += -n(d) * is(d);
             o_off += -n(d) * os(d);
             s_off += -n(d) * ss(d);
+            c_off += -n(d) * cs(d);
             off /= n(d);
 
             if (off == 0) break; /* FIXME: is it really required? */
@@ -212,8 +241,8 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
     void step(int off, int prev_i_off, int prev_o_off, int &i_off, int &o_off,
             int step_size = 1) {
         int dummy = 0;
-        step(off, prev_i_off, prev_o_off, dummy, i_off, o_off, dummy,
-                step_size);
+        step(off, prev_i_off, prev_o_off, dummy, dummy, i_off, o_off, dummy,
+                dummy, step_size);
     }
 
     void tr8x8_avx2(int i_off, int o_off) {
@@ -379,7 +408,8 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                         && utils::one_of(prb_.otype, u8, s8, s32, f32, bf16)))
                 && utils::everyone_is(8, n(0), n(1))
                 && utils::everyone_is(1, os(0), is(1))
-                && prb_.scale_type == scale_type_t::NONE && prb_.beta == 0.f;
+                && prb_.scale_type == scale_type_t::NONE && prb_.beta == 0.f
+                && !prb_.req_comp();
     }
 
     bool process_unroll_tr8x8(int len) {
@@ -408,7 +438,8 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                         || (prb_.itype == s32 && prb_.otype == f32)
                         || (prb_.itype == f32 && prb_.otype == s32))
                 && len % simd_w == 0 && n(0) % len == 0
-                && prb_.scale_type == scale_type_t::NONE && prb_.beta == 0.f;
+                && prb_.scale_type == scale_type_t::NONE && prb_.beta == 0.f
+                && !prb_.req_comp();
         if (!can_do) return false;
 
         for (int off = 0; off < len;) {
@@ -439,8 +470,43 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         return true;
     }
 
+    /* comp[c_off[:]] += (s32)xmm[:]
+     * The values are already saturated, so the conversion matches the one
+     * used to get the output values. */
+    void accumulate_compensation(const Xmm &xmm, const int *c_off, int len) {
+        if (mayiuse(avx))
+            vcvtps2dq(xmm_comp, xmm);
+        else
+            cvtps2dq(xmm_comp, xmm);
+
+        bool same_off = true, consecutive_off = true;
+        for (int r = 1; r < len; ++r) {
+            if (c_off[r] != c_off[0]) same_off = false;
+            if (c_off[r] != c_off[r - 1] + 1) consecutive_off = false;
+        }
+
+        if (len > 1 && same_off) {
+            phaddd(xmm_comp, xmm_comp);
+            phaddd(xmm_comp, xmm_comp);
+            movd(reg_tmp.cvt32(), xmm_comp);
+            add(c_addr(c_off[0]), reg_tmp.cvt32());
+        } else if (len > 1 && consecutive_off) {
+            movups(xmm_tmp, c_addr(c_off[0]));
+            paddd(xmm_comp, xmm_tmp);
+            movups(c_addr(c_off[0]), xmm_comp);
+        } else {
+            for (int r = 0; r < len; ++r) {
+                if (r == 0)
+                    movd(reg_tmp.cvt32(), xmm_comp);
+                else
+                    pextrd(reg_tmp.cvt32(), xmm_comp, r);
+                add(c_addr(c_off[r]), reg_tmp.cvt32());
+            }
+        }
+    }
+
     void process_unroll_generic_step(int reg_unroll, const int *i_off,
-            const int *o_off, const int *s_off) {
+            const int *o_off, const int *s_off, const int *c_off) {
         using namespace data_type;
 
         // TODO: Clean up the code by using "uni" instructions once
@@ -610,7 +676,8 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
 
         const bool interim_f32 = false
                 || utils::one_of(f32, prb_.itype, prb_.otype)
-                || prb_.scale_type != scale_type_t::NONE || prb_.beta != 0.f;
+                || prb_.scale_type != scale_type_t::NONE || prb_.beta != 0.f
+                || prb_.req_comp();
 
         const bool need_saturation
                 = (utils::one_of(prb_.otype, u8, s8, s32) && interim_f32);
@@ -643,7 +710,7 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         if (can_load_xmm && !can_store_xmm) {
             const bool fast_return = true // transposition on the fly
                     && prb_.scale_type != scale_type_t::MANY
-                    && prb_.beta == 0.f;
+                    && prb_.beta == 0.f && !prb_.req_comp();
             if (fast_return) {
                 if (prb_.scale_type == scale_type_t::COMMON)
                     for (int ur = 0; ur < reg_unroll; ur += load_step)
@@ -697,6 +764,12 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
             }
         }
 
+        /* xmm_scale <-- scale_adjust * xmm_scale
+         * (the common scale is adjusted once in generate()) */
+        const auto adjust_scale = [=]() {
+            if (prb_.scale_adjust != 1.f) mulps(xmm_scale, xmm_scale_adjust);
+        };
+
         /* scale and beta processing */
         if (can_store_xmm) {
             /* xmm <-- scale * xmm[:] */
@@ -717,6 +790,7 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                     if (scale_load_type == scale_load_type_t::bcast) {
                         movss(xmm_scale, s_addr(s_off[ur]));
                         shufps(xmm_scale, xmm_scale, 0x0);
+                        adjust_scale();
                         mulps(Xmm(ur), xmm_scale);
                         continue;
                     }
@@ -728,6 +802,7 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
 
                     if (scale_load_type == scale_load_type_t::load) {
                         movups(xmm_scale, s_addr(s_off[ur]));
+                        adjust_scale();
                         mulps(Xmm(ur), xmm_scale);
                         continue;
                     }
@@ -736,6 +811,7 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                     // so gather the scale factors one by one
                     for (int r = ur; r < ur + ur_step; ++r)
                         pinsrd(xmm_scale, s_addr(s_off[r]), r - ur);
+                    adjust_scale();
                     mulps(Xmm(ur), xmm_scale);
                 }
             }
@@ -770,7 +846,12 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                     mulss(Xmm(ur), xmm_scale);
             } else if (prb_.scale_type == scale_type_t::MANY) {
                 for (int ur = 0; ur < reg_unroll; ur += ur_step) {
-                    mulss(Xmm(ur), s_addr(s_off[ur]));
+                    if (prb_.scale_adjust != 1.f) {
+                        movss(xmm_scale, s_addr(s_off[ur]));
+                        adjust_scale();
+                        mulss(Xmm(ur), xmm_scale);
+                    } else
+                        mulss(Xmm(ur), s_addr(s_off[ur]));
                 }
             }
 
@@ -809,6 +890,11 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
             }
         }
 
+        if (prb_.req_comp()) {
+            for (int ur = 0; ur < reg_unroll; ur += ur_step)
+                accumulate_compensation(Xmm(ur), c_off + ur, ur_step);
+        }
+
         for (int ur = 0; ur < reg_unroll; ur += ur_step) {
             if (prb_.otype != f32)
                 cvt2odt(Xmm(ur), prb_.otype, interim_f32 ? f32 : prb_.itype);
@@ -822,6 +908,7 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         int i_off[2 * blk] = {0};
         int o_off[2 * blk] = {0};
         int s_off[2 * blk] = {0};
+        int c_off[2 * blk] = {0};
 
         int curr = 0; // will switch between 0 and 1
 
@@ -833,11 +920,13 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                 const int ur_c = curr * blk + ur;
                 const int ur_p = (ur_c - 1 + 2 * blk) % (2 * blk); // prev ur
                 step(off + ur, i_off[ur_p], o_off[ur_p], s_off[ur_p],
-                        i_off[ur_c], o_off[ur_c], s_off[ur_c]);
+                        c_off[ur_p], i_off[ur_c], o_off[ur_c], s_off[ur_c],
+                        c_off[ur_c]);
             }
 
             process_unroll_generic_step(reg_unroll, i_off + curr * blk,
-                    o_off + curr * blk, s_off + curr * blk);
+                    o_off + curr * blk, s_off + curr * blk,
+                    c_off + curr * blk);
 
             curr = 1 - curr;
         }
@@ -849,11 +938,12 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
     }
 
     void loop_end(Label &l, Reg64 reg_cnt, int len, int i_step, int o_step,
-            int s_step) {
+            int s_step, int c_step) {
         add(reg_off_in, i_step * itype_sz);
         add(reg_off_out, o_step * otype_sz);
         if (prb_.scale_type == scale_type_t::MANY)
             add(reg_off_scale, s_step * stype_sz);
+        if (prb_.req_comp()) add(reg_off_comp, c_step * ctype_sz);
         dec(reg_cnt);
         jnz(l);
 
@@ -861,6 +951,7 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         sub(reg_off_out, len * o_step * otype_sz);
         if (prb_.scale_type == scale_type_t::MANY)
             sub(reg_off_scale, len * s_step * stype_sz);
+        if (prb_.req_comp()) sub(reg_off_comp, len * c_step * ctype_sz);
     }
 
     bool simple_impl() {
@@ -876,6 +967,7 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         xor_(reg_off_out, reg_off_out);
         if (prb_.scale_type == scale_type_t::MANY)
             xor_(reg_off_scale, reg_off_scale);
+        if (prb_.req_comp()) xor_(reg_off_comp, reg_off_comp);
 
         Label l_loop[3];
         Reg64 reg_cnt[3] = {r15, r14, r13};
@@ -895,15 +987,15 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
 
         if (n_jit_loops > 0)
             loop_end(l_loop[0], reg_cnt[0], n(nfu + 0) / ldu, is(nfu + 0) * ldu,
-                    os(nfu + 0) * ldu, ss(nfu + 0) * ldu);
+                    os(nfu + 0) * ldu, ss(nfu + 0) * ldu, cs(nfu + 0) * ldu);
 
         if (n_jit_loops > 1)
             loop_end(l_loop[1], reg_cnt[1], n(nfu + 1), is(nfu + 1),
-                    os(nfu + 1), ss(nfu + 1));
+                    os(nfu + 1), ss(nfu + 1), cs(nfu + 1));
 
         if (n_jit_loops > 2)
             loop_end(l_loop[2], reg_cnt[2], n(nfu + 2), is(nfu + 2),
-                    os(nfu + 2), ss(nfu + 2));
+                    os(nfu + 2), ss(nfu + 2), cs(nfu + 2));
 
         return true;
     }
@@ -918,6 +1010,7 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         itype_sz = data_type_size(prb_.itype);
         otype_sz = data_type_size(prb_.otype);
         stype_sz = sizeof(float);
+        ctype_sz = sizeof(int32_t);
         if (prb_.otype == data_type::bf16 && !mayiuse(avx512_core_bf16)) {
             bf16_emu_ = new bf16_emulation_t(this, bf16_emu_reserv_1,
                     bf16_emu_reserv_2, bf16_emu_reserv_3, bf16_emu_scratch,
@@ -926,6 +1019,13 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         }
     }
 
+    std::string persistent_cache_key() const override {
+        std::string key;
+        jit_utils::code_cache::append_key(key, desc_.id);
+        append_prb_key(key, prb_);
+        return key;
+    }
+
     void generate() override {
         preamble();
 #define PARAM(x) ptr[abi_param1 + offsetof(call_param_t, x)]
@@ -941,6 +1041,14 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         } else if (prb_.scale_type == scale_type_t::MANY) {
             mov(reg_ptr_scale, PARAM(scale));
         }
+        if (prb_.scale_adjust != 1.f) {
+            mov(reg_tmp.cvt32(), float2int(prb_.scale_adjust));
+            movd(xmm_scale_adjust, reg_tmp.cvt32());
+            shufps(xmm_scale_adjust, xmm_scale_adjust, 0x0);
+            if (prb_.scale_type == scale_type_t::COMMON)
+                mulps(xmm_scale, xmm_scale_adjust);
+        }
+        if (prb_.req_comp()) mov(reg_ptr_comp, PARAM(compensation_scratch));
         mov(reg_ptr_in, PARAM(in));
         mov(reg_ptr_out, PARAM(out));
 #undef PARAM
@@ -973,14 +1081,17 @@ private:
     int itype_sz;
     int otype_sz;
     int stype_sz;
+    int ctype_sz;
 
     Reg64 reg_ptr_in = rsi;
     Reg64 reg_ptr_out = rdx;
     Reg64 reg_ptr_scale = abi_not_param1;
+    Reg64 reg_ptr_comp = r11;
 
     Reg64 reg_off_in = r8;
     Reg64 reg_off_out = r9;
     Reg64 reg_off_scale = r10;
+    Reg64 reg_off_comp = r12;
 
     Reg64 reg_tmp = rax;
 
@@ -992,6 +1103,8 @@ private:
     Xmm xmm_tmp = xmm12;
     Xmm xmm_saturation_ubound = xmm12;
     Ymm ymm_saturation_ubound = ymm12;
+    Xmm xmm_scale_adjust = xmm11;
+    Xmm xmm_comp = xmm10;
 
     /* bf16 support on SKX */
     bf16_emulation_t *bf16_emu_;
@@ -1052,6 +1165,12 @@ struct jit_single_blk_kernel_t : public jit_generator {
         , otype_sz(data_type_size(prb_.otype))
         , block_sz(prb.nodes[0].n) {}
 
+    std::string persistent_cache_key() const override {
+        std::string key;
+        append_prb_key(key, prb_);
+        return key;
+    }
+
     void generate() override {
         auto input_stride
                 = prb_.nodes[0].is != 1 ? prb_.nodes[0].is : prb_.nodes[1].is;
@@ -1542,38 +1661,59 @@ struct jit_uni_reorder_t : public primitive_t {
             }
             _pd->prb_ = prb;
             _pd->ker_desc_ = ker_desc;
-            _pd->init_scratchpad_md();
             _pd->nthr_ = nthr;
+            _pd->init_scratchpad();
+            _pd->init_scratchpad_md();
             return safe_ptr_assign(*reorder_pd, _pd);
         }
 
         tr::prb_t prb_;
         tr::kernel_t::desc_t ker_desc_;
         int nthr_;
+        dim_t comp_size_ = 0;
+
+    private:
+        void init_scratchpad() {
+            if (!prb_.req_comp()) return;
+
+            const memory_desc_wrapper od(dst_md());
+            const int comp_mask = prb_.req_s8s8_comp
+                    ? od.extra().compensation_mask
+                    : od.extra().asymm_compensation_mask;
+            comp_size_ = 1;
+            for (int d = 0; d < od.ndims(); ++d)
+                if (comp_mask & (1 << d)) comp_size_ *= od.padded_dims()[d];
+
+            auto scratchpad = scratchpad_registry().registrar();
+            scratchpad.book<int32_t>(
+                    memory_tracking::names::key_reorder_space,
+                    nthr_ * comp_size_);
+        }
     };
 
     jit_uni_reorder_t(const pd_t *apd) : primitive_t(apd) {}
 
-    void omp_driver_0d(
-            int off, const char *in, char *out, const float *scale) const {
-        tr::call_param_t c {in, out, scale};
+    void omp_driver_0d(int off, const char *in, char *out, const float *scale,
+            int32_t *comp) const {
+        tr::call_param_t c {in, out, scale, comp};
         (*kernel_)(&c);
     }
 
     void omp_driver_1d(int ithr, int nthr, int off, const char *in, char *out,
-            const float *scale) const {
+            const float *scale, int32_t *comp) const {
         const tr::node_t *ns = pd()->prb_.nodes + off;
         for_nd(ithr, nthr, (ptrdiff_t)ns[0].n, [&](ptrdiff_t d0) {
             auto c = tr::call_param_t();
             c.in = in + d0 * ns[0].is * data_type_size(pd()->prb_.itype);
             c.out = out + d0 * ns[0].os * data_type_size(pd()->prb_.otype);
             c.scale = scale + d0 * ns[0].ss;
+            c.compensation_scratch = comp + d0 * ns[0].cs;
             (*kernel_)(&c);
         });
     }
 
     void omp_driver_2d(int ithr, int nthr, int off, const char *in, char *out,
-            const float *scale) const {
+            const float *scale, int32_t *comp) const {
         const tr::node_t *ns = pd()->prb_.nodes + off;
         for_nd(ithr, nthr, (ptrdiff_t)ns[1].n, (ptrdiff_t)ns[0].n,
                 [&](ptrdiff_t d1, ptrdiff_t d0) {
@@ -1585,12 +1725,14 @@ struct jit_uni_reorder_t : public primitive_t {
                             + (d0 * ns[0].os + d1 * ns[1].os)
                                     * data_type_size(pd()->prb_.otype);
                     c.scale = scale + d0 * ns[0].ss + d1 * ns[1].ss;
+                    c.compensation_scratch
+                            = comp + d0 * ns[0].cs + d1 * ns[1].cs;
                     (*kernel_)(&c);
                 });
     }
 
     void omp_driver_3d(int ithr, int nthr, int off, const char *in, char *out,
-            const float *scale) const {
+            const float *scale, int32_t *comp) const {
         const tr::node_t *ns = pd()->prb_.nodes + off;
         for_nd(ithr, nthr, (ptrdiff_t)ns[2].n, (ptrdiff_t)ns[1].n,
                 (ptrdiff_t)ns[0].n,
@@ -1604,12 +1746,14 @@ struct jit_uni_reorder_t : public primitive_t {
                                     * data_type_size(pd()->prb_.otype);
                     c.scale = scale + d0 * ns[0].ss + d1 * ns[1].ss
                             + d2 * ns[2].ss;
+                    c.compensation_scratch = comp + d0 * ns[0].cs
+                            + d1 * ns[1].cs + d2 * ns[2].cs;
                     (*kernel_)(&c);
                 });
     }
 
     void omp_driver_4d(int ithr, int nthr, int off, const char *in, char *out,
-            const float *scale) const {
+            const float *scale, int32_t *comp) const {
         const tr::node_t *ns = pd()->prb_.nodes + off;
         for_nd(ithr, nthr, (ptrdiff_t)ns[3].n, (ptrdiff_t)ns[2].n,
                 (ptrdiff_t)ns[1].n, (ptrdiff_t)ns[0].n,
@@ -1625,11 +1769,16 @@ struct jit_uni_reorder_t : public primitive_t {
                                     * data_type_size(pd()->prb_.otype);
                     c.scale = scale + d0 * ns[0].ss + d1 * ns[1].ss
                             + d2 * ns[2].ss + d3 * ns[3].ss;
+                    c.compensation_scratch = comp + d0 * ns[0].cs
+                            + d1 * ns[1].cs + d2 * ns[2].cs + d3 * ns[3].cs;
                     (*kernel_)(&c);
                 });
     }
 
-    void omp_driver(const char *in, char *out, const float *scale) const {
+    /* Each thread accumulates the output values to its own slice of the
+     * compensation scratchpad, returns the number of slices used */
+    int omp_driver(const char *in, char *out, const float *scale,
+            int32_t *comp_scratch) const {
         in += pd()->prb_.ioff * data_type_size(pd()->prb_.itype);
         out += pd()->prb_.ooff * data_type_size(pd()->prb_.otype);
 
@@ -1646,27 +1795,66 @@ struct jit_uni_reorder_t : public primitive_t {
         int ndims_ker = pd()->ker_desc_.prb.ndims;
         assert(ndims - ndims_ker <= ndims_driver_max);
 
+        const dim_t comp_size = pd()->comp_size_;
+        auto thr_comp = [&](int ithr) -> int32_t * {
+            if (comp_scratch == nullptr) return nullptr;
+            int32_t *comp = comp_scratch + ithr * comp_size;
+            utils::array_set(comp, 0, comp_size);
+            return comp;
+        };
+
         if (ndims - ndims_ker == 0) {
-            omp_driver_0d(ndims_ker, in, out, scale);
-        } else {
-            parallel(pd()->nthr_, [&](const int ithr, const int nthr) {
-                switch (ndims - ndims_ker) {
-                    case 1:
-                        omp_driver_1d(ithr, nthr, ndims_ker, in, out, scale);
-                        break;
-                    case 2:
-                        omp_driver_2d(ithr, nthr, ndims_ker, in, out, scale);
-                        break;
-                    case 3:
-                        omp_driver_3d(ithr, nthr, ndims_ker, in, out, scale);
-                        break;
-                    case 4:
-                        omp_driver_4d(ithr, nthr, ndims_ker, in, out, scale);
-                        break;
-                    default: assert(!"unimplemented");
-                }
-            });
+            omp_driver_0d(ndims_ker, in, out, scale, thr_comp(0));
+            return 1;
         }
+
+        int nthr_used = 1;
+        parallel(pd()->nthr_, [&](const int ithr, const int nthr) {
+            if (ithr == 0) nthr_used = nthr;
+            int32_t *comp = thr_comp(ithr);
+            switch (ndims - ndims_ker) {
+                case 1:
+                    omp_driver_1d(ithr, nthr, ndims_ker, in, out, scale, comp);
+                    break;
+                case 2:
+                    omp_driver_2d(ithr, nthr, ndims_ker, in, out, scale, comp);
+                    break;
+                case 3:
+                    omp_driver_3d(ithr, nthr, ndims_ker, in, out, scale, comp);
+                    break;
+                case 4:
+                    omp_driver_4d(ithr, nthr, ndims_ker, in, out, scale, comp);
+                    break;
+                default: assert(!"unimplemented");
+            }
+        });
+        return nthr_used;
+    }
+
+    /* Reduces the per-thread sums of the output values into the
+     * compensations appended to the output */
+    void reduce_compensation(
+            char *out, const int32_t *comp_scratch, int nthr) const {
+        const memory_desc_wrapper od(pd()->dst_md());
+        const auto &prb = pd()->prb_;
+        const dim_t comp_size = pd()->comp_size_;
+
+        const size_t offset = od.size() - od.additional_buffer_size();
+        int32_t *cp = prb.req_s8s8_comp
+                ? reinterpret_cast<int32_t *>(out + offset)
+                : nullptr;
+        int32_t *zp = prb.req_asymmetric_comp
+                ? reinterpret_cast<int32_t *>(out + offset)
+                        + (prb.req_s8s8_comp ? comp_size : 0)
+                : nullptr;
+
+        parallel_nd(comp_size, [&](dim_t i) {
+            int32_t acc = 0;
+            for (int ithr = 0; ithr < nthr; ++ithr)
+                acc += comp_scratch[ithr * comp_size + i];
+            if (cp) cp[i] = -128 * acc;
+            if (zp) zp[i] = -acc;
+        });
     }
 
     status_t init(engine_t *engine) override {
@@ -1679,7 +1867,13 @@ struct jit_uni_reorder_t : public primitive_t {
         auto out = CTX_OUT_MEM(char *, DNNL_ARG_TO);
         DEFINE_SCALES_BUFFER(scales);
 
-        omp_driver(in, out, scales);
+        int32_t *comp_scratch = pd()->prb_.req_comp()
+                ? ctx.get_scratchpad_grantor().get<int32_t>(
+                        memory_tracking::names::key_reorder_space)
+                : nullptr;
+
+        const int nthr = omp_driver(in, out, scales, comp_scratch);
+        if (comp_scratch) reduce_compensation(out, comp_scratch, nthr);
 
         return status::success;
     }
@@ -38,6 +38,7 @@ struct node_t {
     ptrdiff_t is; // input stride
     ptrdiff_t os; // output stride
     ptrdiff_t ss; // scale stride
+    ptrdiff_t cs; // compensation stride
 };
 
 enum class scale_type_t { NONE, COMMON, MANY };
@@ -51,6 +52,13 @@ struct prb_t {
     ptrdiff_t ooff;
     scale_type_t scale_type;
     float beta;
+    /* s8s8 and zero-point compensations share the per-output-channel sums of
+     * the output values, so a single accumulator indexed by cs is used */
+    bool req_s8s8_comp;
+    bool req_asymmetric_comp;
+    float scale_adjust;
+
+    bool req_comp() const { return req_s8s8_comp || req_asymmetric_comp; }
 };
 
 status_t prb_init(prb_t &prb, const memory_desc_t &imd,
@@ -81,6 +89,7 @@ struct call_param_t {
     const void *in;
     void *out;
     const float *scale;
+    int32_t *compensation_scratch;
 };
 
 struct kernel_t {
@@ -45,6 +45,8 @@ namespace {
 
 using namespace Xbyak;
 
+using softmax_impl::vectorize_inner;
+
 template <cpu_isa_t isa>
 struct jit_softmax_base_t : public jit_generator {
     struct call_params_t {
@@ -100,15 +102,28 @@ struct jit_softmax_base_t : public jit_generator {
     size_t simd_w_ = 0;
     size_t unroll_regs_ = 4;
 
+    bool vectorize_inner_ = false;
+    bool is_inner_tail_ = false; // the vector is partially filled
+
     size_t axis_simd_full_;
     size_t axis_simd_tail_;
     size_t n_loops_;
     size_t loop_tail_;
     size_t axis_stride_;
+    size_t tail_size_; // elements in a tail vector (along axis or inner)
 
     void compute_predefined_variables() {
-        axis_simd_full_ = pd_->axis_size() / simd_w_;
-        axis_simd_tail_ = pd_->axis_size() % simd_w_;
+        if (vectorize_inner_) {
+            const dim_t inner_size
+                    = data_d_.blocking_desc().strides[pd_->axis()];
+            axis_simd_full_ = pd_->axis_size();
+            axis_simd_tail_ = 0;
+            tail_size_ = is_inner_tail_ ? inner_size % simd_w_ : 0;
+        } else {
+            axis_simd_full_ = pd_->axis_size() / simd_w_;
+            axis_simd_tail_ = pd_->axis_size() % simd_w_;
+            tail_size_ = axis_simd_tail_;
+        }
         n_loops_ = axis_simd_full_ / unroll_regs_;
         loop_tail_ = axis_simd_full_ - n_loops_ * unroll_regs_;
         axis_stride_ = compute_axis_stride();
@@ -117,7 +132,8 @@ struct jit_softmax_base_t : public jit_generator {
     size_t compute_axis_stride() {
         const auto &bd = data_d_.blocking_desc();
 
-        if (bd.inner_nblks) return data_type_size_ * bd.strides[pd_->axis()];
+        if (bd.inner_nblks || vectorize_inner_)
+            return data_type_size_ * bd.strides[pd_->axis()];
         return is_bf16_ ? vlen / 2 : vlen;
     }
 
@@ -166,9 +182,16 @@ struct jit_softmax_base_t : public jit_generator {
             uni_vaddps(v, v, vtmp);
     }
 
+    // In the inner vectorized mode the lanes are reduced independently
+    void reduce_lanes(const Vmm &v, const Vmm &vtmp, op_t op) {
+        if (!vectorize_inner_) get_horizontal_op(v, vtmp, op);
+    }
+
     template <typename body_t>
     void axis_loop(body_t body) {
         Label main_loop, tail_loop, tail_axis;
+        // every vector is partial when vectorizing over a tail of inner
+        const bool lane_tail = vectorize_inner_ && tail_size_ > 0;
 
         // reverse_spat_offt to dispatch between labels
         mov(reg_reverse_spat_offt, reg_spat_offt_count);
@@ -179,7 +202,7 @@ struct jit_softmax_base_t : public jit_generator {
                 cmp(reg_reverse_spat_offt, unroll_regs_ * axis_stride_);
                 jl(tail_loop, T_NEAR);
 
-                body(unroll_regs_, false);
+                body(unroll_regs_, lane_tail);
                 sub(reg_reverse_spat_offt, unroll_regs_ * axis_stride_);
                 add(reg_spat_offt, unroll_regs_ * axis_stride_);
                 jmp(main_loop);
@@ -189,7 +212,7 @@ struct jit_softmax_base_t : public jit_generator {
         L(tail_loop);
         {
             if (loop_tail_) {
-                body(loop_tail_, false);
+                body(loop_tail_, lane_tail);
                 add(reg_spat_offt, loop_tail_ * axis_stride_);
             }
         }
@@ -239,7 +262,7 @@ struct jit_softmax_base_t : public jit_generator {
         initialization_hook();
         if (exp_injector_) exp_injector_->load_table_addr();
         if (log_injector_) log_injector_->load_table_addr();
-        if (axis_simd_tail_) prepare_tail_mask();
+        if (tail_size_) prepare_tail_mask();
         load_common_params();
         if (pd_->is_fwd())
             forward();
@@ -250,13 +273,15 @@ struct jit_softmax_base_t : public jit_generator {
         if (log_injector_) log_injector_->prepare_table();
     }
 
-    jit_softmax_base_t(const softmax_pd_t *pd)
+    jit_softmax_base_t(const softmax_pd_t *pd, bool is_inner_tail)
         : jit_generator(nullptr, MAX_CODE_SIZE, true, isa)
         , pd_(pd)
         , data_d_(pd_->dst_md()) {
         is_bf16_ = data_d_.data_type() == data_type::bf16;
         data_type_size_ = is_bf16_ ? sizeof(bfloat16_t) : sizeof(float);
         simd_w_ = vlen / sizeof(float); // bf16 works on ymms
+        vectorize_inner_ = vectorize_inner(data_d_, pd_->axis());
+        is_inner_tail_ = is_inner_tail;
     }
 };
 
@@ -301,7 +326,7 @@ struct jit_softmax_t<avx512_common> : public jit_softmax_base_t<avx512_common> {
     };
 
     void prepare_tail_mask() override {
-        const int mask_f32 = (1 << axis_simd_tail_) - 1;
+        const int mask_f32 = (1 << tail_size_) - 1;
         Reg32 regw_tmp = reg_tmp.cvt32();
         mov(regw_tmp, mask_f32);
         kmovw(tail_opmask, regw_tmp);
@@ -333,7 +358,7 @@ struct jit_softmax_t<avx512_common> : public jit_softmax_base_t<avx512_common> {
             }
         });
 
-        get_horizontal_op(vmax, vtmp = vsum, op_t::max);
+        reduce_lanes(vmax, vtmp = vsum, op_t::max);
     }
 
     void accumulate_vsum() override {
@@ -356,7 +381,7 @@ struct jit_softmax_t<avx512_common> : public jit_softmax_base_t<avx512_common> {
             }
         });
 
-        get_horizontal_op(vsum, vtmp = vmax, op_t::sum);
+        reduce_lanes(vsum, vtmp = vmax, op_t::sum);
         if (is_softmax_) uni_vdivps(vsum, vone, vsum, vtmp = vmax);
         if (is_logsoftmax_) log_injector_->compute_vector(vsum.getIdx());
     }
@@ -395,7 +420,7 @@ struct jit_softmax_t<avx512_common> : public jit_softmax_base_t<avx512_common> {
             }
         });
 
-        get_horizontal_op(vsbr, vtmp = vmax, op_t::sum);
+        reduce_lanes(vsbr, vtmp = vmax, op_t::sum);
     }
 
     void compute_diff_src() override {
@@ -422,7 +447,8 @@ struct jit_softmax_t<avx512_common> : public jit_softmax_base_t<avx512_common> {
         if (bf16_emu_) bf16_emu_->init_vcvtneps2bf16();
     }
 
-    jit_softmax_t(const softmax_pd_t *pd) : jit_softmax_base_t(pd) {
+    jit_softmax_t(const softmax_pd_t *pd, bool is_inner_tail = false)
+        : jit_softmax_base_t(pd, is_inner_tail) {
         if (is_bf16_ && !mayiuse(avx512_core_bf16))
             bf16_emu_.reset(new bf16_emulation_t(this, bf16_emu_zmm_1,
                     bf16_emu_zmm_2, bf16_emu_zmm_3, bf16_emu_gpr,
@@ -438,11 +464,25 @@ template <>
 struct jit_softmax_t<avx2> : public jit_softmax_base_t<avx2> {
     Vmm tail_vmask = Vmm(0);
 
+    void store(const Address &addr, const Vmm &vmm, bool tail = false) {
+        if (tail)
+            uni_vmovups_tail(addr, tail_vmask, vmm);
+        else
+            uni_vmovups(addr, vmm);
+    };
+
+    void load(const Vmm &vmm, const Address &addr, bool tail = false) {
+        if (tail)
+            uni_vmovups_tail(vmm, tail_vmask, addr);
+        else
+            uni_vmovups(vmm, addr);
+    };
+
     void prepare_tail_mask() override {
         static const uint32_t mask_f32[14]
                 = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
                         0xffffffff, 0xffffffff, 0, 0, 0, 0, 0, 0, 0};
-        mov(reg_tmp, reinterpret_cast<size_t>(&mask_f32[7 - axis_simd_tail_]));
+        mov(reg_tmp, reinterpret_cast<size_t>(&mask_f32[7 - tail_size_]));
         vmovups(tail_vmask, ptr[reg_tmp]);
     }
 
@@ -473,7 +513,7 @@ struct jit_softmax_t<avx2> : public jit_softmax_base_t<avx2> {
             }
         });
 
-        get_horizontal_op(vmax, vtmp = vsum, op_t::max);
+        reduce_lanes(vmax, vtmp = vsum, op_t::max);
     }
 
     void accumulate_vsum() override {
@@ -510,7 +550,7 @@ struct jit_softmax_t<avx2> : public jit_softmax_base_t<avx2> {
             }
         });
 
-        get_horizontal_op(vsum, vtmp = vmax, op_t::sum);
+        reduce_lanes(vsum, vtmp = vmax, op_t::sum);
         if (is_softmax_) uni_vdivps(vsum, vone, vsum, vtmp = vmax);
         if (is_logsoftmax_) log_injector_->compute_vector(vsum.getIdx());
     }
@@ -542,11 +582,53 @@ struct jit_softmax_t<avx2> : public jit_softmax_base_t<avx2> {
         });
     }
 
+    void accumulate_vsbr() override {
+        uni_vpxor(vsbr, vsbr, vsbr); // flush to zero before accumulation
+
+        axis_loop([&](int unroll, bool tail = false) {
+            for (int i = 0; i < unroll; i++) {
+                Vmm vreg_tmp_dst = Vmm(i * 2 + 1);
+                Vmm vreg_tmp_diff_dst = Vmm(i * 2 + 2);
+                load(vreg_tmp_diff_dst, diff_dst_ptr(axis_stride_ * i), tail);
+                if (is_softmax_) {
+                    load(vreg_tmp_dst, dst_ptr(axis_stride_ * i), tail);
+                    uni_vmulps(
+                            vreg_tmp_diff_dst, vreg_tmp_diff_dst, vreg_tmp_dst);
+                }
+                uni_vaddps(vsbr, vsbr, vreg_tmp_diff_dst);
+            }
+        });
+
+        reduce_lanes(vsbr, vtmp = vmax, op_t::sum);
+    }
+
+    void compute_diff_src() override {
+        axis_loop([&](int unroll, bool tail = false) {
+            for (int i = 0; i < unroll; i++) {
+                Vmm vreg_tmp_dst = Vmm(i * 2 + 1);
+                Vmm vreg_tmp_diff_dst = Vmm(i * 2 + 2);
+                load(vreg_tmp_dst, dst_ptr(axis_stride_ * i), tail);
+                load(vreg_tmp_diff_dst, diff_dst_ptr(axis_stride_ * i), tail);
+                if (is_softmax_) {
+                    uni_vsubps(vreg_tmp_diff_dst, vreg_tmp_diff_dst, vsbr);
+                    uni_vmulps(
+                            vreg_tmp_diff_dst, vreg_tmp_dst, vreg_tmp_diff_dst);
+                }
+                if (is_logsoftmax_) {
+                    exp_injector_->compute_vector(vreg_tmp_dst.getIdx());
+                    uni_vfnmadd231ps(vreg_tmp_diff_dst, vreg_tmp_dst, vsbr);
+                }
+                store(diff_src_ptr(axis_stride_ * i), vreg_tmp_diff_dst, tail);
+            }
+        });
+    }
+
     void operator()(const call_params_t *p) override {
         return jit_generator::operator()(p);
     }
 
-    jit_softmax_t(const softmax_pd_t *pd) : jit_softmax_base_t(pd) {}
+    jit_softmax_t(const softmax_pd_t *pd, bool is_inner_tail = false)
+        : jit_softmax_base_t(pd, is_inner_tail) {}
 };
 
 template <>
@@ -596,7 +678,7 @@ struct jit_softmax_t<sse41> : public jit_softmax_base_t<sse41> {
             }
         });
 
-        get_horizontal_op(vmax, vtmp = vsum, op_t::max);
+        reduce_lanes(vmax, vtmp = vsum, op_t::max);
     }
 
     void accumulate_vsum() override {
@@ -638,7 +720,7 @@ struct jit_softmax_t<sse41> : public jit_softmax_base_t<sse41> {
             }
         });
 
-        get_horizontal_op(vsum, vtmp = vmax, op_t::sum);
+        reduce_lanes(vsum, vtmp = vmax, op_t::sum);
         if (is_softmax_) uni_vdivps(vsum, vone, vsum, vtmp = vmax);
         if (is_logsoftmax_) log_injector_->compute_vector(vsum.getIdx());
     }
@@ -676,7 +758,8 @@ struct jit_softmax_t<sse41> : public jit_softmax_base_t<sse41> {
         return jit_generator::operator()(p);
     }
 
-    jit_softmax_t(const softmax_pd_t *pd) : jit_softmax_base_t(pd) {}
+    jit_softmax_t(const softmax_pd_t *pd, bool is_inner_tail = false)
+        : jit_softmax_base_t(pd, is_inner_tail) {}
 };
 
 } // namespace
@@ -708,6 +791,24 @@ status_t jit_uni_softmax_fwd_t<isa>::execute(const exec_ctx_t &ctx) const {
     const auto &bd = data_d.blocking_desc();
     const auto axis = pd()->axis();
 
+    if (vectorize_inner(data_d, axis)) {
+        // a kernel call handles a vector of inner points along the axis
+        const dim_t simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+        const auto inner_size = bd.strides[axis];
+        const auto outer_stride = pd()->axis_size() * inner_size;
+        const auto outer_size = data_d.nelems() / outer_stride;
+        const auto n_vecs = utils::div_up(inner_size, simd_w);
+
+        parallel_nd(outer_size, n_vecs, [&](dim_t ou, dim_t iv) {
+            dim_t offset = (ou * outer_stride + iv * simd_w) * data_type_size;
+            const bool tail = (iv + 1) * simd_w > inner_size;
+            const char *src_ptr = src + offset;
+            char *dst_ptr = dst + offset;
+            softmax_driver_->exec(src_ptr, dst_ptr, outer_stride, tail);
+        });
+        return status::success;
+    }
+
     const auto inner_stride
             = bd.inner_nblks ? bd.inner_blks[bd.inner_nblks - 1] : (dim_t)1;
     const auto inner_size = bd.strides[axis] / inner_stride;
@@ -752,6 +853,26 @@ status_t jit_uni_softmax_bwd_t<isa>::execute(const exec_ctx_t &ctx) const {
     const auto &bd = data_d.blocking_desc();
     const auto axis = pd()->axis();
 
+    if (vectorize_inner(data_d, axis)) {
+        // a kernel call handles a vector of inner points along the axis
+        const dim_t simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+        const auto inner_size = bd.strides[axis];
+        const auto outer_stride = pd()->axis_size() * inner_size;
+        const auto outer_size = data_d.nelems() / outer_stride;
+        const auto n_vecs = utils::div_up(inner_size, simd_w);
+
+        parallel_nd(outer_size, n_vecs, [&](dim_t ou, dim_t iv) {
+            dim_t offset = (ou * outer_stride + iv * simd_w) * data_type_size;
+            const bool tail = (iv + 1) * simd_w > inner_size;
+            char *diff_src_ptr = diff_src + offset;
+            const char *dst_ptr = dst + offset;
+            const char *diff_dst_ptr = diff_dst + offset;
+            softmax_driver_->exec(
+                    diff_src_ptr, dst_ptr, diff_dst_ptr, outer_stride, tail);
+        });
+        return status::success;
+    }
+
     const auto inner_stride
             = bd.inner_nblks ? bd.inner_blks[bd.inner_nblks - 1] : (dim_t)1;
     const auto inner_size = bd.strides[axis] / inner_stride;
@@ -775,31 +896,45 @@ namespace softmax_impl {
 template <cpu_isa_t isa>
 struct driver_t : public c_compatible {
 
-    driver_t(const softmax_pd_t *pd) : pd_(pd), ker_(pd_) {}
+    driver_t(const softmax_pd_t *pd) : pd_(pd), ker_(pd_) {
+        const memory_desc_wrapper data_d(pd_->dst_md());
+        const int axis = pd_->axis();
+        const dim_t simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+        if (vectorize_inner(data_d, axis)
+                && data_d.blocking_desc().strides[axis] % simd_w != 0)
+            ker_tail_.reset(new jit_softmax_t<isa>(pd_, true));
+    }
 
-    void exec(const void *src, void *dst, const dim_t outer_stride) {
+    void exec(const void *src, void *dst, const dim_t outer_stride,
+            bool tail = false) {
         typename jit_softmax_t<isa>::call_params_t p;
         p.spat_offt_count = outer_stride * ker_.data_type_size_;
         p.src = src;
         p.dst = dst;
-        ker_(&p);
+        (tail ? *ker_tail_ : ker_)(&p);
     }
 
     void exec(void *diff_src, const void *dst, const void *diff_dst,
-            const dim_t outer_stride) {
+            const dim_t outer_stride, bool tail = false) {
         typename jit_softmax_t<isa>::call_params_t p;
         p.spat_offt_count = outer_stride * ker_.data_type_size_;
         p.src = diff_src;
         p.dst = dst;
         p.diff_dst = diff_dst;
-        ker_(&p);
+        (tail ? *ker_tail_ : ker_)(&p);
     }
 
-    status_t create_kernel() { return ker_.create_kernel(); }
+    status_t create_kernel() {
+        CHECK(ker_.create_kernel());
+        if (ker_tail_) CHECK(ker_tail_->create_kernel());
+        return status::success;
+    }
 
 private:
     const softmax_pd_t *pd_;
     jit_softmax_t<isa> ker_;
+    // kernel for the partial vector over inner dims
+    std::unique_ptr<jit_softmax_t<isa>> ker_tail_;
 };
 
 } // namespace softmax_impl
@@ -808,6 +943,7 @@ private:
 template struct jit_uni_softmax_fwd_t<sse41>;
 template struct jit_uni_softmax_fwd_t<avx2>;
 template struct jit_uni_softmax_fwd_t<avx512_common>;
+template struct jit_uni_softmax_bwd_t<avx2>;
 template struct jit_uni_softmax_bwd_t<avx512_common>;
 
 } // namespace x64
@@ -36,7 +36,17 @@ namespace x64 {
 namespace softmax_impl {
 template <cpu_isa_t isa>
 struct driver_t;
+
+// When the axis is neither the innermost dimension nor a blocked one, the
+// elements following the axis are contiguous, and the vector lanes hold
+// independent softmaxes over the strided axis.
+inline bool vectorize_inner(const memory_desc_wrapper &data_d, int axis) {
+    const auto &bd = data_d.blocking_desc();
+    for (int i = 0; i < bd.inner_nblks; i++)
+        if (bd.inner_idxs[i] == axis) return false;
+    return bd.strides[axis] != 1;
 }
+} // namespace softmax_impl
 
 template <cpu_isa_t isa>
 struct jit_uni_softmax_fwd_t : public primitive_t {
@@ -59,11 +69,16 @@ struct jit_uni_softmax_fwd_t : public primitive_t {
                 // It is fine to use float here as the kernel uses halfs of
                 // vector registers.
                 const auto blk_size = cpu_isa_traits<isa>::vlen / sizeof(float);
+                // 31 is a general limit, 2 is for unroll_regs_ = 4;
+                const size_t max_stride = (1LL << (31 - 2)) - 1;
+                // a strided axis, in a plain or a blocked layout, is
+                // processed by vectorizing over the inner dimensions
+                if (softmax_impl::vectorize_inner(src_d, axis()))
+                    return isa != sse41
+                            && sizeof(float) * bd.strides[axis()] < max_stride;
                 if (src_d.is_plain())
                     return bd.strides[axis()] == 1;
                 else {
-                    // 31 is a general limit, 2 is for unroll_regs_ = 4;
-                    const size_t max_stride = (1LL << (31 - 2)) - 1;
                     const int last_blk = bd.inner_nblks - 1;
                     return true && bd.inner_blks[last_blk] == blk_size
                             && bd.inner_idxs[last_blk] == axis()
@@ -124,11 +139,16 @@ struct jit_uni_softmax_bwd_t : public primitive_t {
                 // It is fine to use float here as the kernel uses halfs of
                 // vector registers.
                 const auto blk_size = cpu_isa_traits<isa>::vlen / sizeof(float);
+                // 31 is a general limit, 2 is for unroll_regs_ = 4;
+                const size_t max_stride = (1LL << (31 - 2)) - 1;
+                // a strided axis, in a plain or a blocked layout, is
+                // processed by vectorizing over the inner dimensions
+                if (softmax_impl::vectorize_inner(dst_d, axis()))
+                    return isa != sse41
+                            && sizeof(float) * bd.strides[axis()] < max_stride;
                 if (dst_d.is_plain())
                     return bd.strides[axis()] == 1;
                 else {
-                    // 31 is a general limit, 2 is for unroll_regs_ = 4;
-                    const size_t max_stride = (1LL << (31 - 2)) - 1;
                     const int last_blk = bd.inner_nblks - 1;
                     return true && bd.inner_blks[last_blk] == blk_size
                             && bd.inner_idxs[last_blk] == axis()
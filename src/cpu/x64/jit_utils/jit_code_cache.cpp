@@ -0,0 +1,245 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "common/utils.hpp"
+
+#include "cpu/platform.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
+#include "cpu/x64/jit_utils/jit_code_cache.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace jit_utils {
+namespace code_cache {
+
+namespace {
+
+const char cache_magic[8] = {'D', 'N', 'N', 'L', 'J', 'I', 'T', 'C'};
+const uint32_t cache_format_version = 1;
+// Sanity limit for the size of the code read from a file
+const uint64_t max_code_size = 64 * 1024 * 1024;
+
+struct header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t n_relocs;
+    uint64_t key_size;
+    uint64_t code_size;
+};
+
+const std::string &cache_dir() {
+    static const std::string dir = []() {
+        char buf[4096];
+        const int len = getenv("DNNL_JIT_CACHE_DIR", buf, sizeof(buf));
+        return len > 0 ? std::string(buf) : std::string();
+    }();
+    return dir;
+}
+
+// The generated code depends on the library version, on the instruction sets
+// available (and allowed by DNNL_MAX_CPU_ISA), and on the cache sizes some of
+// the kernels use for blocking.
+const std::string &fingerprint() {
+    static const std::string fp = []() {
+        const dnnl_version_t *v = dnnl_version();
+        std::string s = std::to_string(v->major) + "."
+                + std::to_string(v->minor) + "." + std::to_string(v->patch)
+                + ":" + v->hash + ":";
+        const cpu_isa_t isas[] = {sse41, avx, avx2, avx_vnni, avx512_common,
+                avx512_mic, avx512_mic_4ops, avx512_core, avx512_core_vnni,
+                avx512_core_bf16, amx_tile, amx_int8, amx_bf16};
+        for (auto isa : isas)
+            s += mayiuse(isa) ? '1' : '0';
+        for (int level = 1; level <= 3; level++)
+            s += ":" + std::to_string(platform::get_per_core_cache_size(level));
+        return s;
+    }();
+    return fp;
+}
+
+std::string full_key(const char *code_name, const std::string &key) {
+    std::string k(code_name);
+    k += '\0';
+    k += fingerprint();
+    k += '\0';
+    k += key;
+    return k;
+}
+
+std::string file_name(const std::string &full_key) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%016llx",
+            (unsigned long long)std::hash<std::string>()(full_key));
+    return cache_dir() + "/dnnl_jit_" + buf + ".bin";
+}
+
+bool read(FILE *fp, void *ptr, size_t size) {
+    return size == 0 || fread(ptr, size, 1, fp) == 1;
+}
+
+bool write(FILE *fp, const void *ptr, size_t size) {
+    return size == 0 || fwrite(ptr, size, 1, fp) == 1;
+}
+
+} // namespace
+
+bool is_enabled() {
+    return !cache_dir().empty();
+}
+
+bool load(const char *code_name, const std::string &key, entry_t &entry) {
+    if (!is_enabled()) return false;
+
+    const std::string fkey = full_key(code_name, key);
+    FILE *fp = fopen(file_name(fkey).c_str(), "rb");
+    if (!fp) return false;
+
+    auto validate = [&]() {
+        header_t h;
+        if (!read(fp, &h, sizeof(h))) return false;
+        if (memcmp(h.magic, cache_magic, sizeof(cache_magic)) != 0
+                || h.version != cache_format_version
+                || h.key_size != fkey.size() || h.code_size == 0
+                || h.code_size > max_code_size)
+            return false;
+
+        std::string k(fkey.size(), '\0');
+        if (!read(fp, &k[0], k.size()) || k != fkey) return false;
+
+        entry.relocs.resize(h.n_relocs);
+        for (auto &r : entry.relocs) {
+            if (!read(fp, &r.first, sizeof(r.first))
+                    || !read(fp, &r.second, sizeof(r.second)))
+                return false;
+            if (r.first + sizeof(uint64_t) > h.code_size
+                    || r.second > h.code_size)
+                return false;
+        }
+
+        entry.code.resize(h.code_size);
+        if (!read(fp, entry.code.data(), entry.code.size())) return false;
+
+        // Nothing is expected past the code
+        char c;
+        return fread(&c, 1, 1, fp) == 0;
+    };
+
+    const bool ok = validate();
+    fclose(fp);
+    return ok;
+}
+
+void store(const char *code_name, const std::string &key, const uint8_t *code,
+        size_t code_size, const std::vector<size_t> &relocs) {
+    if (!is_enabled() || code_size == 0) return;
+
+    const uint64_t base = reinterpret_cast<uint64_t>(code);
+    auto points_inside = [&](uint64_t v) {
+        return v >= base && v <= base + code_size;
+    };
+
+    std::vector<std::pair<uint64_t, uint64_t>> entry_relocs;
+    std::vector<bool> is_reloc(code_size, false);
+    for (size_t off : relocs) {
+        uint64_t v;
+        if (off + sizeof(v) > code_size) return;
+        memcpy(&v, code + off, sizeof(v));
+        if (!points_inside(v)) return;
+        entry_relocs.emplace_back(off, v - base);
+        is_reloc[off] = true;
+    }
+
+    // An address the generator did not record would point to the old
+    // location once the code is loaded, so such code is not cached. Any
+    // value that looks like an address is taken as one: this can only skip
+    // caching a kernel, never break it.
+    for (size_t off = 0; off + sizeof(uint64_t) <= code_size;) {
+        uint64_t v;
+        memcpy(&v, code + off, sizeof(v));
+        if (is_reloc[off])
+            off += sizeof(v);
+        else if (points_inside(v))
+            return;
+        else
+            off++;
+    }
+
+    const std::string fkey = full_key(code_name, key);
+    const std::string fname = file_name(fkey);
+
+    // Write to a temporary file and rename it, so that concurrent processes
+    // never observe a partially written entry
+    const size_t uniq = std::hash<std::thread::id>()(std::this_thread::get_id())
+            ^ (size_t)std::chrono::steady_clock::now()
+                      .time_since_epoch()
+                      .count();
+    const std::string tmp_fname = fname + "." + std::to_string(uniq) + ".tmp";
+
+    FILE *fp = fopen(tmp_fname.c_str(), "wb");
+    // Failure to store the code is not fatal
+    if (!fp) return;
+
+    header_t h;
+    memcpy(h.magic, cache_magic, sizeof(cache_magic));
+    h.version = cache_format_version;
+    h.n_relocs = (uint32_t)entry_relocs.size();
+    h.key_size = fkey.size();
+    h.code_size = code_size;
+
+    bool ok = write(fp, &h, sizeof(h)) && write(fp, fkey.data(), fkey.size());
+    for (const auto &r : entry_relocs)
+        ok = ok && write(fp, &r.first, sizeof(r.first))
+                && write(fp, &r.second, sizeof(r.second));
+    ok = ok && write(fp, code, code_size);
+    ok = (fclose(fp) == 0) && ok;
+
+    if (!ok || rename(tmp_fname.c_str(), fname.c_str()) != 0)
+        remove(tmp_fname.c_str());
+}
+
+bool append_post_ops_key(std::string &key, const post_ops_t &post_ops) {
+    append_key(key, post_ops.len());
+    for (int i = 0; i < post_ops.len(); i++) {
+        const auto &e = post_ops.entry_[i];
+        append_key(key, e.kind);
+        if (e.is_eltwise()) {
+            if (e.eltwise.alg == alg_kind::eltwise_pow) return false;
+            append_key(key, e.eltwise.alg, e.eltwise.scale, e.eltwise.alpha,
+                    e.eltwise.beta);
+        } else if (e.is_sum(false))
+            append_key(key, e.sum.scale, e.sum.dt);
+        else
+            return false;
+    }
+    return true;
+}
+
+} // namespace code_cache
+} // namespace jit_utils
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
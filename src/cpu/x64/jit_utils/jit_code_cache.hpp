@@ -0,0 +1,76 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UTILS_JIT_CODE_CACHE_HPP
+#define CPU_X64_JIT_UTILS_JIT_CODE_CACHE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/primitive_attr.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace jit_utils {
+
+// Persistent cache of generated kernels, enabled by setting the
+// DNNL_JIT_CACHE_DIR environment variable to an existing directory. Each
+// kernel is stored in a separate file together with its key, the library
+// version and the CPU features fingerprint, which are all validated on load.
+// A kernel that fails validation is regenerated and stored again.
+namespace code_cache {
+
+struct entry_t {
+    std::vector<uint8_t> code;
+    // 64-bit absolute addresses pointing inside the code (e.g. to constant
+    // tables referenced by labels): offsets of the values in the code and the
+    // offsets they point to, to be patched once the code is placed
+    std::vector<std::pair<uint64_t, uint64_t>> relocs;
+};
+
+bool is_enabled();
+
+bool load(const char *code_name, const std::string &key, entry_t &entry);
+// The relocations are the offsets of the absolute addresses pointing inside
+// the code, as recorded by the generator. The code is not stored if it holds
+// any other value that looks like such an address.
+void store(const char *code_name, const std::string &key, const uint8_t *code,
+        size_t code_size, const std::vector<size_t> &relocs);
+
+// Appends the bytes of the values to a key. The values must not have padding.
+inline void append_key(std::string &) {}
+template <typename T, typename... Ts>
+void append_key(std::string &key, const T &v, const Ts &... vs) {
+    key.append(reinterpret_cast<const char *>(&v), sizeof(v));
+    append_key(key, vs...);
+}
+
+// Appends the sum and eltwise post-ops to a key. Returns false if the
+// post-ops cannot be cached: other kinds are not keyed, and the eltwise pow
+// calls powf() by absolute address.
+bool append_post_ops_key(std::string &key, const post_ops_t &post_ops);
+
+} // namespace code_cache
+} // namespace jit_utils
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+#endif
@@ -0,0 +1,1217 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <xmmintrin.h>
+
+#include "common/bfloat16.hpp"
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/matmul/brgemm_decompress_matmul.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace matmul {
+
+using namespace dnnl::impl::data_type;
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+namespace brgemm_decompress_utils {
+
+int get_brg_kernel_index(const brgemm_decompress_matmul_conf_t &bgmmc,
+        bool is_init, bool is_M_tail, bool is_N_tail, bool is_K_tail) {
+    const dim_t vM = is_M_tail ? bgmmc.M_tail : bgmmc.M_blk;
+    const dim_t vN = is_N_tail ? bgmmc.N_tail : bgmmc.N_blk;
+    const dim_t vK = is_K_tail ? bgmmc.K_tail : bgmmc.K_blk;
+    if (vM == 0 || vN == 0 || vK == 0) return -1;
+    // The tail of the reduction dimension is the last block of it, which is
+    // never the first one
+    if (is_init && is_K_tail) return -1;
+    if (!is_init && bgmmc.nb_k == 1) return -1;
+
+    const int idx = 8 * (int)is_init + 4 * (int)is_M_tail + 2 * (int)is_N_tail
+            + (int)is_K_tail;
+    assert(idx < max_num_brg_kernels);
+    return idx;
+}
+
+} // namespace brgemm_decompress_utils
+
+void jit_brgemm_decompress_base_t::init_tail_masks(
+        reg64_t &reg_tmp, dim_t tail) {
+    mov(reg_tmp, (UINT64_C(1) << tail) - 1);
+    kmovw(k_tail, reg_tmp.cvt32());
+    mov(reg_tmp, (UINT64_C(1) << utils::div_up(tail, 2)) - 1);
+    kmovw(k_tail_4bit, reg_tmp.cvt32());
+}
+
+void jit_brgemm_decompress_base_t::init_4bit_consts(reg64_t &reg_tmp) {
+    mov_label_address(reg_tmp, idx_4bit_table_);
+    vmovups(zmm_idx_4bit, ptr[reg_tmp]);
+    mov(reg_tmp.cvt32(), 0xf);
+    vpbroadcastd(zmm_nibble_mask, reg_tmp.cvt32());
+    mov(reg_tmp.cvt32(), 0x8);
+    vpbroadcastd(zmm_sign_bit, reg_tmp.cvt32());
+}
+
+// The element i of a vector of 4-bit weights is in the low nibble of the byte
+// i / 2 when i is even and in the high one otherwise
+void jit_brgemm_decompress_base_t::load_weights(
+        const Xbyak::Zmm &zmm, reg64_t &reg_wei, dim_t idx, bool tail) {
+    const auto addr = ptr[reg_wei + wei_offset(idx)];
+    const auto zmm_load = tail ? zmm | k_tail | T_z : zmm;
+    switch (wei_dt_) {
+        case data_type::s8: vpmovsxbd(zmm_load, addr); break;
+        case data_type::u8: vpmovzxbd(zmm_load, addr); break;
+        case data_type::s4:
+        case data_type::u4: {
+            const Xbyak::Ymm ymm_bytes(zmm.getIdx());
+            vpmovzxbd(tail ? ymm_bytes | k_tail_4bit | T_z : ymm_bytes, addr);
+            vpsrld(zmm_tmp, zmm, 4);
+            vpandd(zmm, zmm, zmm_nibble_mask);
+            vpermt2d(zmm, zmm_idx_4bit, zmm_tmp);
+            if (wei_dt_ == data_type::s4) {
+                vpxord(zmm, zmm, zmm_sign_bit);
+                vpsubd(zmm, zmm, zmm_sign_bit);
+            }
+            break;
+        }
+        default: assert(!"unsupported weights data type");
+    }
+    vcvtdq2ps(zmm, zmm);
+}
+
+void jit_brgemm_decompress_base_t::emit_4bit_table() {
+    align(64);
+    L(idx_4bit_table_);
+    for (int i = 0; i < simd_w_ / 2; i++) {
+        dd(i);
+        dd(simd_w_ + i);
+    }
+}
+
+#define GET_OFF(field) offsetof(call_params_t, field)
+
+void jit_brgemm_decompress_kernel_t::load_row(
+        const Xbyak::Zmm &zmm, int row, dim_t col, bool tail) {
+    load_weights(zmm, reg_wei[row], col, tail);
+
+    const auto zmm_op = tail ? zmm | k_tail : zmm;
+    const dim_t offset = col * sizeof(float);
+    if (with_zero_points_)
+        vsubps(zmm_op, zmm, ptr[reg_zero_points[row] + offset]);
+    vmulps(zmm_op, zmm, ptr[reg_scales[row] + offset]);
+}
+
+void jit_brgemm_decompress_kernel_t::generate() {
+    const bool is_vnni = dst_dt_ == data_type::bf16;
+    const int nrows = is_vnni ? 2 : 1;
+    const dim_t tail = n_ % simd_w_;
+
+    preamble();
+
+    for (int row = 0; row < nrows; row++) {
+        mov(reg_wei[row], ptr[reg_param + GET_OFF(wei) + row * sizeof(void *)]);
+        mov(reg_scales[row],
+                ptr[reg_param + GET_OFF(scales) + row * sizeof(void *)]);
+        if (with_zero_points_)
+            mov(reg_zero_points[row],
+                    ptr[reg_param + GET_OFF(zero_points)
+                            + row * sizeof(void *)]);
+    }
+    mov(reg_dst, ptr[reg_param + GET_OFF(dst)]);
+
+    if (tail) {
+        init_tail_masks(reg_tmp, tail);
+        mov(reg_tmp, (UINT64_C(1) << (2 * tail)) - 1);
+        kmovd(k_tail_vnni, reg_tmp.cvt32());
+    }
+    if (is_4bit()) init_4bit_consts(reg_tmp);
+    if (is_vnni) {
+        mov_label_address(reg_tmp, idx_vnni_table_);
+        vmovups(zmm_idx_vnni, ptr[reg_tmp]);
+    }
+
+    for (dim_t col = 0; col < n_; col += simd_w_) {
+        const bool is_tail = n_ - col < simd_w_;
+        const Xbyak::Zmm zmm_row0(0), zmm_row1(1);
+        load_row(zmm_row0, 0, col, is_tail);
+        if (!is_vnni) {
+            const auto addr = ptr[reg_dst + col * sizeof(float)];
+            if (is_tail)
+                vmovups(addr | k_tail, zmm_row0);
+            else
+                vmovups(addr, zmm_row0);
+            continue;
+        }
+
+        // The elements of the two rows are interleaved after the conversion,
+        // which puts the first row in the lower half
+        load_row(zmm_row1, 1, col, is_tail);
+        vcvtne2ps2bf16(zmm_row0, zmm_row1, zmm_row0);
+        vpermw(zmm_row0, zmm_idx_vnni, zmm_row0);
+        const auto addr = ptr[reg_dst + 2 * col * sizeof(bfloat16_t)];
+        if (is_tail)
+            vmovdqu16(addr | k_tail_vnni, zmm_row0);
+        else
+            vmovdqu16(addr, zmm_row0);
+    }
+
+    postamble();
+
+    emit_4bit_table();
+    align(64);
+    L(idx_vnni_table_);
+    for (int i = 0; i < simd_w_; i++) {
+        dw(i);
+        dw(simd_w_ + i);
+    }
+}
+
+std::string jit_brgemm_decompress_kernel_t::persistent_cache_key() const {
+    std::string key;
+    jit_utils::code_cache::append_key(
+            key, wei_dt_, dst_dt_, with_zero_points_, n_);
+    return key;
+}
+
+jit_brgemm_decompress_fused_kernel_t::jit_brgemm_decompress_fused_kernel_t(
+        const brgemm_decompress_matmul_conf_t &bgmmc, dim_t m, dim_t n)
+    : jit_brgemm_decompress_base_t(bgmmc.wei_dt)
+    , is_wei_ba_(bgmmc.is_wei_ba)
+    , with_zero_points_(bgmmc.with_zero_points)
+    , with_src_sums_(bgmmc.with_src_sums)
+    , m_(m)
+    , n_(n)
+    , K_(bgmmc.K)
+    , N_(bgmmc.N)
+    , group_size_(bgmmc.k_group_size)
+    , ngroups_(bgmmc.nk_groups) {}
+
+// The rows of a group are multiplied by the elements of the source broadcast
+// to vectors
+void jit_brgemm_decompress_fused_kernel_t::generate_ab() {
+    const int nv = (int)utils::div_up(n_, simd_w_);
+    const int mb = (int)m_;
+    assert(mb * nv + nv <= max_vregs);
+    const bool has_tail = n_ % simd_w_ != 0;
+    const dim_t row_bytes = wei_offset(N_);
+    const int unroll = group_size_ % 4 == 0 ? 4 : group_size_ % 2 == 0 ? 2 : 1;
+    // The rows of a block are in different pages, which the hardware
+    // prefetchers do not follow. The lines of the next block of the columns
+    // are prefetched along the rows instead, from the pages in use.
+    const dim_t block_bytes = wei_offset(nv * simd_w_);
+    const dim_t prefetch_offset = nstl::max(block_bytes, (dim_t)64);
+    const int nlines = (int)utils::div_up(block_bytes, 64);
+
+    auto zmm_acc = [&](int i, int v) { return Xbyak::Zmm(i * nv + v); };
+    auto zmm_wei = [&](int v) { return Xbyak::Zmm(mb * nv + v); };
+    auto is_tail = [&](int v) { return has_tail && v == nv - 1; };
+
+    auto compute_row = [&](int r) {
+        for (int v = 0; v < nv; v++)
+            load_weights(zmm_wei(v), reg_wei, r * N_ + v * simd_w_, is_tail(v));
+        for (int l = 0; l < nlines; l++)
+            prefetcht0(ptr[reg_wei + r * row_bytes + prefetch_offset + l * 64]);
+        for (int i = 0; i < mb; i++) {
+            const size_t offset = (i * K_ + r) * sizeof(float);
+            if (nv == 1) {
+                vfmadd231ps(zmm_acc(i, 0), zmm_wei(0), ptr_b[reg_src + offset]);
+                continue;
+            }
+            vbroadcastss(zmm_aux, ptr[reg_src + offset]);
+            for (int v = 0; v < nv; v++)
+                vfmadd231ps(zmm_acc(i, v), zmm_wei(v), zmm_aux);
+        }
+    };
+
+    for_(int i = 0; i < mb; i++)
+    for (int v = 0; v < nv; v++)
+        vpxord(zmm_acc(i, v), zmm_acc(i, v), zmm_acc(i, v));
+
+    Xbyak::Label group_loop;
+    L(group_loop);
+    {
+        Xbyak::Label row_loop;
+        mov(reg_k, group_size_ / unroll);
+        L(row_loop);
+        {
+            for (int r = 0; r < unroll; r++)
+                compute_row(r);
+            add(reg_wei, unroll * row_bytes);
+            add(reg_src, unroll * sizeof(float));
+            dec(reg_k);
+            jnz(row_loop, T_NEAR);
+        }
+
+        for (int v = 0; v < nv; v++) {
+            const auto mask = [&](const Xbyak::Zmm &zmm) {
+                return is_tail(v) ? zmm | k_tail | T_z : zmm;
+            };
+            const Xbyak::Zmm zmm_scales = zmm_wei(v);
+            const size_t offset = v * simd_w_ * sizeof(float);
+            vmovups(mask(zmm_scales), ptr[reg_scales + offset]);
+            if (with_zero_points_)
+                vmovups(mask(zmm_tmp), ptr[reg_zero_points + offset]);
+            for (int i = 0; i < mb; i++) {
+                const Xbyak::Zmm zmm = zmm_acc(i, v);
+                if (with_zero_points_)
+                    vfnmadd231ps(zmm, zmm_tmp,
+                            ptr_b[reg_src_sums
+                                    + i * ngroups_ * sizeof(float)]);
+                const auto addr
+                        = ptr[reg_dst + (i * N_ + v * simd_w_) * sizeof(float)];
+                vmovups(mask(zmm_aux), addr);
+                vfmadd231ps(zmm_aux, zmm, zmm_scales);
+                vmovups(is_tail(v) ? addr | k_tail : addr, zmm_aux);
+                vpxord(zmm, zmm, zmm);
+            }
+        }
+        add(reg_scales, N_ * sizeof(float));
+        if (with_zero_points_) {
+            add(reg_zero_points, N_ * sizeof(float));
+            add(reg_src_sums, sizeof(float));
+        }
+        dec(reg_group);
+        jnz(group_loop, T_NEAR);
+    }
+}
+
+// With src_sums, the products of a group are accumulated by lanes apart, the
+// zero points are subtracted from the first lane only, then the lanes are
+// scaled to the accumulators. With a single group, they are scaled in place.
+// Otherwise, the products of all the groups are accumulated by lanes with the
+// weights shifted and scaled. The lanes are reduced and added to the
+// destination at the end.
+void jit_brgemm_decompress_fused_kernel_t::generate_ba() {
+    const int nn = (int)n_;
+    const int mb = (int)m_;
+    const bool is_single_group = ngroups_ == 1;
+    const int nacc = with_src_sums_ && !is_single_group ? 2 : 1;
+    assert(nacc * mb * nn + nn <= max_vregs);
+    const dim_t nvecs = group_size_ / simd_w_;
+    const dim_t tail = group_size_ % simd_w_;
+    const dim_t col_bytes = wei_offset(K_);
+
+    auto zmm_acc = [&](int i, int j) { return Xbyak::Zmm(i * nn + j); };
+    auto zmm_group = [&](int i, int j) {
+        return Xbyak::Zmm((nacc - 1) * mb * nn + i * nn + j);
+    };
+    auto zmm_wei = [&](int j) { return Xbyak::Zmm(nacc * mb * nn + j); };
+
+    // The columns of the next block are prefetched along the ones in use. The
+    // tail of the source is loaded with a mask so that the last row is not
+    // read past its end, the products of its other lanes are zeros.
+    auto compute_vec = [&](bool is_tail) {
+        for (int j = 0; j < nn; j++) {
+            const Xbyak::Zmm zmm = zmm_wei(j);
+            load_weights(zmm, reg_wei, j * K_, is_tail);
+            prefetcht0(ptr[reg_wei + (nn + j) * col_bytes]);
+            if (with_src_sums_) continue;
+            if (with_zero_points_)
+                vsubps(zmm, zmm, ptr_b[reg_zero_points + j * sizeof(float)]);
+            vmulps(zmm, zmm, ptr_b[reg_scales + j * sizeof(float)]);
+        }
+        for (int i = 0; i < mb; i++) {
+            const auto addr = ptr[reg_src + i * K_ * sizeof(float)];
+            vmovups(is_tail ? zmm_aux | k_tail | T_z : zmm_aux, addr);
+            for (int j = 0; j < nn; j++)
+                vfmadd231ps(zmm_group(i, j), zmm_wei(j), zmm_aux);
+        }
+    };
+
+    for_(int i = 0; i < mb; i++)
+    for (int j = 0; j < nn; j++) {
+        vpxord(zmm_acc(i, j), zmm_acc(i, j), zmm_acc(i, j));
+        vpxord(zmm_group(i, j), zmm_group(i, j), zmm_group(i, j));
+    }
+
+    Xbyak::Label group_loop;
+    L(group_loop);
+    {
+        if (nvecs > 0) {
+            Xbyak::Label vec_loop;
+            mov(reg_k, nvecs);
+            L(vec_loop);
+            {
+                compute_vec(false);
+                add(reg_wei, wei_offset(simd_w_));
+                add(reg_src, simd_w_ * sizeof(float));
+                dec(reg_k);
+                jnz(vec_loop, T_NEAR);
+            }
+        }
+        if (tail > 0) {
+            compute_vec(true);
+            add(reg_wei, wei_offset(tail));
+            add(reg_src, tail * sizeof(float));
+        }
+
+        for (int j = 0; j < nn && with_src_sums_; j++) {
+            if (with_zero_points_)
+                vbroadcastss(zmm_tmp, ptr[reg_zero_points + j * sizeof(float)]);
+            for (int i = 0; i < mb; i++) {
+                const Xbyak::Zmm zmm = zmm_group(i, j);
+                const auto scale = ptr_b[reg_scales + j * sizeof(float)];
+                if (with_zero_points_)
+                    vfnmadd231ps(zmm | k_lane0, zmm_tmp,
+                            ptr_b[reg_src_sums
+                                    + i * ngroups_ * sizeof(float)]);
+                if (is_single_group) {
+                    vmulps(zmm, zmm, scale);
+                    continue;
+                }
+                vfmadd231ps(zmm_acc(i, j), zmm, scale);
+                vpxord(zmm, zmm, zmm);
+            }
+        }
+        add(reg_scales, N_ * sizeof(float));
+        if (with_zero_points_) add(reg_zero_points, N_ * sizeof(float));
+        if (with_zero_points_ && with_src_sums_)
+            add(reg_src_sums, sizeof(float));
+        dec(reg_group);
+        jnz(group_loop, T_NEAR);
+    }
+
+    const Xbyak::Ymm ymm_tmp(zmm_tmp.getIdx());
+    const Xbyak::Xmm xmm_tmp(zmm_tmp.getIdx());
+    for_(int i = 0; i < mb; i++)
+    for (int j = 0; j < nn; j++) {
+        const Xbyak::Zmm zmm = zmm_acc(i, j);
+        const Xbyak::Ymm ymm(zmm.getIdx());
+        const Xbyak::Xmm xmm(zmm.getIdx());
+        const auto addr = ptr[reg_dst + (i * N_ + j) * sizeof(float)];
+        vextractf64x4(ymm_tmp, zmm, 1);
+        vaddps(ymm, ymm, ymm_tmp);
+        vextractf32x4(xmm_tmp, ymm, 1);
+        vaddps(xmm, xmm, xmm_tmp);
+        vpermilps(xmm_tmp, xmm, 0x4e);
+        vaddps(xmm, xmm, xmm_tmp);
+        vpermilps(xmm_tmp, xmm, 0xb1);
+        vaddps(xmm, xmm, xmm_tmp);
+        vaddss(xmm, xmm, addr);
+        vmovss(addr, xmm);
+    }
+}
+
+void jit_brgemm_decompress_fused_kernel_t::generate() {
+    preamble();
+
+    mov(reg_src, ptr[reg_param + GET_OFF(src)]);
+    mov(reg_wei, ptr[reg_param + GET_OFF(wei)]);
+    mov(reg_scales, ptr[reg_param + GET_OFF(scales)]);
+    if (with_zero_points_) {
+        mov(reg_zero_points, ptr[reg_param + GET_OFF(zero_points)]);
+        mov(reg_src_sums, ptr[reg_param + GET_OFF(src_sums)]);
+    }
+    mov(reg_dst, ptr[reg_param + GET_OFF(dst)]);
+    mov(reg_group, ptr[reg_param + GET_OFF(ngroups)]);
+
+    // The tail is along the columns in the ab layout and along the groups in
+    // the ba one
+    const dim_t tail = (is_wei_ba_ ? group_size_ : n_) % simd_w_;
+    if (tail) init_tail_masks(reg_tmp, tail);
+    if (is_4bit()) init_4bit_consts(reg_tmp);
+    if (is_wei_ba_ && with_src_sums_ && with_zero_points_) {
+        mov(reg_tmp.cvt32(), 1);
+        kmovw(k_lane0, reg_tmp.cvt32());
+    }
+
+    if (is_wei_ba_)
+        generate_ba();
+    else
+        generate_ab();
+
+    postamble();
+
+    emit_4bit_table();
+}
+
+std::string jit_brgemm_decompress_fused_kernel_t::persistent_cache_key() const {
+    std::string key;
+    jit_utils::code_cache::append_key(key, wei_dt_, is_wei_ba_,
+            with_zero_points_, with_src_sums_, m_, n_, K_, N_, group_size_,
+            ngroups_);
+    return key;
+}
+
+#undef GET_OFF
+
+namespace {
+
+// The decompression converts the blocks of the weights through buffers on the
+// stack sized for at most max_N_blk columns
+constexpr dim_t max_N_blk = 64;
+
+// The weights are decompressed in the registers of the kernel that multiplies
+// them for at most max_fused_M rows of the source. Past them, the weights in
+// the ba layout are read slower than the dense ones.
+constexpr dim_t max_fused_M_ab = 32, max_fused_M_ba = 16;
+
+// The decompression of the weights to a buffer of bf16 is amortized over at
+// least min_buffer_M_bf16 rows of the source
+constexpr dim_t min_buffer_M_bf16 = 128;
+
+// In the ab layout, each row of a block is in its own page, so the reduction
+// dimension is split by chunks of at most max_K_chunk rows that are multiplied
+// by all the blocks of the columns in turn. In the ba layout, the columns are
+// read whole instead, which the hardware prefetchers follow.
+constexpr dim_t max_K_chunk = 64, min_K_chunk = 16;
+
+constexpr dim_t max_M_src_sums_ba = 4, max_M_blk_ba = 8;
+
+// Number of f32 elements in a vector register
+constexpr dim_t simd_w = 16;
+
+template <data_type_t wei_type>
+float load_weight(const uint8_t *weights, dim_t idx);
+
+template <>
+float load_weight<s8>(const uint8_t *weights, dim_t idx) {
+    return (float)reinterpret_cast<const int8_t *>(weights)[idx];
+}
+
+template <>
+float load_weight<u8>(const uint8_t *weights, dim_t idx) {
+    return (float)weights[idx];
+}
+
+template <data_type_t wei_type>
+int nibble_value(int v);
+
+template <>
+int nibble_value<u4>(int v) {
+    return v;
+}
+
+template <>
+int nibble_value<s4>(int v) {
+    return v - ((v & 0x8) << 1);
+}
+
+// The element idx is in the low nibble of the byte idx / 2 when idx is even
+// and in the high one otherwise
+template <>
+float load_weight<u4>(const uint8_t *weights, dim_t idx) {
+    const int v = (weights[idx >> 1] >> ((idx & 1) * 4)) & 0xf;
+    return (float)nibble_value<u4>(v);
+}
+
+template <>
+float load_weight<s4>(const uint8_t *weights, dim_t idx) {
+    const int v = (weights[idx >> 1] >> ((idx & 1) * 4)) & 0xf;
+    return (float)nibble_value<s4>(v);
+}
+
+// Converts the n consecutive weights starting at the element idx to f32
+template <data_type_t wei_type>
+void load_weights(const uint8_t *weights, dim_t idx, dim_t n, float *out) {
+    PRAGMA_OMP_SIMD()
+    for (dim_t i = 0; i < n; i++)
+        out[i] = load_weight<wei_type>(weights, idx + i);
+}
+
+// The 4-bit weights are converted by bytes, i.e. by pairs, so that the loop
+// vectorizes. An element sharing its byte with an element out of the range
+// is converted on its own.
+template <data_type_t wei_type>
+void load_weights_4bit(
+        const uint8_t *weights, dim_t idx, dim_t n, float *out) {
+    dim_t i = 0;
+    if (n > 0 && idx % 2 != 0) {
+        out[0] = load_weight<wei_type>(weights, idx);
+        i = 1;
+    }
+    const uint8_t *w = weights + (idx + i) / 2;
+    float *o = out + i;
+    const dim_t npairs = (n - i) / 2;
+    PRAGMA_OMP_SIMD()
+    for (dim_t p = 0; p < npairs; p++) {
+        o[2 * p] = (float)nibble_value<wei_type>(w[p] & 0xf);
+        o[2 * p + 1] = (float)nibble_value<wei_type>(w[p] >> 4);
+    }
+    if ((n - i) % 2 != 0)
+        out[n - 1] = load_weight<wei_type>(weights, idx + n - 1);
+}
+
+template <>
+void load_weights<s4>(const uint8_t *weights, dim_t idx, dim_t n, float *out) {
+    load_weights_4bit<s4>(weights, idx, n, out);
+}
+
+template <>
+void load_weights<u4>(const uint8_t *weights, dim_t idx, dim_t n, float *out) {
+    load_weights_4bit<u4>(weights, idx, n, out);
+}
+
+// The decompressed row kb of the block goes to the buffer directly for f32.
+// For bf16, the pairs of rows are interleaved in f32 first and converted
+// together to the VNNI layout.
+float *row_ptr(float *buf, dim_t LDB, dim_t kb, float *vnni_rows) {
+    return buf + kb * LDB;
+}
+
+float *row_ptr(bfloat16_t *buf, dim_t LDB, dim_t kb, float *vnni_rows) {
+    return vnni_rows;
+}
+
+void store_vnni_rows(float *buf, dim_t LDB, dim_t kb, dim_t vN,
+        const float *vnni_rows) {}
+
+void store_vnni_rows(bfloat16_t *buf, dim_t LDB, dim_t kb, dim_t vN,
+        const float *vnni_rows) {
+    cvt_float_to_bfloat16(buf + (kb / 2) * LDB * 2, vnni_rows, 2 * vN);
+}
+
+// Decompresses the vK x vN block of the weights at (k, n) to the layout
+// expected by brgemm: [K_blk][N_blk] for f32 and [K_blk / 2][N_blk][2] for
+// bf16, the odd tail of the reduction dimension is padded with zeros.
+//
+// The rows are decompressed by the kernel if there is one. Otherwise, the
+// weights are converted to f32 by tiles of rows first, reading them along their
+// dense dimension, then the rows are scaled, by pairs for bf16. The lines of
+// the next tile are prefetched: each row or column of a block is in its own
+// page, which the hardware prefetchers do not follow.
+template <data_type_t wei_type, typename out_t>
+void decompress_block(const brgemm_decompress_matmul_conf_t &bgmmc,
+        const jit_brgemm_decompress_kernel_t *ker, const uint8_t *weights,
+        const float *scales, const float *zero_points, dim_t k, dim_t n,
+        dim_t vK, dim_t vN, out_t *buf) {
+    constexpr int vnni_granularity = sizeof(out_t) == 2 ? 2 : 1;
+    // Even, so that the pairs of rows never span two tiles
+    constexpr dim_t tile_K = 16;
+    constexpr bool is_4bit = utils::one_of(wei_type, s4, u4);
+    const dim_t sk = bgmmc.wei_k_stride;
+    const dim_t sn = bgmmc.wei_n_stride;
+    assert(vN <= max_N_blk);
+
+    static const float zeros[max_N_blk] = {};
+
+    auto prefetch = [&](dim_t idx) {
+        _mm_prefetch(reinterpret_cast<const char *>(
+                             weights + (is_4bit ? idx / 2 : idx)),
+                _MM_HINT_T0);
+    };
+
+    if (ker) {
+        assert(sn == 1);
+        jit_brgemm_decompress_kernel_t::call_params_t p;
+        for (dim_t kk = 0; kk < vK; kk += vnni_granularity) {
+            if (kk % tile_K == 0)
+                for (dim_t kp = kk + tile_K;
+                        kp < nstl::min(kk + 2 * tile_K, vK); kp++)
+                    prefetch((k + kp) * sk + n);
+            for (int i = 0; i < vnni_granularity; i++) {
+                // The missing row of the odd tail is scaled to zeros
+                if (kk + i == vK) {
+                    p.wei[i] = p.wei[0];
+                    p.scales[i] = p.zero_points[i] = zeros;
+                    continue;
+                }
+                const dim_t idx = (k + kk + i) * sk + n;
+                const dim_t g = bgmmc.group_size
+                        ? (k + kk + i) / bgmmc.group_size
+                        : 0;
+                p.wei[i] = weights + (is_4bit ? idx / 2 : idx);
+                p.scales[i] = scales + g * bgmmc.N + n;
+                p.zero_points[i] = zero_points
+                        ? zero_points + g * bgmmc.N + n
+                        : nullptr;
+            }
+            p.dst = buf + kk * bgmmc.LDB;
+            (*ker)(&p);
+        }
+        return;
+    }
+
+    float tile[tile_K][max_N_blk];
+    float vnni_rows[2 * max_N_blk];
+
+    for (dim_t k0 = 0; k0 < vK; k0 += tile_K) {
+        const dim_t tK = nstl::min(tile_K, vK - k0);
+        const bool has_next_tile = k0 + tK < vK;
+        if (sn == 1) {
+            if (has_next_tile)
+                for (dim_t kk = 0; kk < nstl::min(tile_K, vK - k0 - tK); kk++)
+                    prefetch((k + k0 + tK + kk) * sk + n);
+            for (dim_t kk = 0; kk < tK; kk++)
+                load_weights<wei_type>(
+                        weights, (k + k0 + kk) * sk + n, vN, tile[kk]);
+        } else {
+            float col[tile_K];
+            for (dim_t nn = 0; nn < vN; nn++) {
+                const dim_t idx = (n + nn) * sn + (k + k0) * sk;
+                if (has_next_tile) prefetch(idx + tK * sk);
+                load_weights<wei_type>(weights, idx, tK, col);
+                for (dim_t kk = 0; kk < tK; kk++)
+                    tile[kk][nn] = col[kk];
+            }
+        }
+
+        // The missing row of the odd tail is a row of zeros
+        auto row = [&](dim_t kk, const float *&w, const float *&sc,
+                           const float *&zp) {
+            if (kk >= tK) {
+                w = sc = zp = zeros;
+                return;
+            }
+            const dim_t g
+                    = bgmmc.group_size ? (k + k0 + kk) / bgmmc.group_size : 0;
+            w = tile[kk];
+            sc = scales + g * bgmmc.N + n;
+            zp = zero_points ? zero_points + g * bgmmc.N + n : zeros;
+        };
+
+        for (dim_t kk = 0; kk < tK; kk += vnni_granularity) {
+            const dim_t kb = k0 + kk;
+            const float *w0, *sc0, *zp0;
+            row(kk, w0, sc0, zp0);
+            if (vnni_granularity == 1) {
+                float *b = row_ptr(buf, bgmmc.LDB, kb, vnni_rows);
+                PRAGMA_OMP_SIMD()
+                for (dim_t nn = 0; nn < vN; nn++)
+                    b[nn] = sc0[nn] * (w0[nn] - zp0[nn]);
+                continue;
+            }
+
+            const float *w1, *sc1, *zp1;
+            row(kk + 1, w1, sc1, zp1);
+            PRAGMA_OMP_SIMD()
+            for (dim_t nn = 0; nn < vN; nn++) {
+                vnni_rows[2 * nn] = sc0[nn] * (w0[nn] - zp0[nn]);
+                vnni_rows[2 * nn + 1] = sc1[nn] * (w1[nn] - zp1[nn]);
+            }
+            store_vnni_rows(buf, bgmmc.LDB, kb, vN, vnni_rows);
+        }
+    }
+}
+
+} // namespace
+
+template <cpu_isa_t isa, data_type_t src_type, data_type_t dst_type>
+status_t brgemm_decompress_matmul_t<isa, src_type, dst_type>::pd_t::init(
+        engine_t *engine) {
+    using smask_t = primitive_attr_t::skip_mask_t;
+
+    auto check_bias = [&]() -> bool {
+        if (!with_bias()) return true;
+        const auto bia_dt = weights_md(1)->data_type;
+        const bool bia_dt_ok = src_type == bf16
+                ? one_of(bia_dt, f32, bf16)
+                : bia_dt == f32;
+        return bia_dt_ok && is_bias_1xN();
+    };
+
+    const auto &wd = attr()->weights_decompression_;
+    bool ok = mayiuse(isa) && src_md()->data_type == src_type
+            && one_of(weights_md()->data_type, s8, u8, s4, u4)
+            && dst_md()->data_type == dst_type
+            && desc()->accum_data_type == f32 && check_bias()
+            && attr()->has_default_values(
+                    smask_t::post_ops | smask_t::weights_decompression,
+                    dst_type)
+            && wd.enabled_ && brgemm_post_ops_ok(attr()->post_ops_, false)
+            && IMPLICATION(wd.group_size_ > 0, K() % wd.group_size_ == 0)
+            && ndims() == 2 && !has_runtime_dims_or_strides()
+            && !has_zero_dim_memory();
+    if (!ok) return status::unimplemented;
+
+    CHECK(init_conf());
+
+    if (bgmmc_.use_fused_kernel) {
+        init_scratchpad();
+        return status::success;
+    }
+
+    const float alpha = 1.0;
+    for_(int i_init = 0; i_init < 2; i_init++)
+    for_(int i_M = 0; i_M < 2; i_M++)
+    for_(int i_N = 0; i_N < 2; i_N++)
+    for (int i_K = 0; i_K < 2; i_K++) {
+        const int idx = brgemm_decompress_utils::get_brg_kernel_index(
+                bgmmc_, i_init, i_M, i_N, i_K);
+        if (idx < 0) continue;
+
+        const dim_t vM = i_M ? bgmmc_.M_tail : bgmmc_.M_blk;
+        const dim_t vN = i_N ? bgmmc_.N_tail : bgmmc_.N_blk;
+        const dim_t vK = i_K ? bgmmc_.K_tail : bgmmc_.K_blk;
+        const float beta = i_init ? 0.0 : 1.0;
+
+        // Matrix B is the decompressed block of the weights, so it has the
+        // data type of the source
+        brgemm_t &brg = brg_descs_[idx];
+        CHECK(brgemm_desc_init(&brg, isa, brgemm_addr, src_type, src_type,
+                false, false, brgemm_row_major, alpha, beta, bgmmc_.LDA,
+                bgmmc_.LDB, bgmmc_.LDC, vM, vN, vK));
+        CHECK(brgemm_desc_add_postops(
+                &brg, attr(), dst_type, (int)bgmmc_.LDD, bgmmc_.bia_dt));
+    }
+
+    init_scratchpad();
+
+    return status::success;
+}
+
+template <cpu_isa_t isa, data_type_t src_type, data_type_t dst_type>
+status_t
+brgemm_decompress_matmul_t<isa, src_type, dst_type>::pd_t::init_conf() {
+    using namespace format_tag;
+
+    auto &bgmmc = bgmmc_;
+    const auto &wd = attr()->weights_decompression_;
+    const auto &p = attr()->post_ops_;
+
+    if (src_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(src_md_, ab));
+    if (weights_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(weights_md_, ab));
+    if (dst_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(dst_md_, ab));
+    if (with_bias() && bias_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(bias_md_, ab));
+    // The weights are accepted both in the layout of matmul and in the one
+    // of inner product, i.e. with the reduction dimension dense
+    const bool is_wei_ba = memory_desc_matches_tag(weights_md_, ba);
+    if (!memory_desc_matches_tag(src_md_, ab)
+            || !memory_desc_matches_tag(dst_md_, ab)
+            || !(is_wei_ba || memory_desc_matches_tag(weights_md_, ab))
+            || !IMPLICATION(
+                    with_bias(), memory_desc_matches_tag(bias_md_, ab)))
+        return status::unimplemented;
+
+    bgmmc.isa = isa;
+    bgmmc.M = M();
+    bgmmc.N = N();
+    bgmmc.K = K();
+    bgmmc.src_dt = src_type;
+    bgmmc.wei_dt = weights_md_.data_type;
+    bgmmc.dst_dt = dst_type;
+    bgmmc.acc_dt = f32;
+    bgmmc.with_bias = with_bias();
+    bgmmc.bia_dt = bgmmc.with_bias ? bias_md_.data_type : data_type::undef;
+    bgmmc.with_sum = p.find(primitive_kind::sum) != -1;
+    bgmmc.with_eltwise = p.find(primitive_kind::eltwise) != -1;
+    bgmmc.with_zero_points = wd.with_zero_points_;
+    bgmmc.group_size = wd.group_size_;
+
+    bgmmc.is_wei_ba = is_wei_ba;
+    bgmmc.wei_k_stride = is_wei_ba ? 1 : bgmmc.N;
+    bgmmc.wei_n_stride = is_wei_ba ? bgmmc.K : 1;
+    bgmmc.ngroups = bgmmc.group_size > 0 ? bgmmc.K / bgmmc.group_size : 1;
+    // With an even N, N_blk is even too, so the rows of a block of the 4-bit
+    // weights start on a byte
+    bgmmc.use_decompress_kernel = !is_wei_ba
+            && IMPLICATION(one_of(bgmmc.wei_dt, s4, u4), bgmmc.N % 2 == 0);
+
+    bgmmc.use_buffer = bgmmc.dst_dt != bgmmc.acc_dt || bgmmc.with_sum;
+    bgmmc.nthr = dnnl_get_max_threads();
+
+    // The vectors of the 4-bit weights start on a byte: the rows in the ab
+    // layout and the groups of the columns in the ba one
+    const bool is_4bit = one_of(bgmmc.wei_dt, s4, u4);
+    const dim_t group_size = bgmmc.K / bgmmc.ngroups;
+    bgmmc.use_fused_kernel
+            = bgmmc.M <= (is_wei_ba ? max_fused_M_ba : max_fused_M_ab)
+            && IMPLICATION(is_4bit,
+                    is_wei_ba ? group_size % 2 == 0 : bgmmc.N % 2 == 0);
+    if (bgmmc.use_fused_kernel) {
+        bgmmc.k_group_size = group_size;
+        if (!is_wei_ba && group_size > max_K_chunk) {
+            for (dim_t d = max_K_chunk; d >= min_K_chunk; d--)
+                if (group_size % d == 0) {
+                    bgmmc.k_group_size = d;
+                    break;
+                }
+        }
+        bgmmc.nk_groups = bgmmc.K / bgmmc.k_group_size;
+        // A group of the scales that is split is a chunk of its own
+        bgmmc.k_chunk_groups = bgmmc.nk_groups;
+        if (!is_wei_ba)
+            bgmmc.k_chunk_groups = bgmmc.k_group_size < group_size
+                    ? 1
+                    : nstl::max((dim_t)1, max_K_chunk / bgmmc.k_group_size);
+        bgmmc.with_src_sums = !is_wei_ba || bgmmc.M <= max_M_src_sums_ba;
+
+        // The rows of the source are split evenly by blocks that fit the
+        // registers of the kernel, along with as many columns as fit next to
+        // them. In the ba layout, the sums of the groups are accumulated apart
+        // with src_sums, and the blocks are kept small enough for a few
+        // columns to share the rows.
+        const int max_vregs = jit_brgemm_decompress_fused_kernel_t::max_vregs;
+        const bool with_group_acc
+                = is_wei_ba && bgmmc.with_src_sums && bgmmc.nk_groups > 1;
+        const int nacc = with_group_acc ? 2 : 1;
+        const dim_t max_M_blk = is_wei_ba
+                ? nstl::min(max_M_blk_ba, (dim_t)(max_vregs - 1) / nacc)
+                : max_vregs - 1;
+        bgmmc.nb_m = div_up(bgmmc.M, max_M_blk);
+        bgmmc.M_blk = div_up(bgmmc.M, bgmmc.nb_m);
+        const dim_t max_n = nstl::min(
+                (dim_t)8, max_vregs / (nacc * bgmmc.M_blk + 1));
+        bgmmc.N_blk = nstl::min(bgmmc.N, is_wei_ba ? max_n : max_n * simd_w);
+        bgmmc.nb_n = div_up(bgmmc.N, bgmmc.N_blk);
+        bgmmc.M_tail = bgmmc.M % bgmmc.M_blk;
+        bgmmc.N_tail = bgmmc.N % bgmmc.N_blk;
+        return status::success;
+    }
+
+    // The weights in the ba layout are decompressed without the kernel,
+    // slower than the dense ones are multiplied
+    if (is_wei_ba || (src_type == bf16 && bgmmc.M < min_buffer_M_bf16))
+        return status::unimplemented;
+
+    // A block of the decompressed weights fits L2 along with the rows of the
+    // source it is multiplied by
+    const dim_t max_M_blk = 64, max_K_blk = 256;
+    bgmmc.M_blk = nstl::min(bgmmc.M, max_M_blk);
+    bgmmc.N_blk = nstl::min(bgmmc.N, max_N_blk);
+    bgmmc.K_blk = nstl::min(bgmmc.K, max_K_blk);
+    bgmmc.nb_m = div_up(bgmmc.M, bgmmc.M_blk);
+    bgmmc.nb_n = div_up(bgmmc.N, bgmmc.N_blk);
+    bgmmc.nb_k = div_up(bgmmc.K, bgmmc.K_blk);
+    bgmmc.M_tail = bgmmc.M % bgmmc.M_blk;
+    bgmmc.N_tail = bgmmc.N % bgmmc.N_blk;
+    bgmmc.K_tail = bgmmc.K % bgmmc.K_blk;
+    bgmmc.M_chunk_size = nstl::min(bgmmc.nb_m, (dim_t)4);
+    bgmmc.nb_m_chunks = div_up(bgmmc.nb_m, bgmmc.M_chunk_size);
+
+    bgmmc.LDA = bgmmc.K;
+    bgmmc.LDB = bgmmc.N_blk;
+    bgmmc.LDD = bgmmc.N;
+    bgmmc.LDC = bgmmc.use_buffer ? bgmmc.N_blk : bgmmc.LDD;
+
+    return status::success;
+}
+
+template <cpu_isa_t isa, data_type_t src_type, data_type_t dst_type>
+void brgemm_decompress_matmul_t<isa, src_type,
+        dst_type>::pd_t::init_scratchpad() {
+    const auto &bgmmc = bgmmc_;
+    auto scratchpad = scratchpad_registry().registrar();
+
+    if (bgmmc.use_fused_kernel) {
+        const size_t sizeof_f32 = types::data_type_size(f32);
+        if (bgmmc.src_dt != f32)
+            scratchpad.book(key_brgemm_primitive_buffer_a,
+                    (size_t)bgmmc.M * bgmmc.K, sizeof_f32);
+        if (bgmmc.with_zero_points && bgmmc.with_src_sums)
+            scratchpad.book(key_brgemm_primitive_buffer,
+                    (size_t)bgmmc.M * bgmmc.nk_groups, sizeof_f32);
+        if (bgmmc.use_buffer)
+            scratchpad.book(key_matmul_dst_in_acc_dt,
+                    (size_t)bgmmc.M * bgmmc.N, sizeof_f32);
+        return;
+    }
+
+    const size_t n_addr = (size_t)bgmmc.nthr;
+    scratchpad.book(key_brgemm_primitive_addr_a, n_addr, sizeof(void *), 64);
+    scratchpad.book(key_brgemm_primitive_addr_b, n_addr, sizeof(void *), 64);
+
+    // The reduction dimension of a block is rounded up for the VNNI layout
+    const size_t b_nelems = (size_t)bgmmc.nthr
+            * rnd_up(bgmmc.K_blk, 2) * bgmmc.LDB;
+    scratchpad.book(key_brgemm_primitive_buffer_b, b_nelems,
+            types::data_type_size(src_type));
+
+    if (bgmmc.use_buffer) {
+        const size_t c_nelems = (size_t)bgmmc.nthr * bgmmc.M_chunk_size
+                * bgmmc.M_blk * bgmmc.LDC;
+        scratchpad.book(key_brgemm_primitive_buffer, c_nelems,
+                types::data_type_size(bgmmc.acc_dt));
+    }
+}
+
+template <cpu_isa_t isa, data_type_t src_type, data_type_t dst_type>
+status_t brgemm_decompress_matmul_t<isa, src_type, dst_type>::execute_body(
+        const exec_ctx_t &ctx) const {
+    using src_data_t = typename prec_traits<src_type>::type;
+
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto weights = CTX_IN_MEM(const uint8_t *, DNNL_ARG_WEIGHTS);
+    auto bias = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+    auto scales = CTX_IN_MEM(
+            const float *, DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_SCALES);
+    auto zero_points = CTX_IN_MEM(
+            const float *, DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_ZERO_POINTS);
+
+    const auto &bgmmc = pd()->bgmmc_;
+    if (scales == nullptr
+            || (bgmmc.with_zero_points && zero_points == nullptr))
+        return status::invalid_arguments;
+
+    const auto &scratchpad = ctx.get_scratchpad_grantor();
+    const void **addr_A_global = scratchpad.template get<const void *>(
+            key_brgemm_primitive_addr_a);
+    const void **addr_B_global = scratchpad.template get<const void *>(
+            key_brgemm_primitive_addr_b);
+    src_data_t *b_buffer_global = scratchpad.template get<src_data_t>(
+            key_brgemm_primitive_buffer_b);
+    float *c_buffer_global = bgmmc.use_buffer
+            ? scratchpad.template get<float>(key_brgemm_primitive_buffer)
+            : nullptr;
+
+    const size_t src_dt_size = types::data_type_size(bgmmc.src_dt);
+    const size_t dst_dt_size = types::data_type_size(bgmmc.dst_dt);
+    const size_t bia_dt_size
+            = bgmmc.with_bias ? types::data_type_size(bgmmc.bia_dt) : 0;
+    const float *oscales = pd()->attr()->output_scales_.scales_;
+
+    const bool are_post_ops_applicable = one_of(true, bgmmc.with_sum,
+            bgmmc.with_bias, bgmmc.with_eltwise, bgmmc.acc_dt != bgmmc.dst_dt);
+
+    auto decompress = [&](dim_t k, dim_t n, dim_t vK, dim_t vN,
+                              bool is_N_tail, src_data_t *buf) {
+        const auto ker = decompress_kernels_[is_N_tail].get();
+        switch (bgmmc.wei_dt) {
+            case s8:
+                decompress_block<s8>(bgmmc, ker, weights, scales, zero_points,
+                        k, n, vK, vN, buf);
+                break;
+            case u8:
+                decompress_block<u8>(bgmmc, ker, weights, scales, zero_points,
+                        k, n, vK, vN, buf);
+                break;
+            case s4:
+                decompress_block<s4>(bgmmc, ker, weights, scales, zero_points,
+                        k, n, vK, vN, buf);
+                break;
+            case u4:
+                decompress_block<u4>(bgmmc, ker, weights, scales, zero_points,
+                        k, n, vK, vN, buf);
+                break;
+            default: assert(!"unsupported weights data type");
+        }
+    };
+
+    const dim_t work_amount = bgmmc.nb_n * bgmmc.nb_m_chunks;
+    parallel(bgmmc.nthr, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        balance211(work_amount, nthr, ithr, start, end);
+        if (start >= end) return;
+
+        const void **addr_A = addr_A_global + ithr;
+        const void **addr_B = addr_B_global + ithr;
+        src_data_t *b_buffer
+                = b_buffer_global + ithr * rnd_up(bgmmc.K_blk, 2) * bgmmc.LDB;
+        float *c_buffer = bgmmc.use_buffer ? c_buffer_global
+                        + ithr * bgmmc.M_chunk_size * bgmmc.M_blk * bgmmc.LDC
+                                           : nullptr;
+
+        // The consecutive chunks of rows of a thread share the columns of
+        // the weights
+        dim_t nb {0}, mc {0};
+        nd_iterator_init(start, nb, bgmmc.nb_n, mc, bgmmc.nb_m_chunks);
+        while (start < end) {
+            const dim_t n = nb * bgmmc.N_blk;
+            const bool is_N_tail = bgmmc.N - n < bgmmc.N_blk;
+            const dim_t vN = is_N_tail ? bgmmc.N_tail : bgmmc.N_blk;
+            const dim_t mb_start = mc * bgmmc.M_chunk_size;
+            const dim_t mb_end
+                    = nstl::min(mb_start + bgmmc.M_chunk_size, bgmmc.nb_m);
+
+            for (dim_t kb = 0; kb < bgmmc.nb_k; kb++) {
+                const dim_t k = kb * bgmmc.K_blk;
+                const bool is_K_tail = bgmmc.K - k < bgmmc.K_blk;
+                const dim_t vK = is_K_tail ? bgmmc.K_tail : bgmmc.K_blk;
+                const bool is_last_kb = kb == bgmmc.nb_k - 1;
+                decompress(k, n, vK, vN, is_N_tail, b_buffer);
+
+                for (dim_t mb = mb_start; mb < mb_end; mb++) {
+                    const dim_t m = mb * bgmmc.M_blk;
+                    const bool is_M_tail = bgmmc.M - m < bgmmc.M_blk;
+                    const int brg_ker_idx
+                            = brgemm_decompress_utils::get_brg_kernel_index(
+                                    bgmmc, kb == 0, is_M_tail, is_N_tail,
+                                    is_K_tail);
+                    const auto brg_kernel = brg_kernels_[brg_ker_idx].get();
+
+                    addr_A[0] = src + (m * bgmmc.LDA + k) * src_dt_size;
+                    addr_B[0] = b_buffer;
+
+                    char *ptr_D = dst + (m * bgmmc.LDD + n) * dst_dt_size;
+                    char *ptr_C = bgmmc.use_buffer
+                            ? reinterpret_cast<char *>(c_buffer
+                                    + (mb - mb_start) * bgmmc.M_blk
+                                            * bgmmc.LDC)
+                            : ptr_D;
+                    if (is_last_kb && are_post_ops_applicable) {
+                        const char *bias_w = bgmmc.with_bias
+                                ? bias + n * bia_dt_size
+                                : nullptr;
+                        brgemm_kernel_execute_postops(brg_kernel, 1, addr_A,
+                                addr_B, ptr_C, ptr_D, bias_w, oscales);
+                    } else {
+                        brgemm_kernel_execute(
+                                brg_kernel, 1, addr_A, addr_B, ptr_C);
+                    }
+                }
+            }
+
+            ++start;
+            nd_iterator_step(nb, bgmmc.nb_n, mc, bgmmc.nb_m_chunks);
+        }
+    });
+
+    return status::success;
+}
+
+template <cpu_isa_t isa, data_type_t src_type, data_type_t dst_type>
+status_t brgemm_decompress_matmul_t<isa, src_type, dst_type>::execute_fused(
+        const exec_ctx_t &ctx) const {
+    using src_data_t = typename prec_traits<src_type>::type;
+    using dst_data_t = typename prec_traits<dst_type>::type;
+
+    auto src = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
+    auto weights = CTX_IN_MEM(const uint8_t *, DNNL_ARG_WEIGHTS);
+    auto bias = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+    auto scales = CTX_IN_MEM(
+            const float *, DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_SCALES);
+    auto zero_points = CTX_IN_MEM(
+            const float *, DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_ZERO_POINTS);
+
+    const auto &bgmmc = pd()->bgmmc_;
+    if (scales == nullptr
+            || (bgmmc.with_zero_points && zero_points == nullptr))
+        return status::invalid_arguments;
+
+    const dim_t M = bgmmc.M, N = bgmmc.N, K = bgmmc.K;
+    const dim_t group_size = K / bgmmc.ngroups;
+    const dim_t k_group_size = bgmmc.k_group_size;
+    const dim_t nk_groups = bgmmc.nk_groups;
+    const bool is_4bit = one_of(bgmmc.wei_dt, s4, u4);
+
+    const auto &scratchpad = ctx.get_scratchpad_grantor();
+    float *src_f32 = src_type == f32
+            ? nullptr
+            : scratchpad.template get<float>(key_brgemm_primitive_buffer_a);
+    float *src_sums = bgmmc.with_zero_points && bgmmc.with_src_sums
+            ? scratchpad.template get<float>(key_brgemm_primitive_buffer)
+            : nullptr;
+    float *acc = bgmmc.use_buffer
+            ? scratchpad.template get<float>(key_matmul_dst_in_acc_dt)
+            : reinterpret_cast<float *>(dst);
+
+    // The source is converted to f32 and summed by groups first
+    if (src_f32 || src_sums) {
+        parallel_nd(M, nk_groups, [&](dim_t m, dim_t g) {
+            const dim_t off = m * K + g * k_group_size;
+            constexpr dim_t max_len = 256;
+            float a[max_len];
+            for (dim_t k0 = 0; k0 < k_group_size; k0 += max_len) {
+                const dim_t len = nstl::min(max_len, k_group_size - k0);
+                const float *a_f32 = a;
+                if (src_type == f32)
+                    a_f32 = reinterpret_cast<const float *>(src) + off + k0;
+                else
+                    cvt_bfloat16_to_float(a,
+                            reinterpret_cast<const bfloat16_t *>(src) + off
+                                    + k0,
+                            len);
+                if (src_f32) utils::array_copy(src_f32 + off + k0, a, len);
+                if (!src_sums) continue;
+                float sum = k0 == 0 ? 0.f : src_sums[m * nk_groups + g];
+                for (dim_t k = 0; k < len; k++)
+                    sum += a_f32[k];
+                src_sums[m * nk_groups + g] = sum;
+            }
+        });
+    }
+    const float *A = src_f32 ? src_f32 : reinterpret_cast<const float *>(src);
+
+    // The chunks of the reduction dimension are multiplied in turn by the
+    // blocks of a thread, which own their blocks of the destination. The
+    // consecutive blocks share the columns of the weights.
+    const dim_t work_amount = bgmmc.nb_n * bgmmc.nb_m;
+    const dim_t K_chunk = bgmmc.k_chunk_groups * k_group_size;
+    parallel(bgmmc.nthr, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        balance211(work_amount, nthr, ithr, start, end);
+        if (start >= end) return;
+
+        auto block = [&](dim_t iwork, dim_t &m, dim_t &n, bool &is_M_tail,
+                             bool &is_N_tail) {
+            m = (iwork % bgmmc.nb_m) * bgmmc.M_blk;
+            n = (iwork / bgmmc.nb_m) * bgmmc.N_blk;
+            is_M_tail = M - m < bgmmc.M_blk;
+            is_N_tail = N - n < bgmmc.N_blk;
+        };
+
+        dim_t m {0}, n {0};
+        bool is_M_tail {false}, is_N_tail {false};
+
+        // The products of the chunks are added to the destination
+        for (dim_t iwork = start; iwork < end; iwork++) {
+            block(iwork, m, n, is_M_tail, is_N_tail);
+            const dim_t vM = is_M_tail ? bgmmc.M_tail : bgmmc.M_blk;
+            const dim_t vN = is_N_tail ? bgmmc.N_tail : bgmmc.N_blk;
+            for (dim_t mm = 0; mm < vM; mm++)
+                utils::array_set(acc + (m + mm) * N + n, 0.f, vN);
+        }
+
+        for (dim_t k = 0; k < K; k += K_chunk) {
+            const dim_t g = k / group_size;
+            const dim_t kg = k / k_group_size;
+            for (dim_t iwork = start; iwork < end; iwork++) {
+                block(iwork, m, n, is_M_tail, is_N_tail);
+                const dim_t wei_idx
+                        = k * bgmmc.wei_k_stride + n * bgmmc.wei_n_stride;
+                jit_brgemm_decompress_fused_kernel_t::call_params_t p;
+                p.src = A + m * K + k;
+                p.wei = weights + (is_4bit ? wei_idx / 2 : wei_idx);
+                p.scales = scales + g * N + n;
+                p.zero_points
+                        = zero_points ? zero_points + g * N + n : nullptr;
+                p.src_sums
+                        = src_sums ? src_sums + m * nk_groups + kg : nullptr;
+                p.dst = acc + m * N + n;
+                p.ngroups = nstl::min(K - k, K_chunk) / k_group_size;
+                (*fused_kernels_[is_M_tail][is_N_tail])(&p);
+            }
+        }
+    });
+
+    if (pd()->with_pp_kernel()) {
+        const float *oscales = pd()->attr()->output_scales_.scales_;
+        const bool force_sequential = pp_kernel_->sequential_kernel();
+        parallel(force_sequential ? 1 : bgmmc.nthr, [&](int ithr, int nthr) {
+            size_t start {0}, end {0};
+            balance211((size_t)(M * N), nthr, ithr, start, end);
+            (*pp_kernel_)(dst, acc, bias, oscales, start, end, (size_t)N, N,
+                    nullptr);
+        });
+    }
+
+    return status::success;
+}
+
+template struct brgemm_decompress_matmul_t<avx512_core, f32>;
+template struct brgemm_decompress_matmul_t<avx512_core_bf16, bf16>;
+template struct brgemm_decompress_matmul_t<avx512_core_bf16, bf16, f32>;
+
+} // namespace matmul
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
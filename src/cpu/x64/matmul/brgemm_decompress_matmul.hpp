@@ -0,0 +1,345 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_MATMUL_BRGEMM_DECOMPRESS_MATMUL_HPP
+#define CPU_X64_MATMUL_BRGEMM_DECOMPRESS_MATMUL_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/gemm_inner_product_utils.hpp"
+#include "cpu/matmul/cpu_matmul_pd.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+#include "cpu/x64/jit_generator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace matmul {
+
+struct brgemm_decompress_matmul_conf_t {
+    cpu_isa_t isa;
+    dim_t M, N, K;
+    dim_t M_blk, N_blk, K_blk;
+    dim_t M_tail, N_tail, K_tail;
+    dim_t nb_m, nb_n, nb_k;
+    // The blocks of the decompressed weights are shared by a chunk of
+    // M_chunk_size blocks of rows of the source
+    dim_t M_chunk_size, nb_m_chunks;
+    dim_t LDA, LDB, LDC, LDD;
+    // Strides of the weights in elements, not in bytes: the 4-bit values are
+    // packed two per byte
+    dim_t wei_k_stride, wei_n_stride;
+    bool is_wei_ba;
+    dim_t group_size;
+    data_type_t src_dt, wei_dt, dst_dt, acc_dt, bia_dt;
+    bool with_bias, with_sum, with_eltwise, with_zero_points;
+    bool use_buffer;
+    // The rows of the weights are decompressed by a JIT kernel when they are
+    // dense and, for the 4-bit types, start on a byte
+    bool use_decompress_kernel;
+    // For a few rows of the source, the weights are decompressed in the
+    // registers of the kernel that multiplies them instead of to a buffer.
+    // The blocks are then M_blk x N_blk blocks of the destination.
+    bool use_fused_kernel;
+    // Number of groups of the scales
+    dim_t ngroups;
+    // The groups of the kernel divide the groups of the scales, so that the
+    // reduction dimension can be split by chunks of k_chunk_groups of them
+    dim_t k_group_size, nk_groups, k_chunk_groups;
+    // The zero points and the scales are applied to the sums of the groups
+    // of the products, otherwise to the weights as they are loaded, which is
+    // cheaper in the ba layout for more than a few rows of the source
+    bool with_src_sums;
+    int nthr;
+};
+
+// Converts the vectors of 16 compressed weights to f32, the 4-bit ones are
+// unpacked with a permutation of their nibbles
+struct jit_brgemm_decompress_base_t : public jit_generator {
+protected:
+    using reg64_t = const Xbyak::Reg64;
+
+    jit_brgemm_decompress_base_t(data_type_t wei_dt) : wei_dt_(wei_dt) {}
+
+    const data_type_t wei_dt_;
+
+    static constexpr int simd_w_ = 16;
+
+    const Xbyak::Opmask k_tail = k1;
+    const Xbyak::Opmask k_tail_4bit = k2;
+
+    const Xbyak::Zmm zmm_tmp = zmm27;
+    const Xbyak::Zmm zmm_idx_4bit = zmm28;
+    const Xbyak::Zmm zmm_nibble_mask = zmm30;
+    const Xbyak::Zmm zmm_sign_bit = zmm31;
+
+    Xbyak::Label idx_4bit_table_;
+
+    bool is_4bit() const {
+        return utils::one_of(wei_dt_, data_type::s4, data_type::u4);
+    }
+    // Offset in bytes of the weight idx, which is even for the 4-bit types
+    dim_t wei_offset(dim_t idx) const { return is_4bit() ? idx / 2 : idx; }
+
+    // Sets the masks for a tail of the given number of weights
+    void init_tail_masks(reg64_t &reg_tmp, dim_t tail);
+    void init_4bit_consts(reg64_t &reg_tmp);
+    // Loads the 16 weights starting at the weight idx after reg_wei
+    void load_weights(const Xbyak::Zmm &zmm, reg64_t &reg_wei, dim_t idx,
+            bool tail);
+    void emit_4bit_table();
+};
+
+// Decompresses the n columns of a row of a block of the weights to f32, or of
+// a pair of rows to bf16 in the VNNI layout
+struct jit_brgemm_decompress_kernel_t : public jit_brgemm_decompress_base_t {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_brgemm_decompress_kernel_t)
+
+    // The second row is used for bf16 only
+    struct call_params_t {
+        const void *wei[2];
+        const float *scales[2];
+        const float *zero_points[2];
+        void *dst;
+    };
+
+    jit_brgemm_decompress_kernel_t(
+            const brgemm_decompress_matmul_conf_t &bgmmc, dim_t n)
+        : jit_brgemm_decompress_base_t(bgmmc.wei_dt)
+        , dst_dt_(bgmmc.src_dt)
+        , with_zero_points_(bgmmc.with_zero_points)
+        , n_(n) {}
+
+    void operator()(const call_params_t *p) const {
+        jit_generator::operator()(p);
+    }
+
+private:
+    const data_type_t dst_dt_;
+    const bool with_zero_points_;
+    const dim_t n_;
+
+    reg64_t reg_param = abi_param1;
+    reg64_t reg_wei[2] = {r8, r9};
+    reg64_t reg_scales[2] = {r10, r11};
+    reg64_t reg_zero_points[2] = {r12, r13};
+    reg64_t reg_dst = r14;
+    reg64_t reg_tmp = r15;
+
+    const Xbyak::Opmask k_tail_vnni = k3;
+
+    const Xbyak::Zmm zmm_idx_vnni = zmm29;
+
+    Xbyak::Label idx_vnni_table_;
+
+    void load_row(const Xbyak::Zmm &zmm, int row, dim_t col, bool tail);
+    void generate() override;
+    std::string persistent_cache_key() const override;
+};
+
+// Multiplies m rows of the f32 source by n columns of the compressed weights,
+// which are converted in registers right after they are loaded, and adds the
+// products to the f32 destination.
+//
+// With src_sums, the products are accumulated by groups of the reduction
+// dimension, then scaled. The zero points are subtracted from the sums of the
+// groups as their products with the sums of the groups of the rows of the
+// source, src_sums. Otherwise, the weights are shifted and scaled right away.
+//
+// With the weights in the ab layout, a vector holds 16 columns of a row. In
+// the ba layout, it holds 16 elements of a column along the reduction
+// dimension and is reduced horizontally at the end.
+struct jit_brgemm_decompress_fused_kernel_t
+    : public jit_brgemm_decompress_base_t {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_brgemm_decompress_fused_kernel_t)
+
+    struct call_params_t {
+        const float *src;
+        const void *wei;
+        const float *scales;
+        const float *zero_points;
+        const float *src_sums;
+        float *dst;
+        dim_t ngroups;
+    };
+
+    jit_brgemm_decompress_fused_kernel_t(
+            const brgemm_decompress_matmul_conf_t &bgmmc, dim_t m, dim_t n);
+
+    void operator()(const call_params_t *p) const {
+        jit_generator::operator()(p);
+    }
+
+    // Maximal number of vector registers for the accumulators and the
+    // weights, the others are reserved
+    static constexpr int max_vregs = 27;
+
+private:
+    const bool is_wei_ba_;
+    const bool with_zero_points_;
+    const bool with_src_sums_;
+    const dim_t m_, n_;
+    const dim_t K_, N_;
+    const dim_t group_size_, ngroups_;
+
+    reg64_t reg_param = abi_param1;
+    reg64_t reg_src = r8;
+    reg64_t reg_wei = r9;
+    reg64_t reg_scales = r10;
+    reg64_t reg_zero_points = r11;
+    reg64_t reg_src_sums = r12;
+    reg64_t reg_dst = r13;
+    reg64_t reg_k = r14;
+    reg64_t reg_group = r15;
+    reg64_t reg_tmp = rax;
+
+    const Xbyak::Opmask k_lane0 = k3;
+
+    const Xbyak::Zmm zmm_aux = zmm29;
+
+    void generate_ab();
+    void generate_ba();
+    void generate() override;
+    std::string persistent_cache_key() const override;
+};
+
+namespace brgemm_decompress_utils {
+
+constexpr int max_num_brg_kernels = 2 * 2 * 2 * 2;
+
+// Returns -1 if the kernel is not needed
+int get_brg_kernel_index(const brgemm_decompress_matmul_conf_t &bgmmc,
+        bool is_init, bool is_M_tail, bool is_N_tail, bool is_K_tail);
+
+} // namespace brgemm_decompress_utils
+
+// Non-batched matmul with s8, u8, s4 or u4 weights decompressed to the data
+// type of the source with the weights decompression attribute. The blocks of
+// the weights are decompressed to a per-thread buffer right before they are
+// multiplied, so the dense weights are never materialized in full.
+template <cpu_isa_t isa, impl::data_type_t src_type,
+        impl::data_type_t dst_type = src_type>
+struct brgemm_decompress_matmul_t : public primitive_t {
+    struct pd_t : public ::dnnl::impl::cpu::matmul::cpu_matmul_pd_t {
+        using ::dnnl::impl::cpu::matmul::cpu_matmul_pd_t::cpu_matmul_pd_t;
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("brg_decomp:", isa, ""),
+                brgemm_decompress_matmul_t);
+
+        status_t init(engine_t *engine);
+
+        // The fused kernel accumulates in f32, the bias and the post-ops are
+        // applied after it
+        bool with_pp_kernel() const {
+            return bgmmc_.use_fused_kernel
+                    && (bgmmc_.with_bias || bgmmc_.with_sum
+                            || bgmmc_.with_eltwise
+                            || bgmmc_.dst_dt != bgmmc_.acc_dt);
+        }
+
+        brgemm_t brg_descs_[brgemm_decompress_utils::max_num_brg_kernels];
+        brgemm_decompress_matmul_conf_t bgmmc_;
+
+    private:
+        status_t init_conf();
+        void init_scratchpad();
+    };
+
+    brgemm_decompress_matmul_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override {
+        const auto &bgmmc = pd()->bgmmc_;
+        if (bgmmc.use_fused_kernel) {
+            for_(int i_M = 0; i_M < 2; i_M++)
+            for (int i_N = 0; i_N < 2; i_N++) {
+                const dim_t vM = i_M ? bgmmc.M_tail : bgmmc.M_blk;
+                const dim_t vN = i_N ? bgmmc.N_tail : bgmmc.N_blk;
+                if (vM == 0 || vN == 0) continue;
+                CHECK(safe_ptr_assign(fused_kernels_[i_M][i_N],
+                        new jit_brgemm_decompress_fused_kernel_t(
+                                bgmmc, vM, vN)));
+                CHECK(fused_kernels_[i_M][i_N]->create_kernel());
+            }
+            if (pd()->with_pp_kernel()) {
+                CHECK(safe_ptr_assign(pp_kernel_,
+                        pp_kernel_t::create(bgmmc.N, bgmmc.M, bgmmc.N,
+                                pd()->attr(), bgmmc.bia_dt, false)));
+                CHECK(pp_kernel_->create_kernel());
+            }
+            return status::success;
+        }
+
+        for_(int i_init = 0; i_init < 2; i_init++)
+        for_(int i_M = 0; i_M < 2; i_M++)
+        for_(int i_N = 0; i_N < 2; i_N++)
+        for (int i_K = 0; i_K < 2; i_K++) {
+            const int idx = brgemm_decompress_utils::get_brg_kernel_index(
+                    bgmmc, i_init, i_M, i_N, i_K);
+            if (idx < 0) continue;
+
+            brgemm_kernel_t *ker = nullptr;
+            CHECK(brgemm_kernel_create(&ker, pd()->brg_descs_[idx]));
+            CHECK(safe_ptr_assign(brg_kernels_[idx], ker));
+        }
+
+        if (bgmmc.use_decompress_kernel) {
+            for (int i_N = 0; i_N < 2; i_N++) {
+                const dim_t vN = i_N ? bgmmc.N_tail : bgmmc.N_blk;
+                if (vN == 0) continue;
+                CHECK(safe_ptr_assign(decompress_kernels_[i_N],
+                        new jit_brgemm_decompress_kernel_t(bgmmc, vN)));
+                CHECK(decompress_kernels_[i_N]->create_kernel());
+            }
+        }
+
+        return status::success;
+    }
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        return pd()->bgmmc_.use_fused_kernel ? execute_fused(ctx)
+                                             : execute_body(ctx);
+    }
+
+private:
+    status_t execute_body(const exec_ctx_t &ctx) const;
+    status_t execute_fused(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    using pp_kernel_t = inner_product_utils::pp_kernel_t<data_type::f32,
+            dst_type>;
+
+    std::unique_ptr<brgemm_kernel_t>
+            brg_kernels_[brgemm_decompress_utils::max_num_brg_kernels];
+    // Indexed by is_N_tail
+    std::unique_ptr<jit_brgemm_decompress_kernel_t> decompress_kernels_[2];
+    // Indexed by is_M_tail and is_N_tail
+    std::unique_ptr<jit_brgemm_decompress_fused_kernel_t> fused_kernels_[2][2];
+    std::unique_ptr<pp_kernel_t> pp_kernel_;
+};
+
+} // namespace matmul
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
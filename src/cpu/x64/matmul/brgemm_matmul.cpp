@@ -0,0 +1,209 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/amx_tile_configure.hpp"
+#include "cpu/x64/matmul/brgemm_matmul.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace matmul {
+
+using namespace dnnl::impl::data_type;
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+template <cpu_isa_t isa, data_type_t src_type, data_type_t wei_type,
+        data_type_t dst_type>
+status_t brgemm_matmul_t<isa, src_type, wei_type, dst_type>::execute_body(
+        const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const src_data_t *, DNNL_ARG_SRC);
+    auto weights = CTX_IN_MEM(const wei_data_t *, DNNL_ARG_WEIGHTS);
+    auto bias = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(dst_data_t *, DNNL_ARG_DST);
+
+    const auto &bgmmc = pd()->bgmmc_;
+
+    // M and the strides depending on it may be known only now
+    const auto src_d = ctx.memory_mdw(DNNL_ARG_SRC, pd()->src_md());
+    const auto dst_d = ctx.memory_mdw(DNNL_ARG_DST, pd()->dst_md());
+    const int ndims = bgmmc.ndims;
+    const dim_t M = dst_d.dims()[ndims - 2];
+    if (M <= 0) return status::success;
+    const dim_t src_batch_stride
+            = ndims == 3 ? src_d.blocking_desc().strides[0] : 0;
+    const dim_t dst_batch_stride
+            = ndims == 3 ? dst_d.blocking_desc().strides[0] : 0;
+
+    memory_tracking::grantor_t scratchpad = ctx.get_scratchpad_grantor();
+    const size_t bia_dt_size
+            = bgmmc.with_bias ? types::data_type_size(bgmmc.bia_dt) : 0;
+    const float *oscales = pd()->attr()->output_scales_.scales_;
+
+    const src_data_t **addr_A_global
+            = scratchpad.template get<const src_data_t *>(
+                    key_brgemm_primitive_addr_a);
+    const wei_data_t **addr_B_global
+            = scratchpad.template get<const wei_data_t *>(
+                    key_brgemm_primitive_addr_b);
+    char *c_buffer_global = (bgmmc.use_buffer)
+            ? scratchpad.template get<char>(key_brgemm_primitive_buffer)
+            : nullptr;
+    const bool is_amx = one_of(
+            bgmmc.isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
+    char *wsp_tile_base = is_amx
+            ? scratchpad.template get<char>(key_conv_amx_tile_buffer)
+            : nullptr;
+
+    const bool are_post_ops_applicable = one_of(true, bgmmc.with_sum,
+            bgmmc.with_bias, bgmmc.with_scales, bgmmc.with_eltwise,
+            bgmmc.acc_dt != bgmmc.dst_dt);
+
+    const int M_chunk = bgmmc.M_kernel_sizes[0];
+    const dim_t num_M_chunks = div_up(M, M_chunk);
+    const bool has_K_tail = bgmmc.K_tail > 0;
+
+    const auto ker = [&](const int ithr, int &last_brg_ker_idx, dim_t b,
+                             dim_t m, int M_idx, int n_blk) {
+        const src_data_t **addr_A
+                = addr_A_global + ithr * bgmmc.brgemm_batch_size;
+        const wei_data_t **addr_B
+                = addr_B_global + ithr * bgmmc.brgemm_batch_size;
+        char *c_buffer = (bgmmc.use_buffer) ? c_buffer_global
+                        + ithr * types::data_type_size(bgmmc.acc_dt)
+                                * bgmmc.LDC * bgmmc.M_blk
+                                            : nullptr;
+        char *wsp_tile = is_amx ? wsp_tile_base + ithr * 1024 : nullptr;
+
+        const int n = n_blk * bgmmc.N_blk;
+        const bool is_N_tail = (bgmmc.N - n < bgmmc.N_blk);
+        const src_data_t *ptr_A
+                = src + b * src_batch_stride + m * bgmmc.LDA;
+        const wei_data_t *ptr_B = weights
+                + (bgmmc.wei_batch > 1 ? b : 0) * bgmmc.B_batch_stride
+                + n_blk * bgmmc.B_N_blk_stride;
+        dst_data_t *ptr_D = dst + b * dst_batch_stride + m * bgmmc.LDD + n;
+        char *ptr_C = (bgmmc.use_buffer) ? c_buffer : (char *)ptr_D;
+
+        const auto call_brgemm = [&](int brg_ker_idx, int k_blk_s, int bs,
+                                         bool do_postops) {
+            for (int i = 0; i < bs; i++) {
+                addr_A[i] = ptr_A + (k_blk_s + i) * bgmmc.K_blk;
+                addr_B[i] = ptr_B + (k_blk_s + i) * bgmmc.B_K_blk_stride;
+            }
+            auto brg_kernel = brg_kernels_[brg_ker_idx].get();
+            if (is_amx && brg_ker_idx != last_brg_ker_idx) {
+                amx_tile_configure(&brg_kernel_palettes_[brg_ker_idx][0]);
+                last_brg_ker_idx = brg_ker_idx;
+            }
+            if (do_postops) {
+                auto bias_w = bgmmc.with_bias ? bias + bia_dt_size * n
+                                              : nullptr;
+                brgemm_kernel_execute_postops(brg_kernel, bs, (void **)addr_A,
+                        (void **)addr_B, (void *)ptr_C, (void *)ptr_D,
+                        (void *)bias_w, &oscales[bgmmc.is_oc_scale * n],
+                        is_amx ? (void *)wsp_tile : nullptr);
+            } else {
+                brgemm_kernel_execute(brg_kernel, bs, (void **)addr_A,
+                        (void **)addr_B, (void *)ptr_C,
+                        is_amx ? (void *)wsp_tile : nullptr);
+            }
+        };
+
+        if (bgmmc.num_K_blocks > 0) {
+            const int brg_ker_idx
+                    = pd()->get_brg_kernel_idx(true, M_idx, is_N_tail, false);
+            call_brgemm(brg_ker_idx, 0, bgmmc.num_K_blocks,
+                    are_post_ops_applicable && !has_K_tail);
+        }
+        if (has_K_tail) {
+            const int brg_ker_idx = pd()->get_brg_kernel_idx(
+                    bgmmc.num_K_blocks == 0, M_idx, is_N_tail, true);
+            call_brgemm(brg_ker_idx, bgmmc.num_K_blocks, 1,
+                    are_post_ops_applicable);
+        }
+    };
+
+    const dim_t work_amount = bgmmc.batch * num_M_chunks * bgmmc.num_N_blocks;
+
+    parallel(bgmmc.nthr, [&](const int ithr, const int nthr) {
+        if (ithr >= work_amount) return;
+
+        dim_t start {0}, end {0};
+        balance211(work_amount, nthr, ithr, start, end);
+
+        dim_t b {0}, mc {0};
+        int n_blk {0};
+        nd_iterator_init(start, b, bgmmc.batch, mc, num_M_chunks, n_blk,
+                bgmmc.num_N_blocks);
+        int last_brg_ker_idx = -1;
+        while (start < end) {
+            const dim_t m_s = mc * M_chunk;
+            const dim_t m_e = nstl::min(M, m_s + M_chunk);
+            if (m_e - m_s == M_chunk) {
+                ker(ithr, last_brg_ker_idx, b, m_s, 0, n_blk);
+            } else if (!bgmmc.is_runtime_M) {
+                ker(ithr, last_brg_ker_idx, b, m_s, 1, n_blk);
+            } else {
+                // compose the runtime tail of the kernels for powers of two
+                dim_t m = m_s;
+                for (int M_idx = 1; M_idx < bgmmc.num_M_kernels; M_idx++) {
+                    if (m_e - m < bgmmc.M_kernel_sizes[M_idx]) continue;
+                    ker(ithr, last_brg_ker_idx, b, m, M_idx, n_blk);
+                    m += bgmmc.M_kernel_sizes[M_idx];
+                }
+                assert(m == m_e);
+            }
+            ++start;
+            nd_iterator_step(b, bgmmc.batch, mc, num_M_chunks, n_blk,
+                    bgmmc.num_N_blocks);
+        }
+    });
+
+    return status::success;
+}
+
+template struct brgemm_matmul_t<avx512_core, f32>;
+template struct brgemm_matmul_t<avx512_core_bf16, bf16>;
+template struct brgemm_matmul_t<avx512_core_bf16, bf16, bf16, f32>;
+template struct brgemm_matmul_t<avx512_core_vnni, u8, s8, f32>;
+template struct brgemm_matmul_t<avx512_core_vnni, u8, s8, s32>;
+template struct brgemm_matmul_t<avx512_core_vnni, u8, s8, u8>;
+template struct brgemm_matmul_t<avx512_core_vnni, u8, s8, s8>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_bf16, bf16>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_bf16, bf16, bf16, f32>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_int8, u8, s8, f32>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_int8, u8, s8, s32>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_int8, u8, s8, u8>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_int8, u8, s8, s8>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_int8, s8, s8, f32>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_int8, s8, s8, s32>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_int8, s8, s8, u8>;
+template struct brgemm_matmul_t<avx512_core_bf16_amx_int8, s8, s8, s8>;
+
+} // namespace matmul
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
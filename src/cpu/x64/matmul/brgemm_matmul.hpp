@@ -0,0 +1,185 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_MATMUL_BRGEMM_MATMUL_HPP
+#define CPU_X64_MATMUL_BRGEMM_MATMUL_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/matmul/cpu_matmul_pd.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+#include "cpu/x64/matmul/brgemm_matmul_utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace matmul {
+
+namespace {
+constexpr int max_num_brg_kernels_matmul = 2 * max_num_brg_M_kernels * 2 * 2;
+
+inline int get_brg_matmul_kernel_index(const brgemm_matmul_conf_t &bgmmc,
+        bool do_initialization, int M_idx, bool is_N_tail, bool is_K_tail) {
+    if (M_idx >= bgmmc.num_M_kernels) return -1;
+    auto vM = bgmmc.M_kernel_sizes[M_idx];
+    auto vN = (is_N_tail) ? bgmmc.N_tail : bgmmc.N_blk;
+    auto vK = (is_K_tail) ? bgmmc.K_tail : bgmmc.K_blk;
+    if (vM == 0 || vN == 0 || vK == 0 || bgmmc.LDA < vK || bgmmc.LDB < vN
+            || bgmmc.LDC < vN)
+        return -1;
+    if (!is_K_tail && bgmmc.num_K_blocks == 0) return -1;
+
+    int idx = 2 * 2 * max_num_brg_M_kernels * (int)do_initialization
+            + 2 * 2 * M_idx + 2 * (int)is_N_tail + (int)is_K_tail;
+
+    assert(idx < max_num_brg_kernels_matmul);
+    return idx;
+}
+
+} // namespace
+
+template <cpu_isa_t isa, impl::data_type_t src_type,
+        impl::data_type_t wei_type = src_type,
+        impl::data_type_t dst_type = src_type>
+struct brgemm_matmul_t : public primitive_t {
+    struct pd_t : public ::dnnl::impl::cpu::matmul::cpu_matmul_pd_t {
+        using ::dnnl::impl::cpu::matmul::cpu_matmul_pd_t::cpu_matmul_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("brg:", isa, ""), brgemm_matmul_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+            using smask_t = primitive_attr_t::skip_mask_t;
+            const bool is_int8 = utils::one_of(src_type, u8, s8);
+            const auto skip_mask = is_int8
+                    ? smask_t::oscale | smask_t::post_ops
+                    : smask_t::post_ops;
+
+            auto check_bias = [&]() -> bool {
+                if (!with_bias()) return true;
+                const auto bia_dt = weights_md(1)->data_type;
+                const bool bia_dt_ok = is_int8
+                        ? utils::one_of(bia_dt, f32, s32, s8, u8)
+                        : src_type == bf16 ? utils::one_of(bia_dt, f32, bf16)
+                                           : bia_dt == f32;
+                return bia_dt_ok && is_bias_1xN();
+            };
+
+            bool ok = src_md()->data_type == src_type
+                    && weights_md()->data_type == wei_type
+                    && dst_md()->data_type == dst_type
+                    && desc()->accum_data_type == (is_int8 ? s32 : f32)
+                    && check_bias()
+                    && attr()->has_default_values(skip_mask, dst_type)
+                    && attr()->zero_points_.has_default_values();
+            if (!ok) return status::unimplemented;
+
+            CHECK(init_brgemm_matmul_conf(isa, bgmmc_, *desc(), src_md_,
+                    weights_md_, dst_md_, bias_md_, *attr()));
+
+            const float alpha = 1.0;
+            const float beta = 1.0;
+            const float beta_init = 0.0;
+            for_(int i_init = 0; i_init < 2; i_init++)
+            for_(int i_M = 0; i_M < max_num_brg_M_kernels; i_M++)
+            for_(int i_N = 0; i_N < 2; i_N++)
+            for (int i_K = 0; i_K < 2; i_K++) {
+                int idx = get_brg_kernel_idx(i_init, i_M, i_N, i_K);
+                if (idx < 0) continue;
+
+                auto vbeta = (i_init) ? beta_init : beta;
+                auto vM = bgmmc_.M_kernel_sizes[i_M];
+                auto vN = (i_N) ? bgmmc_.N_tail : bgmmc_.N_blk;
+                auto vK = (i_K) ? bgmmc_.K_tail : bgmmc_.K_blk;
+
+                brgemm_t &brg = brg_descs_[idx];
+                CHECK(brgemm_desc_init(&brg, isa, bgmmc_.brg_type, src_type,
+                        wei_type, false, false, brgemm_row_major, alpha, vbeta,
+                        bgmmc_.LDA, bgmmc_.LDB, bgmmc_.LDC, vM, vN, vK));
+
+                auto LDD = bgmmc_.LDD;
+                CHECK(brgemm_desc_add_postops(
+                        &brg, attr(), dst_type, LDD, bgmmc_.bia_dt));
+            }
+
+            auto scratchpad = scratchpad_registry().registrar();
+            init_scratchpad(scratchpad, bgmmc_);
+
+            return status::success;
+        }
+
+        int get_brg_kernel_idx(bool do_initialization, int M_idx,
+                bool is_N_tail, bool is_K_tail) const {
+            return get_brg_matmul_kernel_index(
+                    bgmmc_, do_initialization, M_idx, is_N_tail, is_K_tail);
+        }
+
+        brgemm_t brg_descs_[max_num_brg_kernels_matmul];
+        brgemm_matmul_conf_t bgmmc_;
+    };
+
+    brgemm_matmul_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override {
+        for_(int i_M = 0; i_M < max_num_brg_M_kernels; i_M++)
+        for_(int i_N = 0; i_N < 2; i_N++)
+        for_(int i_K = 0; i_K < 2; i_K++)
+        for (int i_init = 0; i_init < 2; i_init++) {
+            int idx = pd()->get_brg_kernel_idx(i_init, i_M, i_N, i_K);
+            if (idx < 0) continue;
+
+            brgemm_kernel_t *ker = nullptr;
+            CHECK(brgemm_kernel_create(&ker, pd()->brg_descs_[idx]));
+            CHECK(safe_ptr_assign(brg_kernels_[idx], ker));
+            if (utils::one_of(isa, avx512_core_bf16_amx_int8,
+                        avx512_core_bf16_amx_bf16))
+                CHECK(brgemm_init_tiles(
+                        pd()->brg_descs_[idx], &brg_kernel_palettes_[idx][0]));
+        }
+
+        return status::success;
+    }
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        return execute_body(ctx);
+    }
+
+private:
+    status_t execute_body(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    typedef typename prec_traits<src_type>::type src_data_t;
+    typedef typename prec_traits<wei_type>::type wei_data_t;
+    typedef typename prec_traits<dst_type>::type dst_data_t;
+
+    std::unique_ptr<brgemm_kernel_t> brg_kernels_[max_num_brg_kernels_matmul];
+    char brg_kernel_palettes_[max_num_brg_kernels_matmul][64];
+};
+
+} // namespace matmul
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
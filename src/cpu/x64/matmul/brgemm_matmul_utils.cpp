@@ -0,0 +1,247 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+#include "cpu/x64/matmul/brgemm_matmul_utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace matmul {
+
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::format_tag;
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+using namespace data_type;
+
+namespace {
+
+format_tag_t get_brgemm_matmul_weights_tag(int ndims, data_type_t wei_dt) {
+    switch (wei_dt) {
+        case f32: return pick(ndims - 2, BA16a64b, aCB16b64c);
+        case bf16: return pick(ndims - 2, BA16a64b2a, aCB16b64c2b);
+        case s8: return pick(ndims - 2, BA16a64b4a, aCB16b64c4b);
+        default: return format_tag::undef;
+    }
+}
+
+// Activations are read and written in place, so any plain layout with dense
+// rows and a leading dimension known at creation time is accepted.
+bool is_plain_with_dense_rows(const memory_desc_wrapper &mdw) {
+    const int ndims = mdw.ndims();
+    if (!mdw.is_blocking_desc() || mdw.blocking_desc().inner_nblks != 0)
+        return false;
+    const auto &strides = mdw.blocking_desc().strides;
+    return strides[ndims - 1] == 1
+            && strides[ndims - 2] != DNNL_RUNTIME_DIM_VAL;
+}
+
+} // namespace
+
+status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
+        const matmul_desc_t &mmd, memory_desc_t &src_md,
+        memory_desc_t &weights_md, memory_desc_t &dst_md,
+        memory_desc_t &bias_md, const primitive_attr_t &attr) {
+    const memory_desc_wrapper src_d(&src_md);
+    const memory_desc_wrapper weights_d(&weights_md);
+    const memory_desc_wrapper dst_d(&dst_md);
+
+    if (!mayiuse(isa)) return status::unimplemented;
+
+    bgmmc = zero<decltype(bgmmc)>();
+    bgmmc.isa = isa;
+    bgmmc.ndims = dst_d.ndims();
+    if (!one_of(bgmmc.ndims, 2, 3)) return status::unimplemented;
+
+    const int ndims = bgmmc.ndims;
+    const bool is_amx
+            = one_of(isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
+
+    // Only M may be defined at execution time: the kernels are generated for
+    // the N and K sizes and the weights are expected in a blocked layout.
+    bgmmc.is_runtime_M = dst_d.dims()[ndims - 2] == DNNL_RUNTIME_DIM_VAL;
+    if (weights_d.has_runtime_dims_or_strides()
+            || src_d.dims()[ndims - 1] == DNNL_RUNTIME_DIM_VAL
+            || dst_d.dims()[ndims - 1] == DNNL_RUNTIME_DIM_VAL
+            || (ndims == 3
+                    && one_of(DNNL_RUNTIME_DIM_VAL, src_d.dims()[0],
+                            dst_d.dims()[0])))
+        return status::unimplemented;
+
+    bgmmc.batch = ndims == 3 ? dst_d.dims()[0] : 1;
+    bgmmc.wei_batch = ndims == 3 ? weights_d.dims()[0] : 1;
+    if (ndims == 3
+            && (src_d.dims()[0] != bgmmc.batch
+                    || !one_of(bgmmc.wei_batch, 1, bgmmc.batch)))
+        return status::unimplemented;
+    bgmmc.M = dst_d.dims()[ndims - 2];
+    bgmmc.N = dst_d.dims()[ndims - 1];
+    bgmmc.K = src_d.dims()[ndims - 1];
+
+    bgmmc.src_dt = src_d.data_type();
+    bgmmc.wei_dt = weights_d.data_type();
+    bgmmc.dst_dt = dst_d.data_type();
+    bgmmc.with_bias = mmd.bias_desc.format_kind != format_kind::undef;
+    bgmmc.bia_dt = bgmmc.with_bias ? mmd.bias_desc.data_type : data_type::undef;
+
+    const bool is_int8 = bgmmc.wei_dt == s8
+            && (bgmmc.src_dt == u8
+                    || (bgmmc.src_dt == s8
+                            && isa == avx512_core_bf16_amx_int8));
+    const bool is_bf16 = everyone_is(bf16, bgmmc.src_dt, bgmmc.wei_dt)
+            && one_of(bgmmc.dst_dt, bf16, f32);
+    const bool is_f32
+            = everyone_is(f32, bgmmc.src_dt, bgmmc.wei_dt, bgmmc.dst_dt);
+
+    if (!IMPLICATION(is_int8,
+                one_of(isa, avx512_core_vnni, avx512_core_bf16_amx_int8)))
+        return status::unimplemented;
+    if (!IMPLICATION(is_bf16,
+                one_of(isa, avx512_core_bf16, avx512_core_bf16_amx_bf16)))
+        return status::unimplemented;
+    if (!IMPLICATION(is_f32, isa == avx512_core)) return status::unimplemented;
+
+    if (is_int8) {
+        bgmmc.acc_dt = s32;
+        bgmmc.with_scales = true;
+    } else if (is_bf16 || is_f32) {
+        bgmmc.acc_dt = f32;
+    } else
+        return status::unimplemented;
+
+    const auto &p = attr.post_ops_;
+    bgmmc.with_sum = p.find(primitive_kind::sum) != -1;
+    bgmmc.with_eltwise = p.find(primitive_kind::eltwise) != -1;
+    if (!brgemm_post_ops_ok(p, one_of(bgmmc.src_dt, u8, s8)))
+        return status::unimplemented;
+
+    if (bgmmc.with_scales) {
+        const auto &oscales = attr.output_scales_;
+        // brgemm kernels index per-N scales by the mask of 2D problems
+        bgmmc.is_oc_scale = oscales.mask_ == 1 << 1;
+        const bool oscales_ok = oscales.mask_ == 0
+                || (oscales.mask_ == 1 << 1 && ndims == 2);
+        if (!oscales_ok) return status::unimplemented;
+    }
+
+    const format_tag_t plain_tag = pick(ndims - 2, ab, abc);
+    for (auto md : {&src_md, &dst_md}) {
+        if (md->format_kind != format_kind::any) continue;
+        if (memory_desc_wrapper(md).has_runtime_dims())
+            return status::unimplemented;
+        CHECK(memory_desc_init_by_tag(*md, plain_tag));
+    }
+    if (!is_plain_with_dense_rows(src_d) || !is_plain_with_dense_rows(dst_d))
+        return status::unimplemented;
+
+    if (bgmmc.with_bias && bias_md.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_strides(bias_md, nullptr));
+
+    bgmmc.wei_tag = get_brgemm_matmul_weights_tag(ndims, bgmmc.wei_dt);
+    if (bgmmc.wei_tag == format_tag::undef) return status::unimplemented;
+    memory_desc_t want_wei_md = weights_md;
+    CHECK(memory_desc_init_by_tag(want_wei_md, bgmmc.wei_tag));
+    if (weights_md.format_kind == format_kind::any)
+        weights_md = want_wei_md;
+    else if (!(want_wei_md == weights_md))
+        return status::unimplemented;
+
+    // Block sizes follow the weights layout: 64 columns of B and as many rows
+    // as fit into the inner block, which also matches AMX reduction tiles.
+    bgmmc.N_blk = 64;
+    bgmmc.K_blk = is_int8 ? 64 : is_bf16 ? 32 : 16;
+    // AMX kernels do not support an M tail inside of a tile
+    bgmmc.M_blk = is_amx ? 16 : 32;
+
+    bgmmc.N_tail = bgmmc.N % bgmmc.N_blk;
+    bgmmc.K_tail = bgmmc.K % bgmmc.K_blk;
+    bgmmc.num_N_blocks = div_up(bgmmc.N, bgmmc.N_blk);
+    bgmmc.num_K_blocks = bgmmc.K / bgmmc.K_blk;
+
+    bgmmc.M_kernel_sizes[0] = bgmmc.M_blk;
+    if (bgmmc.is_runtime_M) {
+        bgmmc.num_M_kernels = 1;
+        for (int m = bgmmc.M_blk / 2; m > 0; m /= 2)
+            bgmmc.M_kernel_sizes[bgmmc.num_M_kernels++] = m;
+    } else {
+        bgmmc.M_tail = bgmmc.M % bgmmc.M_blk;
+        // small problems are covered by a single kernel of the exact size
+        if (bgmmc.M < bgmmc.M_blk) {
+            bgmmc.M_kernel_sizes[0] = (int)bgmmc.M;
+            bgmmc.M_tail = 0;
+        }
+        bgmmc.num_M_kernels = 1;
+        if (bgmmc.M_tail > 0)
+            bgmmc.M_kernel_sizes[bgmmc.num_M_kernels++] = bgmmc.M_tail;
+    }
+    assert(bgmmc.num_M_kernels <= max_num_brg_M_kernels);
+
+    const auto &wei_strides = weights_d.blocking_desc().strides;
+    bgmmc.B_N_blk_stride = wei_strides[ndims - 1];
+    bgmmc.B_K_blk_stride = wei_strides[ndims - 2];
+    bgmmc.B_batch_stride = (ndims == 3 && bgmmc.wei_batch > 1)
+            ? wei_strides[0]
+            : 0;
+
+    bgmmc.LDA = (int)src_d.blocking_desc().strides[ndims - 2];
+    bgmmc.LDB = bgmmc.N_blk;
+    bgmmc.LDD = (int)dst_d.blocking_desc().strides[ndims - 2];
+
+    // When the reduction is split into the main part and the tail, the
+    // partial result is accumulated in a buffer unless dst can hold it as is.
+    const bool is_k_split = bgmmc.K_tail > 0 && bgmmc.num_K_blocks > 0;
+    bgmmc.use_buffer = is_k_split
+            && (bgmmc.dst_dt != bgmmc.acc_dt || bgmmc.with_sum);
+    bgmmc.LDC = bgmmc.use_buffer ? bgmmc.N_blk : bgmmc.LDD;
+
+    bgmmc.brg_type = brgemm_addr;
+    bgmmc.brgemm_batch_size = nstl::max(bgmmc.num_K_blocks, 1);
+    bgmmc.nthr = dnnl_get_max_threads();
+
+    return status::success;
+}
+
+void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+        const brgemm_matmul_conf_t &bgmmc) {
+    const size_t sc_size = sizeof(void *);
+    const size_t n_elems = (size_t)bgmmc.nthr * bgmmc.brgemm_batch_size;
+    scratchpad.book(key_brgemm_primitive_addr_a, n_elems, sc_size, 64);
+    scratchpad.book(key_brgemm_primitive_addr_b, n_elems, sc_size, 64);
+    if (bgmmc.use_buffer) {
+        const size_t nelements = (size_t)bgmmc.nthr * bgmmc.LDC * bgmmc.M_blk;
+        scratchpad.book(key_brgemm_primitive_buffer, nelements,
+                types::data_type_size(bgmmc.acc_dt));
+    }
+    if (one_of(bgmmc.isa, avx512_core_bf16_amx_int8,
+                avx512_core_bf16_amx_bf16))
+        scratchpad.book(
+                key_conv_amx_tile_buffer, bgmmc.nthr * 1024, sizeof(char));
+}
+
+} // namespace matmul
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,81 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_MATMUL_BRGEMM_MATMUL_UTILS_HPP
+#define CPU_X64_MATMUL_BRGEMM_MATMUL_UTILS_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/memory_tracking.hpp"
+
+#include "cpu/matmul/cpu_matmul_pd.hpp"
+
+#include "cpu/x64/brgemm/brgemm_types.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace matmul {
+
+// Number of distinct M sizes the kernels are generated for: the main block
+// and either the tail known at creation or, for runtime M, all powers of two
+// below the main block, so that any tail can be composed at execution time.
+constexpr int max_num_brg_M_kernels = 6;
+
+struct brgemm_matmul_conf_t {
+    int ndims;
+    dim_t batch;
+    dim_t wei_batch; // 1 when weights are broadcast over the batch
+    dim_t M, N, K;
+    bool is_runtime_M;
+
+    int M_blk, N_blk, K_blk;
+    int M_tail, N_tail, K_tail;
+    int num_M_kernels;
+    int M_kernel_sizes[max_num_brg_M_kernels];
+    int num_N_blocks, num_K_blocks; // K blocks without the tail
+
+    int LDA, LDB, LDC, LDD;
+    dim_t B_batch_stride, B_N_blk_stride, B_K_blk_stride;
+
+    format_tag_t wei_tag;
+    data_type_t src_dt, wei_dt, dst_dt, acc_dt, bia_dt;
+    bool with_bias, with_scales, with_sum, with_eltwise;
+    bool is_oc_scale;
+    bool use_buffer;
+
+    brgemm_batch_kind_t brg_type;
+    int brgemm_batch_size;
+    int nthr;
+    cpu_isa_t isa;
+};
+
+status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
+        const matmul_desc_t &mmd, memory_desc_t &src_md,
+        memory_desc_t &weights_md, memory_desc_t &dst_md,
+        memory_desc_t &bias_md, const primitive_attr_t &attr);
+
+void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+        const brgemm_matmul_conf_t &bgmmc);
+
+} // namespace matmul
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
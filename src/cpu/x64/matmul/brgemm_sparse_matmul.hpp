@@ -0,0 +1,127 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_MATMUL_BRGEMM_SPARSE_MATMUL_HPP
+#define CPU_X64_MATMUL_BRGEMM_SPARSE_MATMUL_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/matmul/cpu_matmul_pd.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+#include "cpu/x64/jit_brgemm_sparse_utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace matmul {
+
+// Non-batched matmul with the weights (B) in the block-sparse format
+template <cpu_isa_t isa, impl::data_type_t src_type,
+        impl::data_type_t wei_type = src_type,
+        impl::data_type_t dst_type = src_type>
+struct brgemm_sparse_matmul_t : public primitive_t {
+    struct pd_t : public ::dnnl::impl::cpu::matmul::cpu_matmul_pd_t {
+        using ::dnnl::impl::cpu::matmul::cpu_matmul_pd_t::cpu_matmul_pd_t;
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("brgemm_sparse:", isa, ""),
+                brgemm_sparse_matmul_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+            using smask_t = primitive_attr_t::skip_mask_t;
+            const bool is_int8 = src_type == u8;
+            const auto skip_mask = is_int8
+                    ? smask_t::oscale | smask_t::post_ops
+                    : smask_t::post_ops;
+
+            auto check_bias = [&]() -> bool {
+                if (!with_bias()) return true;
+                const auto bia_dt = weights_md(1)->data_type;
+                const bool bia_dt_ok = is_int8
+                        ? utils::one_of(bia_dt, f32, s32, s8, u8)
+                        : src_type == bf16 ? utils::one_of(bia_dt, f32, bf16)
+                                           : bia_dt == f32;
+                return bia_dt_ok && is_bias_1xN();
+            };
+
+            bool ok = src_md()->data_type == src_type
+                    && weights_md()->data_type == wei_type
+                    && dst_md()->data_type == dst_type
+                    && desc()->accum_data_type == (is_int8 ? s32 : f32)
+                    && check_bias()
+                    && attr()->has_default_values(skip_mask, dst_type)
+                    && attr()->zero_points_.has_default_values()
+                    && ndims() == 2 && !has_runtime_dims_or_strides()
+                    && !has_zero_dim_memory();
+            if (!ok) return status::unimplemented;
+
+            CHECK(brgemm_sparse_utils::init_conf(isa, jbsp_, 1, M(), N(), K(),
+                    src_md_, weights_md_, dst_md_, bias_md_, *attr(),
+                    dnnl_get_max_threads()));
+            CHECK(brgemm_sparse_utils::init_brg_descs(
+                    brg_descs_, jbsp_, attr()));
+
+            auto scratchpad = scratchpad_registry().registrar();
+            brgemm_sparse_utils::init_scratchpad(scratchpad, jbsp_);
+
+            return status::success;
+        }
+
+        brgemm_t brg_descs_[brgemm_sparse_utils::max_num_brg_kernels];
+        jit_brgemm_sparse_conf_t jbsp_;
+    };
+
+    brgemm_sparse_matmul_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override {
+        for_(int i_M = 0; i_M < 2; i_M++)
+        for (int i_N = 0; i_N < 2; i_N++) {
+            const int idx = brgemm_sparse_utils::get_brg_kernel_index(
+                    pd()->jbsp_, i_M, i_N);
+            if (idx < 0) continue;
+
+            brgemm_kernel_t *ker = nullptr;
+            CHECK(brgemm_kernel_create(&ker, pd()->brg_descs_[idx]));
+            CHECK(safe_ptr_assign(brg_kernels_[idx], ker));
+        }
+
+        return status::success;
+    }
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        return execute_body(ctx);
+    }
+
+private:
+    status_t execute_body(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<brgemm_kernel_t>
+            brg_kernels_[brgemm_sparse_utils::max_num_brg_kernels];
+};
+
+} // namespace matmul
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -240,6 +240,7 @@ status_t jit_uni_shuffle_t<data_type_size>::precompute_offsets() {
     input_off_ = (dim_t *)malloc(
             C * sizeof(dim_t), platform::get_cache_line_size());
     if (input_off_ == nullptr) return dnnl_out_of_memory;
+    add_primitive_creation_footprint(C * sizeof(dim_t));
 
     // Precompute input offsets using transposed axis
     parallel_nd(CB, [&](dim_t cb) {
@@ -61,6 +61,12 @@ public:
         return cpu::cpu_engine_impl_list_t::get_concat_implementation_list();
     }
 
+    const multi_reorder_primitive_desc_create_f *
+    get_multi_reorder_implementation_list() const override {
+        return cpu::cpu_engine_impl_list_t::
+                get_multi_reorder_implementation_list();
+    }
+
     const sum_primitive_desc_create_f *
     get_sum_implementation_list() const override {
         return cpu::cpu_engine_impl_list_t::get_sum_implementation_list();
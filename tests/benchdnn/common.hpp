@@ -210,6 +210,7 @@ struct res_t {
     res_state_t state;
     size_t errors, total;
     benchdnn_timer_t timer;
+    benchdnn_timer_t create_timer; // primitive creation (not from the cache)
     std::string impl_name;
     skip_reason_t reason;
 };
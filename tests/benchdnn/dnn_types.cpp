@@ -668,10 +668,17 @@ std::ostream &operator<<(std::ostream &s, const attr_t &attr) {
 std::ostream &dump_global_params(std::ostream &s) {
     s << "--" << driver_name << " ";
     if (canonical) s << "--canonical=" << bool2str(canonical) << " ";
-    if (canonical || engine_tgt_kind != dnnl_cpu)
-        s << "--engine=" << engine_tgt_kind << " ";
+    if (canonical || engine_tgt_kind != dnnl_cpu || engine_index != 0) {
+        s << "--engine=" << engine_tgt_kind;
+        if (engine_index != 0) s << ":" << engine_index;
+        s << " ";
+    }
     if (canonical || fast_ref_gpu != true)
         s << "--fast-ref-gpu=" << bool2str(fast_ref_gpu) << " ";
+    if (canonical || gemm_tune != false)
+        s << "--gemm-tune=" << bool2str(gemm_tune) << " ";
+    if (canonical || huge_pages_mode != dnnl_huge_pages_none)
+        s << "--huge-pages=" << huge_pages_mode2str(huge_pages_mode) << " ";
     if (!skip_impl.empty()) s << "--skip-impl=" << skip_impl << " ";
     if (canonical || mem_check != true)
         s << "--mem-check=" << bool2str(mem_check) << " ";
@@ -705,6 +712,31 @@ dnnl_scratchpad_mode_t str2scratchpad_mode(const char *str) {
     return dnnl_scratchpad_mode_library;
 }
 
+dnnl_huge_pages_mode_t str2huge_pages_mode(const char *str) {
+    const char *param = "none";
+    if (!strncasecmp(param, str, strlen(param))) return dnnl_huge_pages_none;
+
+    param = "madvise";
+    if (!strncasecmp(param, str, strlen(param)))
+        return dnnl_huge_pages_madvise;
+
+    param = "hugetlb";
+    if (!strncasecmp(param, str, strlen(param)))
+        return dnnl_huge_pages_hugetlb;
+
+    assert(!"not expected");
+    return dnnl_huge_pages_none;
+}
+
+const char *huge_pages_mode2str(dnnl_huge_pages_mode_t mode) {
+    switch (mode) {
+        case dnnl_huge_pages_none: return "none";
+        case dnnl_huge_pages_madvise: return "madvise";
+        case dnnl_huge_pages_hugetlb: return "hugetlb";
+        default: assert(!"not expected"); return "none";
+    }
+}
+
 void attr_args_t::prepare_output_scales(
         const attr_t &attr, const void *vals, int64_t count, int mask) {
     insert(DNNL_ARG_ATTR_OUTPUT_SCALES, vals, count, mask, attr.oscale.runtime);
@@ -1235,8 +1267,9 @@ void maybe_post_ops(const attr_t &attr, float &val, float sum_val,
     }
 }
 
-engine_t::engine_t(dnnl_engine_kind_t engine_kind) {
+engine_t::engine_t(dnnl_engine_kind_t engine_kind, size_t index) {
 #ifdef DNNL_SYCL_DPCPP
+    assert(index == 0);
     if (engine_kind == dnnl_cpu) {
         static dnnl_engine_t inst = nullptr;
         if (!inst) DNN_SAFE_V(dnnl_engine_create(&inst, engine_kind, 0));
@@ -1248,7 +1281,7 @@ engine_t::engine_t(dnnl_engine_kind_t engine_kind) {
     } else
         assert(!"unsupported engine_kind");
 #else
-    DNN_SAFE_V(dnnl_engine_create(&engine_, engine_kind, 0));
+    DNN_SAFE_V(dnnl_engine_create(&engine_, engine_kind, index));
 #endif
 }
 
@@ -415,7 +415,7 @@ private:
 };
 
 struct engine_t {
-    engine_t(dnnl_engine_kind_t engine_kind);
+    engine_t(dnnl_engine_kind_t engine_kind, size_t index = 0);
     ~engine_t();
     operator dnnl_engine_t() const { return engine_; }
 
@@ -450,6 +450,8 @@ dnnl_primitive_attr_t create_dnnl_attr(
 
 dnnl_engine_kind_t str2engine_kind(const char *str);
 dnnl_scratchpad_mode_t str2scratchpad_mode(const char *str);
+dnnl_huge_pages_mode_t str2huge_pages_mode(const char *str);
+const char *huge_pages_mode2str(dnnl_huge_pages_mode_t mode);
 
 void maybe_oscale(const attr_t &attr, float &d, float *scales, int64_t oc);
 void maybe_zero_point(const attr_t &attr, float &d, const int32_t *zero_points,
@@ -43,6 +43,12 @@ float round_to_nearest_representable(dnnl_data_type_t dt, float value) {
 
 // Engine kind used to run oneDNN primitives for testing
 dnnl_engine_kind_t engine_tgt_kind = dnnl_cpu;
+// Engine index used to run oneDNN primitives for testing
+size_t engine_index = 0;
+// Huge pages mode of the large buffers allocated by oneDNN
+dnnl_huge_pages_mode_t huge_pages_mode = dnnl_huge_pages_none;
+// Autotuning of the threading of the CPU GEMM
+bool gemm_tune = false;
 
 args_t &args_t::set(int arg, const dnn_mem_t &mem) {
     args_.emplace_back(arg, &mem);
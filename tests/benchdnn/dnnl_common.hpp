@@ -216,6 +216,9 @@ float round_to_nearest_representable(dnnl_data_type_t dt, float value);
 
 /* simplification */
 extern dnnl_engine_kind_t engine_tgt_kind;
+extern size_t engine_index;
+extern dnnl_huge_pages_mode_t huge_pages_mode;
+extern bool gemm_tune;
 
 inline const char *query_impl_info(const_dnnl_primitive_desc_t pd) {
     const char *str;
@@ -242,7 +245,7 @@ private:
 
 // Engine used to run oneDNN primitives for testing.
 inline const engine_t &get_test_engine() {
-    static const engine_t instance(engine_tgt_kind);
+    static const engine_t instance(engine_tgt_kind, engine_index);
     return instance;
 }
 
@@ -280,7 +283,9 @@ int init_prim(dnnl_primitive_t *prim, const func_t &init_pd_func, prb_t *p,
     status = init_pd_func(engine, p, pd, r, dir, hint);
     if (status != OK) return status;
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
+    r->create_timer.start();
     DNN_SAFE_CLEAN(dnnl_primitive_create(&return_prim, pd), WARN, cleanup_pd);
+    r->create_timer.stamp();
     DNN_SAFE_CLEAN(dnnl_primitive_desc_destroy(pd), WARN, cleanup_prim);
     DNN_SAFE(dnnl_primitive_destroy(return_prim), WARN);
 
@@ -291,7 +296,13 @@ int init_prim(dnnl_primitive_t *prim, const func_t &init_pd_func, prb_t *p,
     if (status != OK) return status;
     if (r->state == SKIPPED || r->state == UNIMPLEMENTED) return OK;
     // This primitive is expected to come from the cache.
+#ifdef DNNL_DISABLE_PRIMITIVE_CACHE
+    r->create_timer.start();
+#endif
     DNN_SAFE_CLEAN(dnnl_primitive_create(&return_prim, pd), WARN, cleanup_pd);
+#ifdef DNNL_DISABLE_PRIMITIVE_CACHE
+    r->create_timer.stamp();
+#endif
     DNN_SAFE_CLEAN(dnnl_primitive_desc_destroy(pd), WARN, cleanup_prim);
     (*prim) = return_prim;
     return OK;
@@ -311,6 +311,12 @@ dnnl_format_tag_t str2fmt_tag(const char *str) {
     CASE(abdEc32e);
     CASE(abdEC32e2c);
     CASE(abdEC32e4c);
+    CASE(BA16a64b);
+    CASE(BA16a64b2a);
+    CASE(BA16a64b4a);
+    CASE(aCB16b64c);
+    CASE(aCB16b64c2b);
+    CASE(aCB16b64c4b);
     CASE(x);
     CASE(nc);
     CASE(cn);
@@ -285,8 +285,23 @@ static bool parse_verbose(
 
 static bool parse_engine_kind(
         const char *str, const std::string &option_name = "engine") {
-    return parse_single_value_option(
-            engine_tgt_kind, dnnl_cpu, str2engine_kind, str, option_name);
+    if (!parse_single_value_option(
+                engine_tgt_kind, dnnl_cpu, str2engine_kind, str, option_name))
+        return false;
+
+    // The engine index follows the kind: `--engine=cpu:1`
+    const char *index_str = strchr(str, ':');
+    engine_index = index_str ? (size_t)atoi(index_str + 1) : 0;
+    const size_t count = dnnl_engine_get_count(engine_tgt_kind);
+    if (engine_index >= count) {
+        fprintf(stderr,
+                "%s driver: ERROR: engine index `%zu` is out of range, the "
+                "number of engines of the requested kind is %zu, "
+                "exiting...\n",
+                driver_name, engine_index, count);
+        exit(2);
+    }
+    return true;
 }
 
 static bool parse_fast_ref_gpu(
@@ -295,6 +310,24 @@ static bool parse_fast_ref_gpu(
             fast_ref_gpu, true, str2bool, str, option_name);
 }
 
+static bool parse_gemm_tune(
+        const char *str, const std::string &option_name = "gemm-tune") {
+    if (!parse_single_value_option(
+                gemm_tune, false, str2bool, str, option_name))
+        return false;
+    DNN_SAFE_V(dnnl_set_gemm_tune(gemm_tune));
+    return true;
+}
+
+static bool parse_huge_pages(
+        const char *str, const std::string &option_name = "huge-pages") {
+    if (!parse_single_value_option(huge_pages_mode, dnnl_huge_pages_none,
+                str2huge_pages_mode, str, option_name))
+        return false;
+    DNN_SAFE_V(dnnl_set_huge_pages_mode(huge_pages_mode));
+    return true;
+}
+
 static bool parse_canonical(
         const char *str, const std::string &option_name = "canonical") {
     return parse_single_value_option(
@@ -327,6 +360,7 @@ bool parse_bench_settings(const char *str) {
     return parse_bench_mode(str) || parse_max_ms_per_prb(str)
             || parse_fix_times_per_prb(str) || parse_verbose(str)
             || parse_engine_kind(str) || parse_fast_ref_gpu(str)
+            || parse_gemm_tune(str) || parse_huge_pages(str)
             || parse_canonical(str) || parse_mem_check(str)
             || parse_skip_impl(str) || parse_allow_enum_tags_only(str);
 }
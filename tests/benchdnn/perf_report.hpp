@@ -101,6 +101,7 @@ struct base_perf_report_t {
         HANDLE("freq", s << get_freq());
         HANDLE("ops", s << ops() / unit);
         HANDLE("time", s << t.ms(mode) / unit);
+        HANDLE("ctime", s << r->create_timer.ms(mode) / unit);
         HANDLE("impl", s << r->impl_name);
 
 #undef HANDLE
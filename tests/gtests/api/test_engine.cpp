@@ -0,0 +1,177 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+// Engine 0 spans the whole system and there is an engine per NUMA node on
+// systems with several nodes
+TEST(engine_test, CpuEngineCount) {
+    const size_t count = engine::get_count(engine::kind::cpu);
+    ASSERT_TRUE(count == 1 || count > 2);
+}
+
+TEST(engine_test, AllCpuEngines) {
+    using dt = memory::data_type;
+    using tag = memory::format_tag;
+
+    const memory::dim n = 1 << 20;
+    memory::desc md({n}, dt::f32, tag::a);
+
+    for (size_t idx = 0; idx < engine::get_count(engine::kind::cpu); ++idx) {
+        engine eng(engine::kind::cpu, idx);
+        stream s(eng);
+
+        memory src(md, eng), dst(md, eng);
+        {
+            auto src_data = map_memory<float>(src);
+            for (memory::dim i = 0; i < n; ++i)
+                src_data[i] = float(i % 97);
+        }
+
+        eltwise_forward::primitive_desc pd(
+                {prop_kind::forward_inference, algorithm::eltwise_linear, md,
+                        2.f, 1.f},
+                eng);
+        eltwise_forward(pd).execute(
+                s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+        s.wait();
+
+        auto dst_data = map_memory<float>(dst);
+        for (memory::dim i = 0; i < n; ++i)
+            ASSERT_EQ(dst_data[i], 2.f * float(i % 97) + 1.f)
+                    << "engine " << idx;
+    }
+}
+
+namespace {
+std::atomic<int> n_allocations {0};
+std::atomic<int> n_deallocations {0};
+
+void *test_allocate(size_t size, size_t alignment) {
+    n_allocations++;
+    void *ptr = nullptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc(size, alignment);
+#else
+    if (posix_memalign(&ptr, alignment, size) != 0) ptr = nullptr;
+#endif
+    return ptr;
+}
+
+void test_deallocate(void *ptr) {
+    n_deallocations++;
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+void run_eltwise(const engine &eng, memory::dim n) {
+    memory::desc md({n}, memory::data_type::f32, memory::format_tag::a);
+    stream s(eng);
+
+    memory src(md, eng), dst(md, eng);
+    {
+        auto src_data = map_memory<float>(src);
+        for (memory::dim i = 0; i < n; ++i)
+            src_data[i] = float(i % 97);
+    }
+
+    eltwise_forward::primitive_desc pd(
+            {prop_kind::forward_inference, algorithm::eltwise_linear, md, 2.f,
+                    1.f},
+            eng);
+    eltwise_forward(pd).execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    s.wait();
+
+    auto dst_data = map_memory<float>(dst);
+    for (memory::dim i = 0; i < n; ++i)
+        ASSERT_EQ(dst_data[i], 2.f * float(i % 97) + 1.f);
+}
+} // namespace
+
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL
+TEST(engine_test, CpuEngineWithAllocator) {
+    n_allocations = n_deallocations = 0;
+    {
+        engine eng(engine::kind::cpu, 0, test_allocate, test_deallocate);
+        run_eltwise(eng, 1 << 10);
+    }
+    // The source and the destination memory objects
+    ASSERT_GE(n_allocations, 2);
+    ASSERT_EQ(n_allocations, n_deallocations);
+
+    dnnl_engine_t c_engine;
+    ASSERT_EQ(dnnl_engine_create_with_allocator(
+                      &c_engine, dnnl_cpu, 0, nullptr, test_deallocate),
+            dnnl_invalid_arguments);
+}
+#endif
+
+TEST(engine_test, HugePages) {
+    ASSERT_EQ(dnnl_set_huge_pages_mode((dnnl_huge_pages_mode_t)3),
+            dnnl_invalid_arguments);
+
+    engine eng(engine::kind::cpu, 0);
+    for (auto mode : {huge_pages_mode::madvise, huge_pages_mode::hugetlb}) {
+        ASSERT_EQ(set_huge_pages_mode(mode), status::success);
+        // The buffers of 2 MB and more use huge pages
+        run_eltwise(eng, (1 << 20) + 3);
+    }
+    ASSERT_EQ(set_huge_pages_mode(huge_pages_mode::none), status::success);
+}
+
+#if defined(__linux__)
+// The threads of the application are only bound to the node while they
+// execute the primitives of a node engine
+TEST(engine_test, NumaEngineRestoresAffinity) {
+    SKIP_IF(engine::get_count(engine::kind::cpu) < 2,
+            "The system has a single NUMA node");
+    using dt = memory::data_type;
+    using tag = memory::format_tag;
+
+    cpu_set_t before, after;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+
+    memory::desc md({1 << 16}, dt::f32, tag::a);
+    engine eng(engine::kind::cpu, 1);
+    stream s(eng);
+    memory src(md, eng), dst(md, eng);
+    eltwise_forward::primitive_desc pd(
+            {prop_kind::forward_inference, algorithm::eltwise_relu, md, 0.f},
+            eng);
+    eltwise_forward(pd).execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    s.wait();
+
+    ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+    ASSERT_TRUE(CPU_EQUAL(&before, &after));
+}
+#endif
+
+} // namespace dnnl
@@ -30,7 +30,7 @@ static bool are_valid_flags(
     if (engine_kind == dnnl_gpu && (stream_flags & dnnl_stream_out_of_order))
         ok = false;
 #endif
-#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     if (engine_kind == dnnl_cpu && (stream_flags & dnnl_stream_out_of_order))
         ok = false;
 #endif
@@ -133,6 +133,59 @@ TEST(stream_test_c, GetStream) {
     DNNL_CHECK(dnnl_engine_destroy(engine));
 }
 
+TEST(stream_test_cpp, OutOfOrderDependencies) {
+    SKIP_IF(!are_valid_flags(dnnl_cpu, dnnl_stream_out_of_order),
+            "Incompatible stream flags.");
+
+    using dt = memory::data_type;
+    using tag = memory::format_tag;
+    using alg = algorithm;
+
+    engine eng(engine::kind::cpu, 0);
+    const memory::dim n = 1 << 16;
+    memory::desc md({n}, dt::f32, tag::a);
+
+    auto linear = [&](float alpha, float beta) {
+        return eltwise_forward(eltwise_forward::primitive_desc(
+                {prop_kind::forward_inference, alg::eltwise_linear, md, alpha,
+                        beta},
+                eng));
+    };
+    binary add(binary::primitive_desc({alg::binary_add, md, md, md}, eng));
+
+    for (int iter = 0; iter < 8; ++iter) {
+        memory src(md, eng), b0(md, eng), b1(md, eng), dst(md, eng);
+        {
+            auto src_data = map_memory<float>(src);
+            for (memory::dim i = 0; i < n; ++i)
+                src_data[i] = float(i % 113);
+        }
+
+        stream s(eng, stream::flags::out_of_order);
+        // Two independent branches, the primitives are destroyed right after
+        // the submission
+        linear(2.f, 1.f).execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, b0}});
+        linear(-1.f, 3.f).execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, b1}});
+        // In-place update of the second branch
+        linear(0.5f, 0.f).execute(s, {{DNNL_ARG_SRC, b1}, {DNNL_ARG_DST, b1}});
+        // Join
+        add.execute(s,
+                {{DNNL_ARG_SRC_0, b0}, {DNNL_ARG_SRC_1, b1},
+                        {DNNL_ARG_DST, dst}});
+        // Overwrite the source read by both branches
+        linear(0.f, 7.f).execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, src}});
+        s.wait();
+
+        auto src_data = map_memory<float>(src);
+        auto dst_data = map_memory<float>(dst);
+        for (memory::dim i = 0; i < n; ++i) {
+            const float x = float(i % 113);
+            ASSERT_EQ(dst_data[i], (2.f * x + 1.f) + 0.5f * (3.f - x));
+            ASSERT_EQ(src_data[i], 7.f);
+        }
+    }
+}
+
 namespace {
 struct PrintToStringParamName {
     template <class ParamType>
@@ -0,0 +1,152 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+namespace dnnl {
+
+TEST(parallel_test, ParallelVisitsEachThreadOnce) {
+    const int nthr = dnnl_get_max_threads();
+    std::vector<std::atomic<int>> visits(nthr);
+    for (auto &v : visits)
+        v = 0;
+
+    impl::parallel(nthr, [&](int ithr, int nthr_) {
+        ASSERT_EQ(nthr_, nthr);
+        visits[ithr]++;
+    });
+    for (int ithr = 0; ithr < nthr; ++ithr)
+        ASSERT_EQ(visits[ithr], 1) << "thread " << ithr;
+}
+
+TEST(parallel_test, ParallelNdVisitsEachPointOnce) {
+    for (int n : {1, 7, 1000, 100003}) {
+        std::vector<int> visits(n, 0);
+        impl::parallel_nd(n, [&](int i) { visits[i]++; });
+        for (int i = 0; i < n; ++i)
+            ASSERT_EQ(visits[i], 1) << "point " << i << " of " << n;
+    }
+
+    const int D0 = 5, D1 = 7, D2 = 11;
+    std::vector<int> visits(D0 * D1 * D2, 0);
+    impl::parallel_nd(D0, D1, D2, [&](int d0, int d1, int d2) {
+        visits[(d0 * D1 + d1) * D2 + d2]++;
+    });
+    for (size_t i = 0; i < visits.size(); ++i)
+        ASSERT_EQ(visits[i], 1) << "point " << i;
+}
+
+TEST(parallel_test, NestedParallelNd) {
+    const int n = 64;
+    std::vector<int> visits(n * n, 0);
+    impl::parallel_nd(n, [&](int i) {
+        impl::parallel_nd(n, [&](int j) { visits[i * n + j]++; });
+    });
+    for (size_t i = 0; i < visits.size(); ++i)
+        ASSERT_EQ(visits[i], 1) << "point " << i;
+}
+
+TEST(parallel_test, NestedParallelNdWithThreadsLimit) {
+    const int n = 64, nouter = 2;
+    std::vector<std::atomic<int>> visits(nouter * n);
+    for (auto &v : visits)
+        v = 0;
+    std::atomic<int> nerrors(0);
+    impl::parallel(nouter, [&](int ithr, int) {
+        // The limit is the budget of the nested region
+        impl::max_threads_limit_scope_t scope(2);
+        if (dnnl_get_current_num_threads() > 2) nerrors++;
+        impl::parallel_nd(n, [&](int i) {
+            // no further nesting
+            if (dnnl_get_current_num_threads() != 1) nerrors++;
+            visits[ithr * n + i]++;
+        });
+    });
+    ASSERT_EQ(nerrors, 0);
+    for (size_t i = 0; i < visits.size(); ++i)
+        ASSERT_EQ(visits[i], 1) << "point " << i;
+}
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+// Run with OMP_DYNAMIC=true and OMP_THREAD_LIMIT set, the limit on the number
+// of threads being above the thread limit
+TEST(parallel_test, NestedParallelFullTeamWithThreadLimit) {
+    const int thread_limit = omp_get_thread_limit();
+    SKIP_IF(thread_limit > 64, "OMP_THREAD_LIMIT is not set");
+    const int nouter = 2;
+    std::atomic<int> nerrors(0);
+    impl::parallel(nouter, [&](int, int) {
+        omp_set_dynamic(1);
+        omp_set_num_threads(2 * thread_limit);
+        impl::max_threads_limit_scope_t scope(2 * thread_limit);
+        const int nthr = dnnl_get_current_num_threads();
+        if (nthr * nouter > thread_limit) nerrors++;
+        std::vector<std::atomic<int>> visits(nthr);
+        for (auto &v : visits)
+            v = 0;
+        impl::parallel(nthr, [&](int ithr, int nthr_) {
+            if (nthr_ != nthr) nerrors++;
+            visits[ithr]++;
+        });
+        for (auto &v : visits)
+            if (v != 1) nerrors++;
+        if (!omp_get_dynamic()) nerrors++;
+    });
+    ASSERT_EQ(nerrors, 0);
+}
+#endif
+
+TEST(parallel_test, ConcurrentParallelNd) {
+    const int nthr = 4, n = 10000;
+    std::atomic<int> nerrors(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nthr; ++t)
+        threads.emplace_back([&]() {
+            for (int iter = 0; iter < 20; ++iter) {
+                std::vector<int> visits(n, 0);
+                impl::parallel_nd(n, [&](int i) { visits[i]++; });
+                for (int v : visits)
+                    if (v != 1) nerrors++;
+            }
+        });
+    for (auto &t : threads)
+        t.join();
+    ASSERT_EQ(nerrors, 0);
+}
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_NATIVE
+TEST(parallel_test, Barrier) {
+    const int nthr = dnnl_get_max_threads();
+    std::atomic<int> arrived(0), nerrors(0);
+    impl::parallel(nthr, [&](int ithr, int nthr_) {
+        for (int step = 1; step <= 3; ++step) {
+            arrived++;
+            dnnl_thr_barrier();
+            if (arrived != step * nthr_) nerrors++;
+            dnnl_thr_barrier();
+        }
+    });
+    ASSERT_EQ(nerrors, 0);
+}
+#endif
+
+} // namespace dnnl
@@ -56,14 +56,6 @@
     CPU_INST_TEST_CASE_( \
             CONCAT_WITH_UNDERSCORE(str, TEST_CASE_NAME_PREFIX), __VA_ARGS__)
 
-// Declare bfloat16 GEMM interfaces for testing
-extern "C" {
-dnnl_status_t dnnl_gemm_bf16bf16f32(char transa, char transb, dnnl_dim_t M,
-        dnnl_dim_t N, dnnl_dim_t K, float alpha, const bfloat16_t *A,
-        dnnl_dim_t lda, const bfloat16_t *B, dnnl_dim_t ldb, float beta,
-        float *C, dnnl_dim_t ldc);
-}
-
 // Declare packed GEMM interfaces for testing
 #include "src/cpu/gemm/gemm_pack.hpp"
 
@@ -398,6 +390,33 @@ struct ref_gemm<a_dt, b_dt, int32_t> {
     }
 };
 
+// Fills the matrix with the integers of [shift, shift + range): the sums of
+// their products are exact in f32, so that a result can be compared to the
+// reference exactly whatever the order of the summation
+inline void fill_exact_matrix(
+        std::vector<float> &v, int range, int shift = 0, int seed = 0) {
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = (float)((int)((i + seed) % range) + shift);
+}
+
+// Computes C = alpha * op(A) * op(B) + beta * C for the row-major matrices of
+// the tests calling the C API directly
+inline void ref_sgemm(char transa, char transb, int64_t M, int64_t N,
+        int64_t K, float alpha, const float *A, int64_t lda, const float *B,
+        int64_t ldb, float beta, float *C, int64_t ldc) {
+    const bool tr_a = transa == 'T' || transa == 't';
+    const bool tr_b = transb == 'T' || transb == 't';
+    for (int64_t m = 0; m < M; m++)
+        for (int64_t n = 0; n < N; n++) {
+            float acc = 0.f;
+            for (int64_t k = 0; k < K; k++)
+                acc += A[tr_a ? k * lda + m : m * lda + k]
+                        * B[tr_b ? n * ldb + k : k * ldb + n];
+            float &c = C[m * ldc + n];
+            c = alpha * acc + (beta == 0.f ? 0.f : beta * c);
+        }
+}
+
 template <typename a_dt, typename c_dt>
 void compare(const test_params &p, const test_memory &c_mem,
         const test_memory &c_ref_mem) {
@@ -836,69 +855,53 @@ struct dnnl_gemm<bfloat16_t, bfloat16_t, float> {
     static dnnl_status_t call_packed(const test_params &p,
             const test_memory &a_mem, const test_memory &b_mem,
             const test_memory &c_mem) {
-        /* Alas, the internal API still uses Fortran notation.
-         * So in addition to the changes for pack API, we also need to take
-         * care of conversions and layouts */
-
-        using namespace dnnl::impl::cpu;
-
+        /* The public pack API uses the row-major notation as the GEMM
+         * itself */
         assert(p.alpha == 1.f);
 
-        /* Prepare for Fortran style, hence A <-> B */
-        char trans_a = p.transB, trans_b = p.transA;
+        char trans_a = p.transA, trans_b = p.transB;
 
-        int64_t m = p.N, n = p.M, k = p.K;
-        int64_t lda = p.ldb, ldb = p.lda, ldc = p.ldc;
-
-        std::vector<bfloat16_t> a_pack_buf, b_pack_buf;
-        bfloat16_t *A = map_memory<bfloat16_t>(b_mem), *a_eff = A;
-        bfloat16_t *B = map_memory<bfloat16_t>(a_mem), *b_eff = B;
+        std::vector<uint16_t> a_pack_buf, b_pack_buf;
+        bfloat16_t *A = map_memory<bfloat16_t>(a_mem);
+        bfloat16_t *B = map_memory<bfloat16_t>(b_mem);
+        const uint16_t *a_eff = (const uint16_t *)A;
+        const uint16_t *b_eff = (const uint16_t *)B;
         float *C = map_memory<float>(c_mem);
 
-        bool pack_a = p.pack_params.pack_b;
-        bool pack_b = p.pack_params.pack_a;
-
         dnnl_status_t status = dnnl_success;
 
-        if (pack_a) {
+        if (p.pack_params.pack_a) {
             size_t a_sz;
-            status = gemm_bf16bf16f32_pack_get_size("A", &trans_a, &trans_b, &m,
-                    &n, &k, &lda, &ldb, &a_sz, &pack_a);
+            status = dnnl_gemm_bf16bf16f32_pack_get_size('A', p.transA,
+                    p.transB, p.M, p.N, p.K, p.lda, p.ldb, &a_sz);
             if (status != dnnl_success) return status;
 
-            if (pack_a) {
-                a_pack_buf.resize(a_sz / sizeof(*a_eff));
-                a_eff = a_pack_buf.data();
+            a_pack_buf.resize(a_sz / sizeof(uint16_t));
+            status = dnnl_gemm_bf16bf16f32_pack('A', p.transA, p.transB, p.M,
+                    p.N, p.K, p.lda, p.ldb, a_eff, a_pack_buf.data());
+            if (status != dnnl_success) return status;
 
-                status = gemm_bf16bf16f32_pack("A", &trans_a, &trans_b, &m, &n,
-                        &k, &lda, &ldb, A, a_eff);
-                if (status != dnnl_success) return status;
-            }
+            a_eff = a_pack_buf.data();
+            trans_a = 'P';
         }
 
-        if (pack_b) {
+        if (p.pack_params.pack_b) {
             size_t b_sz;
-            status = gemm_bf16bf16f32_pack_get_size("B", &trans_a, &trans_b, &m,
-                    &n, &k, &lda, &ldb, &b_sz, &pack_b);
+            status = dnnl_gemm_bf16bf16f32_pack_get_size('B', p.transA,
+                    p.transB, p.M, p.N, p.K, p.lda, p.ldb, &b_sz);
             if (status != dnnl_success) return status;
 
-            if (pack_b) {
-                b_pack_buf.resize(b_sz / sizeof(*b_eff));
-                b_eff = b_pack_buf.data();
+            b_pack_buf.resize(b_sz / sizeof(uint16_t));
+            status = dnnl_gemm_bf16bf16f32_pack('B', p.transA, p.transB, p.M,
+                    p.N, p.K, p.lda, p.ldb, b_eff, b_pack_buf.data());
+            if (status != dnnl_success) return status;
 
-                status = gemm_bf16bf16f32_pack("B", &trans_a, &trans_b, &m, &n,
-                        &k, &lda, &ldb, B, b_eff);
-                if (status != dnnl_success) return status;
-            }
+            b_eff = b_pack_buf.data();
+            trans_b = 'P';
         }
 
-        if (pack_a) trans_a = 'P';
-        if (pack_b) trans_b = 'P';
-
-        status = gemm_bf16bf16f32_compute(&trans_a, &trans_b, &m, &n, &k, a_eff,
-                &lda, b_eff, &ldb, &p.beta, C, &ldc);
-
-        return status;
+        return dnnl_gemm_bf16bf16f32_compute(trans_a, trans_b, p.M, p.N, p.K,
+                a_eff, p.lda, b_eff, p.ldb, p.beta, C, p.ldc);
     }
 
     static dnnl_status_t call(const test_params &p, const test_memory &a_mem,
@@ -911,7 +914,8 @@ struct dnnl_gemm<bfloat16_t, bfloat16_t, float> {
         auto B = map_memory<bfloat16_t>(b_mem);
         auto C = map_memory<float>(c_mem);
         return dnnl_gemm_bf16bf16f32(p.transA, p.transB, p.M, p.N, p.K, p.alpha,
-                A, p.lda, B, p.ldb, p.beta, C, p.ldc);
+                (const uint16_t *)(bfloat16_t *)A, p.lda,
+                (const uint16_t *)(bfloat16_t *)B, p.ldb, p.beta, C, p.ldc);
     }
 };
 
@@ -0,0 +1,133 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.h"
+#include "test_gemm_common.hpp"
+
+namespace dnnl {
+
+struct gemm_grouped_test_params_t {
+    char transa, transb;
+    memory::dim group_size;
+    float alpha, beta;
+    // Number of the distinct matrices B, shared by the GEMMs of the group
+    memory::dim nweights;
+};
+
+// Each GEMM of the group must compute the same result as the reference,
+// whether its matrix B is packed or not
+class gemm_grouped_test_t
+    : public ::testing::TestWithParam<gemm_grouped_test_params_t> {
+protected:
+    void SetUp() override {
+        SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+                "GEMM is supported on CPU only");
+        auto p = ::testing::TestWithParam<
+                gemm_grouped_test_params_t>::GetParam();
+        Test(p);
+    }
+
+    void Test(const gemm_grouped_test_params_t &p) {
+        const bool ta = p.transa == 'T', tb = p.transb == 'T';
+        const memory::dim gs = p.group_size;
+        // The GEMMs sharing a matrix B have the same N and K
+        const memory::dim N0 = 48, K0 = 40;
+
+        std::vector<memory::dim> M(gs), N(gs), K(gs), lda(gs), ldb(gs),
+                ldc(gs);
+        std::vector<std::vector<float>> A_data(gs), B_data(p.nweights),
+                C_data(gs), ref(gs);
+        std::vector<const float *> A(gs), B(gs);
+        std::vector<float *> C(gs);
+
+        for (memory::dim w = 0; w < p.nweights; w++) {
+            B_data[w].resize((tb ? N0 + w : K0 + w) * (tb ? K0 + w : N0 + w));
+            fill_exact_matrix(B_data[w], 7, -3, (int)w);
+        }
+
+        for (memory::dim g = 0; g < gs; g++) {
+            const memory::dim w = g % p.nweights;
+            M[g] = 1 + (g * 37) % 70;
+            N[g] = N0 + w;
+            K[g] = K0 + w;
+            lda[g] = (ta ? M[g] : K[g]) + g % 3;
+            ldb[g] = tb ? K[g] : N[g];
+            ldc[g] = N[g] + 1;
+
+            A_data[g].resize((ta ? K[g] : M[g]) * lda[g]);
+            fill_exact_matrix(A_data[g], 5, -2, (int)g);
+            C_data[g].resize(M[g] * ldc[g]);
+            fill_exact_matrix(C_data[g], 3);
+
+            A[g] = A_data[g].data();
+            B[g] = B_data[w].data();
+            C[g] = C_data[g].data();
+
+            ref[g] = C_data[g];
+            ref_sgemm(p.transa, p.transb, M[g], N[g], K[g], p.alpha, A[g],
+                    lda[g], B[g], ldb[g], p.beta, ref[g].data(), ldc[g]);
+        }
+
+        ASSERT_EQ(dnnl_sgemm_grouped(p.transa, p.transb, gs, M.data(),
+                          N.data(), K.data(), p.alpha, A.data(), lda.data(),
+                          B.data(), ldb.data(), p.beta, C.data(), ldc.data()),
+                dnnl_success);
+
+        for (memory::dim g = 0; g < gs; g++)
+            for (memory::dim m = 0; m < M[g]; m++)
+                for (memory::dim n = 0; n < N[g]; n++)
+                    ASSERT_EQ(C_data[g][m * ldc[g] + n],
+                            ref[g][m * ldc[g] + n])
+                            << "g: " << g << " m: " << m << " n: " << n;
+    }
+};
+
+TEST_P(gemm_grouped_test_t, TestGemmGrouped) {}
+
+using params = gemm_grouped_test_params_t;
+INSTANTIATE_TEST_SUITE_P(TestGemmGrouped, gemm_grouped_test_t,
+        ::testing::Values(params {'N', 'N', 1, 1.f, 0.f, 1},
+                params {'N', 'N', 32, 1.f, 0.f, 4},
+                params {'N', 'T', 17, 1.f, 1.f, 3},
+                params {'T', 'N', 9, 2.f, 0.f, 2},
+                params {'T', 'T', 24, 1.f, 0.5f, 24}));
+
+HANDLE_EXCEPTIONS_FOR_TEST(gemm_grouped_test, TestInvalidArguments) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "GEMM is supported on CPU only");
+    const memory::dim M = 4, N = 4, K = 4, ld = 4, small_ld = 2;
+    std::vector<float> data(M * ld);
+    const float *A = data.data(), *B = data.data();
+    float *C = data.data();
+
+    EXPECT_EQ(dnnl_sgemm_grouped('N', 'N', 0, nullptr, nullptr, nullptr, 1.f,
+                      nullptr, nullptr, nullptr, nullptr, 0.f, nullptr,
+                      nullptr),
+            dnnl_success);
+    EXPECT_EQ(dnnl_sgemm_grouped('N', 'N', 1, &M, &N, &K, 1.f, &A, &small_ld,
+                      &B, &ld, 0.f, &C, &ld),
+            dnnl_invalid_arguments);
+    EXPECT_EQ(dnnl_sgemm_grouped('P', 'N', 1, &M, &N, &K, 1.f, &A, &ld, &B,
+                      &ld, 0.f, &C, &ld),
+            dnnl_invalid_arguments);
+}
+
+} // namespace dnnl
@@ -0,0 +1,86 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.h"
+#include "test_gemm_common.hpp"
+
+namespace dnnl {
+
+struct gemm_tune_test_params_t {
+    char transa, transb;
+    memory::dim M, N, K;
+    float beta;
+};
+
+// The tuning call and the calls reusing the tuned variant must compute the
+// same result as the reference, whatever variant wins
+class gemm_tune_test_t
+    : public ::testing::TestWithParam<gemm_tune_test_params_t> {
+protected:
+    void SetUp() override {
+        SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+                "GEMM is supported on CPU only");
+        auto p = ::testing::TestWithParam<gemm_tune_test_params_t>::GetParam();
+        ASSERT_EQ(dnnl_set_gemm_tune(1), dnnl_success);
+        Test(p);
+        ASSERT_EQ(dnnl_set_gemm_tune(0), dnnl_success);
+    }
+
+    void Test(const gemm_tune_test_params_t &p) {
+        const bool ta = p.transa == 'T', tb = p.transb == 'T';
+        const memory::dim M = p.M, N = p.N, K = p.K;
+        const memory::dim lda = (ta ? M : K) + 1, ldb = (tb ? K : N) + 3;
+        const memory::dim ldc = N + 2;
+
+        std::vector<float> A((ta ? K : M) * lda), B((tb ? N : K) * ldb);
+        fill_exact_matrix(A, 5, -2);
+        fill_exact_matrix(B, 7, -3);
+
+        std::vector<float> C_init(M * ldc);
+        fill_exact_matrix(C_init, 3);
+        std::vector<float> ref(C_init);
+        ref_sgemm(p.transa, p.transb, M, N, K, 1.f, A.data(), lda, B.data(),
+                ldb, p.beta, ref.data(), ldc);
+
+        for (int call = 0; call < 2; call++) {
+            std::vector<float> C(C_init);
+            ASSERT_EQ(dnnl_sgemm(p.transa, p.transb, M, N, K, 1.f, A.data(),
+                              lda, B.data(), ldb, p.beta, C.data(), ldc),
+                    dnnl_success);
+            for (memory::dim m = 0; m < M; m++)
+                for (memory::dim n = 0; n < N; n++)
+                    ASSERT_EQ(C[m * ldc + n], ref[m * ldc + n])
+                            << "call: " << call << " m: " << m << " n: " << n;
+        }
+    }
+};
+
+TEST_P(gemm_tune_test_t, TestGemmTune) {}
+
+using params = gemm_tune_test_params_t;
+INSTANTIATE_TEST_SUITE_P(TestGemmTune, gemm_tune_test_t,
+        ::testing::Values(params {'N', 'N', 64, 2000, 512, 0.f},
+                params {'N', 'T', 64, 1500, 1024, 1.f},
+                params {'T', 'N', 700, 40, 300, 2.f},
+                params {'N', 'N', 48, 48, 3000, 1.f},
+                params {'T', 'T', 257, 129, 65, 0.5f}));
+
+} // namespace dnnl
@@ -19,6 +19,10 @@
 
 #include "oneapi/dnnl/dnnl.hpp"
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+#include <omp.h>
+#endif
+
 namespace dnnl {
 
 using data_type = memory::data_type;
@@ -96,6 +100,119 @@ HANDLE_EXCEPTIONS_FOR_TEST_F(attr_test_t, TestScratchpadArg) {
     }
 }
 
+TEST_F(attr_test_t, TestMaxThreads) {
+    dnnl::primitive_attr attr;
+    ASSERT_EQ(attr.get_max_threads(), 0);
+    for (int n : {1, 3, 0, DNNL_MAX_THREADS_AUTO}) {
+        attr.set_max_threads(n);
+        ASSERT_EQ(attr.get_max_threads(), n);
+    }
+    EXPECT_ANY_THROW(attr.set_max_threads(-2));
+}
+
+HANDLE_EXCEPTIONS_FOR_TEST_F(attr_test_t, TestMaxThreadsExec) {
+    engine eng = get_test_engine();
+
+    memory::desc data_md(
+            {64, 1000}, memory::data_type::f32, memory::format_tag::nc);
+    auto softmax_d
+            = softmax_forward::desc(prop_kind::forward_inference, data_md, 1);
+
+    auto src = test::make_memory(data_md, eng);
+    auto ref = test::make_memory(data_md, eng);
+    fill_data<float>(data_md.get_size() / sizeof(float), src);
+
+    stream s(eng);
+    softmax_forward(softmax_forward::primitive_desc(softmax_d, eng))
+            .execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, ref}});
+
+    // The rows are independent, so the result does not depend on the number
+    // of threads
+    for (int n : {1, 2, DNNL_MAX_THREADS_AUTO}) {
+        dnnl::primitive_attr attr;
+        attr.set_max_threads(n);
+        auto softmax_pd = softmax_forward::primitive_desc(softmax_d, attr, eng);
+        ASSERT_EQ(softmax_pd.get_primitive_attr().get_max_threads(), n);
+
+        auto dst = test::make_memory(data_md, eng);
+        softmax_forward(softmax_pd).execute(
+                s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+        s.wait();
+
+        auto dst_data = map_memory<const float>(dst);
+        auto ref_data = map_memory<const float>(ref);
+        for (memory::dim i = 0; i < 64 * 1000; ++i)
+            ASSERT_EQ(dst_data[i], ref_data[i]) << "max_threads " << n;
+    }
+}
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+// Batch normalization synchronizes its threads with barriers, so it hangs if
+// it expects more threads than the nested team of the application thread has
+HANDLE_EXCEPTIONS_FOR_TEST_F(attr_test_t, TestMaxThreadsNestedExec) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Nested parallelism is supported on CPU only");
+    engine eng = get_test_engine();
+
+    const memory::dim N = 16, C = 32, H = 9, W = 9;
+    memory::desc data_md(
+            {N, C, H, W}, data_type::f32, memory::format_tag::nChw16c);
+    const auto prop = prop_kind::forward_inference;
+    auto bnorm_d = batch_normalization_forward::desc(
+            prop, data_md, 1e-5f, normalization_flags::none);
+
+    auto src = test::make_memory(data_md, eng);
+    auto ref = test::make_memory(data_md, eng);
+    fill_data<float>(data_md.get_size() / sizeof(float), src);
+
+    stream s(eng);
+    batch_normalization_forward(
+            batch_normalization_forward::primitive_desc(bnorm_d, eng))
+            .execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, ref}});
+    s.wait();
+
+    // The limit is above the OpenMP thread limit of the run with
+    // OMP_THREAD_LIMIT=4. The primitive is created for as many threads as it
+    // may be executed with.
+    const int max_threads = omp_get_max_threads();
+    omp_set_num_threads(8);
+    dnnl::primitive_attr attr;
+    attr.set_max_threads(8);
+    auto bnorm = batch_normalization_forward(
+            batch_normalization_forward::primitive_desc(bnorm_d, attr, eng));
+    omp_set_num_threads(max_threads);
+
+    const int nouter = 2;
+    std::vector<memory> dst(nouter);
+    for (auto &d : dst)
+        d = test::make_memory(data_md, eng);
+
+    const int max_active_levels = omp_get_max_active_levels();
+    // Every outer thread executes the primitive, while the runtime may give
+    // the nested regions fewer threads than requested with dynamic teams
+    const int dynamic = omp_get_dynamic();
+    omp_set_dynamic(0);
+#pragma omp parallel num_threads(nouter)
+    {
+        omp_set_dynamic(1);
+        omp_set_num_threads(8);
+        const int ithr = omp_get_thread_num();
+        stream s_ithr(eng);
+        bnorm.execute(s_ithr, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst[ithr]}});
+        s_ithr.wait();
+    }
+    omp_set_dynamic(dynamic);
+    ASSERT_EQ(omp_get_max_active_levels(), max_active_levels);
+
+    auto ref_data = map_memory<const float>(ref);
+    for (int i = 0; i < nouter; ++i) {
+        auto dst_data = map_memory<const float>(dst[i]);
+        for (memory::dim j = 0; j < N * C * H * W; ++j)
+            ASSERT_NEAR(dst_data[j], ref_data[j], 1e-4f) << "thread " << i;
+    }
+}
+#endif
+
 HANDLE_EXCEPTIONS_FOR_TEST_F(attr_test_t, TestIntOutputScales) {
     dnnl::primitive_attr attr;
 
@@ -96,6 +96,20 @@ TEST(primitive_cache_test, TestSizeGreaterCapacity) {
     ASSERT_EQ(get_primitive_cache_size(), 10);
 }
 
+TEST(primitive_cache_test, TestCapacityBytes) {
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(16);
+    set_primitive_cache_capacity_bytes(1);
+    ASSERT_EQ(get_primitive_cache_capacity_bytes(), 1u);
+    // Every primitive occupies more than a byte
+    fill_primitive_cache(4);
+    ASSERT_EQ(get_primitive_cache_size(), 0);
+
+    set_primitive_cache_capacity_bytes(0);
+    fill_primitive_cache(4);
+    ASSERT_EQ(get_primitive_cache_size(), 4);
+}
+
 TEST(primitive_cache_test, TestCacheHit) {
     set_primitive_cache_capacity(0);
     set_primitive_cache_capacity(2);
@@ -0,0 +1,225 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using dt = memory::data_type;
+using tag = memory::format_tag;
+
+struct weights_decompression_test_params_t {
+    dt src_dt, wei_dt;
+    tag wei_tag;
+    memory::dim M, N, K;
+    memory::dim group_size;
+    bool with_zero_points;
+    bool with_bias;
+};
+
+// The matmul with the compressed weights must match the reference computed
+// with the weights decompressed in advance
+class weights_decompression_test_t
+    : public ::testing::TestWithParam<weights_decompression_test_params_t> {
+protected:
+    void SetUp() override {
+        SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+                "Weights decompression is supported on CPU only");
+        catch_expected_failures([=]() { Test(); }, false, dnnl_success, true);
+    }
+
+    static int wei_value(dt wei_dt, memory::dim k, memory::dim n) {
+        switch (wei_dt) {
+            case dt::s8: return (int)((k * 3 + n * 5) % 11) - 5;
+            case dt::u8: return (int)((k * 3 + n * 5) % 11);
+            case dt::s4: return (int)((k * 3 + n * 5) % 16) - 8;
+            case dt::u4: return (int)((k * 3 + n * 5) % 16);
+            default: return 0;
+        }
+    }
+
+    // Powers of two and small integers keep the results exact
+    static float scale_value(memory::dim g, memory::dim n) {
+        static const float values[] = {0.5f, 1.f, 2.f};
+        return values[(g + n) % 3];
+    }
+
+    static float zero_point_value(memory::dim g, memory::dim n) {
+        return (float)((g + 2 * n) % 4);
+    }
+
+    static float src_value(memory::dim m, memory::dim k) {
+        return (float)((m * 5 + k * 11) % 7) - 3.f;
+    }
+
+    void Test() {
+        auto p = ::testing::TestWithParam<
+                weights_decompression_test_params_t>::GetParam();
+        const memory::dim M = p.M, N = p.N, K = p.K;
+        const memory::dim G = p.group_size ? K / p.group_size : 1;
+        const bool is_4bit = p.wei_dt == dt::s4 || p.wei_dt == dt::u4;
+
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        std::vector<float> src(M * K), scales(G * N), zero_points(G * N),
+                bias(N), ref(M * N);
+        for (memory::dim m = 0; m < M; m++)
+            for (memory::dim k = 0; k < K; k++)
+                src[m * K + k] = src_value(m, k);
+        for (memory::dim g = 0; g < G; g++)
+            for (memory::dim n = 0; n < N; n++) {
+                scales[g * N + n] = scale_value(g, n);
+                zero_points[g * N + n] = zero_point_value(g, n);
+            }
+        for (memory::dim n = 0; n < N; n++)
+            bias[n] = p.with_bias ? (float)(n % 4) : 0.f;
+        for (memory::dim m = 0; m < M; m++)
+            for (memory::dim n = 0; n < N; n++) {
+                float acc = bias[n];
+                for (memory::dim k = 0; k < K; k++) {
+                    const memory::dim g = p.group_size ? k / p.group_size : 0;
+                    const float zp
+                            = p.with_zero_points ? zero_points[g * N + n] : 0;
+                    const float w = scales[g * N + n]
+                            * ((float)wei_value(p.wei_dt, k, n) - zp);
+                    acc += src[m * K + k] * w;
+                }
+                ref[m * N + n] = acc;
+            }
+
+        memory::desc src_md({M, K}, p.src_dt, tag::ab);
+        memory::desc wei_md({K, N}, p.wei_dt, p.wei_tag);
+        memory::desc dst_md({M, N}, dt::f32, tag::ab);
+        memory::desc bia_md = p.with_bias
+                ? memory::desc({1, N}, dt::f32, tag::ab)
+                : memory::desc();
+
+        primitive_attr attr;
+        attr.set_weights_decompression(p.group_size, p.with_zero_points);
+
+        memory::dim group_size = -1;
+        bool with_zero_points = !p.with_zero_points;
+        attr.get_weights_decompression(group_size, with_zero_points);
+        ASSERT_EQ(group_size, p.group_size);
+        ASSERT_EQ(with_zero_points, p.with_zero_points);
+
+        auto pd = matmul::primitive_desc(
+                {src_md, wei_md, bia_md, dst_md}, attr, eng);
+        ASSERT_NE(std::string(pd.impl_info_str()).find("brg_decomp"),
+                std::string::npos);
+        auto prim = matmul(pd);
+
+        memory src_f32_m({{M, K}, dt::f32, tag::ab}, eng, src.data());
+        memory src_m(src_md, eng), wei_m(wei_md, eng), dst_m(dst_md, eng);
+        memory bia_m(bia_md, eng, bias.data());
+        memory scales_m({{G, N}, dt::f32, tag::ab}, eng, scales.data());
+        memory zero_points_m(
+                {{G, N}, dt::f32, tag::ab}, eng, zero_points.data());
+        reorder(src_f32_m, src_m).execute(strm, src_f32_m, src_m);
+
+        // The 4-bit values are packed two per byte, the first one in the low
+        // nibble
+        {
+            auto wei = map_memory<uint8_t>(wei_m);
+            for (size_t i = 0; i < wei_md.get_size(); i++)
+                wei[i] = 0;
+            for (memory::dim k = 0; k < K; k++)
+                for (memory::dim n = 0; n < N; n++) {
+                    const memory::dim idx
+                            = p.wei_tag == tag::ab ? k * N + n : n * K + k;
+                    const uint8_t v = (uint8_t)wei_value(p.wei_dt, k, n);
+                    if (is_4bit)
+                        wei[idx / 2] |= (uint8_t)((v & 0xf) << (idx % 2 * 4));
+                    else
+                        wei[idx] = v;
+                }
+        }
+
+        std::unordered_map<int, memory> args = {{DNNL_ARG_SRC, src_m},
+                {DNNL_ARG_WEIGHTS, wei_m}, {DNNL_ARG_DST, dst_m},
+                {DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_SCALES, scales_m}};
+        if (p.with_bias) args.insert({DNNL_ARG_BIAS, bia_m});
+        if (p.with_zero_points)
+            args.insert({DNNL_ARG_ATTR_WEIGHTS_DECOMPRESSION_ZERO_POINTS,
+                    zero_points_m});
+        prim.execute(strm, args);
+        strm.wait();
+
+        auto dst = map_memory<float>(dst_m);
+        for (memory::dim m = 0; m < M; m++)
+            for (memory::dim n = 0; n < N; n++)
+                ASSERT_EQ(dst[m * N + n], ref[m * N + n])
+                        << "m: " << m << " n: " << n;
+    }
+};
+
+TEST_P(weights_decompression_test_t, TestsWeightsDecompression) {}
+
+using params_t = weights_decompression_test_params_t;
+INSTANTIATE_TEST_SUITE_P(TestWeightsDecompression,
+        weights_decompression_test_t,
+        ::testing::Values(
+                params_t {dt::f32, dt::s8, tag::ab, 4, 70, 300, 0, false,
+                        true},
+                params_t {dt::f32, dt::u8, tag::ab, 130, 64, 64, 0, true,
+                        false},
+                params_t {dt::f32, dt::s4, tag::ab, 1, 128, 512, 128, false,
+                        false},
+                params_t {dt::f32, dt::u4, tag::ba, 5, 33, 96, 32, true,
+                        true},
+                params_t {dt::f32, dt::s4, tag::ba, 3, 17, 38, 0, true,
+                        false},
+                params_t {dt::bf16, dt::s8, tag::ba, 12, 20, 160, 32, true,
+                        true},
+                params_t {dt::bf16, dt::s8, tag::ab, 2, 80, 37, 0, false,
+                        true},
+                params_t {dt::bf16, dt::u4, tag::ab, 140, 64, 300, 100, true,
+                        false},
+                params_t {dt::bf16, dt::s4, tag::ba, 1, 96, 256, 64, true,
+                        true},
+                params_t {dt::f32, dt::u4, tag::ab, 3, 50, 64, 16, true,
+                        false},
+                params_t {dt::f32, dt::s8, tag::ab, 3, 40, 174, 87, true,
+                        true},
+                params_t {dt::bf16, dt::s4, tag::ab, 2, 90, 45, 15, true,
+                        true},
+                params_t {dt::bf16, dt::u4, tag::ab, 3, 33, 40, 0, false,
+                        true}));
+
+HANDLE_EXCEPTIONS_FOR_TEST(weights_decompression_test, TestAttr) {
+    primitive_attr attr;
+    memory::dim group_size = 0;
+    bool with_zero_points = false;
+
+    // The attribute is not set by default
+    EXPECT_ANY_THROW(
+            attr.get_weights_decompression(group_size, with_zero_points));
+    EXPECT_ANY_THROW(attr.set_weights_decompression(-1));
+
+    attr.set_weights_decompression(32, true);
+    attr.get_weights_decompression(group_size, with_zero_points);
+    EXPECT_EQ(group_size, 32);
+    EXPECT_TRUE(with_zero_points);
+}
+
+} // namespace dnnl
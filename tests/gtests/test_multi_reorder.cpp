@@ -0,0 +1,123 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using dt = memory::data_type;
+using tag = memory::format_tag;
+
+struct multi_reorder_test_params_t {
+    memory::dims dims;
+    tag src_tag;
+    std::vector<std::pair<dt, tag>> dsts;
+    float scale;
+};
+
+// Every destination must match the result of a separate reorder
+class multi_reorder_test_t
+    : public ::testing::TestWithParam<multi_reorder_test_params_t> {
+protected:
+    void SetUp() override {
+        SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+                "Multi-destination reorder is supported on CPU only");
+        catch_expected_failures([=]() { Test(); }, false, dnnl_success);
+    }
+
+    void Test() {
+        auto p = ::testing::TestWithParam<
+                multi_reorder_test_params_t>::GetParam();
+        engine eng(get_test_engine_kind(), 0);
+        stream strm(eng);
+
+        memory::desc src_md(p.dims, dt::f32, p.src_tag);
+        std::vector<memory::desc> dst_mds;
+        for (const auto &d : p.dsts)
+            dst_mds.emplace_back(p.dims, d.first, d.second);
+
+        primitive_attr attr;
+        if (p.scale != 1.f) attr.set_output_scales(0, {p.scale});
+
+        auto src = test::make_memory(src_md, eng);
+        fill_data<float>(src_md.get_size() / sizeof(float), src, 0.f, 100.f);
+
+        multi_reorder::primitive_desc pd(src_md, dst_mds, eng, attr);
+        for (size_t i = 0; i < dst_mds.size(); ++i)
+            ASSERT_TRUE(pd.dst_desc((int)i) == dst_mds[i]);
+
+        std::vector<memory> dsts, refs;
+        for (const auto &md : dst_mds) {
+            dsts.push_back(test::make_memory(md, eng));
+            refs.push_back(test::make_memory(md, eng));
+        }
+
+        multi_reorder(pd).execute(strm, src, dsts);
+        for (size_t i = 0; i < dst_mds.size(); ++i)
+            reorder(reorder::primitive_desc(src, refs[i], attr))
+                    .execute(strm, src, refs[i]);
+        strm.wait();
+
+        for (size_t i = 0; i < dst_mds.size(); ++i) {
+            auto dst_data = map_memory<const char>(dsts[i]);
+            auto ref_data = map_memory<const char>(refs[i]);
+            ASSERT_EQ(std::memcmp(dst_data, ref_data, dst_mds[i].get_size()),
+                    0)
+                    << "destination " << i << " mismatch";
+        }
+    }
+};
+
+TEST_P(multi_reorder_test_t, TestsMultiReorder) {}
+
+INSTANTIATE_TEST_SUITE_P(TestMultiReorder, multi_reorder_test_t,
+        ::testing::Values(
+                multi_reorder_test_params_t {{2, 32, 5, 5}, tag::nchw,
+                        {{dt::f32, tag::nhwc}}, 1.f},
+                multi_reorder_test_params_t {{2, 32, 5, 5}, tag::nchw,
+                        {{dt::f32, tag::nchw}, {dt::f32, tag::nChw16c}}, 1.f},
+                multi_reorder_test_params_t {{8, 64, 28, 28}, tag::nchw,
+                        {{dt::f32, tag::nChw16c}, {dt::f32, tag::nhwc},
+                                {dt::s8, tag::nChw8c}},
+                        1.f},
+                multi_reorder_test_params_t {{1, 64, 56, 56}, tag::nhwc,
+                        {{dt::f32, tag::nChw16c}, {dt::u8, tag::nchw},
+                                {dt::bf16, tag::nhwc}},
+                        0.5f},
+                multi_reorder_test_params_t {{64, 32, 3, 3}, tag::oihw,
+                        {{dt::f32, tag::OIhw16i16o}, {dt::s8, tag::hwio}},
+                        2.f},
+                multi_reorder_test_params_t {{3, 17, 7, 5}, tag::nchw,
+                        {{dt::f32, tag::nChw16c}, {dt::f32, tag::nhwc}},
+                        1.f}));
+
+HANDLE_EXCEPTIONS_FOR_TEST(multi_reorder_test, TestInvalidArguments) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Multi-destination reorder is supported on CPU only");
+    engine eng(get_test_engine_kind(), 0);
+
+    memory::desc src_md({2, 16, 4, 4}, dt::f32, tag::nchw);
+    memory::desc bad_md({2, 16, 4, 5}, dt::f32, tag::nchw);
+    EXPECT_ANY_THROW(multi_reorder::primitive_desc(src_md, {}, eng));
+    EXPECT_ANY_THROW(multi_reorder::primitive_desc(src_md, {bad_md}, eng));
+}
+
+} // namespace dnnl
@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 
 #include "dnnl.hpp"
+#include "src/common/primitive_cache.hpp"
 
 namespace dnnl {
 
@@ -59,4 +60,135 @@ TEST(primitive_cache_mt_test, TestNestedCase) {
     });
 }
 
+TEST(primitive_cache_mt_test, TestConcurrentHits) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    engine eng(get_test_engine_kind(), 0);
+
+    // Most of the requests are cache hits coming from all the threads at
+    // once. Run with DNNL_PRIMITIVE_CACHE_SHARDS > 1 to stress the sharded
+    // cache.
+    int n_shapes = 64;
+    int n_iters = 4096;
+
+    dnnl::impl::parallel_nd(n_iters, [&](int it) {
+        int np = it % n_shapes + 1;
+        auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, {{np, 1, 1, 1}, dt::f32, tag::nchw},
+                0.f, 0.f);
+        auto relu_pd = eltwise_forward::primitive_desc(relu_d, eng);
+        auto relu = eltwise_forward(relu_pd);
+    });
+
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    int size = 0;
+    ASSERT_EQ(impl::get_primitive_cache_size(&size), impl::status::success);
+    ASSERT_LE(size, get_primitive_cache_capacity());
+#endif
+}
+
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+// The sharded cache is built for every test whatever
+// DNNL_PRIMITIVE_CACHE_SHARDS is, the parameter is the number of shards
+class primitive_cache_shards_test_t : public ::testing::TestWithParam<int> {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(impl::set_primitive_cache_shards(GetParam()),
+                impl::status::success);
+    }
+
+    // Restores the default cache together with its capacity
+    void TearDown() override {
+        ASSERT_EQ(impl::set_primitive_cache_shards(0), impl::status::success);
+    }
+
+    int get_size() const {
+        int size = 0;
+        EXPECT_EQ(impl::get_primitive_cache_size(&size),
+                impl::status::success);
+        return size;
+    }
+
+    void create_relu(int np) const {
+        using tag = memory::format_tag;
+        using dt = memory::data_type;
+
+        auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, {{np, 1, 1, 1}, dt::f32, tag::nchw},
+                0.f, 0.f);
+        auto relu_pd = eltwise_forward::primitive_desc(relu_d, eng_);
+        auto relu = eltwise_forward(relu_pd);
+    }
+
+    engine eng_ {get_test_engine_kind(), 0};
+};
+
+TEST_P(primitive_cache_shards_test_t, TestHitsAndMisses) {
+    const int n_shards = GetParam();
+    const int n_shapes = 64;
+
+    // Every shard can hold all the shapes, so that nothing is evicted
+    set_primitive_cache_capacity(n_shapes * n_shards);
+    ASSERT_EQ(get_size(), 0);
+
+    // The first request of a shape is a miss, the others are hits that do not
+    // add an entry, in whichever shard the key lands
+    dnnl::impl::parallel_nd(4 * n_shapes,
+            [&](int it) { create_relu(it % n_shapes + 1); });
+    ASSERT_EQ(get_size(), n_shapes);
+
+    dnnl::impl::parallel_nd(n_shapes, [&](int np) { create_relu(np + 1); });
+    ASSERT_EQ(get_size(), n_shapes);
+}
+
+TEST_P(primitive_cache_shards_test_t, TestEviction) {
+    const int n_shards = GetParam();
+    const int n_shapes = 64;
+
+    // One entry per shard
+    set_primitive_cache_capacity(n_shards);
+    dnnl::impl::parallel_nd(4 * n_shapes,
+            [&](int it) { create_relu(it % n_shapes + 1); });
+    ASSERT_GT(get_size(), 0);
+    ASSERT_LE(get_size(), n_shards);
+
+    // A capacity below the number of shards leaves only one shard in use
+    set_primitive_cache_capacity(1);
+    ASSERT_LE(get_size(), 1);
+    dnnl::impl::parallel_nd(n_shapes, [&](int np) { create_relu(np + 1); });
+    ASSERT_EQ(get_size(), 1);
+
+    set_primitive_cache_capacity(0);
+    ASSERT_EQ(get_size(), 0);
+}
+
+TEST_P(primitive_cache_shards_test_t, TestSetCapacityConcurrently) {
+    const int n_shards = GetParam();
+    const int n_shapes = 64;
+    const int n_iters = 2048;
+
+    // The capacities change the number of shards in use
+    const int capacities[] = {n_shards / 2, n_shards, n_shapes};
+
+    dnnl::impl::parallel_nd(n_iters, [&](int it) {
+        if (it % n_shapes == 0)
+            set_primitive_cache_capacity(capacities[it / n_shapes % 3]);
+        else
+            create_relu(it % n_shapes + 1);
+    });
+    ASSERT_LE(get_size(), get_primitive_cache_capacity());
+
+    // The keys are found in the shards they were added to whatever capacity
+    // they were added with
+    set_primitive_cache_capacity(n_shapes * n_shards);
+    dnnl::impl::parallel_nd(2 * n_shapes,
+            [&](int it) { create_relu(it % n_shapes + 1); });
+    ASSERT_EQ(get_size(), n_shapes);
+}
+
+INSTANTIATE_TEST_SUITE_P(TestShards, primitive_cache_shards_test_t,
+        ::testing::Values(2, 4, 8));
+#endif
+
 } // namespace dnnl
@@ -0,0 +1,144 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <cstring>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using dt = memory::data_type;
+using tag = memory::format_tag;
+
+namespace {
+// The pool is opt-in. Enable it, unless it is explicitly disabled, before the
+// library reads the setting on the first primitive creation.
+const bool pool_env_set = []() {
+    if (std::getenv("DNNL_SCRATCHPAD_POOL")) return false;
+#ifdef _WIN32
+    _putenv_s("DNNL_SCRATCHPAD_POOL", "1");
+#else
+    setenv("DNNL_SCRATCHPAD_POOL", "1", 0);
+#endif
+    return true;
+}();
+} // namespace
+
+class scratchpad_pool_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const char *pool_env = std::getenv("DNNL_SCRATCHPAD_POOL");
+        pool_enabled_ = get_test_engine_kind() == engine::kind::cpu
+                && pool_env && strcmp(pool_env, "0") != 0;
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+        pool_enabled_ = false;
+#endif
+    }
+
+    // The int8 matmul with an int8 destination accumulates into an s32
+    // buffer from the scratchpad, and the primitive does not use the global
+    // scratchpad, unlike the GEMM-based convolutions
+    matmul::primitive_desc make_matmul_pd(
+            const engine &eng, memory::dim N) const {
+        const memory::dim M = 64, K = 32;
+        auto desc = matmul::desc({{M, K}, dt::s8, tag::ab},
+                {{K, N}, dt::s8, tag::ab}, {{M, N}, dt::s8, tag::ab});
+        return matmul::primitive_desc(desc, eng);
+    }
+
+    void execute(const matmul &mm, const matmul::primitive_desc &pd,
+            const engine &eng, stream &strm) const {
+        auto src = test::make_memory(pd.src_desc(), eng);
+        auto wei = test::make_memory(pd.weights_desc(), eng);
+        auto dst = test::make_memory(pd.dst_desc(), eng);
+        mm.execute(strm,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                        {DNNL_ARG_DST, dst}});
+        strm.wait();
+    }
+
+    bool pool_enabled_ = false;
+};
+
+HANDLE_EXCEPTIONS_FOR_TEST_F(scratchpad_pool_test, TestReuse) {
+    SKIP_IF(!pool_enabled_, "Scratchpad pool is not used");
+
+    engine eng(get_test_engine_kind(), 0);
+    stream strm(eng);
+
+    auto pd_1 = make_matmul_pd(eng, 32);
+    auto pd_2 = make_matmul_pd(eng, 30);
+    SKIP_IF(pd_1.query_s64(query::memory_consumption_s64) == 0
+                    || pd_2.query_s64(query::memory_consumption_s64) == 0,
+            "Matmul does not need a scratchpad");
+
+    matmul mm_1(pd_1), mm_2(pd_2);
+
+    const auto before = get_scratchpad_pool_stats();
+    execute(mm_1, pd_1, eng, strm);
+    execute(mm_2, pd_2, eng, strm);
+    execute(mm_1, pd_1, eng, strm);
+    const auto after = get_scratchpad_pool_stats();
+
+    // The primitives are never executed at the same time and the second one
+    // needs a slightly smaller scratchpad, so they share one buffer
+    ASSERT_EQ(after.allocations + after.reuses,
+            before.allocations + before.reuses + 3);
+    ASSERT_LE(after.allocations, before.allocations + 1);
+    ASSERT_EQ(after.bytes_in_use, 0u);
+    ASSERT_GE(after.bytes,
+            (uint64_t)pd_1.query_s64(query::memory_consumption_s64));
+}
+
+HANDLE_EXCEPTIONS_FOR_TEST_F(scratchpad_pool_test, TestTrim) {
+    SKIP_IF(!pool_enabled_, "Scratchpad pool is not used");
+
+    engine eng(get_test_engine_kind(), 0);
+    stream strm(eng);
+
+    auto pd_big = make_matmul_pd(eng, 1024);
+    auto pd_small = make_matmul_pd(eng, 16);
+    const auto big_size
+            = (uint64_t)pd_big.query_s64(query::memory_consumption_s64);
+    const auto small_size
+            = (uint64_t)pd_small.query_s64(query::memory_consumption_s64);
+    // The small executions must not be able to reuse the big buffer
+    SKIP_IF(small_size == 0 || big_size <= 4 * small_size,
+            "Matmul scratchpad sizes do not fit the test");
+
+    matmul mm_big(pd_big), mm_small(pd_small);
+
+    execute(mm_big, pd_big, eng, strm);
+    ASSERT_GE(get_scratchpad_pool_stats().bytes, big_size);
+
+    // The free buffers are trimmed every 256 releases down to the peak usage
+    // since the previous trim, so after two trim periods without the big
+    // primitive its buffer is freed
+    for (int i = 0; i < 2 * 256 + 1; i++)
+        execute(mm_small, pd_small, eng, strm);
+
+    const auto after = get_scratchpad_pool_stats();
+    ASSERT_EQ(after.bytes_in_use, 0u);
+    ASSERT_LT(after.bytes, big_size);
+    ASSERT_GE(after.bytes, small_size);
+}
+
+} // namespace dnnl
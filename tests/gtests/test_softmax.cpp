@@ -252,7 +252,13 @@ INSTANTIATE_TEST_SUITE_P(TestSoftmaxForwardFloat, softmax_forward_test_float,
                 test_params<float> {prop_kind::forward_inference, tag::nChw8c,
                         tag::undef, {64, 1011, 1, 1}, 1},
                 test_params<float> {prop_kind::forward_inference, tag::nChw8c,
-                        tag::undef, {2, 1011, 32, 1}, 2}));
+                        tag::undef, {2, 1011, 32, 1}, 2},
+                test_params<float> {prop_kind::forward_inference, tag::nChw16c,
+                        tag::undef, {2, 32, 17, 5}, 2},
+                test_params<float> {prop_kind::forward_inference, tag::nChw16c,
+                        tag::undef, {3, 16, 4, 19}, 3},
+                test_params<float> {prop_kind::forward_inference, tag::nChw8c,
+                        tag::undef, {2, 24, 7, 3}, 0}));
 
 TEST_P(softmax_forward_test_bfloat16, TestsSoftmax) {}
 GPU_INSTANTIATE_TEST_SUITE_P(TestSoftmaxForwardBfloat16,
@@ -346,5 +352,9 @@ INSTANTIATE_TEST_SUITE_P(TestSoftmaxBackward, softmax_backward_test_float,
                 test_params<float> {prop_kind::backward_data, tag::nChw8c,
                         tag::nChw8c, {64, 1011, 1, 1}, 1},
                 test_params<float> {prop_kind::backward_data, tag::nchw,
-                        tag::nChw8c, {2, 1011, 32, 1}, 2}));
+                        tag::nChw8c, {2, 1011, 32, 1}, 2},
+                test_params<float> {prop_kind::backward_data, tag::nChw16c,
+                        tag::nChw16c, {2, 32, 17, 5}, 3},
+                test_params<float> {prop_kind::backward_data, tag::nChw8c,
+                        tag::nChw8c, {2, 24, 7, 3}, 0}));
 } // namespace dnnl
@@ -0,0 +1,177 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using dt = memory::data_type;
+using tag = memory::format_tag;
+
+struct sparse_weights_test_params_t {
+    primitive::kind prim_kind;
+    dt src_dt, wei_dt, dst_dt;
+    int block_k;
+    memory::dim M, N, K;
+    bool with_bias;
+};
+
+// The inner product and matmul with the weights reordered to the block-sparse
+// format must match the reference computed with the dense weights
+class sparse_weights_test_t
+    : public ::testing::TestWithParam<sparse_weights_test_params_t> {
+protected:
+    void SetUp() override {
+        SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+                "Block-sparse weights are supported on CPU only");
+        catch_expected_failures([=]() { Test(); }, false, dnnl_success, true);
+    }
+
+    // Only the blocks with (nb + kb) % 3 == 0 are non-zero, so that some rows
+    // of blocks are empty for the narrow reduction dimensions. The values are
+    // small integers, so that the results are exact.
+    static float wei_value(memory::dim n, memory::dim k, int block_k) {
+        if ((n / 16 + k / block_k) % 3 != 0) return 0.f;
+        return (float)((n * 7 + k * 3) % 5 - 2);
+    }
+
+    static float src_value(memory::dim m, memory::dim k) {
+        return (float)((m * 5 + k * 11) % 7);
+    }
+
+    void Test() {
+        auto p = ::testing::TestWithParam<
+                sparse_weights_test_params_t>::GetParam();
+        const bool is_ip = p.prim_kind == primitive::kind::inner_product;
+        const memory::dim M = p.M, N = p.N, K = p.K;
+
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        // Dense f32 tensors in the layouts of the primitive
+        const memory::dims wei_dims = is_ip ? memory::dims {N, K}
+                                            : memory::dims {K, N};
+        const memory::dims bia_dims
+                = is_ip ? memory::dims {N} : memory::dims {1, N};
+        std::vector<float> src(M * K), wei(N * K), bias(N), ref(M * N);
+        for (memory::dim m = 0; m < M; m++)
+            for (memory::dim k = 0; k < K; k++)
+                src[m * K + k] = src_value(m, k);
+        for (memory::dim n = 0; n < N; n++) {
+            for (memory::dim k = 0; k < K; k++)
+                wei[is_ip ? n * K + k : k * N + n]
+                        = wei_value(n, k, p.block_k);
+            bias[n] = p.with_bias ? (float)(n % 4) : 0.f;
+        }
+        for (memory::dim m = 0; m < M; m++)
+            for (memory::dim n = 0; n < N; n++) {
+                float acc = bias[n];
+                for (memory::dim k = 0; k < K; k++)
+                    acc += src[m * K + k] * wei_value(n, k, p.block_k);
+                ref[m * N + n] = acc;
+            }
+
+        memory::desc src_md({M, K}, p.src_dt, tag::ab);
+        memory::desc dst_md({M, N}, p.dst_dt, tag::ab);
+        memory::desc bia_md = p.with_bias
+                ? memory::desc(bia_dims, dt::f32, is_ip ? tag::a : tag::ab)
+                : memory::desc();
+        auto wei_md = memory::desc::sparse_bcsr(
+                wei_dims, p.wei_dt, is_ip ? 0 : 1, p.block_k);
+
+        primitive prim;
+        std::string impl_name;
+        if (is_ip) {
+            auto pd = inner_product_forward::primitive_desc(
+                    {prop_kind::forward_inference, src_md, wei_md, bia_md,
+                            dst_md},
+                    eng);
+            impl_name = pd.impl_info_str();
+            prim = inner_product_forward(pd);
+        } else {
+            auto pd = matmul::primitive_desc(
+                    {src_md, wei_md, bia_md, dst_md}, eng);
+            impl_name = pd.impl_info_str();
+            prim = matmul(pd);
+        }
+        ASSERT_NE(impl_name.find("brgemm_sparse"), std::string::npos);
+
+        memory src_f32_m({{M, K}, dt::f32, tag::ab}, eng, src.data());
+        memory wei_f32_m({wei_dims, dt::f32, tag::ab}, eng, wei.data());
+        memory bia_m(bia_md, eng, bias.data());
+        memory src_m(src_md, eng), wei_m(wei_md, eng), dst_m(dst_md, eng);
+        reorder(src_f32_m, src_m).execute(strm, src_f32_m, src_m);
+        reorder(wei_f32_m, wei_m).execute(strm, wei_f32_m, wei_m);
+
+        std::unordered_map<int, memory> args = {{DNNL_ARG_SRC, src_m},
+                {DNNL_ARG_WEIGHTS, wei_m}, {DNNL_ARG_DST, dst_m}};
+        if (p.with_bias) args.insert({DNNL_ARG_BIAS, bia_m});
+        prim.execute(strm, args);
+        strm.wait();
+
+        auto dst = map_memory<float>(dst_m);
+        for (memory::dim m = 0; m < M; m++)
+            for (memory::dim n = 0; n < N; n++)
+                ASSERT_EQ(dst[m * N + n], ref[m * N + n])
+                        << "m: " << m << " n: " << n;
+    }
+};
+
+TEST_P(sparse_weights_test_t, TestsSparseWeights) {}
+
+using pk = primitive::kind;
+INSTANTIATE_TEST_SUITE_P(TestSparseWeights, sparse_weights_test_t,
+        ::testing::Values(
+                sparse_weights_test_params_t {pk::inner_product, dt::f32,
+                        dt::f32, dt::f32, 1, 13, 37, 20, true},
+                sparse_weights_test_params_t {pk::inner_product, dt::f32,
+                        dt::f32, dt::f32, 4, 69, 48, 32, false},
+                sparse_weights_test_params_t {pk::matmul, dt::f32, dt::f32,
+                        dt::f32, 1, 8, 19, 9, true},
+                sparse_weights_test_params_t {pk::inner_product, dt::bf16,
+                        dt::bf16, dt::f32, 4, 16, 40, 64, true},
+                sparse_weights_test_params_t {pk::matmul, dt::bf16, dt::bf16,
+                        dt::f32, 4, 5, 64, 8, false},
+                sparse_weights_test_params_t {pk::inner_product, dt::u8,
+                        dt::s8, dt::f32, 4, 70, 48, 4, true},
+                sparse_weights_test_params_t {pk::matmul, dt::u8, dt::s8,
+                        dt::f32, 4, 10, 33, 16, true}));
+
+HANDLE_EXCEPTIONS_FOR_TEST(sparse_weights_test, TestCapacity) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Block-sparse weights are supported on CPU only");
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    // Invalid block sizes
+    EXPECT_ANY_THROW(memory::desc::sparse_bcsr({16, 6}, dt::f32, 0, 4));
+    EXPECT_ANY_THROW(memory::desc::sparse_bcsr({16, 8}, dt::s8, 0, 1));
+
+    // Two non-zero blocks do not fit into the capacity of one block
+    std::vector<float> wei(32 * 4, 1.f);
+    memory wei_f32_m({{32, 4}, dt::f32, tag::ab}, eng, wei.data());
+    memory wei_m(memory::desc::sparse_bcsr({32, 4}, dt::f32, 0, 4, 1), eng);
+    EXPECT_ANY_THROW(
+            reorder(wei_f32_m, wei_m).execute(strm, wei_f32_m, wei_m));
+}
+
+} // namespace dnnl
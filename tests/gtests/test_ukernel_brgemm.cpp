@@ -0,0 +1,221 @@
+/*******************************************************************************
+* Copyright 2020 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+#include "oneapi/dnnl/dnnl_ukernel.hpp"
+#include "test_gemm_common.hpp"
+
+namespace dnnl {
+
+using dt = memory::data_type;
+using brgemm = ukernel::brgemm;
+
+struct ukernel_brgemm_test_params_t {
+    dt a_dt;
+    dt b_dt;
+    memory::dim M, N, K, batch_size;
+    brgemm::batch_kind kind;
+    float beta;
+    bool with_post_ops;
+};
+
+// The C or D matrix computed by a ukernel must match the reference sum of the
+// products of the batch
+class ukernel_brgemm_test_t
+    : public ::testing::TestWithParam<ukernel_brgemm_test_params_t> {
+protected:
+    void SetUp() override {
+        SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+                "BRGEMM ukernels are supported on CPU only");
+        catch_expected_failures([=]() { Test(); }, false, dnnl_success, true);
+    }
+
+    static size_t dt_size(dt adt) {
+        switch (adt) {
+            case dt::f32:
+            case dt::s32: return 4;
+            case dt::bf16: return 2;
+            default: return 1;
+        }
+    }
+
+    template <typename data_t>
+    static std::vector<data_t> convert(const std::vector<float> &v) {
+        return std::vector<data_t>(v.begin(), v.end());
+    }
+
+    void Test() {
+        auto p = ::testing::TestWithParam<
+                ukernel_brgemm_test_params_t>::GetParam();
+        const bool is_int8 = p.a_dt == dt::u8;
+        const dt c_dt = is_int8 ? dt::s32 : dt::f32;
+        const memory::dim M = p.M, N = p.N, K = p.K, bs = p.batch_size;
+        const memory::dim lda = K + 3, ldb = N, ldc = N + 1;
+
+        brgemm brg(p.kind, M, N, K, p.a_dt, lda, p.b_dt, ldb, c_dt, ldc, 1.f,
+                p.beta);
+        const size_t b_size = brgemm::get_B_packed_size(p.b_dt, K, ldb);
+        const size_t a_size = M * lda * dt_size(p.a_dt);
+        if (p.kind == brgemm::batch_kind::strd)
+            brg.set_batch_strides(a_size, b_size);
+        if (p.with_post_ops) {
+            primitive_attr attr;
+            if (is_int8)
+                attr.set_output_scales(1 << 1, {DNNL_RUNTIME_F32_VAL});
+            post_ops ops;
+            ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+            attr.set_post_ops(ops);
+            brg.set_post_ops(dt::f32, N, dt::f32, attr);
+        }
+        brg.generate();
+
+        // Matrices in f32, converted to the data types of the ukernel
+        std::vector<float> A(bs * M * lda), B(bs * K * N), bias(N), scales(N);
+        fill_exact_matrix(A, is_int8 ? 7 : 5, 0, 1);
+        fill_exact_matrix(B, 5, -2, 2);
+        fill_exact_matrix(bias, 4, 0, 3);
+        for (memory::dim n = 0; n < N; n++)
+            scales[n] = 0.5f * (n % 3 + 1);
+
+        std::vector<float> C(M * ldc), D(M * N, 0.f);
+        fill_exact_matrix(C, 3, 0, 4);
+        std::vector<float> ref(C);
+        for (memory::dim b = 0; b < bs; b++)
+            ref_sgemm('N', 'N', M, N, K, 1.f, &A[b * M * lda], lda,
+                    &B[b * K * N], N, b == 0 ? p.beta : 1.f, ref.data(), ldc);
+
+        std::vector<char> B_packed(bs * b_size);
+        std::vector<char> A_data, B_data;
+        std::vector<char> C_data(M * ldc * dt_size(c_dt));
+        if (is_int8) {
+            auto A_u8 = convert<uint8_t>(A);
+            auto B_s8 = convert<int8_t>(B);
+            A_data.assign((char *)A_u8.data(), (char *)A_u8.data() + A.size());
+            B_data.assign((char *)B_s8.data(), (char *)B_s8.data() + B.size());
+            auto C_s32 = convert<int32_t>(C);
+            std::memcpy(C_data.data(), C_s32.data(), C_data.size());
+        } else if (p.a_dt == dt::bf16) {
+            std::vector<bfloat16_t> A_bf16(A.begin(), A.end()),
+                    B_bf16(B.begin(), B.end());
+            A_data.assign((char *)A_bf16.data(),
+                    (char *)A_bf16.data() + A.size() * sizeof(bfloat16_t));
+            B_data.assign((char *)B_bf16.data(),
+                    (char *)B_bf16.data() + B.size() * sizeof(bfloat16_t));
+            std::memcpy(C_data.data(), C.data(), C_data.size());
+        } else {
+            A_data.assign((char *)A.data(), (char *)A.data() + A.size() * 4);
+            B_data.assign((char *)B.data(), (char *)B.data() + B.size() * 4);
+            std::memcpy(C_data.data(), C.data(), C_data.size());
+        }
+
+        const size_t b_dt_size = dt_size(p.b_dt);
+        for (memory::dim b = 0; b < bs; b++)
+            brgemm::pack_B(p.b_dt, K, N, &B_data[b * K * N * b_dt_size], N,
+                    false, &B_packed[b * b_size], ldb);
+
+        std::vector<char> scratchpad(brg.get_scratchpad_size());
+        void *scratch = scratchpad.empty() ? nullptr : scratchpad.data();
+        void *D_ptr = p.with_post_ops ? D.data() : nullptr;
+
+        brg.set_hw_context();
+        switch (p.kind) {
+            case brgemm::batch_kind::addr: {
+                std::vector<const void *> A_addrs(bs), B_addrs(bs);
+                for (memory::dim b = 0; b < bs; b++) {
+                    A_addrs[b] = &A_data[b * a_size];
+                    B_addrs[b] = &B_packed[b * b_size];
+                }
+                brg.execute(A_addrs, B_addrs, C_data.data(), D_ptr,
+                        bias.data(), scales.data(), scratch);
+                break;
+            }
+            case brgemm::batch_kind::offs: {
+                std::vector<memory::dim> A_offs(bs), B_offs(bs);
+                for (memory::dim b = 0; b < bs; b++) {
+                    A_offs[b] = b * a_size;
+                    B_offs[b] = b * b_size;
+                }
+                brg.execute(A_data.data(), A_offs, B_packed.data(), B_offs,
+                        C_data.data(), D_ptr, bias.data(), scales.data(),
+                        scratch);
+                break;
+            }
+            case brgemm::batch_kind::strd:
+                brg.execute(bs, A_data.data(), B_packed.data(), C_data.data(),
+                        D_ptr, bias.data(), scales.data(), scratch);
+                break;
+        }
+        brgemm::release_hw_context();
+
+        for (memory::dim m = 0; m < M; m++)
+            for (memory::dim n = 0; n < N; n++) {
+                float expected = ref[m * ldc + n];
+                float got = 0.f;
+                if (p.with_post_ops) {
+                    expected += bias[n];
+                    if (is_int8) expected *= scales[n];
+                    expected = std::max(expected, 0.f);
+                    got = D[m * N + n];
+                } else if (is_int8) {
+                    got = (float)((int32_t *)C_data.data())[m * ldc + n];
+                } else {
+                    got = ((float *)C_data.data())[m * ldc + n];
+                }
+                ASSERT_EQ(got, expected) << "m: " << m << " n: " << n;
+            }
+    }
+};
+
+TEST_P(ukernel_brgemm_test_t, TestsUkernelBrgemm) {}
+
+using kind = brgemm::batch_kind;
+INSTANTIATE_TEST_SUITE_P(TestUkernelBrgemm, ukernel_brgemm_test_t,
+        ::testing::Values(
+                ukernel_brgemm_test_params_t {dt::f32, dt::f32, 16, 32, 16, 4,
+                        kind::addr, 0.f, false},
+                ukernel_brgemm_test_params_t {dt::f32, dt::f32, 13, 37, 9, 3,
+                        kind::offs, 1.f, false},
+                ukernel_brgemm_test_params_t {dt::f32, dt::f32, 7, 24, 32, 2,
+                        kind::strd, 0.f, true},
+                ukernel_brgemm_test_params_t {dt::u8, dt::s8, 16, 48, 64, 2,
+                        kind::addr, 1.f, false},
+                ukernel_brgemm_test_params_t {dt::u8, dt::s8, 9, 19, 12, 3,
+                        kind::strd, 0.f, true},
+                ukernel_brgemm_test_params_t {dt::bf16, dt::bf16, 16, 32, 32,
+                        2, kind::offs, 0.f, false}));
+
+HANDLE_EXCEPTIONS_FOR_TEST(ukernel_brgemm_test, TestInvalidArguments) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "BRGEMM ukernels are supported on CPU only");
+    // Leading dimension smaller than the number of columns
+    EXPECT_ANY_THROW(brgemm(kind::addr, 16, 16, 16, dt::f32, 8, dt::f32, 16,
+            dt::f32, 16));
+    // Strides of a batch of addresses
+    brgemm brg(kind::addr, 16, 16, 16, dt::f32, 16, dt::f32, 16, dt::f32, 16);
+    EXPECT_ANY_THROW(brg.set_batch_strides(1024, 1024));
+    // Execution before generation
+    std::vector<float> C(16 * 16);
+    EXPECT_ANY_THROW(brg.execute({C.data()}, {C.data()}, C.data()));
+}
+
+} // namespace dnnl